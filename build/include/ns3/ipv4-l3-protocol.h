@@ -0,0 +1 @@
+#include "/root/repo/src/internet/model/ipv4-l3-protocol.h"
@@ -0,0 +1 @@
+#include "/root/repo/src/mpi/model/mpi-interface.h"
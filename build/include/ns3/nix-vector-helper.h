@@ -0,0 +1 @@
+#include "/root/repo/src/nix-vector-routing/helper/nix-vector-helper.h"
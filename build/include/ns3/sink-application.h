@@ -0,0 +1 @@
+#include "/root/repo/src/applications/model/sink-application.h"
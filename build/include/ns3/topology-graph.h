@@ -0,0 +1 @@
+#include "/root/repo/src/topology-read/model/topology-graph.h"
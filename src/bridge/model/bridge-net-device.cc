@@ -13,6 +13,8 @@
 #include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 /**
  * @file
  * @ingroup bridge
@@ -48,12 +50,20 @@ BridgeNetDevice::GetTypeId()
                           "Time it takes for learned MAC state entry to expire.",
                           TimeValue(Seconds(300)),
                           MakeTimeAccessor(&BridgeNetDevice::m_expirationTime),
-                          MakeTimeChecker());
+                          MakeTimeChecker())
+            .AddAttribute("MaxAddresses",
+                          "The maximum number of learned MAC addresses, 0 for no limit. "
+                          "When the table is full, the frames from new addresses are "
+                          "forwarded, but their addresses are not learned.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&BridgeNetDevice::m_maxAddresses),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
 BridgeNetDevice::BridgeNetDevice()
-    : m_node(nullptr),
+    : m_agedSlot(0),
+      m_node(nullptr),
       m_ifIndex(0)
 {
     NS_LOG_FUNCTION_NOARGS();
@@ -74,6 +84,11 @@ BridgeNetDevice::DoDispose()
         *iter = nullptr;
     }
     m_ports.clear();
+    m_learnState.clear();
+    for (auto& slot : m_agingWheel)
+    {
+        slot.clear();
+    }
     m_channel = nullptr;
     m_node = nullptr;
     NetDevice::DoDispose();
@@ -151,6 +166,7 @@ BridgeNetDevice::ForwardUnicast(Ptr<NetDevice> incomingPort,
     else
     {
         NS_LOG_LOGIC("No learned state: send through all ports");
+        m_fdbStats.nFloods++;
         for (auto iter = m_ports.begin(); iter != m_ports.end(); iter++)
         {
             Ptr<NetDevice> port = *iter;
@@ -180,6 +196,7 @@ BridgeNetDevice::ForwardBroadcast(Ptr<NetDevice> incomingPort,
                  << ", protocol=" << protocol << ", src=" << src << ", dst=" << dst << ")");
     Learn(src, incomingPort);
 
+    m_fdbStats.nFloods++;
     for (auto iter = m_ports.begin(); iter != m_ports.end(); iter++)
     {
         Ptr<NetDevice> port = *iter;
@@ -200,9 +217,100 @@ BridgeNetDevice::Learn(Mac48Address source, Ptr<NetDevice> port)
     NS_LOG_FUNCTION_NOARGS();
     if (m_enableLearning)
     {
-        LearnedState& state = m_learnState[source];
-        state.associatedPort = port;
-        state.expirationTime = Simulator::Now() + m_expirationTime;
+        Time now = Simulator::Now();
+        Age(now);
+        Time expirationTime = now + m_expirationTime;
+        auto iter = m_learnState.find(source);
+        if (iter != m_learnState.end())
+        {
+            // the address stays in its slot of the aging wheel until the slot is aged
+            iter->second.associatedPort = port;
+            iter->second.expirationTime = expirationTime;
+            return;
+        }
+        if (m_maxAddresses > 0 && m_learnState.size() >= m_maxAddresses)
+        {
+            NS_LOG_LOGIC("Table of learned addresses full: " << source << " not learned");
+            m_fdbStats.nOverflows++;
+            return;
+        }
+        int64_t slot =
+            std::clamp(GetAgingSlot(expirationTime), m_agedSlot, m_agedSlot + AGING_SLOTS);
+        m_learnState.emplace(source, LearnedState{port, expirationTime, slot});
+        m_agingWheel[slot % (AGING_SLOTS + 1)].push_back(source);
+        m_fdbStats.nLearned++;
+    }
+}
+
+int64_t
+BridgeNetDevice::GetAgingSlot(Time time) const
+{
+    return time.GetTimeStep() / std::max<int64_t>(m_expirationTime.GetTimeStep() / AGING_SLOTS, 1);
+}
+
+void
+BridgeNetDevice::Age(Time now)
+{
+    int64_t nowSlot = GetAgingSlot(now);
+    if (nowSlot == m_agedSlot)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << now);
+
+    if (nowSlot < m_agedSlot || nowSlot - m_agedSlot > AGING_SLOTS)
+    {
+        // All the slots of the wheel are due (or the expiration time was
+        // changed): age all the addresses and rebuild the wheel
+        for (auto& slot : m_agingWheel)
+        {
+            slot.clear();
+        }
+        m_agedSlot = nowSlot;
+        for (auto iter = m_learnState.begin(); iter != m_learnState.end();)
+        {
+            if (iter->second.expirationTime <= now)
+            {
+                iter = m_learnState.erase(iter);
+                m_fdbStats.nAged++;
+                continue;
+            }
+            int64_t slot = std::clamp(GetAgingSlot(iter->second.expirationTime),
+                                      m_agedSlot,
+                                      m_agedSlot + AGING_SLOTS);
+            iter->second.agingSlot = slot;
+            m_agingWheel[slot % (AGING_SLOTS + 1)].push_back(iter->first);
+            iter++;
+        }
+        return;
+    }
+
+    std::vector<Mac48Address> addresses;
+    for (; m_agedSlot < nowSlot; m_agedSlot++)
+    {
+        // The addresses still in a slot ending before now either expired, or
+        // were refreshed and must be moved to the slot of their new expiration time
+        addresses.swap(m_agingWheel[m_agedSlot % (AGING_SLOTS + 1)]);
+        for (const auto& address : addresses)
+        {
+            auto iter = m_learnState.find(address);
+            if (iter == m_learnState.end() || iter->second.agingSlot != m_agedSlot)
+            {
+                // removed by GetLearnedState(), or learned again since
+                continue;
+            }
+            if (iter->second.expirationTime <= now)
+            {
+                m_learnState.erase(iter);
+                m_fdbStats.nAged++;
+                continue;
+            }
+            int64_t slot =
+                std::min(GetAgingSlot(iter->second.expirationTime), m_agedSlot + AGING_SLOTS);
+            iter->second.agingSlot = slot;
+            m_agingWheel[slot % (AGING_SLOTS + 1)].push_back(address);
+        }
+        addresses.clear();
     }
 }
 
@@ -219,13 +327,16 @@ BridgeNetDevice::GetLearnedState(Mac48Address source)
             LearnedState& state = iter->second;
             if (state.expirationTime > now)
             {
+                m_fdbStats.nHits++;
                 return state.associatedPort;
             }
             else
             {
                 m_learnState.erase(iter);
+                m_fdbStats.nAged++;
             }
         }
+        m_fdbStats.nMisses++;
     }
     return nullptr;
 }
@@ -244,6 +355,20 @@ BridgeNetDevice::GetBridgePort(uint32_t n) const
     return m_ports[n];
 }
 
+uint32_t
+BridgeNetDevice::GetNLearnedAddresses() const
+{
+    NS_LOG_FUNCTION_NOARGS();
+    return m_learnState.size();
+}
+
+const BridgeNetDevice::FdbStats&
+BridgeNetDevice::GetFdbStats() const
+{
+    NS_LOG_FUNCTION_NOARGS();
+    return m_fdbStats;
+}
+
 void
 BridgeNetDevice::AddBridgePort(Ptr<NetDevice> bridgePort)
 {
@@ -405,6 +530,7 @@ BridgeNetDevice::SendFrom(Ptr<Packet> packet,
 
     // data was not unicast or no state has been learned for that mac
     // address => flood through all ports.
+    m_fdbStats.nFloods++;
     Ptr<Packet> pktCopy;
     for (auto iter = m_ports.begin(); iter != m_ports.end(); iter++)
     {
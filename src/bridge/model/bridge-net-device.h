@@ -12,9 +12,13 @@
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
 
-#include <map>
 #include <stdint.h>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+class BridgeNetDeviceLearningTestCase;
+class BridgeNetDeviceAgingTestCase;
 
 /**
  * @file
@@ -62,6 +66,20 @@ class Node;
 class BridgeNetDevice : public NetDevice
 {
   public:
+    /**
+     * @ingroup bridge
+     * Statistics of the learning of addresses and of the forwarding of frames
+     */
+    struct FdbStats
+    {
+        uint64_t nHits{0};      //!< unicast lookups finding the port of the destination
+        uint64_t nMisses{0};    //!< unicast lookups not finding the port of the destination
+        uint64_t nFloods{0};    //!< frames sent through all the ports
+        uint64_t nLearned{0};   //!< addresses learned
+        uint64_t nAged{0};      //!< learned addresses removed after they expired
+        uint64_t nOverflows{0}; //!< addresses not learned because the table was full
+    };
+
     /**
      * @brief Get the type ID.
      * @return the object TypeId
@@ -103,6 +121,23 @@ class BridgeNetDevice : public NetDevice
      */
     Ptr<NetDevice> GetBridgePort(uint32_t n) const;
 
+    /**
+     * @brief Gets the number of addresses in the table of learned addresses.
+     *
+     * The addresses which expired are only removed from the table periodically,
+     * while the frames are received, so that they may be counted.
+     *
+     * @return the number of learned addresses.
+     */
+    uint32_t GetNLearnedAddresses() const;
+
+    /**
+     * @brief Gets the statistics of the learning of addresses and of the
+     * forwarding of frames.
+     * @return the statistics
+     */
+    const FdbStats& GetFdbStats() const;
+
     // inherited from NetDevice base class.
     void SetIfIndex(const uint32_t index) override;
     uint32_t GetIfIndex() const override;
@@ -193,7 +228,26 @@ class BridgeNetDevice : public NetDevice
      */
     Ptr<NetDevice> GetLearnedState(Mac48Address source);
 
+    /**
+     * @brief Removes the learned addresses which expired in the slots of the
+     * aging wheel which ended before the current time.
+     * @param now the current time
+     */
+    void Age(Time now);
+
+    /**
+     * @brief Gets the slot of the aging wheel containing a time.
+     * @param time the time
+     * @return the number of the slot since the start of the simulation
+     */
+    int64_t GetAgingSlot(Time time) const;
+
   private:
+    /// allow BridgeNetDeviceLearningTestCase class access
+    friend class ::BridgeNetDeviceLearningTestCase;
+    /// allow BridgeNetDeviceAgingTestCase class access
+    friend class ::BridgeNetDeviceAgingTestCase;
+
     NetDevice::ReceiveCallback m_rxCallback;               //!< receive callback
     NetDevice::PromiscReceiveCallback m_promiscRxCallback; //!< promiscuous receive callback
 
@@ -208,15 +262,34 @@ class BridgeNetDevice : public NetDevice
     {
         Ptr<NetDevice> associatedPort; //!< port associated with the address
         Time expirationTime;           //!< time it takes for learned MAC state to expire
+        int64_t agingSlot;             //!< slot of the aging wheel the address is in
     };
 
-    std::map<Mac48Address, LearnedState> m_learnState; //!< Container for known address statuses
-    Ptr<Node> m_node;                                  //!< node owning this NetDevice
-    Ptr<BridgeChannel> m_channel;                      //!< virtual bridged channel
-    std::vector<Ptr<NetDevice>> m_ports;               //!< bridged ports
-    uint32_t m_ifIndex;                                //!< Interface index
-    uint16_t m_mtu;                                    //!< MTU of the bridged NetDevice
-    bool m_enableLearning; //!< true if the bridge will learn the node status
+    /**
+     * Number of slots the expiration time is divided into by the aging wheel.
+     * The wheel has one more slot, for the addresses expiring in the current
+     * slot.
+     */
+    static constexpr int64_t AGING_SLOTS = 16;
+
+    /// Container for known address statuses
+    std::unordered_map<Mac48Address, LearnedState, Mac48AddressHash> m_learnState;
+
+    /**
+     * Aging wheel: each learned address is in the slot containing its expiration
+     * time when it was learned, or when its slot was last aged
+     */
+    std::vector<Mac48Address> m_agingWheel[AGING_SLOTS + 1];
+
+    int64_t m_agedSlot;                  //!< first slot of the aging wheel not aged yet
+    uint32_t m_maxAddresses;             //!< maximum number of learned addresses, 0 if none
+    FdbStats m_fdbStats;                 //!< statistics of the learning and forwarding
+    Ptr<Node> m_node;                    //!< node owning this NetDevice
+    Ptr<BridgeChannel> m_channel;        //!< virtual bridged channel
+    std::vector<Ptr<NetDevice>> m_ports; //!< bridged ports
+    uint32_t m_ifIndex;                  //!< Interface index
+    uint16_t m_mtu;                      //!< MTU of the bridged NetDevice
+    bool m_enableLearning;               //!< true if the bridge will learn the node status
 };
 
 } // namespace ns3
@@ -0,0 +1,304 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/bridge-net-device.h"
+#include "ns3/mac48-address.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @ingroup bridge-tests
+ * BridgeNetDevice test suite
+ */
+
+/**
+ * @defgroup bridge-tests Bridge module tests
+ * @ingroup bridge
+ * @ingroup tests
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup bridge-tests
+ *
+ * Create a bridge with two ports, each on its own channel.
+ *
+ * @param [in] maxAddresses The maximum number of learned addresses.
+ * @return The bridge.
+ */
+static Ptr<BridgeNetDevice>
+CreateBridge(uint32_t maxAddresses)
+{
+    Ptr<Node> node = CreateObject<Node>();
+    Ptr<BridgeNetDevice> bridge = CreateObject<BridgeNetDevice>();
+    bridge->SetAttribute("MaxAddresses", UintegerValue(maxAddresses));
+    bridge->SetAttribute("ExpirationTime", TimeValue(Seconds(16)));
+    node->AddDevice(bridge);
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<SimpleNetDevice> port = CreateObject<SimpleNetDevice>();
+        port->SetAddress(Mac48Address::Allocate());
+        port->SetChannel(CreateObject<SimpleChannel>());
+        node->AddDevice(port);
+        bridge->AddBridgePort(port);
+    }
+    return bridge;
+}
+
+/**
+ * @ingroup bridge-tests
+ *
+ * @brief Test case checking that a bridge learns addresses up to its
+ * MaxAddresses limit, and the counters of its FdbStats.
+ */
+class BridgeNetDeviceLearningTestCase : public TestCase
+{
+  public:
+    BridgeNetDeviceLearningTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Receive frames through the ports of a bridge, in the context of its node.
+     * @param [in] bridge The bridge.
+     */
+    void ReceiveFrames(Ptr<BridgeNetDevice> bridge);
+};
+
+BridgeNetDeviceLearningTestCase::BridgeNetDeviceLearningTestCase()
+    : TestCase("Check the learning of addresses up to MaxAddresses and the FdbStats")
+{
+}
+
+void
+BridgeNetDeviceLearningTestCase::DoRun()
+{
+    Ptr<BridgeNetDevice> bridge = CreateBridge(4);
+    Simulator::ScheduleWithContext(bridge->GetNode()->GetId(),
+                                   Seconds(0),
+                                   &BridgeNetDeviceLearningTestCase::ReceiveFrames,
+                                   this,
+                                   bridge);
+    Simulator::Run();
+    Simulator::Destroy();
+}
+
+void
+BridgeNetDeviceLearningTestCase::ReceiveFrames(Ptr<BridgeNetDevice> bridge)
+{
+    Ptr<NetDevice> port0 = bridge->GetBridgePort(0);
+    Ptr<NetDevice> port1 = bridge->GetBridgePort(1);
+    std::vector<Mac48Address> addresses;
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        addresses.push_back(Mac48Address::Allocate());
+    }
+    Ptr<Packet> packet = Create<Packet>(100);
+    Mac48Address broadcast = Mac48Address::GetBroadcast();
+
+    // Addresses 0 and 1 behind port 1, 2 to 5 behind port 0: only the first
+    // four are learned, the frames of the others are still flooded
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        bridge->ReceiveFromDevice(i < 2 ? port1 : port0,
+                                  packet,
+                                  0x0800,
+                                  addresses[i],
+                                  broadcast,
+                                  NetDevice::PACKET_BROADCAST);
+    }
+    const BridgeNetDevice::FdbStats& stats = bridge->GetFdbStats();
+    NS_TEST_EXPECT_MSG_EQ(bridge->GetNLearnedAddresses(), 4, "learned addresses");
+    NS_TEST_EXPECT_MSG_EQ(stats.nLearned, 4, "learned addresses");
+    NS_TEST_EXPECT_MSG_EQ(stats.nOverflows, 2, "addresses not learned");
+    NS_TEST_EXPECT_MSG_EQ(stats.nFloods, 6, "broadcast frames flooded");
+    NS_TEST_EXPECT_MSG_EQ(bridge->GetLearnedState(addresses[1]), port1, "port of address 1");
+    NS_TEST_EXPECT_MSG_EQ(bridge->GetLearnedState(addresses[3]), port0, "port of address 3");
+    NS_TEST_EXPECT_MSG_EQ(bridge->GetLearnedState(addresses[4]), nullptr, "address 4");
+    NS_TEST_EXPECT_MSG_EQ(stats.nHits, 2, "lookups of learned addresses");
+    NS_TEST_EXPECT_MSG_EQ(stats.nMisses, 1, "lookups of unknown addresses");
+
+    // A unicast frame to a learned address is forwarded through its port
+    bridge->ReceiveFromDevice(port0,
+                              packet,
+                              0x0800,
+                              addresses[6],
+                              addresses[0],
+                              NetDevice::PACKET_OTHERHOST);
+    NS_TEST_EXPECT_MSG_EQ(stats.nOverflows, 3, "address 6 not learned");
+    NS_TEST_EXPECT_MSG_EQ(stats.nHits, 3, "lookup of address 0");
+    NS_TEST_EXPECT_MSG_EQ(stats.nFloods, 6, "frame to address 0 not flooded");
+
+    // A unicast frame to an unknown address, or to an address behind the port
+    // it is received from, is flooded
+    bridge->ReceiveFromDevice(port0,
+                              packet,
+                              0x0800,
+                              addresses[2],
+                              addresses[7],
+                              NetDevice::PACKET_OTHERHOST);
+    bridge->ReceiveFromDevice(port0,
+                              packet,
+                              0x0800,
+                              addresses[2],
+                              addresses[3],
+                              NetDevice::PACKET_OTHERHOST);
+    NS_TEST_EXPECT_MSG_EQ(stats.nMisses, 2, "lookup of address 7");
+    NS_TEST_EXPECT_MSG_EQ(stats.nHits, 4, "lookup of address 3");
+    NS_TEST_EXPECT_MSG_EQ(stats.nFloods, 8, "frames flooded");
+    NS_TEST_EXPECT_MSG_EQ(stats.nLearned, 4, "addresses learned again are not counted");
+    NS_TEST_EXPECT_MSG_EQ(stats.nOverflows, 3, "known addresses do not overflow");
+    NS_TEST_EXPECT_MSG_EQ(stats.nAged, 0, "no address expired");
+}
+
+/**
+ * @ingroup bridge-tests
+ *
+ * @brief Test case checking that the learned addresses expire at their
+ * ExpirationTime, and are removed from the table in batches after it.
+ */
+class BridgeNetDeviceAgingTestCase : public TestCase
+{
+  public:
+    BridgeNetDeviceAgingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Learn an address behind the first port of the bridge.
+     * @param [in] address The address.
+     */
+    void Learn(Mac48Address address);
+
+    /**
+     * Check the table of learned addresses.
+     * @param [in] learned The expected number of learned addresses.
+     * @param [in] aged The expected number of addresses removed since they expired.
+     */
+    void CheckTable(uint32_t learned, uint64_t aged);
+
+    /**
+     * Check the lookup of an address.
+     * @param [in] address The address.
+     * @param [in] found Whether the address should be found.
+     */
+    void CheckLookup(Mac48Address address, bool found);
+
+    Ptr<BridgeNetDevice> m_bridge; //!< The bridge.
+};
+
+BridgeNetDeviceAgingTestCase::BridgeNetDeviceAgingTestCase()
+    : TestCase("Check the aging of the learned addresses at and after their ExpirationTime")
+{
+}
+
+void
+BridgeNetDeviceAgingTestCase::Learn(Mac48Address address)
+{
+    m_bridge->Learn(address, m_bridge->GetBridgePort(0));
+}
+
+void
+BridgeNetDeviceAgingTestCase::CheckTable(uint32_t learned, uint64_t aged)
+{
+    NS_TEST_EXPECT_MSG_EQ(m_bridge->GetNLearnedAddresses(),
+                          learned,
+                          "learned addresses at " << Simulator::Now().As(Time::S));
+    NS_TEST_EXPECT_MSG_EQ(m_bridge->GetFdbStats().nAged,
+                          aged,
+                          "aged addresses at " << Simulator::Now().As(Time::S));
+}
+
+void
+BridgeNetDeviceAgingTestCase::CheckLookup(Mac48Address address, bool found)
+{
+    NS_TEST_EXPECT_MSG_EQ((m_bridge->GetLearnedState(address) != nullptr),
+                          found,
+                          "lookup of " << address << " at " << Simulator::Now().As(Time::S));
+}
+
+void
+BridgeNetDeviceAgingTestCase::DoRun()
+{
+    // With an ExpirationTime of 16 s, the slots of the aging wheel last 1 s
+    m_bridge = CreateBridge(0);
+    Mac48Address a = Mac48Address::Allocate();
+    Mac48Address b = Mac48Address::Allocate();
+    Mac48Address c = Mac48Address::Allocate();
+    Mac48Address d = Mac48Address::Allocate();
+    Mac48Address e = Mac48Address::Allocate();
+    Mac48Address f = Mac48Address::Allocate();
+
+    // a and b expire at 16 s, b is refreshed at 10 s to expire at 26 s
+    Learn(a);
+    Learn(b);
+    Simulator::Schedule(Seconds(10), &BridgeNetDeviceAgingTestCase::Learn, this, b);
+    Simulator::Schedule(Seconds(15.5), &BridgeNetDeviceAgingTestCase::CheckLookup, this, a, true);
+
+    // a expired at 16 s, but stays in the table until its slot is aged at 17 s
+    Simulator::Schedule(Seconds(16), &BridgeNetDeviceAgingTestCase::Learn, this, c);
+    Simulator::Schedule(Seconds(16), &BridgeNetDeviceAgingTestCase::CheckTable, this, 3, 0);
+    Simulator::Schedule(Seconds(17), &BridgeNetDeviceAgingTestCase::Learn, this, d);
+    Simulator::Schedule(Seconds(17), &BridgeNetDeviceAgingTestCase::CheckTable, this, 3, 1);
+    Simulator::Schedule(Seconds(17), &BridgeNetDeviceAgingTestCase::CheckLookup, this, a, false);
+
+    // b is found until 26 s, and removed when looked up at its expiration time
+    Simulator::Schedule(Seconds(25.5), &BridgeNetDeviceAgingTestCase::CheckLookup, this, b, true);
+    Simulator::Schedule(Seconds(26), &BridgeNetDeviceAgingTestCase::CheckLookup, this, b, false);
+    Simulator::Schedule(Seconds(26), &BridgeNetDeviceAgingTestCase::CheckTable, this, 2, 2);
+
+    // c, learned at 16 s, is aged in the batch of 33 s, not d, learned at 17 s
+    Simulator::Schedule(Seconds(33), &BridgeNetDeviceAgingTestCase::Learn, this, e);
+    Simulator::Schedule(Seconds(33), &BridgeNetDeviceAgingTestCase::CheckTable, this, 2, 3);
+
+    // After more than ExpirationTime without learning, all the expired
+    // addresses are aged at once
+    Simulator::Schedule(Seconds(100), &BridgeNetDeviceAgingTestCase::Learn, this, f);
+    Simulator::Schedule(Seconds(100), &BridgeNetDeviceAgingTestCase::CheckTable, this, 1, 5);
+    Simulator::Schedule(Seconds(100), &BridgeNetDeviceAgingTestCase::CheckLookup, this, f, true);
+
+    Simulator::Run();
+
+    const BridgeNetDevice::FdbStats& stats = m_bridge->GetFdbStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.nLearned, 6, "learned addresses");
+    NS_TEST_EXPECT_MSG_EQ(stats.nHits, 3, "lookups of learned addresses");
+    NS_TEST_EXPECT_MSG_EQ(stats.nMisses, 2, "lookups of expired addresses");
+    NS_TEST_EXPECT_MSG_EQ(stats.nOverflows, 0, "no limit on the learned addresses");
+
+    m_bridge = nullptr;
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup bridge-tests
+ *
+ * @brief BridgeNetDevice TestSuite
+ */
+class BridgeTestSuite : public TestSuite
+{
+  public:
+    BridgeTestSuite();
+};
+
+BridgeTestSuite::BridgeTestSuite()
+    : TestSuite("bridge", Type::UNIT)
+{
+    AddTestCase(new BridgeNetDeviceLearningTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BridgeNetDeviceAgingTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static BridgeTestSuite g_bridgeTestSuite;
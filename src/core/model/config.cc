@@ -14,8 +14,11 @@
 #include "object.h"
 #include "pointer.h"
 #include "singleton.h"
+#include "trace-source-accessor.h"
 
+#include <limits>
 #include <sstream>
+#include <unordered_map>
 
 /**
  * @file
@@ -130,15 +133,7 @@ bool
 MatchContainer::ConnectFailSafe(std::string name, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(this << name << &cb);
-    NS_ASSERT(m_objects.size() == m_contexts.size());
-    bool ok = false;
-    for (uint32_t i = 0; i < m_objects.size(); ++i)
-    {
-        Ptr<Object> object = m_objects[i];
-        std::string ctx = m_contexts[i] + name;
-        ok |= object->TraceConnect(name, ctx, cb);
-    }
-    return ok;
+    return DoConnect(name, cb, true) > 0;
 }
 
 void
@@ -154,13 +149,75 @@ bool
 MatchContainer::ConnectWithoutContextFailSafe(std::string name, const CallbackBase& cb)
 {
     NS_LOG_FUNCTION(this << name << &cb);
-    bool ok = false;
-    for (auto tmp = Begin(); tmp != End(); ++tmp)
+    return DoConnect(name, cb, false) > 0;
+}
+
+std::vector<std::size_t>
+MatchContainer::ConnectBulk(const std::vector<TraceSink>& sinks)
+{
+    NS_LOG_FUNCTION(this << &sinks);
+    std::vector<std::size_t> counts;
+    counts.reserve(sinks.size());
+    for (const auto& sink : sinks)
     {
-        Ptr<Object> object = *tmp;
-        ok |= object->TraceConnectWithoutContext(name, cb);
+        counts.push_back(DoConnect(sink.first, sink.second, true));
     }
-    return ok;
+    return counts;
+}
+
+std::vector<std::size_t>
+MatchContainer::ConnectWithoutContextBulk(const std::vector<TraceSink>& sinks)
+{
+    NS_LOG_FUNCTION(this << &sinks);
+    std::vector<std::size_t> counts;
+    counts.reserve(sinks.size());
+    for (const auto& sink : sinks)
+    {
+        counts.push_back(DoConnect(sink.first, sink.second, false));
+    }
+    return counts;
+}
+
+std::size_t
+MatchContainer::DoConnect(std::string name, const CallbackBase& cb, bool withContext)
+{
+    NS_LOG_FUNCTION(this << name << &cb << withContext);
+    NS_ASSERT(m_objects.size() == m_contexts.size());
+
+    // Matched objects usually share a handful of types: look up the
+    // trace source once per TypeId rather than once per object.
+    std::unordered_map<uint16_t, Ptr<const TraceSourceAccessor>> accessors;
+    std::size_t count = 0;
+    for (uint32_t i = 0; i < m_objects.size(); ++i)
+    {
+        Ptr<Object> object = m_objects[i];
+        TypeId tid = object->GetInstanceTypeId();
+        auto [it, inserted] = accessors.try_emplace(tid.GetUid());
+        if (inserted)
+        {
+            it->second = tid.LookupTraceSourceByName(name);
+        }
+        if (!it->second)
+        {
+            NS_LOG_DEBUG("Cannot connect trace " << name << " on object of type "
+                                                 << tid.GetName());
+            continue;
+        }
+        bool ok;
+        if (withContext)
+        {
+            ok = it->second->Connect(PeekPointer(object), m_contexts[i] + name, cb);
+        }
+        else
+        {
+            ok = it->second->ConnectWithoutContext(PeekPointer(object), cb);
+        }
+        if (ok)
+        {
+            count++;
+        }
+    }
+    return count;
 }
 
 void
@@ -190,6 +247,10 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * @ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, at construction, into a list of
+ * index ranges so that matching the entries of large containers does
+ * not re-parse the path element for every entry.
  */
 class ArrayMatcher
 {
@@ -209,6 +270,12 @@ class ArrayMatcher
     bool Matches(std::size_t i) const;
 
   private:
+    /**
+     * Parse one alternative of the Config path specification.
+     *
+     * @param [in] element The alternative to parse.
+     */
+    void Compile(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -219,6 +286,8 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** The inclusive index ranges matched by the Config path element. */
+    std::vector<std::pair<std::size_t, std::size_t>> m_ranges;
 
     // end of class ArrayMatcher
 };
@@ -227,65 +296,62 @@ ArrayMatcher::ArrayMatcher(std::string element)
     : m_element(element)
 {
     NS_LOG_FUNCTION(this << element);
+    Compile(element);
 }
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
+void
+ArrayMatcher::Compile(std::string element)
 {
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        m_ranges.emplace_back(0, std::numeric_limits<std::size_t>::max());
+        return;
     }
     std::string::size_type tmp;
-    tmp = m_element.find('|');
+    tmp = element.find('|');
     if (tmp != std::string::npos)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
+        std::string left = element.substr(0, tmp - 0);
+        std::string right = element.substr(tmp + 1, element.size() - (tmp + 1));
+        Compile(left);
+        Compile(right);
+        return;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max))
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
-        {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-        return true;
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    for (const auto& range : m_ranges)
+    {
+        if (i >= range.first && i <= range.second)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
     }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
@@ -304,6 +370,13 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 /**
  * @ingroup config-impl
  * Abstract class to parse Config paths into object references.
+ *
+ * The Config path is split into its elements once, at construction.
+ * The attributes of a TypeId which match a given element, and the
+ * TypeId named by a "$" element, are looked up the first time they
+ * are needed and reused for every other object found at the same
+ * position in the path, so that resolving a path with wildcards over
+ * many objects of the same type does not repeat the metadata lookups.
  */
 class Resolver
 {
@@ -327,23 +400,60 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
+    /** A Config path element. */
+    struct PathItem
+    {
+        std::string name;     //!< The text of the element.
+        ArrayMatcher matcher; //!< The element parsed as an array index.
+        bool tidResolved;     //!< Whether \c tid was looked up.
+        TypeId tid;           //!< The TypeId named by a "$" element.
+    };
+
+    /** An attribute matching a Config path element. */
+    struct PathAttribute
+    {
+        std::string name;                      //!< The attribute name.
+        Ptr<const AttributeAccessor> accessor; //!< The accessor used to get the attribute.
+        bool gettable;                         //!< Whether the accessor can get the attribute.
+        bool isPointer;                        //!< Whether the attribute holds a Pointer.
+        bool isContainer;                      //!< Whether the attribute holds an object container.
+    };
+
     /** Ensure the Config path starts and ends with a '/'. */
     void Canonicalize();
     /**
      * Parse the next element in the Config path.
      *
-     * @param [in] path The remaining portion of the Config path.
+     * @param [in] index The index of the next element of the Config path.
      * @param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(std::size_t index, Ptr<Object> root);
     /**
      * Parse an index on the Config path.
      *
-     * @param [in] path The remaining Config path.
+     * @param [in] index The index of the next element of the Config path.
      * @param [in,out] vector The resulting list of matching objects.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoArrayResolve(std::size_t index, const ObjectPtrContainerValue& vector);
+    /**
+     * Get the object attributes matching a Config path element.
+     *
+     * @param [in] index The index of the element of the Config path.
+     * @param [in] tid The TypeId of the object.
+     * @returns The matching attributes, in the order they are visited.
+     */
+    const std::vector<PathAttribute>& GetAttributes(std::size_t index, TypeId tid);
+    /**
+     * Get an attribute value, as ObjectBase::GetAttribute() would.
+     *
+     * @param [in] object The object owning the attribute.
+     * @param [in] attribute The attribute.
+     * @param [out] value The attribute value.
+     */
+    void GetAttribute(Ptr<Object> object,
+                      const PathAttribute& attribute,
+                      AttributeValue& value) const;
     /**
      * Handle one object found on the path.
      *
@@ -368,6 +478,13 @@ class Resolver
     std::vector<std::string> m_workStack;
     /** The Config path. */
     std::string m_path;
+    /** The elements of the Config path. */
+    std::vector<PathItem> m_items;
+    /**
+     * The attributes matching each Config path element, indexed by the
+     * element index and the TypeId uid.
+     */
+    std::unordered_map<uint64_t, std::vector<PathAttribute>> m_attributes;
 
     // end of class Resolver
 };
@@ -377,6 +494,15 @@ Resolver::Resolver(std::string path)
 {
     NS_LOG_FUNCTION(this << path);
     Canonicalize();
+
+    std::string::size_type start = 1;
+    std::string::size_type next;
+    while ((next = m_path.find('/', start)) != std::string::npos)
+    {
+        std::string item = m_path.substr(start, next - start);
+        m_items.push_back({item, ArrayMatcher(item), false, TypeId()});
+        start = next + 1;
+    }
 }
 
 Resolver::~Resolver()
@@ -409,7 +535,7 @@ Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(0, root);
 }
 
 std::string
@@ -434,14 +560,83 @@ Resolver::DoResolveOne(Ptr<Object> object)
     DoOne(object, GetResolvedPath());
 }
 
+const std::vector<Resolver::PathAttribute>&
+Resolver::GetAttributes(std::size_t index, TypeId tid)
+{
+    NS_LOG_FUNCTION(this << index << tid);
+
+    uint64_t key = (static_cast<uint64_t>(index) << 16) | tid.GetUid();
+    auto [it, inserted] = m_attributes.try_emplace(key);
+    if (!inserted)
+    {
+        return it->second;
+    }
+
+    const std::string& item = m_items[index].name;
+    TypeId instanceTid = tid;
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+
+        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info;
+            info = tid.GetAttribute(i);
+            if (info.name != item && item != "*")
+            {
+                continue;
+            }
+            PathAttribute attribute;
+            attribute.name = info.name;
+            // attempt to cast to a pointer checker.
+            attribute.isPointer =
+                dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr;
+            // attempt to cast to an object vector.
+            attribute.isContainer =
+                dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                nullptr;
+            // this could be anything else and we don't know what to do with it.
+            // So, we just ignore it.
+            if (!attribute.isPointer && !attribute.isContainer)
+            {
+                continue;
+            }
+            // The value is read by name, which finds the most derived
+            // attribute with that name.
+            TypeId::AttributeInformation named;
+            attribute.gettable = instanceTid.LookupAttributeByName(info.name, &named) &&
+                                 (named.flags & TypeId::ATTR_GET) && named.accessor->HasGetter();
+            attribute.accessor = named.accessor;
+            it->second.push_back(attribute);
+        }
+
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+
+    return it->second;
+}
+
+void
+Resolver::GetAttribute(Ptr<Object> object,
+                       const PathAttribute& attribute,
+                       AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << object << attribute.name << &value);
+
+    if (!attribute.gettable || !attribute.accessor->Get(PeekPointer(object), value))
+    {
+        // Let ObjectBase::GetAttribute raise any errors
+        object->GetAttribute(attribute.name, value);
+    }
+}
+
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::DoResolve(std::size_t index, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << index << root);
 
-    if (next == std::string::npos)
+    if (index == m_items.size())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -457,8 +652,8 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    PathItem& pathItem = m_items[index];
+    const std::string& item = pathItem.name;
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -469,11 +664,11 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     //
     if (!root)
     {
-        std::string::size_type offset = path.find("/Names");
+        std::string::size_type offset = item.find("Names");
         if (offset == 0)
         {
             m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
+            DoResolve(index + 1, root);
             m_workStack.pop_back();
             return;
         }
@@ -490,7 +685,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
         m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        DoResolve(index + 1, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -512,79 +707,60 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         // This is a call to GetObject
         std::string tidString = item.substr(1, item.size() - 1);
         NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
-        Ptr<Object> object = root->GetObject<Object>(tid);
+        if (!pathItem.tidResolved)
+        {
+            pathItem.tid = TypeId::LookupByName(tidString);
+            pathItem.tidResolved = true;
+        }
+        Ptr<Object> object = root->GetObject<Object>(pathItem.tid);
         if (!object)
         {
             NS_LOG_DEBUG("GetObject (" << tidString << ") failed on path=" << GetResolvedPath());
             return;
         }
         m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        DoResolve(index + 1, object);
         m_workStack.pop_back();
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
         bool foundMatch = false;
 
-        do
+        for (const auto& attribute : GetAttributes(index, root->GetInstanceTypeId()))
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            if (attribute.isPointer)
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << attribute.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                GetAttribute(root, attribute, pValue);
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
+                    NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
                     continue;
                 }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                foundMatch = true;
+                m_workStack.push_back(attribute.name);
+                DoResolve(index + 1, object);
+                m_workStack.pop_back();
             }
-
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
+            if (attribute.isContainer)
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << attribute.name
+                                                     << " on path=" << GetResolvedPath());
+                foundMatch = true;
+                ObjectPtrContainerValue vector;
+                GetAttribute(root, attribute, vector);
+                m_workStack.push_back(attribute.name);
+                DoArrayResolve(index + 1, vector);
+                m_workStack.pop_back();
+            }
+        }
 
         if (!foundMatch)
         {
@@ -596,29 +772,22 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(std::size_t index, const ObjectPtrContainerValue& container)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << index << &container);
+    if (index == m_items.size())
     {
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
 
-    ArrayMatcher matcher = ArrayMatcher(item);
+    const ArrayMatcher& matcher = m_items[index].matcher;
     ObjectPtrContainerValue::Iterator it;
     for (it = container.Begin(); it != container.End(); ++it)
     {
         if (matcher.Matches((*it).first))
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
+            m_workStack.push_back(std::to_string((*it).first));
+            DoResolve(index + 1, (*it).second);
             m_workStack.pop_back();
         }
     }
@@ -645,6 +814,11 @@ class ConfigImpl : public Singleton<ConfigImpl>
     void DisconnectWithoutContext(std::string path, const CallbackBase& cb);
     /** @copydoc ns3::Config::Disconnect() */
     void Disconnect(std::string path, const CallbackBase& cb);
+    /** @copydoc ns3::Config::ConnectBulk() */
+    std::vector<std::size_t> ConnectBulk(std::string path, const std::vector<TraceSink>& sinks);
+    /** @copydoc ns3::Config::ConnectWithoutContextBulk() */
+    std::vector<std::size_t> ConnectWithoutContextBulk(std::string path,
+                                                       const std::vector<TraceSink>& sinks);
     /** @copydoc ns3::Config::LookupMatches() */
     MatchContainer LookupMatches(std::string path);
 
@@ -773,6 +947,24 @@ ConfigImpl::Disconnect(std::string path, const CallbackBase& cb)
     container.Disconnect(leaf, cb);
 }
 
+std::vector<std::size_t>
+ConfigImpl::ConnectBulk(std::string path, const std::vector<TraceSink>& sinks)
+{
+    NS_LOG_FUNCTION(this << path << &sinks);
+
+    MatchContainer container = LookupMatches(path);
+    return container.ConnectBulk(sinks);
+}
+
+std::vector<std::size_t>
+ConfigImpl::ConnectWithoutContextBulk(std::string path, const std::vector<TraceSink>& sinks)
+{
+    NS_LOG_FUNCTION(this << path << &sinks);
+
+    MatchContainer container = LookupMatches(path);
+    return container.ConnectWithoutContextBulk(sinks);
+}
+
 MatchContainer
 ConfigImpl::LookupMatches(std::string path)
 {
@@ -990,6 +1182,20 @@ Disconnect(std::string path, const CallbackBase& cb)
     ConfigImpl::Get()->Disconnect(path, cb);
 }
 
+std::vector<std::size_t>
+ConnectBulk(std::string path, const std::vector<TraceSink>& sinks)
+{
+    NS_LOG_FUNCTION(path << &sinks);
+    return ConfigImpl::Get()->ConnectBulk(path, sinks);
+}
+
+std::vector<std::size_t>
+ConnectWithoutContextBulk(std::string path, const std::vector<TraceSink>& sinks)
+{
+    NS_LOG_FUNCTION(path << &sinks);
+    return ConfigImpl::Get()->ConnectWithoutContextBulk(path, sinks);
+}
+
 MatchContainer
 LookupMatches(std::string path)
 {
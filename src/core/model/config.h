@@ -11,6 +11,7 @@
 #include "ptr.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
@@ -172,6 +173,39 @@ bool ConnectFailSafe(std::string path, const CallbackBase& cb);
  */
 void Disconnect(std::string path, const CallbackBase& cb);
 
+/**
+ * @ingroup config
+ * The name of a trace source and the callback to connect to it.
+ */
+typedef std::pair<std::string, CallbackBase> TraceSink;
+
+/**
+ * @ingroup config
+ * @param [in] path A path to match objects.
+ * @param [in] sinks The trace source names and the callbacks to connect
+ *                   to them on every matching object.
+ * @returns The number of trace sources connected for each sink.
+ *
+ * This function resolves the object path once and then connects each
+ * callback to the named trace source of every matching object, as
+ * Config::ConnectFailSafe would for the path of that trace source.
+ * Connecting several trace sources below the same wildcard path
+ * this way avoids resolving the path for each of them.
+ */
+std::vector<std::size_t> ConnectBulk(std::string path, const std::vector<TraceSink>& sinks);
+/**
+ * @ingroup config
+ * @param [in] path A path to match objects.
+ * @param [in] sinks The trace source names and the callbacks to connect
+ *                   to them on every matching object.
+ * @returns The number of trace sources connected for each sink.
+ *
+ * This function is the equivalent of Config::ConnectBulk for callbacks
+ * which do not receive a context string.
+ */
+std::vector<std::size_t> ConnectWithoutContextBulk(std::string path,
+                                                   const std::vector<TraceSink>& sinks);
+
 /**
  * @ingroup config
  * @brief hold a set of objects which match a specific search string.
@@ -332,8 +366,37 @@ class MatchContainer
      * \sa ns3::Config::DisconnectWithoutContext
      */
     void DisconnectWithoutContext(std::string name, const CallbackBase& cb);
+    /**
+     * @param [in] sinks The trace source names and the sinks to connect to them
+     * @returns The number of trace sources connected for each sink.
+     *
+     * Connect each sink to the named trace source of all the objects
+     * stored in this container.
+     * \sa ns3::Config::ConnectBulk
+     */
+    std::vector<std::size_t> ConnectBulk(const std::vector<TraceSink>& sinks);
+    /**
+     * @param [in] sinks The trace source names and the sinks to connect to them
+     * @returns The number of trace sources connected for each sink.
+     *
+     * Connect each sink to the named trace source of all the objects
+     * stored in this container, without context.
+     * \sa ns3::Config::ConnectWithoutContextBulk
+     */
+    std::vector<std::size_t> ConnectWithoutContextBulk(const std::vector<TraceSink>& sinks);
 
   private:
+    /**
+     * Connect a sink to the named trace source of all the objects stored
+     * in this container.
+     *
+     * @param [in] name The name of the trace source to connect to
+     * @param [in] cb The sink to connect to the trace source
+     * @param [in] withContext Whether the sink receives the context string
+     * @returns The number of trace sources connected.
+     */
+    std::size_t DoConnect(std::string name, const CallbackBase& cb, bool withContext);
+
     /** The list of objects in this container. */
     std::vector<Ptr<Object>> m_objects;
     /** The context for each object. */
@@ -8,8 +8,10 @@
 #ifndef EVENT_IMPL_H
 #define EVENT_IMPL_H
 
+#include "object-accounting.h"
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -38,6 +40,8 @@ class EventImpl : public SimpleRefCount<EventImpl>
     EventImpl();
     /** Destructor. */
     virtual ~EventImpl() = 0;
+    NS_OBJECT_ACCOUNTING_ALLOCATION("ns3::EventImpl", ObjectAccounting::HeapAllocator)
+
     /**
      * Called by the simulation engine to notify the event that it is time
      * to execute.
@@ -0,0 +1,206 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "object-accounting.h"
+
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+
+/**
+ * @file
+ * @ingroup object
+ * ns3::ObjectAccounting implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ObjectAccounting");
+
+namespace
+{
+
+/**
+ * @ingroup object
+ * @brief The counters of the ObjectAccounting.
+ */
+struct Counters
+{
+    /// Counters of the Objects, indexed by the uid of their TypeId
+    std::vector<ObjectAccounting::Counter> objects;
+    /// Size of the Objects, indexed by the uid of their TypeId
+    std::vector<std::size_t> sizes;
+    /// Counters of the other kinds of allocation, which never move
+    std::deque<ObjectAccounting::Counter> others;
+};
+
+/**
+ * @ingroup object
+ * Get the counters, created on first use and never destroyed, since the
+ * Objects and the other instances may be deleted during static destruction.
+ * @return The counters.
+ */
+Counters&
+GetCountersInstance()
+{
+    static auto counters = new Counters;
+    return *counters;
+}
+
+} // unnamed namespace
+
+bool ObjectAccounting::m_enabled = false;
+
+void
+ObjectAccounting::Enable()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enabled = true;
+}
+
+void
+ObjectAccounting::Disable()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_enabled = false;
+}
+
+ObjectAccounting::Counter
+ObjectAccounting::GetObjectCounter(TypeId tid)
+{
+    NS_LOG_FUNCTION(tid);
+    const Counters& counters = GetCountersInstance();
+    if (tid.GetUid() < counters.objects.size())
+    {
+        return counters.objects[tid.GetUid()];
+    }
+    return Counter{tid.GetName()};
+}
+
+std::vector<ObjectAccounting::Counter>
+ObjectAccounting::GetCounters()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    const Counters& counters = GetCountersInstance();
+    std::vector<Counter> result;
+    for (const auto& counter : counters.objects)
+    {
+        if (counter.created > 0)
+        {
+            result.push_back(counter);
+        }
+    }
+    for (const auto& counter : counters.others)
+    {
+        if (counter.created > 0)
+        {
+            result.push_back(counter);
+        }
+    }
+    std::stable_sort(result.begin(), result.end(), [](const Counter& a, const Counter& b) {
+        return a.bytes > b.bytes;
+    });
+    return result;
+}
+
+void
+ObjectAccounting::Print(std::ostream& os)
+{
+    NS_LOG_FUNCTION_NOARGS();
+    std::vector<Counter> counters = GetCounters();
+    std::size_t width = 4;
+    for (const auto& counter : counters)
+    {
+        width = std::max(width, counter.name.size());
+    }
+    os << std::left << std::setw(width) << "Type" << std::right << std::setw(12) << "Live"
+       << std::setw(12) << "Created" << std::setw(16) << "Bytes" << std::endl;
+    uint64_t live = 0;
+    uint64_t bytes = 0;
+    for (const auto& counter : counters)
+    {
+        os << std::left << std::setw(width) << counter.name << std::right << std::setw(12)
+           << counter.live << std::setw(12) << counter.created << std::setw(16) << counter.bytes
+           << std::endl;
+        live += counter.live;
+        bytes += counter.bytes;
+    }
+    os << std::left << std::setw(width) << "Total" << std::right << std::setw(12) << live
+       << std::setw(12) << "" << std::setw(16) << bytes << std::endl;
+}
+
+ObjectAccounting::Counter*
+ObjectAccounting::LookupCounter(const std::string& name)
+{
+    NS_LOG_FUNCTION(name);
+    Counters& counters = GetCountersInstance();
+    for (auto& counter : counters.others)
+    {
+        if (counter.name == name)
+        {
+            return &counter;
+        }
+    }
+    counters.others.push_back(Counter{name});
+    return &counters.others.back();
+}
+
+void
+ObjectAccounting::NotifyAllocation(Counter* counter, std::size_t bytes)
+{
+    counter->live++;
+    counter->created++;
+    counter->bytes += bytes;
+}
+
+void
+ObjectAccounting::NotifyDeallocation(Counter* counter, std::size_t bytes)
+{
+    // the instances allocated before the accounting was enabled cannot be told
+    // apart from the counted ones: only keep the counter from wrapping around
+    if (counter->live > 0)
+    {
+        counter->live--;
+        counter->bytes -= std::min<uint64_t>(counter->bytes, bytes);
+    }
+}
+
+void
+ObjectAccounting::NotifyCreated(TypeId tid)
+{
+    Counters& counters = GetCountersInstance();
+    uint16_t uid = tid.GetUid();
+    if (uid >= counters.objects.size())
+    {
+        counters.objects.resize(uid + 1);
+        counters.sizes.resize(uid + 1);
+    }
+    Counter& counter = counters.objects[uid];
+    if (counter.name.empty())
+    {
+        counter.name = tid.GetName();
+        // the size of the classes not registered with NS_OBJECT_ENSURE_REGISTERED is unknown
+        std::size_t size = tid.GetSize();
+        counters.sizes[uid] = (size == static_cast<std::size_t>(-1)) ? 0 : size;
+    }
+    counter.live++;
+    counter.created++;
+    counter.bytes += counters.sizes[uid];
+}
+
+void
+ObjectAccounting::NotifyDeleted(TypeId tid)
+{
+    Counters& counters = GetCountersInstance();
+    uint16_t uid = tid.GetUid();
+    NS_ASSERT(uid < counters.objects.size() && counters.objects[uid].live > 0);
+    counters.objects[uid].live--;
+    counters.objects[uid].bytes -= counters.sizes[uid];
+}
+
+} // namespace ns3
@@ -0,0 +1,234 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef OBJECT_ACCOUNTING_H
+#define OBJECT_ACCOUNTING_H
+
+#include "type-id.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup object
+ * ns3::ObjectAccounting declaration and
+ * NS_OBJECT_ACCOUNTING_ALLOCATION() macro definition.
+ */
+
+/**
+ * @ingroup object
+ * @brief Count the instances of a class which is not an Object in a named
+ * counter of the ObjectAccounting.
+ *
+ * This macro should be invoked in the public section of the class
+ * definition. It defines the class-specific operator new and operator
+ * delete, which count the instances of the class and of its subclasses when
+ * the accounting is enabled, and get their memory from the static
+ * Allocate(size) and Deallocate(p, size) functions of \p allocator.
+ *
+ * @param name The name of the counter.
+ * @param allocator The class providing the memory, such as
+ *        ns3::ObjectAccounting::HeapAllocator.
+ */
+#define NS_OBJECT_ACCOUNTING_ALLOCATION(name, allocator)                                           \
+    static void* operator new(std::size_t size)                                                    \
+    {                                                                                              \
+        if (ns3::ObjectAccounting::IsEnabled())                                                    \
+        {                                                                                          \
+            static auto counter = ns3::ObjectAccounting::LookupCounter(name);                      \
+            ns3::ObjectAccounting::NotifyAllocation(counter, size);                                \
+        }                                                                                          \
+        return allocator::Allocate(size);                                                          \
+    }                                                                                              \
+    static void operator delete(void* p, std::size_t size)                                         \
+    {                                                                                              \
+        if (ns3::ObjectAccounting::IsEnabled())                                                    \
+        {                                                                                          \
+            static auto counter = ns3::ObjectAccounting::LookupCounter(name);                      \
+            ns3::ObjectAccounting::NotifyDeallocation(counter, size);                              \
+        }                                                                                          \
+        allocator::Deallocate(p, size);                                                            \
+    }
+
+namespace ns3
+{
+
+/**
+ * @ingroup object
+ * @brief Accounting of the live Objects, per TypeId, and of the memory they hold.
+ *
+ * Once enabled, the Objects created by CreateObject(), ObjectFactory and
+ * CopyObject() are counted per TypeId until they are deleted, each being
+ * assumed to hold the size of its class (see TypeId::GetSize()). The
+ * instances of the classes which are not Objects, such as packets, buffers,
+ * events and routing table entries, are counted with their exact size in
+ * named counters, which the allocations of these classes update (see
+ * NS_OBJECT_ACCOUNTING_ALLOCATION()).
+ *
+ * The counters can be queried at any time, for instance from an event
+ * scheduled during the simulation, and printed at the end of the
+ * simulation. The accounting is disabled by default, and costs a test of
+ * a flag per allocation until enabled. Like the simulator, it is not
+ * thread safe.
+ *
+ * The counts are only exact when the accounting is enabled before any
+ * instance is allocated, at the start of the program, and never disabled.
+ * The Objects are flagged when counted, so that those created before the
+ * accounting was enabled are never counted. The other instances are not:
+ * the deallocations of the instances allocated before the accounting was
+ * enabled are counted as those of counted instances, so that the live
+ * instances and their bytes are under-counted; and the instances
+ * deallocated after the accounting was disabled stay counted as live.
+ *
+ * @code
+ *   ObjectAccounting::Enable();
+ *   ...
+ *   Simulator::Run();
+ *   ObjectAccounting::Print(std::cout);
+ * @endcode
+ */
+class ObjectAccounting
+{
+  public:
+    /// Instances of a TypeId, or of a kind of allocation
+    struct Counter
+    {
+        std::string name;    //!< name of the TypeId or of the kind of allocation
+        uint64_t live{0};    //!< number of instances alive
+        uint64_t created{0}; //!< number of instances created since the accounting was enabled
+        uint64_t bytes{0};   //!< approximate size of the live instances, in bytes
+    };
+
+    /// Provides the memory of the instances with the global operator new
+    struct HeapAllocator
+    {
+        /**
+         * Allocate memory.
+         *
+         * @param [in] size The number of bytes.
+         * @return The memory.
+         */
+        static void* Allocate(std::size_t size)
+        {
+            return ::operator new(size);
+        }
+
+        /**
+         * Release memory.
+         *
+         * @param [in] p The memory.
+         * @param [in] size The number of bytes.
+         */
+        static void Deallocate(void* p, std::size_t size)
+        {
+            ::operator delete(p, size);
+        }
+    };
+
+    /**
+     * Enable the accounting.
+     */
+    static void Enable();
+
+    /**
+     * Disable the accounting.
+     *
+     * The Objects counted are still uncounted when they are deleted, but the
+     * other instances are not anymore: they stay counted as live.
+     */
+    static void Disable();
+
+    /**
+     * @return true if the accounting is enabled
+     */
+    static bool IsEnabled();
+
+    /**
+     * Get the counter of the Objects of a TypeId.
+     *
+     * @param [in] tid The TypeId.
+     * @return A copy of the counter.
+     */
+    static Counter GetObjectCounter(TypeId tid);
+
+    /**
+     * Get the counters of all the TypeIds and kinds of allocation which had
+     * instances created.
+     *
+     * @return Copies of the counters, by decreasing size of their live instances.
+     */
+    static std::vector<Counter> GetCounters();
+
+    /**
+     * Print the counters of all the TypeIds and kinds of allocation which had
+     * instances created, by decreasing size of their live instances.
+     *
+     * @param [in,out] os The output stream.
+     */
+    static void Print(std::ostream& os);
+
+    /**
+     * Look up the counter of a kind of allocation, creating it if needed.
+     *
+     * The counter stays at the same address, which can be kept by the
+     * allocations to count.
+     *
+     * @param [in] name The name of the kind of allocation.
+     * @return The counter.
+     */
+    static Counter* LookupCounter(const std::string& name);
+
+    /**
+     * Count an allocation of an instance.
+     *
+     * @param [in,out] counter The counter of its kind of allocation.
+     * @param [in] bytes The size of the instance.
+     */
+    static void NotifyAllocation(Counter* counter, std::size_t bytes);
+
+    /**
+     * Count a deallocation of an instance.
+     *
+     * The instance is assumed to have been counted when allocated, which is
+     * only certain if the accounting was enabled before any allocation of its
+     * kind. The counter never goes below zero.
+     *
+     * @param [in,out] counter The counter of its kind of allocation.
+     * @param [in] bytes The size of the instance.
+     */
+    static void NotifyDeallocation(Counter* counter, std::size_t bytes);
+
+  private:
+    friend class Object;
+
+    /**
+     * Count the creation of an Object.
+     *
+     * @param [in] tid The TypeId of the Object.
+     */
+    static void NotifyCreated(TypeId tid);
+
+    /**
+     * Count the deletion of an Object counted when created.
+     *
+     * @param [in] tid The TypeId of the Object.
+     */
+    static void NotifyDeleted(TypeId tid);
+
+    static bool m_enabled; //!< Whether the accounting is enabled
+};
+
+inline bool
+ObjectAccounting::IsEnabled()
+{
+    return m_enabled;
+}
+
+} // namespace ns3
+
+#endif /* OBJECT_ACCOUNTING_H */
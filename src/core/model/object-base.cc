@@ -82,6 +82,10 @@ ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
 {
     // loop over the inheritance tree back to the Object base class.
     NS_LOG_FUNCTION(this << &attributes);
+    // The attributes are only looked up in the NS_ATTRIBUTE_DEFAULT
+    // environment variable if it is set, since building the full name of
+    // every attribute of every object created is costly
+    bool envDefaults = EnvironmentVariable::Get("NS_ATTRIBUTE_DEFAULT").first;
     TypeId tid = GetInstanceTypeId();
     do // Do this tid and all parents
     {
@@ -119,7 +123,7 @@ ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
                 }
             }
 
-            if (!value)
+            if (!value && envDefaults)
             {
                 NS_LOG_DEBUG("trying to set from environment variable NS_ATTRIBUTE_DEFAULT");
                 auto [found, val] =
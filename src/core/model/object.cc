@@ -12,12 +12,14 @@
 #include "assert.h"
 #include "attribute.h"
 #include "log.h"
+#include "object-accounting.h"
 #include "object-factory.h"
 #include "string.h"
 
 #include <cstdlib>
 #include <cstring>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -37,6 +39,15 @@ NS_LOG_COMPONENT_DEFINE("Object");
 
 NS_OBJECT_ENSURE_REGISTERED(Object);
 
+/**
+ * Maps a TypeId uid to the aggregate implementing it, or to \c nullptr
+ * if none of the normal aggregates does.
+ */
+struct Object::AggregateCache
+{
+    std::unordered_map<uint16_t, Object*> objects; //!< The cached lookups.
+};
+
 Object::AggregateIterator::AggregateIterator()
     : m_object(nullptr),
       m_current(0)
@@ -97,11 +108,13 @@ Object::Object()
     : m_tid(Object::GetTypeId()),
       m_disposed(false),
       m_initialized(false),
+      m_accounted(false),
       m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
       m_getObjectCount(0)
 {
     NS_LOG_FUNCTION(this);
     m_aggregates->n = 1;
+    m_aggregates->cache = nullptr;
     m_aggregates->buffer[0] = this;
 }
 
@@ -121,6 +134,8 @@ Object::~Object()
             m_aggregates->n--;
         }
     }
+    // the cache may point to this object
+    InvalidateCache(m_aggregates);
     // finally, if all objects have been removed from the list,
     // delete the aggregate list
     if (m_aggregates->n == 0)
@@ -129,16 +144,26 @@ Object::~Object()
     }
     m_aggregates = nullptr;
     m_unidirectionalAggregates.clear();
+    if (m_accounted)
+    {
+        ObjectAccounting::NotifyDeleted(m_tid);
+    }
 }
 
 Object::Object(const Object& o)
     : m_tid(o.m_tid),
       m_disposed(false),
       m_initialized(false),
+      m_accounted(ObjectAccounting::IsEnabled()),
       m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
       m_getObjectCount(0)
 {
+    if (m_accounted)
+    {
+        ObjectAccounting::NotifyCreated(m_tid);
+    }
     m_aggregates->n = 1;
+    m_aggregates->cache = nullptr;
     m_aggregates->buffer[0] = this;
 }
 
@@ -156,32 +181,45 @@ Object::DoGetObject(TypeId tid) const
     NS_ASSERT(CheckLoose());
 
     // First check if the object is in the normal aggregates.
-    uint32_t n = m_aggregates->n;
+    // The result of the scan is cached, so repeated lookups of the
+    // same TypeId cost a single hash lookup.
+    if (m_aggregates->cache == nullptr)
+    {
+        m_aggregates->cache = new AggregateCache;
+    }
     TypeId objectTid = Object::GetTypeId();
-    for (uint32_t i = 0; i < n; i++)
+    auto [it, inserted] = m_aggregates->cache->objects.try_emplace(tid.GetUid(), nullptr);
+    if (inserted)
     {
-        Object* current = m_aggregates->buffer[i];
-        TypeId cur = current->GetInstanceTypeId();
-        while (cur != tid && cur != objectTid)
+        uint32_t n = m_aggregates->n;
+        for (uint32_t i = 0; i < n; i++)
         {
-            cur = cur.GetParent();
-        }
-        if (cur == tid)
-        {
-            // This is an attempt to 'cache' the result of this lookup.
-            // the idea is that if we perform a lookup for a TypeId on this object,
-            // we are likely to perform the same lookup later so, we make sure
-            // that the aggregate array is sorted by the number of accesses
-            // to each object.
-
-            // first, increment the access count
-            current->m_getObjectCount++;
-            // then, update the sort
-            UpdateSortedArray(m_aggregates, i);
-            // finally, return the match
-            return const_cast<Object*>(current);
+            Object* current = m_aggregates->buffer[i];
+            TypeId cur = current->GetInstanceTypeId();
+            while (cur != tid && cur != objectTid)
+            {
+                cur = cur.GetParent();
+            }
+            if (cur == tid)
+            {
+                // Keep the aggregate array sorted by the number of accesses
+                // to each object, so that the most used object stays in front
+                // for the GetObject<T>() fast path.
+
+                // first, increment the access count
+                current->m_getObjectCount++;
+                // then, update the sort
+                UpdateSortedArray(m_aggregates, i);
+                // finally, remember the match
+                it->second = current;
+                break;
+            }
         }
     }
+    if (it->second != nullptr)
+    {
+        return it->second;
+    }
 
     // Next check if it's a unidirectional aggregate
     for (auto& uniItem : m_unidirectionalAggregates)
@@ -294,6 +332,13 @@ Object::UpdateSortedArray(Aggregates* aggregates, uint32_t j) const
     }
 }
 
+void
+Object::InvalidateCache(Aggregates* aggregates)
+{
+    delete aggregates->cache;
+    aggregates->cache = nullptr;
+}
+
 void
 Object::AggregateObject(Ptr<Object> o)
 {
@@ -308,6 +353,7 @@ Object::AggregateObject(Ptr<Object> o)
     uint32_t total = m_aggregates->n + other->m_aggregates->n;
     auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (total - 1) * sizeof(Object*));
     aggregates->n = total;
+    aggregates->cache = nullptr;
 
     // copy our buffer to the new buffer
     std::memcpy(&aggregates->buffer[0],
@@ -360,6 +406,8 @@ Object::AggregateObject(Ptr<Object> o)
     }
 
     // Now that we are done with them, we can free our old aggregate buffers
+    InvalidateCache(a);
+    InvalidateCache(b);
     std::free(a);
     std::free(b);
 }
@@ -426,7 +474,17 @@ Object::SetTypeId(TypeId tid)
 {
     NS_LOG_FUNCTION(this << tid);
     NS_ASSERT(Check());
+    if (m_accounted)
+    {
+        ObjectAccounting::NotifyDeleted(m_tid);
+    }
     m_tid = tid;
+    m_accounted = ObjectAccounting::IsEnabled();
+    if (m_accounted)
+    {
+        ObjectAccounting::NotifyCreated(m_tid);
+    }
+    InvalidateCache(m_aggregates);
 }
 
 void
@@ -360,6 +360,12 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
 
     /**@}*/
 
+    /**
+     * Cache of the results of DoGetObject() on the normal aggregates,
+     * indexed by TypeId uid.  Defined in object.cc.
+     */
+    struct AggregateCache;
+
     /**
      * The list of Objects aggregated to this one.
      *
@@ -376,6 +382,11 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     {
         /** The number of entries in \c buffer. */
         uint32_t n;
+        /**
+         * TypeId lookup cache, allocated on the first lookup.
+         * Invalidated whenever \c buffer changes membership.
+         */
+        AggregateCache* cache;
         /** The array of Objects. */
         Object* buffer[1];
     };
@@ -434,6 +445,12 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * @param [in] i The most recently used entry in the list.
      */
     void UpdateSortedArray(Aggregates* aggregates, uint32_t i) const;
+    /**
+     * Drop the TypeId lookup cache of a list of aggregates.
+     *
+     * @param [in,out] aggregates The list of aggregated Objects.
+     */
+    static void InvalidateCache(Aggregates* aggregates);
     /**
      * Attempt to delete this Object.
      *
@@ -457,6 +474,11 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * \c false otherwise
      */
     bool m_initialized;
+    /**
+     * Set to \c true if this Object was counted by the ObjectAccounting
+     * when it was created, \c false otherwise
+     */
+    bool m_accounted;
     /**
      * A pointer to an array of 'aggregates'.
      *
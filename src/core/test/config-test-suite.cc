@@ -853,6 +853,125 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * @ingroup config-tests
+ * Test for the ability to connect several sinks at once and count
+ * the connected trace sources.
+ */
+class ConnectBulkConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ConnectBulkConfigTestCase();
+
+    /** Destructor. */
+    ~ConnectBulkConfigTestCase() override
+    {
+    }
+
+    /**
+     * Trace callback without context.
+     * @param oldValue The old value.
+     * @param newValue The new value.
+     */
+    void Trace(int16_t oldValue [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+    }
+
+    /**
+     * Trace callback with context path.
+     * @param path The context path.
+     * @param old The old value.
+     * @param newValue The new value.
+     */
+    void TraceWithPath(std::string path, int16_t old [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+        m_path = path;
+    }
+
+  private:
+    void DoRun() override;
+
+    int16_t m_newValue; //!< Flag to detect tracing result.
+    std::string m_path; //!< The context path.
+};
+
+ConnectBulkConfigTestCase::ConnectBulkConfigTestCase()
+    : TestCase("Check bulk trace connections through vectors of Object")
+{
+}
+
+void
+ConnectBulkConfigTestCase::DoRun()
+{
+    //
+    // Use the name service rather than a root namespace object, so that
+    // the objects registered by the other test cases are not matched.
+    //
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Names::Add("BulkRoot", root);
+    Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject>();
+    root->SetNodeA(a);
+    Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject>();
+    a->SetNodeB(b);
+
+    Ptr<ConfigTestObject> obj0 = CreateObject<ConfigTestObject>();
+    Ptr<ConfigTestObject> obj1 = CreateObject<ConfigTestObject>();
+    Ptr<ConfigTestObject> obj2 = CreateObject<ConfigTestObject>();
+    Ptr<ConfigTestObject> obj3 = CreateObject<ConfigTestObject>();
+    b->AddNodeB(obj0);
+    b->AddNodeB(obj1);
+    b->AddNodeB(obj2);
+    b->AddNodeB(obj3);
+
+    //
+    // The counts are reported per sink; a sink naming a trace source
+    // which does not exist connects nothing.
+    //
+    std::vector<Config::TraceSink> sinks;
+    sinks.emplace_back("Source", MakeCallback(&ConnectBulkConfigTestCase::TraceWithPath, this));
+    sinks.emplace_back("Missing", MakeCallback(&ConnectBulkConfigTestCase::TraceWithPath, this));
+    std::vector<std::size_t> counts =
+        Config::ConnectBulk("/Names/BulkRoot/NodeA/NodeB/NodesB/[0-1]|3", sinks);
+    NS_TEST_ASSERT_MSG_EQ(counts.size(), 2, "Expected one count per sink");
+    NS_TEST_ASSERT_MSG_EQ(counts[0], 3, "Expected three trace sources to be connected");
+    NS_TEST_ASSERT_MSG_EQ(counts[1], 0, "Unexpected connection to a missing trace source");
+
+    m_newValue = 0;
+    m_path = "";
+    obj3->SetAttribute("Source", IntegerValue(-4));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, -4, "Trace 3 did not fire as expected");
+    NS_TEST_ASSERT_MSG_EQ(m_path,
+                          "/Names/BulkRoot/NodeA/NodeB/NodesB/3/Source",
+                          "Trace 3 did not provide expected context");
+
+    m_newValue = 0;
+    obj2->SetAttribute("Source", IntegerValue(-3));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, 0, "Trace 2 fired unexpectedly");
+
+    Config::Disconnect("/Names/BulkRoot/NodeA/NodeB/NodesB/*/Source",
+                       MakeCallback(&ConnectBulkConfigTestCase::TraceWithPath, this));
+
+    //
+    // Without context, a wildcard over the whole vector.
+    //
+    sinks.clear();
+    sinks.emplace_back("Source", MakeCallback(&ConnectBulkConfigTestCase::Trace, this));
+    counts = Config::ConnectWithoutContextBulk("/Names/BulkRoot/NodeA/NodeB/NodesB/*", sinks);
+    NS_TEST_ASSERT_MSG_EQ(counts.size(), 1, "Expected one count per sink");
+    NS_TEST_ASSERT_MSG_EQ(counts[0], 4, "Expected four trace sources to be connected");
+
+    m_newValue = 0;
+    obj2->SetAttribute("Source", IntegerValue(-2));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, -2, "Trace 2 did not fire as expected");
+
+    Config::DisconnectWithoutContext("/Names/BulkRoot/NodeA/NodeB/NodesB/*/Source",
+                                     MakeCallback(&ConnectBulkConfigTestCase::Trace, this));
+    Names::Clear();
+}
+
 /**
  * @ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -871,6 +990,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new ConnectBulkConfigTestCase);
 }
 
 /**
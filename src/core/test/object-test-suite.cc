@@ -7,8 +7,11 @@
  *          Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/assert.h"
+#include "ns3/nstime.h"
+#include "ns3/object-accounting.h"
 #include "ns3/object-factory.h"
 #include "ns3/object.h"
+#include "ns3/simulator.h"
 #include "ns3/test.h"
 
 /**
@@ -453,6 +456,71 @@ AggregateObjectTestCase::DoRun()
     NS_TEST_ASSERT_MSG_NE(baseA, nullptr, "Unable to GetObject on released object");
 }
 
+/**
+ * @ingroup object-tests
+ * Test that cached aggregate lookups follow changes to the aggregation.
+ */
+class AggregateObjectCacheTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    AggregateObjectCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+AggregateObjectCacheTestCase::AggregateObjectCacheTestCase()
+    : TestCase("Check Object aggregate lookup cache")
+{
+}
+
+void
+AggregateObjectCacheTestCase::DoRun()
+{
+    Ptr<BaseA> baseA = CreateObject<BaseA>();
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB>();
+
+    //
+    // Cache a failed lookup, then aggregate: the lookup must now succeed.
+    //
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(), nullptr, "Unexpectedly found a BaseB");
+    baseA->AggregateObject(derivedB);
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(),
+                          derivedB,
+                          "Cached lookup not invalidated by AggregateObject");
+
+    //
+    // Repeated lookups, through the parent and the derived TypeIds, return the
+    // same Object.
+    //
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<DerivedB>(), derivedB, "Wrong DerivedB Object");
+        NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseA>(), baseA, "Wrong BaseA Object");
+        NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<Object>(BaseB::GetTypeId()),
+                              derivedB,
+                              "Wrong BaseB Object through TypeId");
+    }
+
+    //
+    // A unidirectional aggregate is still found after the normal aggregates
+    // have been cached as not matching.
+    //
+    Ptr<DerivedA> derivedA = CreateObject<DerivedA>();
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<BaseB>(), nullptr, "Unexpectedly found a BaseB");
+    derivedA->UnidirectionalAggregateObject(derivedB);
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<BaseB>(),
+                          derivedB,
+                          "Unidirectional aggregate hidden by cached lookup");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<DerivedA>(),
+                          nullptr,
+                          "Unidirectional aggregation is not symmetric");
+
+    derivedA->Dispose();
+    baseA->Dispose();
+}
+
 /**
  * @ingroup object-tests
  * Test we can aggregate Objects.
@@ -606,6 +674,111 @@ ObjectFactoryTestCase::DoRun()
                           "Unexpectedly able to work around C++ type system");
 }
 
+/**
+ * @ingroup object-tests
+ * Test the accounting of the live Objects per TypeId.
+ */
+class ObjectAccountingTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ObjectAccountingTestCase();
+    /** Destructor. */
+    ~ObjectAccountingTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+ObjectAccountingTestCase::ObjectAccountingTestCase()
+    : TestCase("Check the accounting of the live Objects")
+{
+}
+
+ObjectAccountingTestCase::~ObjectAccountingTestCase()
+{
+}
+
+void
+ObjectAccountingTestCase::DoRun()
+{
+    // The accounting is global: it is left as it was found
+    bool wasEnabled = ObjectAccounting::IsEnabled();
+
+    // Created while the accounting is disabled, so not counted
+    ObjectAccounting::Disable();
+    Ptr<DerivedB> notCounted = CreateObject<DerivedB>();
+
+    ObjectAccounting::Enable();
+    ObjectAccounting::Counter before = ObjectAccounting::GetObjectCounter(DerivedB::GetTypeId());
+    uint64_t liveAggregated = ObjectAccounting::GetObjectCounter(BaseA::GetTypeId()).live;
+    NS_TEST_EXPECT_MSG_EQ(before.name, "ObjectTest:DerivedB", "Wrong name of the counter");
+
+    //
+    // Create Objects of type DerivedB with CreateObject, an object factory and
+    // CopyObject, and aggregate an Object of type BaseA to one of them
+    //
+    Ptr<DerivedB> b1 = CreateObject<DerivedB>();
+    Ptr<DerivedB> b2 = CreateObject<DerivedB>();
+    ObjectFactory factory;
+    factory.SetTypeId(DerivedB::GetTypeId());
+    Ptr<Object> b3 = factory.Create();
+    Ptr<DerivedB> b4 = CopyObject(b1);
+    b1->AggregateObject(CreateObject<BaseA>());
+
+    ObjectAccounting::Counter counter =
+        ObjectAccounting::GetObjectCounter(DerivedB::GetTypeId());
+    NS_TEST_EXPECT_MSG_EQ(counter.live - before.live, 4, "Wrong number of live Objects");
+    NS_TEST_EXPECT_MSG_EQ(counter.created - before.created, 4, "Wrong number of created Objects");
+    NS_TEST_EXPECT_MSG_EQ(counter.bytes - before.bytes,
+                          4 * sizeof(DerivedB),
+                          "Wrong size of the live Objects");
+    NS_TEST_EXPECT_MSG_EQ(ObjectAccounting::GetObjectCounter(BaseA::GetTypeId()).live -
+                              liveAggregated,
+                          1,
+                          "Wrong number of live aggregated Objects");
+
+    //
+    // The Objects, including the Object created before the accounting was
+    // enabled and the aggregated Object, are uncounted when they are deleted
+    //
+    b1 = nullptr;
+    b2 = nullptr;
+    b3 = nullptr;
+    b4 = nullptr;
+    notCounted = nullptr;
+    counter = ObjectAccounting::GetObjectCounter(DerivedB::GetTypeId());
+    NS_TEST_EXPECT_MSG_EQ(counter.live, before.live, "Objects not uncounted");
+    NS_TEST_EXPECT_MSG_EQ(counter.bytes, before.bytes, "Objects not uncounted");
+    NS_TEST_EXPECT_MSG_EQ(counter.created - before.created, 4, "Wrong number of created Objects");
+    NS_TEST_EXPECT_MSG_EQ(ObjectAccounting::GetObjectCounter(BaseA::GetTypeId()).live,
+                          liveAggregated,
+                          "Aggregated Object not uncounted");
+
+    //
+    // The events are counted until they are run
+    //
+    ObjectAccounting::Counter* events = ObjectAccounting::LookupCounter("ns3::EventImpl");
+    uint64_t liveEvents = events->live;
+    Simulator::Schedule(Seconds(1), []() {});
+    NS_TEST_EXPECT_MSG_EQ(events->live - liveEvents, 1, "Event not counted");
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(events->live, liveEvents, "Event not uncounted");
+    Simulator::Destroy();
+
+    bool found = false;
+    for (const auto& counter : ObjectAccounting::GetCounters())
+    {
+        found |= (counter.name == "ObjectTest:DerivedB");
+    }
+    NS_TEST_EXPECT_MSG_EQ(found, true, "Counter missing from the counters");
+
+    if (!wasEnabled)
+    {
+        ObjectAccounting::Disable();
+    }
+}
+
 /**
  * @ingroup object-tests
  * The Test Suite that glues the Test Cases together.
@@ -622,8 +795,10 @@ ObjectTestSuite::ObjectTestSuite()
 {
     AddTestCase(new CreateObjectTestCase);
     AddTestCase(new AggregateObjectTestCase);
+    AddTestCase(new AggregateObjectCacheTestCase);
     AddTestCase(new UnidirectionalAggregateObjectTestCase);
     AddTestCase(new ObjectFactoryTestCase);
+    AddTestCase(new ObjectAccountingTestCase);
 }
 
 /**
@@ -68,6 +68,23 @@ CsmaNetDevice::GetTypeId()
                           PointerValue(),
                           MakePointerAccessor(&CsmaNetDevice::m_receiveErrorModel),
                           MakePointerChecker<ErrorModel>())
+            .AddAttribute("ReceiveBatching",
+                          "If true, the packets received are passed to the node in batches, "
+                          "whose protocol handlers are looked up once per batch, rather than "
+                          "one by one through the receive callback. The packets are only batched "
+                          "if the receive callback is the one set by the node: with a custom "
+                          "receive callback, they are still passed one by one",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&CsmaNetDevice::m_receiveBatching),
+                          MakeBooleanChecker())
+            .AddAttribute("ReceiveBatchDelay",
+                          "When ReceiveBatching is enabled, the time the first packet of a "
+                          "batch is held, waiting for more packets, before the batch is passed "
+                          "to the node. A zero delay only batches the packets received at the "
+                          "same time.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&CsmaNetDevice::m_receiveBatchDelay),
+                          MakeTimeChecker())
 
             //
             // Transmit queueing discipline for the device which includes its own set
@@ -180,6 +197,7 @@ CsmaNetDevice::CsmaNetDevice()
     m_txMachineState = READY;
     m_tInterframeGap = Seconds(0);
     m_channel = nullptr;
+    m_rxCallbackIsNode = false;
 
     //
     // We would like to let the attribute system take care of initializing the
@@ -208,6 +226,8 @@ CsmaNetDevice::DoDispose()
     m_channel = nullptr;
     m_node = nullptr;
     m_queue = nullptr;
+    m_rxBatchEvent.Cancel();
+    m_rxBatch.clear();
     NetDevice::DoDispose();
 }
 
@@ -822,7 +842,41 @@ CsmaNetDevice::Receive(Ptr<const Packet> packet, Ptr<CsmaNetDevice> senderDevice
     {
         m_snifferTrace(packet);
         m_macRxTrace(packet);
-        m_rxCallback(this, pktCopy, protocol, header.GetSource());
+        if (m_receiveBatching && m_rxCallbackIsNode)
+        {
+            m_rxBatch.emplace_back(pktCopy, protocol, header.GetSource());
+            if (!m_rxBatchEvent.IsPending())
+            {
+                m_rxBatchEvent = Simulator::Schedule(m_receiveBatchDelay,
+                                                     &CsmaNetDevice::DeliverReceiveBatch,
+                                                     this);
+            }
+        }
+        else
+        {
+            m_rxCallback(this, pktCopy, protocol, header.GetSource());
+        }
+    }
+}
+
+void
+CsmaNetDevice::DeliverReceiveBatch()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<std::tuple<Ptr<Packet>, uint16_t, Mac48Address>> batch;
+    batch.swap(m_rxBatch);
+
+    std::vector<Ptr<const Packet>> packets;
+    for (auto i = batch.begin(); i != batch.end(); i++)
+    {
+        auto [packet, protocol, source] = *i;
+        packets.push_back(packet);
+        if (i + 1 == batch.end() || std::get<1>(*(i + 1)) != protocol ||
+            std::get<2>(*(i + 1)) != source)
+        {
+            m_node->ReceiveBatchFromDevice(this, packets, protocol, source);
+            packets.clear();
+        }
     }
 }
 
@@ -1034,6 +1088,7 @@ CsmaNetDevice::SetReceiveCallback(NetDevice::ReceiveCallback cb)
 {
     NS_LOG_FUNCTION(&cb);
     m_rxCallback = cb;
+    m_rxCallbackIsNode = m_node && m_node->IsReceiveCallback(cb);
 }
 
 Address
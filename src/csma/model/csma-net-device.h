@@ -14,6 +14,7 @@
 #include "ns3/address.h"
 #include "ns3/callback.h"
 #include "ns3/data-rate.h"
+#include "ns3/event-id.h"
 #include "ns3/mac48-address.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -24,6 +25,8 @@
 #include "ns3/traced-callback.h"
 
 #include <cstring>
+#include <tuple>
+#include <vector>
 
 namespace ns3
 {
@@ -427,6 +430,14 @@ class CsmaNetDevice : public NetDevice
      */
     void TransmitReadyEvent();
 
+    /**
+     * Deliver the packets received since the last batch to the node, each
+     * run of packets of the same protocol and sender as a batch.
+     *
+     * @see Node::ReceiveBatchFromDevice
+     */
+    void DeliverReceiveBatch();
+
     /**
      * Aborts the transmission of the current packet
      *
@@ -533,6 +544,34 @@ class CsmaNetDevice : public NetDevice
      */
     Ptr<ErrorModel> m_receiveErrorModel;
 
+    /**
+     * Enable batching of the received packets: the packets are passed to the
+     * node in batches, rather than one by one through the receive callback.
+     */
+    bool m_receiveBatching;
+
+    /**
+     * The time the first packet of a batch of received packets waits for
+     * more packets before the batch is passed to the node.
+     */
+    Time m_receiveBatchDelay;
+
+    /**
+     * The packets received since the last batch, with their protocol and sender.
+     */
+    std::vector<std::tuple<Ptr<Packet>, uint16_t, Mac48Address>> m_rxBatch;
+
+    /**
+     * The event delivering the received packets to the node.
+     */
+    EventId m_rxBatchEvent;
+
+    /**
+     * Whether the receive callback is the one set by the node, without which
+     * the received packets are not batched.
+     */
+    bool m_rxCallbackIsNode;
+
     /**
      * The trace source fired when packets come into the "top" of the device
      * at the L3/L2 transition, before being queued for transmission.
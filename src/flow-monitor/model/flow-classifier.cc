@@ -20,6 +20,11 @@ FlowClassifier::~FlowClassifier()
 {
 }
 
+void
+FlowClassifier::RemoveIdleFlows(Time time, Callback<bool, FlowId> isMonitored)
+{
+}
+
 FlowId
 FlowClassifier::GetNewFlowId()
 {
@@ -9,6 +9,8 @@
 #ifndef FLOW_CLASSIFIER_H
 #define FLOW_CLASSIFIER_H
 
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
 #include "ns3/simple-ref-count.h"
 
 #include <ostream>
@@ -57,6 +59,16 @@ class FlowClassifier : public SimpleRefCount<FlowClassifier>
     /// @param indent number of spaces to use as base indentation level
     virtual void SerializeToXmlStream(std::ostream& os, uint16_t indent) const = 0;
 
+    /// Remove the flows which had no packet classified since a time, and
+    /// whose statistics are not kept by the FlowMonitor anymore, either
+    /// because they were exported or because the flows are not sampled.  A
+    /// later packet of a removed flow is classified into a new flow.  The
+    /// default implementation keeps all the flows.
+    /// @param time the time of the last packet of the flows to remove, at the latest
+    /// @param isMonitored callback returning true if the FlowMonitor keeps
+    /// statistics for a flow, which is then kept
+    virtual void RemoveIdleFlows(Time time, Callback<bool, FlowId> isMonitored);
+
   protected:
     /// Returns a new, unique Flow Identifier
     /// @returns a new FlowId
@@ -9,20 +9,60 @@
 #include "flow-monitor.h"
 
 #include "ns3/double.h"
+#include "ns3/enum.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
 
+#include <bit>
 #include <fstream>
 #include <limits>
 #include <sstream>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds(1))
+#define LOSS_CHECK_BUCKET_WIDTH (MilliSeconds(100))
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("FlowMonitor");
 
+namespace
+{
+
+/// @param flowId the FlowId of a packet
+/// @param packetId the FlowPacketId of the packet
+/// @returns the key of the packet in the table of tracked packets
+uint64_t
+GetTrackedPacketKey(FlowId flowId, FlowPacketId packetId)
+{
+    return (static_cast<uint64_t>(flowId) << 32) | packetId;
+}
+
+/// Write an integer to a stream, in little endian byte order
+/// @param os the stream
+/// @param value the integer
+/// @param size the number of bytes to write
+void
+WriteLittleEndian(std::ostream& os, uint64_t value, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; i++)
+    {
+        os.put(static_cast<char>(value >> (8 * i)));
+    }
+}
+
+/// @param time a time
+/// @returns the loss check bucket of the packets last seen at that time
+int64_t
+GetLossCheckBucket(Time time)
+{
+    return time.GetTimeStep() / LOSS_CHECK_BUCKET_WIDTH.GetTimeStep();
+}
+
+} // namespace
+
 NS_OBJECT_ENSURE_REGISTERED(FlowMonitor);
 
 TypeId
@@ -70,7 +110,35 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("FlowSampling",
+                          "One flow out of this number is monitored, the flows being selected "
+                          "deterministically from their FlowId.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_flowSampling),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("ExportFileName",
+                          "The name of the file the flows are exported to when they become "
+                          "idle, their stats being then freed.  No flow is exported if empty.",
+                          StringValue(""),
+                          MakeStringAccessor(&FlowMonitor::m_exportFileName),
+                          MakeStringChecker())
+            .AddAttribute("ExportFormat",
+                          "The format of the file the flows are exported to.",
+                          EnumValue(EXPORT_CSV),
+                          MakeEnumAccessor<ExportFormat>(&FlowMonitor::m_exportFormat),
+                          MakeEnumChecker(EXPORT_CSV, "Csv", EXPORT_BINARY, "Binary"))
+            .AddAttribute("ExportInterval",
+                          "The interval between two exports of the idle flows.",
+                          TimeValue(Seconds(10)),
+                          MakeTimeAccessor(&FlowMonitor::m_exportInterval),
+                          MakeTimeChecker(Time(1)))
+            .AddAttribute("FlowIdleTimeout",
+                          "The time without any packet sent nor received after which a flow "
+                          "with no packet in flight is exported.",
+                          TimeValue(Seconds(10)),
+                          MakeTimeAccessor(&FlowMonitor::m_flowIdleTimeout),
+                          MakeTimeChecker());
     return tid;
 }
 
@@ -86,6 +154,20 @@ FlowMonitor::DoDispose()
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_exportEvent);
+    if (!m_exportFileName.empty())
+    {
+        // export the flows still monitored, even if they have packets in flight
+        for (const auto& [flowId, flowStats] : m_flowStats)
+        {
+            ExportFlow(flowId, flowStats);
+        }
+        m_flowStats.clear();
+        m_flowStatsIndex.clear();
+        m_trackedPackets = TrackedPacketTable();
+        m_lossCheckBuckets.clear();
+        m_exportStream.close();
+    }
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         *iter = nullptr;
@@ -98,12 +180,127 @@ FlowMonitor::DoDispose()
     Object::DoDispose();
 }
 
+std::size_t
+FlowMonitor::TrackedPacketTable::GetHome(uint64_t key) const
+{
+    // multiplicative hashing, keeping the high bits of the product
+    return (key * 0x9e3779b97f4a7c15ULL) >> (64 - std::countr_zero(m_slots.size()));
+}
+
+FlowMonitor::TrackedPacket*
+FlowMonitor::TrackedPacketTable::Find(uint64_t key)
+{
+    if (m_slots.empty())
+    {
+        return nullptr;
+    }
+    std::size_t mask = m_slots.size() - 1;
+    for (std::size_t i = GetHome(key);; i = (i + 1) & mask)
+    {
+        if (!m_slots[i].used)
+        {
+            return nullptr;
+        }
+        if (m_slots[i].key == key)
+        {
+            return &m_slots[i].packet;
+        }
+    }
+}
+
+FlowMonitor::TrackedPacket&
+FlowMonitor::TrackedPacketTable::Insert(uint64_t key)
+{
+    // keep the load factor at most 1/2, so that the probe sequences are short
+    if (2 * (m_size + 1) > m_slots.size())
+    {
+        Grow();
+    }
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t i = GetHome(key);
+    for (; m_slots[i].used; i = (i + 1) & mask)
+    {
+        if (m_slots[i].key == key)
+        {
+            return m_slots[i].packet;
+        }
+    }
+    m_slots[i].key = key;
+    m_slots[i].used = true;
+    m_slots[i].packet = TrackedPacket();
+    m_size++;
+    return m_slots[i].packet;
+}
+
+void
+FlowMonitor::TrackedPacketTable::Erase(uint64_t key)
+{
+    if (m_slots.empty())
+    {
+        return;
+    }
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t i = GetHome(key);
+    while (m_slots[i].used && m_slots[i].key != key)
+    {
+        i = (i + 1) & mask;
+    }
+    if (!m_slots[i].used)
+    {
+        return;
+    }
+    // shift back the following packets of the cluster which may fill the
+    // hole, instead of leaving a tombstone, so that no probe sequence is broken
+    for (std::size_t j = (i + 1) & mask; m_slots[j].used; j = (j + 1) & mask)
+    {
+        if (((j - GetHome(m_slots[j].key)) & mask) >= ((j - i) & mask))
+        {
+            m_slots[i] = m_slots[j];
+            i = j;
+        }
+    }
+    m_slots[i].used = false;
+    m_size--;
+}
+
+std::size_t
+FlowMonitor::TrackedPacketTable::GetSize() const
+{
+    return m_size;
+}
+
+void
+FlowMonitor::TrackedPacketTable::Grow()
+{
+    std::vector<Slot> slots(std::max<std::size_t>(2 * m_slots.size(), 64));
+    m_slots.swap(slots);
+    std::size_t mask = m_slots.size() - 1;
+    for (const auto& slot : slots)
+    {
+        if (slot.used)
+        {
+            std::size_t i = GetHome(slot.key);
+            while (m_slots[i].used)
+            {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = slot;
+        }
+    }
+}
+
 inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow(FlowId flowId)
+{
+    return *GetFlowState(flowId).stats;
+}
+
+FlowMonitor::FlowState&
+FlowMonitor::GetFlowState(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
-    auto iter = m_flowStats.find(flowId);
-    if (iter == m_flowStats.end())
+    auto iter = m_flowStatsIndex.find(flowId);
+    if (iter == m_flowStatsIndex.end())
     {
         FlowMonitor::FlowStats& ref = m_flowStats[flowId];
         ref.delaySum = Seconds(0);
@@ -121,7 +318,7 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
         ref.jitterHistogram.SetDefaultBinWidth(m_jitterBinWidth);
         ref.packetSizeHistogram.SetDefaultBinWidth(m_packetSizeBinWidth);
         ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
-        return ref;
+        return m_flowStatsIndex[flowId] = FlowState{&ref, 0};
     }
     else
     {
@@ -129,6 +326,22 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
     }
 }
 
+void
+FlowMonitor::QueueLossCheck(uint64_t key, TrackedPacket& tracked)
+{
+    tracked.lossCheckBucket = GetLossCheckBucket(tracked.lastSeenTime);
+    // the packets are mostly queued in the last bucket
+    if (!m_lossCheckBuckets.empty() &&
+        m_lossCheckBuckets.rbegin()->first == tracked.lossCheckBucket)
+    {
+        m_lossCheckBuckets.rbegin()->second.push_back(key);
+    }
+    else
+    {
+        m_lossCheckBuckets[tracked.lossCheckBucket].push_back(key);
+    }
+}
+
 void
 FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
                            uint32_t flowId,
@@ -141,17 +354,30 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (!IsFlowSampled(flowId))
+    {
+        NS_LOG_DEBUG("Flow " << flowId << " not sampled; returning");
+        return;
+    }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+    FlowState& state = GetFlowState(flowId);
+    uint64_t key = GetTrackedPacketKey(flowId, packetId);
+    std::size_t trackedCount = m_trackedPackets.GetSize();
+    TrackedPacket& tracked = m_trackedPackets.Insert(key);
+    if (m_trackedPackets.GetSize() > trackedCount)
+    {
+        state.packetsInFlight++;
+    }
     tracked.firstSeenTime = now;
     tracked.lastSeenTime = tracked.firstSeenTime;
     tracked.timesForwarded = 0;
+    QueueLossCheck(key, tracked);
     NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
                                                                  << packetId << ").");
 
     probe->AddPacketStats(flowId, packetSize, Seconds(0));
 
-    FlowStats& stats = GetStatsForFlow(flowId);
+    FlowStats& stats = *state.stats;
     stats.txBytes += packetSize;
     stats.txPackets++;
     if (stats.txPackets == 1)
@@ -173,19 +399,19 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    auto tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    TrackedPacket* tracked = m_trackedPackets.Find(GetTrackedPacketKey(flowId, packetId));
+    if (!tracked)
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    // the packet stays in its loss check bucket, it is queued again when checked
+    tracked->timesForwarded++;
+    tracked->lastSeenTime = Simulator::Now();
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
+    Time delay = (Simulator::Now() - tracked->firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 }
 
@@ -201,8 +427,9 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    uint64_t key = GetTrackedPacketKey(flowId, packetId);
+    TrackedPacket* tracked = m_trackedPackets.Find(key);
+    if (!tracked)
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
@@ -210,10 +437,11 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
     }
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
+    Time delay = (now - tracked->firstSeenTime);
     probe->AddPacketStats(flowId, packetSize, delay);
 
-    FlowStats& stats = GetStatsForFlow(flowId);
+    FlowState& state = GetFlowState(flowId);
+    FlowStats& stats = *state.stats;
     stats.delaySum += delay;
     stats.delayHistogram.AddValue(delay.GetSeconds());
     if (stats.rxPackets > 0)
@@ -257,12 +485,13 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
+    stats.timesForwarded += tracked->timesForwarded;
 
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    m_trackedPackets.Erase(key); // we don't need to track this packet anymore
+    state.packetsInFlight--;
 }
 
 void
@@ -281,7 +510,8 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
 
     probe->AddPacketDropStats(flowId, packetSize, reasonCode);
 
-    FlowStats& stats = GetStatsForFlow(flowId);
+    FlowState& state = GetFlowState(flowId);
+    FlowStats& stats = *state.stats;
     stats.lostPackets++;
     if (stats.packetsDropped.size() < reasonCode + 1)
     {
@@ -293,14 +523,15 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked != m_trackedPackets.end())
+    uint64_t key = GetTrackedPacketKey(flowId, packetId);
+    if (m_trackedPackets.Find(key))
     {
         // we don't need to track this packet anymore
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        m_trackedPackets.Erase(key);
+        state.packetsInFlight--;
     }
 }
 
@@ -315,22 +546,47 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
 {
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
+    if (now < maxDelay)
+    {
+        // no packet was seen that long ago
+        return;
+    }
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
+    // Only the packets queued in the buckets up to the one of now - maxDelay
+    // may be lost.  The packets received or dropped since they were queued
+    // are skipped, and the packets forwarded since are queued again.
+    int64_t lastBucket = GetLossCheckBucket(now - maxDelay);
+    std::vector<std::pair<int64_t, std::vector<uint64_t>>> buckets;
+    while (!m_lossCheckBuckets.empty() && m_lossCheckBuckets.begin()->first <= lastBucket)
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
-        {
-            // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
+        auto bucket = m_lossCheckBuckets.extract(m_lossCheckBuckets.begin());
+        buckets.emplace_back(bucket.key(), std::move(bucket.mapped()));
+    }
 
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
-        }
-        else
+    for (const auto& [bucket, keys] : buckets)
+    {
+        for (uint64_t key : keys)
         {
-            iter++;
+            TrackedPacket* tracked = m_trackedPackets.Find(key);
+            if (!tracked || tracked->lossCheckBucket != bucket)
+            {
+                continue;
+            }
+            if (now - tracked->lastSeenTime >= maxDelay)
+            {
+                // packet is considered lost, add it to the loss statistics
+                auto flow = m_flowStatsIndex.find(key >> 32);
+                NS_ASSERT(flow != m_flowStatsIndex.end());
+                flow->second.stats->lostPackets++;
+                flow->second.packetsInFlight--;
+
+                // we won't track it anymore
+                m_trackedPackets.Erase(key);
+            }
+            else
+            {
+                QueueLossCheck(key, *tracked);
+            }
         }
     }
 }
@@ -348,6 +604,142 @@ FlowMonitor::PeriodicCheckForLostPackets()
     Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
 }
 
+bool
+FlowMonitor::IsFlowSampled(FlowId flowId) const
+{
+    // multiplicative hashing, so that the flows sampled do not depend on the
+    // order in which they start
+    return m_flowSampling == 1 || (flowId * 2654435761U) % m_flowSampling == 0;
+}
+
+void
+FlowMonitor::ExportFlow(FlowId flowId, const FlowStats& stats)
+{
+    NS_LOG_FUNCTION(this << flowId);
+    if (!m_exportStream.is_open())
+    {
+        m_exportStream.open(m_exportFileName, std::ios::out | std::ios::binary);
+        if (!m_exportStream.is_open())
+        {
+            NS_FATAL_ERROR("Could not open the export file " << m_exportFileName);
+        }
+        if (m_exportFormat == EXPORT_CSV)
+        {
+            m_exportStream << "flowId,timeFirstTxPacket,timeFirstRxPacket,timeLastTxPacket,"
+                           << "timeLastRxPacket,delaySum,jitterSum,lastDelay,maxDelay,minDelay,"
+                           << "txBytes,rxBytes,txPackets,rxPackets,lostPackets,timesForwarded,"
+                           << "packetsDropped,bytesDropped\n";
+        }
+    }
+
+    uint32_t packetsDropped = 0;
+    for (uint32_t dropped : stats.packetsDropped)
+    {
+        packetsDropped += dropped;
+    }
+    uint64_t bytesDropped = 0;
+    for (uint64_t dropped : stats.bytesDropped)
+    {
+        bytesDropped += dropped;
+    }
+    const Time* times[] = {&stats.timeFirstTxPacket,
+                           &stats.timeFirstRxPacket,
+                           &stats.timeLastTxPacket,
+                           &stats.timeLastRxPacket,
+                           &stats.delaySum,
+                           &stats.jitterSum,
+                           &stats.lastDelay,
+                           &stats.maxDelay,
+                           &stats.minDelay};
+
+    if (m_exportFormat == EXPORT_CSV)
+    {
+        m_exportStream << flowId;
+        for (const Time* time : times)
+        {
+            m_exportStream << "," << time->GetNanoSeconds();
+        }
+        m_exportStream << "," << stats.txBytes << "," << stats.rxBytes << ","
+                       << stats.txPackets << "," << stats.rxPackets << "," << stats.lostPackets
+                       << "," << stats.timesForwarded << "," << packetsDropped << ","
+                       << bytesDropped << "\n";
+    }
+    else
+    {
+        WriteLittleEndian(m_exportStream, flowId, 4);
+        for (const Time* time : times)
+        {
+            WriteLittleEndian(m_exportStream, time->GetNanoSeconds(), 8);
+        }
+        WriteLittleEndian(m_exportStream, stats.txBytes, 8);
+        WriteLittleEndian(m_exportStream, stats.rxBytes, 8);
+        WriteLittleEndian(m_exportStream, stats.txPackets, 4);
+        WriteLittleEndian(m_exportStream, stats.rxPackets, 4);
+        WriteLittleEndian(m_exportStream, stats.lostPackets, 4);
+        WriteLittleEndian(m_exportStream, stats.timesForwarded, 4);
+        WriteLittleEndian(m_exportStream, packetsDropped, 4);
+        WriteLittleEndian(m_exportStream, bytesDropped, 8);
+    }
+}
+
+void
+FlowMonitor::ExportIdleFlows()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_exportFileName.empty())
+    {
+        return;
+    }
+
+    // count the lost packets first, which may leave flows without packets in flight
+    CheckForLostPackets();
+
+    Time now = Simulator::Now();
+    for (auto iter = m_flowStats.begin(); iter != m_flowStats.end();)
+    {
+        const FlowStats& stats = iter->second;
+        Time lastActivity = std::max(stats.timeLastTxPacket, stats.timeLastRxPacket);
+        auto state = m_flowStatsIndex.find(iter->first);
+        NS_ASSERT(state != m_flowStatsIndex.end());
+        if (state->second.packetsInFlight == 0 && now - lastActivity >= m_flowIdleTimeout)
+        {
+            ExportFlow(iter->first, stats);
+            for (const auto& probe : m_flowProbes)
+            {
+                probe->RemoveStats(iter->first);
+            }
+            m_flowStatsIndex.erase(state);
+            iter = m_flowStats.erase(iter);
+        }
+        else
+        {
+            iter++;
+        }
+    }
+    m_exportStream.flush();
+
+    // forget the five-tuples of the exported flows, and of the idle flows not sampled
+    for (const auto& classifier : m_classifiers)
+    {
+        classifier->RemoveIdleFlows(now - m_flowIdleTimeout,
+                                    MakeCallback(&FlowMonitor::IsFlowMonitored, this));
+    }
+}
+
+bool
+FlowMonitor::IsFlowMonitored(FlowId flowId) const
+{
+    return m_flowStatsIndex.find(flowId) != m_flowStatsIndex.end();
+}
+
+void
+FlowMonitor::PeriodicExportIdleFlows()
+{
+    ExportIdleFlows();
+    m_exportEvent =
+        Simulator::Schedule(m_exportInterval, &FlowMonitor::PeriodicExportIdleFlows, this);
+}
+
 void
 FlowMonitor::NotifyConstructionCompleted()
 {
@@ -400,6 +792,11 @@ FlowMonitor::StartRightNow()
         return;
     }
     m_enabled = true;
+    if (!m_exportFileName.empty() && !m_exportEvent.IsPending())
+    {
+        m_exportEvent =
+            Simulator::Schedule(m_exportInterval, &FlowMonitor::PeriodicExportIdleFlows, this);
+    }
 }
 
 void
@@ -18,9 +18,14 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <fstream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
+class FlowMonitorTrackedPacketTableTestCase;
+class FlowMonitorLossTestCase;
+
 namespace ns3
 {
 
@@ -36,10 +41,40 @@ namespace ns3
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * For long simulations, the statistics of the flows may be exported as
+ * they become idle instead of being kept until the end of the simulation:
+ * when the ExportFileName attribute is set, the flows which have no packet
+ * in flight and have not sent nor received a packet for FlowIdleTimeout are
+ * written to that file every ExportInterval, as CSV text or as binary
+ * records (see ExportFormat), and their statistics are freed.  The flows
+ * still monitored are written when the FlowMonitor is disposed.  Only the
+ * counters and times of the flows are exported, not their histograms nor
+ * their per-probe statistics.  The classifiers also forget the exported
+ * flows, so that a flow which becomes active again after being exported is
+ * given a new FlowId, and is exported again later as a new record.
+ *
+ * The cost of the monitoring may also be bounded by only monitoring one
+ * flow out of FlowSampling, selected deterministically from their FlowId.
+ * When the flows are exported, the classifiers forget the flows not sampled
+ * after FlowIdleTimeout without any packet sent, like the exported flows.
  */
 class FlowMonitor : public Object
 {
   public:
+    /// Format of the file the flows are exported to
+    enum ExportFormat
+    {
+        /// One line of comma-separated values per flow, after a header line
+        EXPORT_CSV,
+        /// One fixed-size record of little endian fields per flow: FlowId
+        /// (32 bits), the nine times of FlowStats from timeFirstTxPacket to
+        /// minDelay in nanoseconds (64 bits each), txBytes and rxBytes (64
+        /// bits each), txPackets, rxPackets, lostPackets, timesForwarded and
+        /// the total of packetsDropped (32 bits each), and the total of
+        /// bytesDropped (64 bits)
+        EXPORT_BINARY,
+    };
+
     /// @brief Structure that represents the measured metrics of an individual packet flow
     struct FlowStats
     {
@@ -208,6 +243,16 @@ class FlowMonitor : public Object
                     uint32_t packetSize,
                     uint32_t reasonCode);
 
+    /// @param flowId flow identification
+    /// @returns true if the flow is monitored, according to the
+    /// FlowSampling attribute
+    bool IsFlowSampled(FlowId flowId) const;
+
+    /// Export right now the flows which are idle for FlowIdleTimeout, and
+    /// free their statistics.  This method is called periodically when the
+    /// ExportFileName attribute is set.
+    void ExportIdleFlows();
+
     /// Check right now for packets that appear to be lost
     void CheckForLostPackets();
 
@@ -274,22 +319,81 @@ class FlowMonitor : public Object
     void DoDispose() override;
 
   private:
+    /// allow FlowMonitorTrackedPacketTableTestCase class access
+    friend class ::FlowMonitorTrackedPacketTableTestCase;
+    /// allow FlowMonitorLossTestCase class access
+    friend class ::FlowMonitorLossTestCase;
+
     /// Structure to represent a single tracked packet data
     struct TrackedPacket
     {
         Time firstSeenTime;      //!< absolute time when the packet was first seen by a probe
         Time lastSeenTime;       //!< absolute time when the packet was last seen by a probe
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+        int64_t lossCheckBucket; //!< loss check bucket the packet is queued in
+    };
+
+    /// Open-addressed hash table of the tracked packets, with linear
+    /// probing, keyed by (FlowId << 32 | FlowPacketId)
+    class TrackedPacketTable
+    {
+      public:
+        /// @param key the key of the packet
+        /// @returns the packet, or nullptr if it is not tracked
+        TrackedPacket* Find(uint64_t key);
+
+        /// @param key the key of the packet
+        /// @returns the packet, which is added to the table if it is not tracked
+        TrackedPacket& Insert(uint64_t key);
+
+        /// Remove a packet from the table, if it is tracked
+        /// @param key the key of the packet
+        void Erase(uint64_t key);
+
+        /// @returns the number of tracked packets
+        std::size_t GetSize() const;
+
+      private:
+        /// allow FlowMonitorTrackedPacketTableTestCase class access
+        friend class ::FlowMonitorTrackedPacketTableTestCase;
+
+        /// Slot of the table
+        struct Slot
+        {
+            uint64_t key;         //!< key of the packet
+            bool used;            //!< true if the slot holds a packet
+            TrackedPacket packet; //!< the packet
+        };
+
+        /// @param key the key of a packet
+        /// @returns the index of the first slot to probe for the packet
+        std::size_t GetHome(uint64_t key) const;
+
+        /// Double the number of slots of the table
+        void Grow();
+
+        std::vector<Slot> m_slots; //!< slots, whose number is a power of two
+        std::size_t m_size{0};     //!< number of used slots
+    };
+
+    /// State of a monitored flow, indexed by FlowId
+    struct FlowState
+    {
+        FlowStats* stats;         //!< stats of the flow, in m_flowStats
+        uint32_t packetsInFlight; //!< number of tracked packets of the flow
     };
 
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
+    /// FlowId --> FlowState, hashed to find the stats of each packet quickly
+    std::unordered_map<FlowId, FlowState> m_flowStatsIndex;
 
-    /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-    TrackedPacketMap m_trackedPackets; //!< Tracked packets
-    Time m_maxPerHopDelay;             //!< Minimum per-hop delay
-    FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
+    TrackedPacketTable m_trackedPackets; //!< Tracked packets
+    Time m_maxPerHopDelay;               //!< Minimum per-hop delay
+    FlowProbeContainer m_flowProbes;     //!< all the FlowProbes
+
+    /// Bucket of last seen times --> keys of the packets to check for loss
+    std::map<int64_t, std::vector<uint64_t>> m_lossCheckBuckets;
 
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
@@ -302,12 +406,43 @@ class FlowMonitor : public Object
     double m_packetSizeBinWidth;        //!< packet size bin width (for histograms)
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
+    uint32_t m_flowSampling;            //!< One flow out of m_flowSampling is monitored
+
+    std::string m_exportFileName; //!< Name of the file the flows are exported to
+    ExportFormat m_exportFormat;  //!< Format of the file the flows are exported to
+    Time m_exportInterval;        //!< Interval between the exports of the idle flows
+    Time m_flowIdleTimeout;       //!< Idle time after which a flow is exported
+    std::ofstream m_exportStream; //!< Stream of the file the flows are exported to
+    EventId m_exportEvent;        //!< Periodic export event
 
     /// Get the stats for a given flow
     /// @param flowId the Flow identification
     /// @returns the stats of the flow
     FlowStats& GetStatsForFlow(FlowId flowId);
 
+    /// Get the state of a given flow, creating its stats if needed
+    /// @param flowId the Flow identification
+    /// @returns the state of the flow
+    FlowState& GetFlowState(FlowId flowId);
+
+    /// Write the stats of a flow to the export file
+    /// @param flowId the Flow identification
+    /// @param stats the stats of the flow
+    void ExportFlow(FlowId flowId, const FlowStats& stats);
+
+    /// Periodic function to export the idle flows
+    void PeriodicExportIdleFlows();
+
+    /// @param flowId flow identification
+    /// @returns true if the stats of the flow are kept, i.e. the flow is
+    /// sampled, active and not exported yet
+    bool IsFlowMonitored(FlowId flowId) const;
+
+    /// Queue a tracked packet to be checked for loss
+    /// @param key the key of the packet
+    /// @param tracked the packet
+    void QueueLossCheck(uint64_t key, TrackedPacket& tracked);
+
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
 };
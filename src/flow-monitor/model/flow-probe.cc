@@ -64,6 +64,12 @@ FlowProbe::AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reaso
     flow.bytesDropped[reasonCode] += packetSize;
 }
 
+void
+FlowProbe::RemoveStats(FlowId flowId)
+{
+    m_stats.erase(flowId);
+}
+
 FlowProbe::Stats
 FlowProbe::GetStats() const
 {
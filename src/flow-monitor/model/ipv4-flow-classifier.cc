@@ -9,6 +9,7 @@
 #include "ipv4-flow-classifier.h"
 
 #include "ns3/packet.h"
+#include "ns3/simulator.h"
 #include "ns3/tcp-header.h"
 #include "ns3/udp-header.h"
 
@@ -80,6 +81,16 @@ operator==(const Ipv4FlowClassifier::FiveTuple& t1, const Ipv4FlowClassifier::Fi
             t1.sourcePort == t2.sourcePort && t1.destinationPort == t2.destinationPort);
 }
 
+size_t
+Ipv4FlowClassifier::FiveTupleHash::operator()(const FiveTuple& tuple) const
+{
+    uint64_t addresses = tuple.sourceAddress.Get();
+    addresses = (addresses << 32) | tuple.destinationAddress.Get();
+    uint64_t rest = tuple.protocol;
+    rest = (rest << 32) | (static_cast<uint32_t>(tuple.sourcePort) << 16) | tuple.destinationPort;
+    return std::hash<uint64_t>()(addresses) ^ std::hash<uint64_t>()(rest) * 0x9e3779b9;
+}
+
 Ipv4FlowClassifier::Ipv4FlowClassifier()
 {
 }
@@ -134,51 +145,45 @@ Ipv4FlowClassifier::Classify(const Ipv4Header& ipHeader,
     tuple.destinationPort = dstPort;
 
     // try to insert the tuple, but check if it already exists
-    auto insert = m_flowMap.insert(std::pair<FiveTuple, FlowId>(tuple, 0));
+    auto insert = m_flowMap.try_emplace(tuple);
+    Flow& flow = insert.first->second;
 
     // if the insertion succeeded, we need to assign this tuple a new flow identifier
     if (insert.second)
     {
-        FlowId newFlowId = GetNewFlowId();
-        insert.first->second = newFlowId;
-        m_flowPktIdMap[newFlowId] = 0;
-        m_flowDscpMap[newFlowId];
+        flow.flowId = GetNewFlowId();
+        m_flowIds[flow.flowId] = &*insert.first;
     }
     else
     {
-        m_flowPktIdMap[insert.first->second]++;
+        flow.lastPacketId++;
     }
+    flow.lastSeen = Simulator::Now();
 
     // increment the counter of packets with the same DSCP value
-    Ipv4Header::DscpType dscp = ipHeader.GetDscp();
-    auto dscpInserter = m_flowDscpMap[insert.first->second].insert(
-        std::pair<Ipv4Header::DscpType, uint32_t>(dscp, 1));
+    flow.dscpCounts[ipHeader.GetDscp()]++;
 
-    // if the insertion did not succeed, we need to increment the counter
-    if (!dscpInserter.second)
-    {
-        m_flowDscpMap[insert.first->second][dscp]++;
-    }
-
-    *out_flowId = insert.first->second;
-    *out_packetId = m_flowPktIdMap[*out_flowId];
+    *out_flowId = flow.flowId;
+    *out_packetId = flow.lastPacketId;
 
     return true;
 }
 
-Ipv4FlowClassifier::FiveTuple
-Ipv4FlowClassifier::FindFlow(FlowId flowId) const
+const Ipv4FlowClassifier::FlowMap::value_type&
+Ipv4FlowClassifier::GetFlow(FlowId flowId) const
 {
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    auto flow = m_flowIds.find(flowId);
+    if (flow == m_flowIds.end())
     {
-        if (iter->second == flowId)
-        {
-            return iter->first;
-        }
+        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     }
-    NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
-    FiveTuple retval = {Ipv4Address::GetZero(), Ipv4Address::GetZero(), 0, 0, 0};
-    return retval;
+    return *flow->second;
+}
+
+Ipv4FlowClassifier::FiveTuple
+Ipv4FlowClassifier::FindFlow(FlowId flowId) const
+{
+    return GetFlow(flowId).first;
 }
 
 bool
@@ -191,15 +196,9 @@ Ipv4FlowClassifier::SortByCount::operator()(std::pair<Ipv4Header::DscpType, uint
 std::vector<std::pair<Ipv4Header::DscpType, uint32_t>>
 Ipv4FlowClassifier::GetDscpCounts(FlowId flowId) const
 {
-    auto flow = m_flowDscpMap.find(flowId);
-
-    if (flow == m_flowDscpMap.end())
-    {
-        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
-    }
-
-    std::vector<std::pair<Ipv4Header::DscpType, uint32_t>> v(flow->second.begin(),
-                                                             flow->second.end());
+    const Flow& flow = GetFlow(flowId).second;
+    std::vector<std::pair<Ipv4Header::DscpType, uint32_t>> v(flow.dscpCounts.begin(),
+                                                             flow.dscpCounts.end());
     std::sort(v.begin(), v.end(), SortByCount());
     return v;
 }
@@ -210,28 +209,38 @@ Ipv4FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
     Indent(os, indent);
     os << "<Ipv4FlowClassifier>\n";
 
+    // the flows are listed in the order of their five-tuples
+    std::vector<const FlowMap::value_type*> flows;
+    flows.reserve(m_flowMap.size());
+    for (const auto& flow : m_flowMap)
+    {
+        flows.push_back(&flow);
+    }
+    std::sort(flows.begin(),
+              flows.end(),
+              [](const FlowMap::value_type* f1, const FlowMap::value_type* f2) {
+                  return f1->first < f2->first;
+              });
+
     indent += 2;
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    for (const auto* flow : flows)
     {
+        const FiveTuple& tuple = flow->first;
         Indent(os, indent);
-        os << "<Flow flowId=\"" << iter->second << "\""
-           << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-           << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-           << " protocol=\"" << int(iter->first.protocol) << "\""
-           << " sourcePort=\"" << iter->first.sourcePort << "\""
-           << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
-
+        os << "<Flow flowId=\"" << flow->second.flowId << "\""
+           << " sourceAddress=\"" << tuple.sourceAddress << "\""
+           << " destinationAddress=\"" << tuple.destinationAddress << "\""
+           << " protocol=\"" << int(tuple.protocol) << "\""
+           << " sourcePort=\"" << tuple.sourcePort << "\""
+           << " destinationPort=\"" << tuple.destinationPort << "\">\n";
+
+        const auto& dscpCounts = flow->second.dscpCounts;
         indent += 2;
-        auto flow = m_flowDscpMap.find(iter->second);
-
-        if (flow != m_flowDscpMap.end())
+        for (auto i = dscpCounts.begin(); i != dscpCounts.end(); i++)
         {
-            for (auto i = flow->second.begin(); i != flow->second.end(); i++)
-            {
-                Indent(os, indent);
-                os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
-                   << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+            Indent(os, indent);
+            os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
+               << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
         indent -= 2;
@@ -244,4 +253,21 @@ Ipv4FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
     os << "</Ipv4FlowClassifier>\n";
 }
 
+void
+Ipv4FlowClassifier::RemoveIdleFlows(Time time, Callback<bool, FlowId> isMonitored)
+{
+    for (auto flow = m_flowMap.begin(); flow != m_flowMap.end();)
+    {
+        if (flow->second.lastSeen <= time && !isMonitored(flow->second.flowId))
+        {
+            m_flowIds.erase(flow->second.flowId);
+            flow = m_flowMap.erase(flow);
+        }
+        else
+        {
+            flow++;
+        }
+    }
+}
+
 } // namespace ns3
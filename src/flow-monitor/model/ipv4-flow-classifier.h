@@ -15,6 +15,8 @@
 
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -81,13 +83,38 @@ class Ipv4FlowClassifier : public FlowClassifier
 
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
+    void RemoveIdleFlows(Time time, Callback<bool, FlowId> isMonitored) override;
+
   private:
-    /// Map to Flows Identifiers to FlowIds
-    std::map<FiveTuple, FlowId> m_flowMap;
-    /// Map to FlowIds to FlowPacketId
-    std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-    /// Map FlowIds to (DSCP value, packet count) pairs
-    std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t>> m_flowDscpMap;
+    /// Hash function of the five-tuples
+    struct FiveTupleHash
+    {
+        /// @param tuple the five-tuple to hash
+        /// @returns the hash of the five-tuple
+        size_t operator()(const FiveTuple& tuple) const;
+    };
+
+    /// State of a flow
+    struct Flow
+    {
+        FlowId flowId;             //!< Identifier of the flow
+        FlowPacketId lastPacketId; //!< Identifier of the last packet of the flow
+        Time lastSeen;             //!< Time the last packet of the flow was classified
+        /// (DSCP value, packet count) pairs
+        std::map<Ipv4Header::DscpType, uint32_t> dscpCounts;
+    };
+
+    /// Container: five-tuple, Flow
+    typedef std::unordered_map<FiveTuple, Flow, FiveTupleHash> FlowMap;
+
+    /// @param flowId the FlowId of a flow of this classifier
+    /// @returns the five-tuple and the state of the flow
+    const FlowMap::value_type& GetFlow(FlowId flowId) const;
+
+    /// Map of the five-tuples to the flows
+    FlowMap m_flowMap;
+    /// Flows of m_flowMap, by FlowId
+    std::unordered_map<FlowId, FlowMap::value_type*> m_flowIds;
 };
 
 /**
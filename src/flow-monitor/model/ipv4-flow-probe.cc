@@ -331,7 +331,10 @@ Ipv4FlowProbe::SendOutgoingLogger(const Ipv4Header& ipHeader,
         return;
     }
 
-    if (m_classifier->Classify(ipHeader, ipPayload, &flowId, &packetId))
+    // the packets of the flows which are not sampled are not tagged, so
+    // that the other probes ignore them
+    if (m_classifier->Classify(ipHeader, ipPayload, &flowId, &packetId) &&
+        m_flowMonitor->IsFlowSampled(flowId))
     {
         uint32_t size = (ipPayload->GetSize() + ipHeader.GetSerializedSize());
         NS_LOG_DEBUG("ReportFirstTx (" << this << ", " << flowId << ", " << packetId << ", " << size
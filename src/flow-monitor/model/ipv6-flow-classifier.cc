@@ -10,6 +10,7 @@
 #include "ipv6-flow-classifier.h"
 
 #include "ns3/packet.h"
+#include "ns3/simulator.h"
 #include "ns3/tcp-header.h"
 #include "ns3/udp-header.h"
 
@@ -81,6 +82,16 @@ operator==(const Ipv6FlowClassifier::FiveTuple& t1, const Ipv6FlowClassifier::Fi
             t1.sourcePort == t2.sourcePort && t1.destinationPort == t2.destinationPort);
 }
 
+size_t
+Ipv6FlowClassifier::FiveTupleHash::operator()(const FiveTuple& tuple) const
+{
+    uint64_t rest = tuple.protocol;
+    rest = (rest << 32) | (static_cast<uint32_t>(tuple.sourcePort) << 16) | tuple.destinationPort;
+    return Ipv6AddressHash()(tuple.sourceAddress) ^
+           Ipv6AddressHash()(tuple.destinationAddress) * 0x9e3779b9 ^
+           std::hash<uint64_t>()(rest) * 0x85ebca6b;
+}
+
 Ipv6FlowClassifier::Ipv6FlowClassifier()
 {
 }
@@ -135,51 +146,45 @@ Ipv6FlowClassifier::Classify(const Ipv6Header& ipHeader,
     tuple.destinationPort = dstPort;
 
     // try to insert the tuple, but check if it already exists
-    auto insert = m_flowMap.insert(std::pair<FiveTuple, FlowId>(tuple, 0));
+    auto insert = m_flowMap.try_emplace(tuple);
+    Flow& flow = insert.first->second;
 
     // if the insertion succeeded, we need to assign this tuple a new flow identifier
     if (insert.second)
     {
-        FlowId newFlowId = GetNewFlowId();
-        insert.first->second = newFlowId;
-        m_flowPktIdMap[newFlowId] = 0;
-        m_flowDscpMap[newFlowId];
+        flow.flowId = GetNewFlowId();
+        m_flowIds[flow.flowId] = &*insert.first;
     }
     else
     {
-        m_flowPktIdMap[insert.first->second]++;
+        flow.lastPacketId++;
     }
+    flow.lastSeen = Simulator::Now();
 
     // increment the counter of packets with the same DSCP value
-    Ipv6Header::DscpType dscp = ipHeader.GetDscp();
-    auto dscpInserter = m_flowDscpMap[insert.first->second].insert(
-        std::pair<Ipv6Header::DscpType, uint32_t>(dscp, 1));
+    flow.dscpCounts[ipHeader.GetDscp()]++;
 
-    // if the insertion did not succeed, we need to increment the counter
-    if (!dscpInserter.second)
-    {
-        m_flowDscpMap[insert.first->second][dscp]++;
-    }
-
-    *out_flowId = insert.first->second;
-    *out_packetId = m_flowPktIdMap[*out_flowId];
+    *out_flowId = flow.flowId;
+    *out_packetId = flow.lastPacketId;
 
     return true;
 }
 
-Ipv6FlowClassifier::FiveTuple
-Ipv6FlowClassifier::FindFlow(FlowId flowId) const
+const Ipv6FlowClassifier::FlowMap::value_type&
+Ipv6FlowClassifier::GetFlow(FlowId flowId) const
 {
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    auto flow = m_flowIds.find(flowId);
+    if (flow == m_flowIds.end())
     {
-        if (iter->second == flowId)
-        {
-            return iter->first;
-        }
+        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     }
-    NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
-    FiveTuple retval = {Ipv6Address::GetZero(), Ipv6Address::GetZero(), 0, 0, 0};
-    return retval;
+    return *flow->second;
+}
+
+Ipv6FlowClassifier::FiveTuple
+Ipv6FlowClassifier::FindFlow(FlowId flowId) const
+{
+    return GetFlow(flowId).first;
 }
 
 bool
@@ -192,15 +197,9 @@ Ipv6FlowClassifier::SortByCount::operator()(std::pair<Ipv6Header::DscpType, uint
 std::vector<std::pair<Ipv6Header::DscpType, uint32_t>>
 Ipv6FlowClassifier::GetDscpCounts(FlowId flowId) const
 {
-    auto flow = m_flowDscpMap.find(flowId);
-
-    if (flow == m_flowDscpMap.end())
-    {
-        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
-    }
-
-    std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> v(flow->second.begin(),
-                                                             flow->second.end());
+    const Flow& flow = GetFlow(flowId).second;
+    std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> v(flow.dscpCounts.begin(),
+                                                             flow.dscpCounts.end());
     std::sort(v.begin(), v.end(), SortByCount());
     return v;
 }
@@ -211,28 +210,38 @@ Ipv6FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
     Indent(os, indent);
     os << "<Ipv6FlowClassifier>\n";
 
+    // the flows are listed in the order of their five-tuples
+    std::vector<const FlowMap::value_type*> flows;
+    flows.reserve(m_flowMap.size());
+    for (const auto& flow : m_flowMap)
+    {
+        flows.push_back(&flow);
+    }
+    std::sort(flows.begin(),
+              flows.end(),
+              [](const FlowMap::value_type* f1, const FlowMap::value_type* f2) {
+                  return f1->first < f2->first;
+              });
+
     indent += 2;
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    for (const auto* flow : flows)
     {
+        const FiveTuple& tuple = flow->first;
         Indent(os, indent);
-        os << "<Flow flowId=\"" << iter->second << "\""
-           << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-           << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-           << " protocol=\"" << int(iter->first.protocol) << "\""
-           << " sourcePort=\"" << iter->first.sourcePort << "\""
-           << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
-
+        os << "<Flow flowId=\"" << flow->second.flowId << "\""
+           << " sourceAddress=\"" << tuple.sourceAddress << "\""
+           << " destinationAddress=\"" << tuple.destinationAddress << "\""
+           << " protocol=\"" << int(tuple.protocol) << "\""
+           << " sourcePort=\"" << tuple.sourcePort << "\""
+           << " destinationPort=\"" << tuple.destinationPort << "\">\n";
+
+        const auto& dscpCounts = flow->second.dscpCounts;
         indent += 2;
-        auto flow = m_flowDscpMap.find(iter->second);
-
-        if (flow != m_flowDscpMap.end())
+        for (auto i = dscpCounts.begin(); i != dscpCounts.end(); i++)
         {
-            for (auto i = flow->second.begin(); i != flow->second.end(); i++)
-            {
-                Indent(os, indent);
-                os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
-                   << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+            Indent(os, indent);
+            os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
+               << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
         indent -= 2;
@@ -245,4 +254,21 @@ Ipv6FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
     os << "</Ipv6FlowClassifier>\n";
 }
 
+void
+Ipv6FlowClassifier::RemoveIdleFlows(Time time, Callback<bool, FlowId> isMonitored)
+{
+    for (auto flow = m_flowMap.begin(); flow != m_flowMap.end();)
+    {
+        if (flow->second.lastSeen <= time && !isMonitored(flow->second.flowId))
+        {
+            m_flowIds.erase(flow->second.flowId);
+            flow = m_flowMap.erase(flow);
+        }
+        else
+        {
+            flow++;
+        }
+    }
+}
+
 } // namespace ns3
@@ -274,7 +274,10 @@ Ipv6FlowProbe::SendOutgoingLogger(const Ipv6Header& ipHeader,
     FlowId flowId;
     FlowPacketId packetId;
 
-    if (m_classifier->Classify(ipHeader, ipPayload, &flowId, &packetId))
+    // the packets of the flows which are not sampled are not tagged, so
+    // that the other probes ignore them
+    if (m_classifier->Classify(ipHeader, ipPayload, &flowId, &packetId) &&
+        m_flowMonitor->IsFlowSampled(flowId))
     {
         uint32_t size = (ipPayload->GetSize() + ipHeader.GetSerializedSize());
         NS_LOG_DEBUG("ReportFirstTx (" << this << ", " << flowId << ", " << packetId << ", " << size
@@ -0,0 +1,582 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/enum.h"
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/udp-header.h"
+#include "ns3/uinteger.h"
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup flow-monitor-tests
+ * FlowMonitor test suite
+ */
+
+/**
+ * @defgroup flow-monitor-tests FlowMonitor module tests
+ * @ingroup flow-monitor
+ * @ingroup tests
+ */
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("FlowMonitorTestSuite");
+
+/**
+ * @ingroup flow-monitor-tests
+ *
+ * @brief FlowProbe reporting the packets chosen by the tests
+ */
+class FlowMonitorTestProbe : public FlowProbe
+{
+  public:
+    /**
+     * Constructor
+     * @param monitor the FlowMonitor the probe reports to
+     */
+    FlowMonitorTestProbe(Ptr<FlowMonitor> monitor)
+        : FlowProbe(monitor)
+    {
+    }
+};
+
+/**
+ * @ingroup flow-monitor-tests
+ *
+ * @brief Test case of the open-addressed table of the tracked packets:
+ * insertion, lookup and backward-shift deletion, with colliding keys
+ * wrapping around the end of the table, and against a reference map.
+ */
+class FlowMonitorTrackedPacketTableTestCase : public TestCase
+{
+  public:
+    FlowMonitorTrackedPacketTableTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Check the colliding keys wrapping around the end of the table
+    void TestCollisions();
+    /// Check random insertions and deletions against a reference map
+    void TestRandom();
+};
+
+FlowMonitorTrackedPacketTableTestCase::FlowMonitorTrackedPacketTableTestCase()
+    : TestCase("Check the table of the tracked packets")
+{
+}
+
+void
+FlowMonitorTrackedPacketTableTestCase::TestCollisions()
+{
+    FlowMonitor::TrackedPacketTable table;
+    NS_TEST_EXPECT_MSG_EQ(table.Find(1), nullptr, "An empty table must not find any packet");
+    table.Erase(1);
+
+    // allocate the slots, to look for keys of the same home
+    table.Insert(0);
+    table.Erase(0);
+    NS_TEST_ASSERT_MSG_EQ(table.GetSize(), 0, "The table must be empty");
+    std::size_t last = table.m_slots.size() - 1;
+
+    // three keys whose home is the last slot, and two whose home is the first
+    std::vector<uint64_t> a;
+    std::vector<uint64_t> b;
+    for (uint64_t key = 1; a.size() < 3 || b.size() < 2; key++)
+    {
+        if (table.GetHome(key) == last && a.size() < 3)
+        {
+            a.push_back(key);
+        }
+        else if (table.GetHome(key) == 0 && b.size() < 2)
+        {
+            b.push_back(key);
+        }
+    }
+
+    for (uint64_t key : {a[0], a[1], a[2], b[0], b[1]})
+    {
+        table.Insert(key).timesForwarded = key;
+    }
+    NS_TEST_ASSERT_MSG_EQ(table.GetSize(), 5, "Wrong number of packets");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[last].key, a[0], "Wrong slot of the first key");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[0].key, a[1], "The probe sequence must wrap around");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[1].key, a[2], "The probe sequence must wrap around");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[2].key, b[0], "Wrong slot of a displaced key");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[3].key, b[1], "Wrong slot of a displaced key");
+
+    // inserting a tracked packet again must return it
+    NS_TEST_EXPECT_MSG_EQ(table.Insert(b[1]).timesForwarded, b[1], "The packet must be found");
+    NS_TEST_EXPECT_MSG_EQ(table.GetSize(), 5, "The packet must not be inserted again");
+
+    // the following packets of the cluster are shifted back, across the end
+    table.Erase(a[0]);
+    NS_TEST_EXPECT_MSG_EQ(table.GetSize(), 4, "Wrong number of packets");
+    NS_TEST_EXPECT_MSG_EQ(table.Find(a[0]), nullptr, "The erased packet must not be found");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[last].key, a[1], "The key must be shifted back");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[0].key, a[2], "The key must be shifted back");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[1].key, b[0], "The key must be shifted back");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[2].key, b[1], "The key must be shifted back");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[3].used, false, "The end of the cluster must be freed");
+
+    table.Erase(a[2]);
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[0].key, b[0], "The key must be shifted back");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[1].key, b[1], "The key must be shifted back");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[2].used, false, "The end of the cluster must be freed");
+    // the packets before the freed slot are not moved
+    table.Erase(b[0]);
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[0].key, b[1], "The key must be shifted back");
+    NS_TEST_EXPECT_MSG_EQ(table.m_slots[last].key, a[1], "The key must stay in its home slot");
+
+    // erasing a packet not tracked changes nothing
+    table.Erase(a[0]);
+    NS_TEST_EXPECT_MSG_EQ(table.GetSize(), 2, "Wrong number of packets");
+    for (uint64_t key : {a[1], b[1]})
+    {
+        FlowMonitor::TrackedPacket* packet = table.Find(key);
+        NS_TEST_ASSERT_MSG_NE(packet, nullptr, "The packet must be found");
+        NS_TEST_EXPECT_MSG_EQ(packet->timesForwarded, key, "Wrong packet found");
+    }
+    for (uint64_t key : {a[0], a[2], b[0]})
+    {
+        NS_TEST_EXPECT_MSG_EQ(table.Find(key), nullptr, "The erased packet must not be found");
+    }
+}
+
+void
+FlowMonitorTrackedPacketTableTestCase::TestRandom()
+{
+    FlowMonitor::TrackedPacketTable table;
+    std::unordered_map<uint64_t, uint32_t> reference;
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<uint32_t> flowIds(1, 8);
+    std::uniform_int_distribution<uint32_t> packetIds(0, 2000);
+    std::uniform_int_distribution<uint32_t> operations(0, 2);
+
+    for (uint32_t i = 0; i < 50000; i++)
+    {
+        uint64_t key = (static_cast<uint64_t>(flowIds(generator)) << 32) | packetIds(generator);
+        // insert more than erase, so that the table grows
+        if (operations(generator) > 0)
+        {
+            table.Insert(key).timesForwarded = i;
+            reference[key] = i;
+        }
+        else
+        {
+            table.Erase(key);
+            reference.erase(key);
+        }
+        FlowMonitor::TrackedPacket* packet = table.Find(key);
+        NS_TEST_ASSERT_MSG_EQ((packet != nullptr), (reference.count(key) == 1), "Wrong lookup");
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(table.GetSize(), reference.size(), "Wrong number of packets");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(2 * table.GetSize(), table.m_slots.size(), "Table too loaded");
+    for (const auto& [key, value] : reference)
+    {
+        FlowMonitor::TrackedPacket* packet = table.Find(key);
+        NS_TEST_ASSERT_MSG_NE(packet, nullptr, "The packet must be found");
+        NS_TEST_EXPECT_MSG_EQ(packet->timesForwarded, value, "Wrong packet found");
+    }
+    for (const auto& [key, value] : reference)
+    {
+        table.Erase(key);
+    }
+    NS_TEST_EXPECT_MSG_EQ(table.GetSize(), 0, "The table must be empty");
+}
+
+void
+FlowMonitorTrackedPacketTableTestCase::DoRun()
+{
+    TestCollisions();
+    TestRandom();
+}
+
+/**
+ * @ingroup flow-monitor-tests
+ *
+ * @brief Test case of the timeout-driven loss accounting: the packets not
+ * seen for MaxPerHopDelay are counted as lost once, while the packets
+ * received or forwarded in the meantime are not, and the packets dropped
+ * are counted as lost when dropped.
+ */
+class FlowMonitorLossTestCase : public TestCase
+{
+  public:
+    FlowMonitorLossTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check for lost packets now, and check the loss accounting
+     * @param lostPackets the expected number of lost packets
+     * @param trackedPackets the expected number of packets still tracked
+     */
+    void CheckLosses(uint32_t lostPackets, uint32_t trackedPackets);
+
+    Ptr<FlowMonitor> m_monitor; //!< the FlowMonitor
+};
+
+FlowMonitorLossTestCase::FlowMonitorLossTestCase()
+    : TestCase("Check the timeout-driven loss accounting")
+{
+}
+
+void
+FlowMonitorLossTestCase::CheckLosses(uint32_t lostPackets, uint32_t trackedPackets)
+{
+    m_monitor->CheckForLostPackets();
+    const FlowMonitor::FlowStats& stats = m_monitor->GetFlowStats().at(1);
+    NS_TEST_EXPECT_MSG_EQ(stats.lostPackets,
+                          lostPackets,
+                          "Wrong number of lost packets at " << Simulator::Now().As(Time::S));
+    NS_TEST_EXPECT_MSG_EQ(m_monitor->m_trackedPackets.GetSize(),
+                          trackedPackets,
+                          "Wrong number of tracked packets at " << Simulator::Now().As(Time::S));
+    NS_TEST_EXPECT_MSG_EQ(m_monitor->m_flowStatsIndex.at(1).packetsInFlight,
+                          trackedPackets,
+                          "Wrong number of packets in flight at " << Simulator::Now().As(Time::S));
+}
+
+void
+FlowMonitorLossTestCase::DoRun()
+{
+    m_monitor = CreateObject<FlowMonitor>();
+    m_monitor->SetAttribute("MaxPerHopDelay", TimeValue(Seconds(1)));
+    Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe>(m_monitor);
+    m_monitor->StartRightNow();
+
+    // packet 1 is lost, packet 2 forwarded, packet 3 received and packet 4 dropped
+    for (uint32_t packetId = 1; packetId <= 4; packetId++)
+    {
+        m_monitor->ReportFirstTx(probe, 1, packetId, 100);
+    }
+    Simulator::Schedule(Seconds(0.2), &FlowMonitor::ReportLastRx, m_monitor, probe, 1, 3, 100);
+    Simulator::Schedule(Seconds(0.3), &FlowMonitor::ReportDrop, m_monitor, probe, 1, 4, 100, 0);
+    Simulator::Schedule(Seconds(0.5), &FlowMonitor::ReportForwarding, m_monitor, probe, 1, 2, 100);
+
+    // the periodic check at 1 s finds packet 1 lost, and requeues packet 2
+    Simulator::Schedule(Seconds(1.4), &FlowMonitorLossTestCase::CheckLosses, this, 2, 1);
+    Simulator::Schedule(Seconds(1.6), &FlowMonitorLossTestCase::CheckLosses, this, 3, 0);
+    // a lost packet received late is neither received nor lost again
+    Simulator::Schedule(Seconds(2.5), &FlowMonitor::ReportLastRx, m_monitor, probe, 1, 1, 100);
+    Simulator::Schedule(Seconds(3), &FlowMonitorLossTestCase::CheckLosses, this, 3, 0);
+
+    Simulator::Stop(Seconds(4));
+    Simulator::Run();
+
+    const FlowMonitor::FlowStats& stats = m_monitor->GetFlowStats().at(1);
+    NS_TEST_EXPECT_MSG_EQ(stats.txPackets, 4, "Wrong number of transmitted packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.rxPackets, 1, "Wrong number of received packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.lostPackets, 3, "Wrong number of lost packets");
+    NS_TEST_EXPECT_MSG_EQ(stats.packetsDropped.at(0), 1, "Wrong number of dropped packets");
+    NS_TEST_EXPECT_MSG_EQ(m_monitor->m_lossCheckBuckets.empty(),
+                          true,
+                          "No packet must be left to check for loss");
+
+    Simulator::Destroy();
+    m_monitor->Dispose();
+    m_monitor = nullptr;
+}
+
+/**
+ * @ingroup flow-monitor-tests
+ *
+ * @brief Test case of the export of the idle flows: the flows idle for
+ * FlowIdleTimeout are exported as binary records and freed, their
+ * five-tuples are forgotten by the classifier, and the records read back
+ * hold the statistics of the flows.
+ */
+class FlowMonitorExportTestCase : public TestCase
+{
+  public:
+    FlowMonitorExportTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Classify and report a UDP packet, received 10 ms later
+     * @param port the source port of the packet
+     */
+    void SendPacket(uint16_t port);
+
+    /**
+     * Check that a flow is monitored, or was exported and freed
+     * @param flowId the flow identification
+     * @param monitored true if the flow must be monitored
+     */
+    void CheckMonitored(FlowId flowId, bool monitored);
+
+    Ptr<FlowMonitor> m_monitor;                      //!< the FlowMonitor
+    Ptr<FlowProbe> m_probe;                          //!< the FlowProbe
+    Ptr<Ipv4FlowClassifier> m_classifier;            //!< the FlowClassifier
+    std::map<uint16_t, std::vector<FlowId>> m_flows; //!< FlowIds given to each source port
+    std::string m_exportFileName;                    //!< name of the export file
+};
+
+FlowMonitorExportTestCase::FlowMonitorExportTestCase()
+    : TestCase("Check the export of the idle flows")
+{
+}
+
+void
+FlowMonitorExportTestCase::DoSetup()
+{
+    m_exportFileName = CreateTempDirFilename("flow-monitor-export.bin");
+}
+
+void
+FlowMonitorExportTestCase::DoTeardown()
+{
+    if (remove(m_exportFileName.c_str()))
+    {
+        NS_LOG_ERROR("Failed to delete file " << m_exportFileName);
+    }
+}
+
+void
+FlowMonitorExportTestCase::SendPacket(uint16_t port)
+{
+    Ipv4Header ipHeader;
+    ipHeader.SetSource(Ipv4Address("10.0.0.1"));
+    ipHeader.SetDestination(Ipv4Address("10.0.0.2"));
+    ipHeader.SetProtocol(17);
+    UdpHeader udpHeader;
+    udpHeader.SetSourcePort(port);
+    udpHeader.SetDestinationPort(9);
+    Ptr<Packet> payload = Create<Packet>(92);
+    payload->AddHeader(udpHeader);
+
+    FlowId flowId;
+    FlowPacketId packetId;
+    bool classified = m_classifier->Classify(ipHeader, payload, &flowId, &packetId);
+    NS_TEST_ASSERT_MSG_EQ(classified, true, "The UDP packet must be classified");
+    std::vector<FlowId>& flows = m_flows[port];
+    if (flows.empty() || flows.back() != flowId)
+    {
+        flows.push_back(flowId);
+    }
+
+    m_monitor->ReportFirstTx(m_probe, flowId, packetId, 100);
+    Simulator::Schedule(MilliSeconds(10),
+                        &FlowMonitor::ReportLastRx,
+                        m_monitor,
+                        m_probe,
+                        flowId,
+                        packetId,
+                        100);
+}
+
+void
+FlowMonitorExportTestCase::CheckMonitored(FlowId flowId, bool monitored)
+{
+    NS_TEST_EXPECT_MSG_EQ(m_monitor->GetFlowStats().count(flowId),
+                          (monitored ? 1 : 0),
+                          "Flow " << flowId << " wrongly monitored at "
+                                  << Simulator::Now().As(Time::S));
+}
+
+void
+FlowMonitorExportTestCase::DoRun()
+{
+    m_monitor = CreateObject<FlowMonitor>();
+    m_monitor->SetAttribute("MaxPerHopDelay", TimeValue(Seconds(1)));
+    m_monitor->SetAttribute("ExportFileName", StringValue(m_exportFileName));
+    m_monitor->SetAttribute("ExportFormat", EnumValue(FlowMonitor::EXPORT_BINARY));
+    m_monitor->SetAttribute("ExportInterval", TimeValue(Seconds(1)));
+    m_monitor->SetAttribute("FlowIdleTimeout", TimeValue(Seconds(2)));
+    m_classifier = Create<Ipv4FlowClassifier>();
+    m_monitor->AddFlowClassifier(m_classifier);
+    m_probe = CreateObject<FlowMonitorTestProbe>(m_monitor);
+    m_monitor->StartRightNow();
+
+    // the flow of port 1000 is idle from 0.11 s, and active again at 3.5 s;
+    // the flow of port 2000 sends a packet every 0.5 s until 4.5 s
+    Simulator::Schedule(Seconds(0), &FlowMonitorExportTestCase::SendPacket, this, 1000);
+    Simulator::Schedule(Seconds(0.1), &FlowMonitorExportTestCase::SendPacket, this, 1000);
+    Simulator::Schedule(Seconds(3.5), &FlowMonitorExportTestCase::SendPacket, this, 1000);
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Simulator::Schedule(i * MilliSeconds(500),
+                            &FlowMonitorExportTestCase::SendPacket,
+                            this,
+                            2000);
+    }
+    // the first flow is exported at 3 s, after 2 s without any packet
+    Simulator::Schedule(Seconds(2.5), &FlowMonitorExportTestCase::CheckMonitored, this, 1, true);
+    Simulator::Schedule(Seconds(3.2), &FlowMonitorExportTestCase::CheckMonitored, this, 1, false);
+    Simulator::Schedule(Seconds(3.2), &FlowMonitorExportTestCase::CheckMonitored, this, 2, true);
+
+    Simulator::Stop(Seconds(5.5));
+    Simulator::Run();
+
+    // the classifier forgot the exported flow, which got a new FlowId
+    NS_TEST_ASSERT_MSG_EQ(m_flows[1000].size(), 2, "The exported flow must get a new FlowId");
+    NS_TEST_EXPECT_MSG_EQ(m_flows[1000][0], 1, "Wrong FlowId");
+    NS_TEST_EXPECT_MSG_EQ(m_flows[1000][1], 3, "Wrong FlowId");
+    NS_TEST_ASSERT_MSG_EQ(m_flows[2000].size(), 1, "The active flow must keep its FlowId");
+    NS_TEST_EXPECT_MSG_EQ(m_flows[2000][0], 2, "Wrong FlowId");
+    NS_TEST_EXPECT_MSG_EQ(m_classifier->FindFlow(3).sourcePort, 1000, "Wrong five-tuple");
+    NS_TEST_EXPECT_MSG_EQ(m_monitor->GetFlowStats().size(), 2, "Wrong number of flows");
+
+    // the remaining flows are exported when the monitor is disposed
+    Simulator::Destroy();
+    m_monitor->Dispose();
+    m_monitor = nullptr;
+    m_probe = nullptr;
+
+    std::ifstream file(m_exportFileName, std::ios::binary);
+    NS_TEST_ASSERT_MSG_EQ(file.is_open(), true, "The export file must exist");
+    auto read = [&file](uint32_t size) {
+        uint64_t value = 0;
+        for (uint32_t i = 0; i < size; i++)
+        {
+            value |= static_cast<uint64_t>(static_cast<uint8_t>(file.get())) << (8 * i);
+        }
+        return value;
+    };
+
+    // FlowId, the number of packets sent and the times of the last packet
+    // of the exported flows, in order of export
+    struct Expected
+    {
+        FlowId flowId;
+        uint32_t packets;
+        Time lastTx;
+    };
+
+    for (const auto& expected : {Expected{1, 2, Seconds(0.1)},
+                                 Expected{2, 10, Seconds(4.5)},
+                                 Expected{3, 1, Seconds(3.5)}})
+    {
+        NS_TEST_EXPECT_MSG_EQ(read(4), expected.flowId, "Wrong FlowId");
+        int64_t times[9];
+        for (auto& time : times)
+        {
+            time = static_cast<int64_t>(read(8));
+        }
+        std::string flow = "flow " + std::to_string(expected.flowId);
+        Time delay = MilliSeconds(10);
+        NS_TEST_EXPECT_MSG_EQ(times[2],
+                              expected.lastTx.GetNanoSeconds(),
+                              "Wrong last tx of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(times[3],
+                              (expected.lastTx + delay).GetNanoSeconds(),
+                              "Wrong last rx of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(times[4],
+                              (expected.packets * delay).GetNanoSeconds(),
+                              "Wrong delay sum of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(times[5], 0, "Wrong jitter sum of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(times[7], delay.GetNanoSeconds(), "Wrong max delay of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(times[8], delay.GetNanoSeconds(), "Wrong min delay of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(read(8), 100 * expected.packets, "Wrong tx bytes of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(read(8), 100 * expected.packets, "Wrong rx bytes of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(read(4), expected.packets, "Wrong tx packets of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(read(4), expected.packets, "Wrong rx packets of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(read(4), 0, "Wrong lost packets of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(read(4), 0, "Wrong times forwarded of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(read(4), 0, "Wrong dropped packets of " << flow);
+        NS_TEST_EXPECT_MSG_EQ(read(8), 0, "Wrong dropped bytes of " << flow);
+    }
+    file.peek();
+    NS_TEST_EXPECT_MSG_EQ(file.eof(), true, "The export file must only hold three records");
+}
+
+/**
+ * @ingroup flow-monitor-tests
+ *
+ * @brief Test case of the sampling of the flows: one flow out of
+ * FlowSampling is monitored, the same whatever the order the flows start in.
+ */
+class FlowMonitorSamplingTestCase : public TestCase
+{
+  public:
+    FlowMonitorSamplingTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+FlowMonitorSamplingTestCase::FlowMonitorSamplingTestCase()
+    : TestCase("Check the sampling of the flows")
+{
+}
+
+void
+FlowMonitorSamplingTestCase::DoRun()
+{
+    const uint32_t flows = 10000;
+    for (uint32_t sampling : {1, 2, 4, 7, 10, 100})
+    {
+        Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor>();
+        monitor->SetAttribute("FlowSampling", UintegerValue(sampling));
+        Ptr<FlowProbe> probe = CreateObject<FlowMonitorTestProbe>(monitor);
+        monitor->StartRightNow();
+
+        // the flows start in decreasing order of FlowId
+        uint32_t sampled = 0;
+        for (FlowId flowId = flows; flowId > 0; flowId--)
+        {
+            monitor->ReportFirstTx(probe, flowId, 0, 100);
+            sampled += monitor->IsFlowSampled(flowId) ? 1 : 0;
+            NS_TEST_EXPECT_MSG_EQ(monitor->GetFlowStats().count(flowId),
+                                  (monitor->IsFlowSampled(flowId) ? 1 : 0),
+                                  "Only the sampled flows must be monitored");
+        }
+        NS_TEST_EXPECT_MSG_EQ(monitor->GetFlowStats().size(),
+                              sampled,
+                              "Wrong number of monitored flows");
+        NS_TEST_EXPECT_MSG_EQ_TOL(static_cast<double>(sampled),
+                                  static_cast<double>(flows) / sampling,
+                                  0.1 * flows / sampling,
+                                  "Wrong sampling rate for FlowSampling " << sampling);
+
+        Simulator::Destroy();
+        monitor->Dispose();
+    }
+}
+
+/**
+ * @ingroup flow-monitor-tests
+ *
+ * @brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", Type::UNIT)
+{
+    AddTestCase(new FlowMonitorTrackedPacketTableTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorLossTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorExportTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowMonitorSamplingTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static FlowMonitorTestSuite g_flowMonitorTestSuite;
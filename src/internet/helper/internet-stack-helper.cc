@@ -18,7 +18,9 @@
 #include "ns3/assert.h"
 #include "ns3/callback.h"
 #include "ns3/config.h"
+#include "ns3/double.h"
 #include "ns3/global-router-interface.h"
+#include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/ipv4-global-routing.h"
 #include "ns3/ipv4.h"
@@ -33,9 +35,12 @@
 #include "ns3/node.h"
 #include "ns3/object.h"
 #include "ns3/packet-socket-factory.h"
+#include "ns3/pointer.h"
+#include "ns3/random-variable-stream.h"
 #include "ns3/simulator.h"
-#include "ns3/string.h"
+#include "ns3/tcp-l4-protocol.h"
 #include "ns3/traffic-control-layer.h"
+#include "ns3/udp-l4-protocol.h"
 
 #include <limits>
 #include <map>
@@ -256,9 +261,10 @@ InternetStackHelper::AssignStreams(NodeContainer c, int64_t stream)
 void
 InternetStackHelper::Install(NodeContainer c) const
 {
+    InstallFactories factories;
     for (auto i = c.Begin(); i != c.End(); ++i)
     {
-        Install(*i);
+        Install(*i, factories);
     }
 }
 
@@ -268,36 +274,53 @@ InternetStackHelper::InstallAll() const
     Install(NodeContainer::GetGlobal());
 }
 
+InternetStackHelper::InstallFactories::InstallFactories()
+{
+    arp.SetTypeId(ArpL3Protocol::GetTypeId());
+    ipv4.SetTypeId(Ipv4L3Protocol::GetTypeId());
+    icmpv4.SetTypeId(Icmpv4L4Protocol::GetTypeId());
+    ipv6.SetTypeId(Ipv6L3Protocol::GetTypeId());
+    icmpv6.SetTypeId(Icmpv6L4Protocol::GetTypeId());
+    trafficControl.SetTypeId(TrafficControlLayer::GetTypeId());
+    udp.SetTypeId(UdpL4Protocol::GetTypeId());
+    tcp.SetTypeId(TcpL4Protocol::GetTypeId());
+    noJitter.SetTypeId(ConstantRandomVariable::GetTypeId());
+    noJitter.Set("Constant", DoubleValue(0));
+}
+
 void
-InternetStackHelper::CreateAndAggregateObjectFromTypeId(Ptr<Node> node, const std::string typeId)
+InternetStackHelper::CreateAndAggregateObject(Ptr<Node> node, const ObjectFactory& factory)
 {
-    TypeId tid = TypeId::LookupByName(typeId);
-    if (node->GetObject<Object>(tid))
+    if (node->GetObject<Object>(factory.GetTypeId()))
     {
         return;
     }
 
-    ObjectFactory factory;
-    factory.SetTypeId(typeId);
     Ptr<Object> protocol = factory.Create<Object>();
     node->AggregateObject(protocol);
 }
 
 void
 InternetStackHelper::Install(Ptr<Node> node) const
+{
+    Install(node, InstallFactories());
+}
+
+void
+InternetStackHelper::Install(Ptr<Node> node, const InstallFactories& factories) const
 {
     if (m_ipv4Enabled)
     {
         /* IPv4 stack */
-        CreateAndAggregateObjectFromTypeId(node, "ns3::ArpL3Protocol");
-        CreateAndAggregateObjectFromTypeId(node, "ns3::Ipv4L3Protocol");
-        CreateAndAggregateObjectFromTypeId(node, "ns3::Icmpv4L4Protocol");
+        CreateAndAggregateObject(node, factories.arp);
+        CreateAndAggregateObject(node, factories.ipv4);
+        CreateAndAggregateObject(node, factories.icmpv4);
         if (!m_ipv4ArpJitterEnabled)
         {
             Ptr<ArpL3Protocol> arp = node->GetObject<ArpL3Protocol>();
             NS_ASSERT(arp);
             arp->SetAttribute("RequestJitter",
-                              StringValue("ns3::ConstantRandomVariable[Constant=0.0]"));
+                              PointerValue(factories.noJitter.Create<RandomVariableStream>()));
         }
 
         // Set routing
@@ -312,14 +335,14 @@ InternetStackHelper::Install(Ptr<Node> node) const
     if (m_ipv6Enabled)
     {
         /* IPv6 stack */
-        CreateAndAggregateObjectFromTypeId(node, "ns3::Ipv6L3Protocol");
-        CreateAndAggregateObjectFromTypeId(node, "ns3::Icmpv6L4Protocol");
+        CreateAndAggregateObject(node, factories.ipv6);
+        CreateAndAggregateObject(node, factories.icmpv6);
         if (!m_ipv6NsRsJitterEnabled)
         {
             Ptr<Icmpv6L4Protocol> icmpv6l4 = node->GetObject<Icmpv6L4Protocol>();
             NS_ASSERT(icmpv6l4);
             icmpv6l4->SetAttribute("SolicitationJitter",
-                                   StringValue("ns3::ConstantRandomVariable[Constant=0.0]"));
+                                   PointerValue(factories.noJitter.Create<RandomVariableStream>()));
         }
         // Set routing
         Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
@@ -335,9 +358,9 @@ InternetStackHelper::Install(Ptr<Node> node) const
 
     if (m_ipv4Enabled || m_ipv6Enabled)
     {
-        CreateAndAggregateObjectFromTypeId(node, "ns3::TrafficControlLayer");
-        CreateAndAggregateObjectFromTypeId(node, "ns3::UdpL4Protocol");
-        CreateAndAggregateObjectFromTypeId(node, "ns3::TcpL4Protocol");
+        CreateAndAggregateObject(node, factories.trafficControl);
+        CreateAndAggregateObject(node, factories.udp);
+        CreateAndAggregateObject(node, factories.tcp);
         if (!node->GetObject<PacketSocketFactory>())
         {
             Ptr<PacketSocketFactory> factory = CreateObject<PacketSocketFactory>();
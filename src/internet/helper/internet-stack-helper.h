@@ -153,6 +153,8 @@ class InternetStackHelper : public PcapHelperForIpv4,
      * For each node in the input container, aggregate implementations of the
      * ns3::Ipv4, ns3::Ipv6, ns3::Udp, and, ns3::Tcp classes.  This method will do nothing if the
      * stacks are already installed, and will not overwrite existing stacks parameters.
+     * The factories of the protocols are set up once for all the nodes, which makes
+     * it faster than installing the stacks node by node.
      *
      * @param c NodeContainer that holds the set of nodes on which to install the
      * new stacks.
@@ -276,12 +278,39 @@ class InternetStackHelper : public PcapHelperForIpv4,
     const Ipv6RoutingHelper* m_routingv6;
 
     /**
-     * @brief create an object from its TypeId and aggregates it to the node. Does nothing if
+     * @brief Factories of the objects installed on the nodes, set up once for
+     * all the nodes a stack is installed on.
+     */
+    struct InstallFactories
+    {
+        /// Set up the factories
+        InstallFactories();
+
+        ObjectFactory arp;            //!< ArpL3Protocol factory
+        ObjectFactory ipv4;           //!< Ipv4L3Protocol factory
+        ObjectFactory icmpv4;         //!< Icmpv4L4Protocol factory
+        ObjectFactory ipv6;           //!< Ipv6L3Protocol factory
+        ObjectFactory icmpv6;         //!< Icmpv6L4Protocol factory
+        ObjectFactory trafficControl; //!< TrafficControlLayer factory
+        ObjectFactory udp;            //!< UdpL4Protocol factory
+        ObjectFactory tcp;            //!< TcpL4Protocol factory
+        ObjectFactory noJitter;       //!< factory of the jitter when it is disabled
+    };
+
+    /**
+     * @brief Aggregate the stacks to a node.
+     * @param node the node
+     * @param factories the factories of the objects installed on the node
+     */
+    void Install(Ptr<Node> node, const InstallFactories& factories) const;
+
+    /**
+     * @brief create an object from a factory and aggregates it to the node. Does nothing if
      * an object of the same type is already aggregated to the node.
      * @param node the node
-     * @param typeId the object TypeId
+     * @param factory the factory of the object
      */
-    static void CreateAndAggregateObjectFromTypeId(Ptr<Node> node, const std::string typeId);
+    static void CreateAndAggregateObject(Ptr<Node> node, const ObjectFactory& factory);
 
     /**
      * @brief checks if there is an hook to a Pcap wrapper
@@ -19,6 +19,9 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace ns3
 {
 
@@ -188,37 +191,36 @@ ArpCache::HandleWaitReplyTimeout()
     NS_LOG_FUNCTION(this);
     ArpCache::Entry* entry;
     bool restartWaitReplyTimer = false;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // Only the entries waiting for a reply are visited; marking an entry
+    // dead removes it from m_waitReplyEntries, hence the early increment
+    for (auto i = m_waitReplyEntries.begin(); i != m_waitReplyEntries.end();)
     {
-        entry = (*i).second;
-        if (entry != nullptr && entry->IsWaitReply())
+        entry = (*i++).second;
+        if (entry->GetRetries() < m_maxRetries)
         {
-            if (entry->GetRetries() < m_maxRetries)
-            {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- retransmitting arp request since retries = "
-                                     << entry->GetRetries());
-                m_arpRequestCallback(this, entry->GetIpv4Address());
-                restartWaitReplyTimer = true;
-                entry->IncrementRetries();
-            }
-            else
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", ArpWaitTimeout for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- retransmitting arp request since retries = "
+                                 << entry->GetRetries());
+            m_arpRequestCallback(this, entry->GetIpv4Address());
+            restartWaitReplyTimer = true;
+            entry->IncrementRetries();
+        }
+        else
+        {
+            NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
+                                 << entry->GetIpv4Address()
+                                 << " expired -- drop since max retries exceeded: "
+                                 << entry->GetRetries());
+            entry->MarkDead();
+            entry->ClearRetries();
+            Ipv4PayloadHeaderPair pending = entry->DequeuePending();
+            while (pending.first)
             {
-                NS_LOG_LOGIC("node=" << m_device->GetNode()->GetId() << ", wait reply for "
-                                     << entry->GetIpv4Address()
-                                     << " expired -- drop since max retries exceeded: "
-                                     << entry->GetRetries());
-                entry->MarkDead();
-                entry->ClearRetries();
-                Ipv4PayloadHeaderPair pending = entry->DequeuePending();
-                while (pending.first)
-                {
-                    // add the Ipv4 header for tracing purposes
-                    pending.first->AddHeader(pending.second);
-                    m_dropTrace(pending.first);
-                    pending = entry->DequeuePending();
-                }
+                // add the Ipv4 header for tracing purposes
+                pending.first->AddHeader(pending.second);
+                m_dropTrace(pending.first);
+                pending = entry->DequeuePending();
             }
         }
     }
@@ -239,6 +241,8 @@ ArpCache::Flush()
         delete (*i).second;
     }
     m_arpCache.erase(m_arpCache.begin(), m_arpCache.end());
+    m_macIndex.clear();
+    m_waitReplyEntries.clear();
     if (m_waitReplyTimer.IsPending())
     {
         NS_LOG_LOGIC("Stopping WaitReplyTimer at " << Simulator::Now().GetSeconds()
@@ -253,7 +257,13 @@ ArpCache::PrintArpCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    // print the entries in address order, as the cache is not sorted
+    std::vector<std::pair<Ipv4Address, ArpCache::Entry*>> entries(m_arpCache.begin(),
+                                                                  m_arpCache.end());
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (auto i = entries.begin(); i != entries.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -300,8 +310,9 @@ ArpCache::RemoveAutoGeneratedEntries()
         if (i->second->IsAutoGenerated())
         {
             i->second->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+            RemoveMacAddress(i->second);
             delete i->second;
-            m_arpCache.erase(i++);
+            i = m_arpCache.erase(i);
             continue;
         }
         i++;
@@ -314,13 +325,10 @@ ArpCache::LookupInverse(Address to)
     NS_LOG_FUNCTION(this << to);
 
     std::list<ArpCache::Entry*> entryList;
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto range = m_macIndex.equal_range(to);
+    for (auto i = range.first; i != range.second; i++)
     {
-        ArpCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == to)
-        {
-            entryList.push_back(entry);
-        }
+        entryList.push_back(i->second);
     }
     return entryList;
 }
@@ -345,6 +353,7 @@ ArpCache::Add(Ipv4Address to)
 
     auto entry = new ArpCache::Entry(this);
     m_arpCache[to] = entry;
+    m_macIndex.emplace(entry->GetMacAddress(), entry);
     entry->SetIpv4Address(to);
     return entry;
 }
@@ -354,19 +363,45 @@ ArpCache::Remove(ArpCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_arpCache.begin(); i != m_arpCache.end(); i++)
+    auto i = m_arpCache.find(entry->GetIpv4Address());
+    if (i != m_arpCache.end() && (*i).second == entry)
     {
-        if ((*i).second == entry)
-        {
-            m_arpCache.erase(i);
-            entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
-            delete entry;
-            return;
-        }
+        m_arpCache.erase(i);
+        m_waitReplyEntries.erase(entry->GetIpv4Address());
+        RemoveMacAddress(entry);
+        entry->ClearPendingPacket(); // clear the pending packets for entry's ipaddress
+        delete entry;
+        return;
     }
     NS_LOG_WARN("Entry not found in this ARP Cache");
 }
 
+void
+ArpCache::UpdateMacAddress(ArpCache::Entry* entry, const Address& macAddress)
+{
+    NS_LOG_FUNCTION(this << entry << macAddress);
+    if (entry->GetMacAddress() == macAddress)
+    {
+        return;
+    }
+    RemoveMacAddress(entry);
+    m_macIndex.emplace(macAddress, entry);
+}
+
+void
+ArpCache::RemoveMacAddress(ArpCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    auto range = m_macIndex.equal_range(entry->GetMacAddress());
+    auto i = std::find_if(range.first, range.second, [entry](const auto& indexed) {
+        return indexed.second == entry;
+    });
+    if (i != range.second)
+    {
+        m_macIndex.erase(i);
+    }
+}
+
 ArpCache::Entry::Entry(ArpCache* arp)
     : m_arp(arp),
       m_state(ALIVE),
@@ -415,7 +450,7 @@ ArpCache::Entry::MarkDead()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(m_state == ALIVE || m_state == WAIT_REPLY || m_state == DEAD);
-    m_state = DEAD;
+    SetState(DEAD);
     ClearRetries();
     UpdateSeen();
 }
@@ -425,8 +460,8 @@ ArpCache::Entry::MarkAlive(Address macAddress)
 {
     NS_LOG_FUNCTION(this << macAddress);
     NS_ASSERT(m_state == WAIT_REPLY);
-    m_macAddress = macAddress;
-    m_state = ALIVE;
+    SetMacAddress(macAddress);
+    SetState(ALIVE);
     ClearRetries();
     UpdateSeen();
 }
@@ -437,7 +472,7 @@ ArpCache::Entry::MarkPermanent()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
-    m_state = PERMANENT;
+    SetState(PERMANENT);
     ClearRetries();
     UpdateSeen();
 }
@@ -448,7 +483,7 @@ ArpCache::Entry::MarkAutoGenerated()
     NS_LOG_FUNCTION(this << m_macAddress);
     NS_ASSERT(!m_macAddress.IsInvalid());
 
-    m_state = STATIC_AUTOGENERATED;
+    SetState(STATIC_AUTOGENERATED);
     ClearRetries();
     UpdateSeen();
 }
@@ -478,7 +513,7 @@ ArpCache::Entry::MarkWaitReply(Ipv4PayloadHeaderPair waiting)
     NS_ASSERT(m_pending.empty());
     NS_ASSERT_MSG(waiting.first, "Can not add a null packet to the ARP queue");
 
-    m_state = WAIT_REPLY;
+    SetState(WAIT_REPLY);
     m_pending.push_back(waiting);
     UpdateSeen();
     m_arp->StartWaitReplyTimer();
@@ -495,6 +530,7 @@ void
 ArpCache::Entry::SetMacAddress(Address macAddress)
 {
     NS_LOG_FUNCTION(this);
+    m_arp->UpdateMacAddress(this, macAddress);
     m_macAddress = macAddress;
 }
 
@@ -512,6 +548,21 @@ ArpCache::Entry::SetIpv4Address(Ipv4Address destination)
     m_ipv4Address = destination;
 }
 
+void
+ArpCache::Entry::SetState(ArpCacheEntryState_e state)
+{
+    NS_LOG_FUNCTION(this << state);
+    if (m_state == WAIT_REPLY && state != WAIT_REPLY)
+    {
+        m_arp->m_waitReplyEntries.erase(m_ipv4Address);
+    }
+    else if (m_state != WAIT_REPLY && state == WAIT_REPLY)
+    {
+        m_arp->m_waitReplyEntries[m_ipv4Address] = this;
+    }
+    m_state = state;
+}
+
 Time
 ArpCache::Entry::GetTimeout() const
 {
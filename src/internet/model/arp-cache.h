@@ -23,6 +23,7 @@
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -304,6 +305,13 @@ class ArpCache : public Object
             STATIC_AUTOGENERATED
         };
 
+        /**
+         * @brief Change the state of this entry, keeping track of the
+         * entries waiting for a reply in the ARP cache.
+         * @param state the new state
+         */
+        void SetState(ArpCacheEntryState_e state);
+
         ArpCache* m_arp;              //!< pointer to the ARP cache owning the entry
         ArpCacheEntryState_e m_state; //!< state of the entry
         Time m_lastSeen;              //!< last moment a packet from that address has been seen
@@ -317,11 +325,28 @@ class ArpCache : public Object
     /**
      * @brief ARP Cache container
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv4Address, ArpCache::Entry*, Ipv4AddressHash> Cache;
     /**
      * @brief ARP Cache container iterator
      */
-    typedef std::map<Ipv4Address, ArpCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
+    /**
+     * @brief Container of the ARP Cache entries, indexed by MAC address
+     */
+    typedef std::unordered_multimap<Address, ArpCache::Entry*, AddressHash> MacIndex;
+
+    /**
+     * @brief Update the index of the entries by MAC address after the MAC
+     * address of an entry changed.
+     * @param entry the entry
+     * @param macAddress the new MAC address of the entry
+     */
+    void UpdateMacAddress(ArpCache::Entry* entry, const Address& macAddress);
+    /**
+     * @brief Remove an entry from the index of the entries by MAC address.
+     * @param entry the entry
+     */
+    void RemoveMacAddress(ArpCache::Entry* entry);
 
     void DoDispose() override;
 
@@ -343,6 +368,8 @@ class ArpCache : public Object
     void HandleWaitReplyTimeout();
     uint32_t m_pendingQueueSize; //!< number of packets waiting for a resolution
     Cache m_arpCache;            //!< the ARP cache
+    MacIndex m_macIndex;         //!< the ARP cache entries, indexed by MAC address
+    std::map<Ipv4Address, ArpCache::Entry*> m_waitReplyEntries; //!< entries in WAIT_REPLY state
     TracedCallback<Ptr<const Packet>>
         m_dropTrace; //!< trace for packets dropped by the ARP cache queue
 };
@@ -11,7 +11,8 @@
 #include "ns3/log.h"
 #include "ns3/simulation-singleton.h"
 
-#include <list>
+#include <iterator>
+#include <map>
 
 namespace ns3
 {
@@ -165,17 +166,13 @@ class Ipv4AddressGeneratorImpl
     NetworkState m_netTable[N_BITS]; //!< the available networks
 
     /**
-     * @brief This class holds the allocated addresses
+     * @brief The allocated addresses, as ranges of consecutive addresses, each
+     * indexed by its lowest address and holding its highest address, so that
+     * finding the range an address belongs to, or may extend, is logarithmic
+     * in the number of ranges.
      */
-    class Entry
-    {
-      public:
-        uint32_t addrLow;  //!< the lowest allocated address
-        uint32_t addrHigh; //!< the highest allocated address
-    };
-
-    std::list<Entry> m_entries; //!< contained of allocated addresses
-    bool m_test;                //!< test mode (if true)
+    std::map<uint32_t, uint32_t> m_entries;
+    bool m_test; //!< test mode (if true)
 };
 
 Ipv4AddressGeneratorImpl::Ipv4AddressGeneratorImpl()
@@ -354,17 +351,19 @@ Ipv4AddressGeneratorImpl::AddAllocated(const Ipv4Address address)
         addr,
         "Ipv4AddressGeneratorImpl::Add(): Allocating the broadcast address is not a good idea");
 
-    std::list<Entry>::iterator i;
-
-    for (i = m_entries.begin(); i != m_entries.end(); ++i)
+    //
+    // The only range which may hold the new address, or be extended up to
+    // include it, is the last range starting at or below it.  The only range
+    // which may be extended down to include it is the next one.
+    //
+    auto next = m_entries.upper_bound(addr);
+    auto prev = m_entries.end();
+    if (next != m_entries.begin())
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv4Address((*i).addrLow) << " to "
-                                       << Ipv4Address((*i).addrHigh));
-        //
-        // First things first.  Is there an address collision -- that is, does the
-        // new address fall in a previously allocated block of addresses.
-        //
-        if (addr >= (*i).addrLow && addr <= (*i).addrHigh)
+        prev = std::prev(next);
+        NS_LOG_LOGIC("examine entry: " << Ipv4Address(prev->first) << " to "
+                                       << Ipv4Address(prev->second));
+        if (addr <= prev->second)
         {
             NS_LOG_LOGIC(
                 "Ipv4AddressGeneratorImpl::Add(): Address Collision: " << Ipv4Address(addr));
@@ -375,65 +374,32 @@ Ipv4AddressGeneratorImpl::AddAllocated(const Ipv4Address address)
             }
             return false;
         }
-        //
-        // If the new address is less than the lowest address in the current block,
-        // and can't be merged into to the current block, then insert it as a new
-        // block before the current block.
-        //
-        if (addr < (*i).addrLow - 1)
-        {
-            break;
-        }
-        //
-        // If the new address fits at the end of the block, look ahead to the next
-        // block and make sure it's not a collision there.  If we won't overlap, then
-        // just extend the current block by one address.  We expect that completely
-        // filled network ranges will be a fairly rare occurrence, so we don't worry
-        // about collapsing address range blocks.
-        //
-        if (addr == (*i).addrHigh + 1)
-        {
-            auto j = i;
-            ++j;
-
-            if (j != m_entries.end())
-            {
-                if (addr == (*j).addrLow)
-                {
-                    NS_LOG_LOGIC("Ipv4AddressGeneratorImpl::Add(): "
-                                 "Address Collision: "
-                                 << Ipv4Address(addr));
-                    if (!m_test)
-                    {
-                        NS_FATAL_ERROR("Ipv4AddressGeneratorImpl::Add(): Address Collision: "
-                                       << Ipv4Address(addr));
-                    }
-                    return false;
-                }
-            }
-
-            NS_LOG_LOGIC("New addrHigh = " << Ipv4Address(addr));
-            (*i).addrHigh = addr;
-            return true;
-        }
-        //
-        // If we get here, we know that the next lower block of addresses couldn't
-        // have been extended to include this new address since the code immediately
-        // above would have been executed and that next lower block extended upward.
-        // So we know it's safe to extend the current block down to include the new
-        // address.
-        //
-        if (addr == (*i).addrLow - 1)
-        {
-            NS_LOG_LOGIC("New addrLow = " << Ipv4Address(addr));
-            (*i).addrLow = addr;
-            return true;
-        }
     }
 
-    Entry entry;
-    entry.addrLow = entry.addrHigh = addr;
-    m_entries.insert(i, entry);
+    bool extendPrev = (prev != m_entries.end() && prev->second + 1 == addr);
+    bool extendNext = (next != m_entries.end() && next->first - 1 == addr);
+    if (extendPrev && extendNext)
+    {
+        NS_LOG_LOGIC("Merge " << Ipv4Address(prev->first) << " to " << Ipv4Address(next->second));
+        prev->second = next->second;
+        m_entries.erase(next);
+    }
+    else if (extendPrev)
+    {
+        NS_LOG_LOGIC("New addrHigh = " << Ipv4Address(addr));
+        prev->second = addr;
+    }
+    else if (extendNext)
+    {
+        NS_LOG_LOGIC("New addrLow = " << Ipv4Address(addr));
+        uint32_t addrHigh = next->second;
+        next = m_entries.erase(next);
+        m_entries.emplace_hint(next, addr, addrHigh);
+    }
+    else
+    {
+        m_entries.emplace_hint(next, addr, addr);
+    }
     return true;
 }
 
@@ -448,11 +414,13 @@ Ipv4AddressGeneratorImpl::IsAddressAllocated(const Ipv4Address address)
         addr,
         "Ipv4AddressGeneratorImpl::IsAddressAllocated(): Don't check for the broadcast address...");
 
-    for (auto i = m_entries.begin(); i != m_entries.end(); ++i)
+    auto i = m_entries.upper_bound(addr);
+    if (i != m_entries.begin())
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv4Address((*i).addrLow) << " to "
-                                       << Ipv4Address((*i).addrHigh));
-        if (addr >= (*i).addrLow && addr <= (*i).addrHigh)
+        --i;
+        NS_LOG_LOGIC("examine entry: " << Ipv4Address(i->first) << " to "
+                                       << Ipv4Address(i->second));
+        if (addr <= i->second)
         {
             NS_LOG_LOGIC("Ipv4AddressGeneratorImpl::IsAddressAllocated(): Address Collision: "
                          << Ipv4Address(addr));
@@ -472,18 +440,23 @@ Ipv4AddressGeneratorImpl::IsNetworkAllocated(const Ipv4Address address, const Ip
         "Ipv4AddressGeneratorImpl::IsNetworkAllocated(): network address and mask don't match "
             << address << " " << mask);
 
-    for (auto i = m_entries.begin(); i != m_entries.end(); ++i)
+    //
+    // The network is allocated if the last range starting at or below its
+    // highest address ends at or above its lowest address.
+    //
+    uint32_t low = address.Get();
+    uint32_t high = low | ~mask.Get();
+    auto i = m_entries.upper_bound(high);
+    if (i != m_entries.begin())
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv4Address((*i).addrLow) << " to "
-                                       << Ipv4Address((*i).addrHigh));
-        Ipv4Address low((*i).addrLow);
-        Ipv4Address high((*i).addrHigh);
-
-        if (address == low.CombineMask(mask) || address == high.CombineMask(mask))
+        --i;
+        NS_LOG_LOGIC("examine entry: " << Ipv4Address(i->first) << " to "
+                                       << Ipv4Address(i->second));
+        if (i->second >= low)
         {
             NS_LOG_LOGIC(
                 "Ipv4AddressGeneratorImpl::IsNetworkAllocated(): Network already allocated: "
-                << address << " " << low << "-" << high);
+                << address << " " << Ipv4Address(i->first) << "-" << Ipv4Address(i->second));
             return false;
         }
     }
@@ -13,6 +13,8 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -32,29 +34,52 @@ Ipv4EndPointDemux::~Ipv4EndPointDemux()
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv4EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
+    m_positions.clear();
+    m_connected.clear();
+    m_unconnected.clear();
+    m_localPorts.clear();
 }
 
 bool
 Ipv4EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_localPorts.contains(port);
 }
 
 bool
 Ipv4EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv4Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
+    auto count = m_localPorts.find(port);
+    if (count == m_localPorts.end())
+    {
+        return false;
+    }
+
+    uint32_t unconnected = 0;
+    EndPointBucket* bucket = FindUnconnected(port);
+    if (bucket)
+    {
+        for (auto endP : *bucket)
+        {
+            if (endP->GetLocalAddress() == addr && endP->GetBoundNetDevice() == boundNetDevice)
+            {
+                return true;
+            }
+        }
+        unconnected = bucket->size();
+    }
+    if (count->second == unconnected)
+    {
+        return false;
+    }
+
+    // Connected end points are not indexed by local port alone.
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
@@ -77,7 +102,7 @@ Ipv4EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(Ipv4Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -93,7 +118,7 @@ Ipv4EndPointDemux::Allocate(Ipv4Address address)
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -116,7 +141,7 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv4Address address,
         return nullptr;
     }
     auto endPoint = new Ipv4EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -129,19 +154,24 @@ Ipv4EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << localAddress << localPort << peerAddress << peerPort << boundNetDevice);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto endPoint = new Ipv4EndPoint(localAddress, localPort);
+    endPoint->SetPeer(peerAddress, peerPort);
+    EndPointBucket* bucket = FindBucket(endPoint);
+    if (bucket)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto endP : *bucket)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if (endP->GetLocalPort() == localPort && endP->GetLocalAddress() == localAddress &&
+                endP->GetPeerPort() == peerPort && endP->GetPeerAddress() == peerAddress &&
+                (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                delete endPoint;
+                return nullptr;
+            }
         }
     }
-    auto endPoint = new Ipv4EndPoint(localAddress, localPort);
-    endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
 
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
 
@@ -152,15 +182,16 @@ void
 Ipv4EndPointDemux::DeAllocate(Ipv4EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this << endPoint);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_positions.find(endPoint);
+    if (position == m_positions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
     }
+    Unindex(endPoint);
+    m_endPoints.erase(position->second);
+    m_positions.erase(position);
+    endPoint->m_demux = nullptr;
+    delete endPoint;
 }
 
 /*
@@ -200,131 +231,141 @@ Ipv4EndPointDemux::Lookup(Ipv4Address daddr,
     EndPoints retval4; // Exact match on all 4
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr << ":" << dport);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv4EndPoint* endP = *i;
 
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
-        {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
-            continue;
-        }
-
-        if (endP->GetLocalPort() != dport)
+    // Only the end points connected to the source of the packet and the
+    // unconnected ones bound to the destination port can match.
+    for (EndPointBucket* bucket : {FindConnected(saddr, sport, dport), FindUnconnected(dport)})
+    {
+        if (!bucket)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
             continue;
         }
-        if (endP->GetBoundNetDevice())
+        for (Ipv4EndPoint* endP : *bucket)
         {
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+            NS_LOG_DEBUG("Looking at endpoint dport="
+                         << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
+                         << " sport=" << endP->GetPeerPort()
+                         << " saddr=" << endP->GetPeerAddress());
+
+            if (!endP->IsRxEnabled())
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
+                NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                                  << " because endpoint can not receive packets");
                 continue;
             }
-        }
 
-        bool localAddressMatchesExact = false;
-        bool localAddressIsAny = false;
-        bool localAddressIsSubnetAny = false;
+            if (endP->GetLocalPort() != dport)
+            {
+                NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
+                                                  << endP->GetLocalPort()
+                                                  << " does not match packet dport " << dport);
+                continue;
+            }
+            if (endP->GetBoundNetDevice())
+            {
+                if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+                {
+                    NS_LOG_LOGIC("Skipping endpoint "
+                                 << &endP << " because endpoint is bound to specific device and"
+                                 << endP->GetBoundNetDevice() << " does not match packet device "
+                                 << incomingInterface->GetDevice());
+                    continue;
+                }
+            }
 
-        // We have 3 cases:
-        // 1) Exact local / destination address match
-        // 2) Local endpoint bound to Any -> matches anything
-        // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
-        // x.y.z.255 in a /24 net) and direct destination match.
+            bool localAddressMatchesExact = false;
+            bool localAddressIsAny = false;
+            bool localAddressIsSubnetAny = false;
 
-        if (endP->GetLocalAddress() == daddr)
-        {
-            // Case 1:
-            localAddressMatchesExact = true;
-        }
-        else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
-        {
-            // Case 2:
-            localAddressIsAny = true;
-        }
-        else
-        {
-            // Case 3:
-            for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
-            {
-                Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
+            // We have 3 cases:
+            // 1) Exact local / destination address match
+            // 2) Local endpoint bound to Any -> matches anything
+            // 3) Local endpoint bound to x.y.z.0 -> matches Subnet-directed broadcast packet (e.g.,
+            // x.y.z.255 in a /24 net) and direct destination match.
 
-                Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
-                if (endP->GetLocalAddress() == addrNetpart)
+            if (endP->GetLocalAddress() == daddr)
+            {
+                // Case 1:
+                localAddressMatchesExact = true;
+            }
+            else if (endP->GetLocalAddress() == Ipv4Address::GetAny())
+            {
+                // Case 2:
+                localAddressIsAny = true;
+            }
+            else
+            {
+                // Case 3:
+                for (uint32_t i = 0; i < incomingInterface->GetNAddresses(); i++)
                 {
-                    NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
-                                 << endP->GetLocalAddress() << "/"
-                                 << addr.GetMask().GetPrefixLength());
+                    Ipv4InterfaceAddress addr = incomingInterface->GetAddress(i);
 
-                    Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
-                    if (addrNetpart == daddrNetPart)
+                    Ipv4Address addrNetpart = addr.GetLocal().CombineMask(addr.GetMask());
+                    if (endP->GetLocalAddress() == addrNetpart)
                     {
-                        localAddressIsSubnetAny = true;
+                        NS_LOG_LOGIC("Endpoint is SubnetDirectedAny "
+                                     << endP->GetLocalAddress() << "/"
+                                     << addr.GetMask().GetPrefixLength());
+
+                        Ipv4Address daddrNetPart = daddr.CombineMask(addr.GetMask());
+                        if (addrNetpart == daddrNetPart)
+                        {
+                            localAddressIsSubnetAny = true;
+                        }
                     }
                 }
+
+                // if no match here, keep looking
+                if (!localAddressIsSubnetAny)
+                {
+                    continue;
+                }
             }
 
-            // if no match here, keep looking
-            if (!localAddressIsSubnetAny)
+            bool remotePortMatchesExact = endP->GetPeerPort() == sport;
+            bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
+            bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+            bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
+
+            // If remote does not match either with exact or wildcard,
+            // skip this one
+            if (!(remotePortMatchesExact || remotePortMatchesWildCard))
+            {
+                continue;
+            }
+            if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
             {
                 continue;
             }
-        }
-
-        bool remotePortMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePortMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv4Address::GetAny();
-
-        // If remote does not match either with exact or wildcard,
-        // skip this one
-        if (!(remotePortMatchesExact || remotePortMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
 
-        bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
+            bool localAddressMatchesWildCard = localAddressIsAny || localAddressIsSubnetAny;
 
-        if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All 4 match - this is the case of an open TCP connection, for example.
-            NS_LOG_LOGIC("Found an endpoint for case 4, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval4.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
-        { // All but local address - no idea what this case could be.
-            NS_LOG_LOGIC("Found an endpoint for case 3, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remoteAddressMatchesWildCard && remotePortMatchesWildCard)
-        { // Only local port and local address matches exactly - Not yet opened connection
-            NS_LOG_LOGIC("Found an endpoint for case 2, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
-            remotePortMatchesWildCard)
-        { // Only local port matches exactly - Endpoint open to "any" connection
-            NS_LOG_LOGIC("Found an endpoint for case 1, adding " << endP->GetLocalAddress() << ":"
-                                                                 << endP->GetLocalPort());
-            retval1.push_back(endP);
+            if (localAddressMatchesExact && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All 4 match - this is the case of an open TCP connection, for example.
+                NS_LOG_LOGIC("Found an endpoint for case 4, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval4.push_back(endP);
+            }
+            if (localAddressMatchesWildCard && remoteAddressMatchesExact && remotePortMatchesExact)
+            { // All but local address - no idea what this case could be.
+                NS_LOG_LOGIC("Found an endpoint for case 3, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval3.push_back(endP);
+            }
+            if (localAddressMatchesExact && remoteAddressMatchesWildCard &&
+                remotePortMatchesWildCard)
+            { // Only local port and local address matches exactly - Not yet opened connection
+                NS_LOG_LOGIC("Found an endpoint for case 2, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval2.push_back(endP);
+            }
+            if (localAddressMatchesWildCard && remoteAddressMatchesWildCard &&
+                remotePortMatchesWildCard)
+            { // Only local port matches exactly - Endpoint open to "any" connection
+                NS_LOG_LOGIC("Found an endpoint for case 1, adding "
+                             << endP->GetLocalAddress() << ":" << endP->GetLocalPort());
+                retval1.push_back(endP);
+            }
         }
     }
 
@@ -361,6 +402,19 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
 {
     NS_LOG_FUNCTION(this << daddr << dport << saddr << sport);
 
+    EndPointBucket* bucket = FindConnected(saddr, sport, dport);
+    if (bucket)
+    {
+        for (auto endP : *bucket)
+        {
+            if (endP->GetLocalAddress() == daddr)
+            {
+                /* this is an exact match. */
+                return endP;
+            }
+        }
+    }
+
     // this code is a copy/paste version of an old BSD ip stack lookup
     // function.
     uint32_t genericity = 3;
@@ -395,6 +449,101 @@ Ipv4EndPointDemux::SimpleLookup(Ipv4Address daddr,
     return generic;
 }
 
+void
+Ipv4EndPointDemux::Insert(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    endPoint->m_demux = this;
+    m_positions[endPoint] = m_endPoints.insert(m_endPoints.end(), endPoint);
+    Index(endPoint);
+}
+
+void
+Ipv4EndPointDemux::Index(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    m_localPorts[endPoint->GetLocalPort()]++;
+    if (IsConnected(endPoint))
+    {
+        uint64_t key = GetConnectedKey(endPoint->GetPeerAddress(),
+                                       endPoint->GetPeerPort(),
+                                       endPoint->GetLocalPort());
+        m_connected[key].push_back(endPoint);
+    }
+    else
+    {
+        m_unconnected[endPoint->GetLocalPort()].push_back(endPoint);
+    }
+}
+
+void
+Ipv4EndPointDemux::Unindex(Ipv4EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto count = m_localPorts.find(endPoint->GetLocalPort());
+    NS_ASSERT(count != m_localPorts.end());
+    if (--count->second == 0)
+    {
+        m_localPorts.erase(count);
+    }
+
+    EndPointBucket* bucket = FindBucket(endPoint);
+    NS_ASSERT(bucket);
+    bucket->erase(std::find(bucket->begin(), bucket->end(), endPoint));
+    if (bucket->empty())
+    {
+        if (IsConnected(endPoint))
+        {
+            m_connected.erase(GetConnectedKey(endPoint->GetPeerAddress(),
+                                              endPoint->GetPeerPort(),
+                                              endPoint->GetLocalPort()));
+        }
+        else
+        {
+            m_unconnected.erase(endPoint->GetLocalPort());
+        }
+    }
+}
+
+Ipv4EndPointDemux::EndPointBucket*
+Ipv4EndPointDemux::FindBucket(Ipv4EndPoint* endPoint)
+{
+    if (IsConnected(endPoint))
+    {
+        return FindConnected(endPoint->GetPeerAddress(),
+                             endPoint->GetPeerPort(),
+                             endPoint->GetLocalPort());
+    }
+    return FindUnconnected(endPoint->GetLocalPort());
+}
+
+Ipv4EndPointDemux::EndPointBucket*
+Ipv4EndPointDemux::FindConnected(Ipv4Address peerAddress, uint16_t peerPort, uint16_t localPort)
+{
+    auto it = m_connected.find(GetConnectedKey(peerAddress, peerPort, localPort));
+    return it != m_connected.end() ? &it->second : nullptr;
+}
+
+Ipv4EndPointDemux::EndPointBucket*
+Ipv4EndPointDemux::FindUnconnected(uint16_t localPort)
+{
+    auto it = m_unconnected.find(localPort);
+    return it != m_unconnected.end() ? &it->second : nullptr;
+}
+
+bool
+Ipv4EndPointDemux::IsConnected(const Ipv4EndPoint* endPoint)
+{
+    return endPoint->GetPeerPort() != 0 && endPoint->GetPeerAddress() != Ipv4Address::GetAny();
+}
+
+uint64_t
+Ipv4EndPointDemux::GetConnectedKey(Ipv4Address peerAddress, uint16_t peerPort, uint16_t localPort)
+{
+    return (static_cast<uint64_t>(peerAddress.Get()) << 32) |
+           (static_cast<uint64_t>(peerPort) << 16) | localPort;
+}
+
 uint16_t
 Ipv4EndPointDemux::AllocateEphemeralPort()
 {
@@ -15,6 +15,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -160,12 +162,79 @@ class Ipv4EndPointDemux
     void DeAllocate(Ipv4EndPoint* endPoint);
 
   private:
+    friend class Ipv4EndPoint;
+
+    /**
+     * @brief Container of the IPv4 end points sharing the same index key.
+     */
+    typedef std::vector<Ipv4EndPoint*> EndPointBucket;
+
     /**
      * @brief Allocate an ephemeral port.
      * @returns the ephemeral port
      */
     uint16_t AllocateEphemeralPort();
 
+    /**
+     * @brief Add an end point to the list of end points and to the index.
+     * @param endPoint the end point
+     */
+    void Insert(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Add an end point to the index, according to its current
+     * local port and peer.
+     * @param endPoint the end point
+     */
+    void Index(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Remove an end point from the index.
+     *
+     * Must be called before the local port or peer of the end point change.
+     * @param endPoint the end point
+     */
+    void Unindex(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Get the bucket of the index an end point is stored in.
+     * @param endPoint the end point
+     * @return the bucket, nullptr if the bucket does not exist
+     */
+    EndPointBucket* FindBucket(Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Get the bucket of connected end points for a peer and local port.
+     * @param peerAddress the peer address
+     * @param peerPort the peer port
+     * @param localPort the local port
+     * @return the bucket, nullptr if there are no such end points
+     */
+    EndPointBucket* FindConnected(Ipv4Address peerAddress, uint16_t peerPort, uint16_t localPort);
+
+    /**
+     * @brief Get the bucket of unconnected end points for a local port.
+     * @param localPort the local port
+     * @return the bucket, nullptr if there are no such end points
+     */
+    EndPointBucket* FindUnconnected(uint16_t localPort);
+
+    /**
+     * @brief Check whether an end point is indexed as a connected end point.
+     * @param endPoint the end point
+     * @return true if both the peer address and port of the end point are set
+     */
+    static bool IsConnected(const Ipv4EndPoint* endPoint);
+
+    /**
+     * @brief Key of the connected end points index.
+     * @param peerAddress the peer address
+     * @param peerPort the peer port
+     * @param localPort the local port
+     * @return the key
+     */
+    static uint64_t GetConnectedKey(Ipv4Address peerAddress, uint16_t peerPort, uint16_t localPort);
+
     /**
      * @brief The ephemeral port.
      */
@@ -185,6 +254,26 @@ class Ipv4EndPointDemux
      * @brief A list of IPv4 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief Position of each end point in the list of end points.
+     */
+    std::unordered_map<Ipv4EndPoint*, EndPointsI> m_positions;
+
+    /**
+     * @brief Connected end points, indexed by peer address, peer port and local port.
+     */
+    std::unordered_map<uint64_t, EndPointBucket> m_connected;
+
+    /**
+     * @brief Unconnected end points, indexed by local port.
+     */
+    std::unordered_map<uint16_t, EndPointBucket> m_unconnected;
+
+    /**
+     * @brief Number of end points using each local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } // namespace ns3
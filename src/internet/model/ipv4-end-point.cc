@@ -8,6 +8,8 @@
 
 #include "ipv4-end-point.h"
 
+#include "ipv4-end-point-demux.h"
+
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
@@ -18,7 +20,8 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Ipv4EndPoint");
 
 Ipv4EndPoint::Ipv4EndPoint(Ipv4Address address, uint16_t port)
-    : m_localAddr(address),
+    : m_demux(nullptr),
+      m_localAddr(address),
       m_localPort(port),
       m_peerAddr(Ipv4Address::GetAny()),
       m_peerPort(0),
@@ -78,8 +81,16 @@ void
 Ipv4EndPoint::SetPeer(Ipv4Address address, uint16_t port)
 {
     NS_LOG_FUNCTION(this << address << port);
+    if (m_demux)
+    {
+        m_demux->Unindex(this);
+    }
     m_peerAddr = address;
     m_peerPort = port;
+    if (m_demux)
+    {
+        m_demux->Index(this);
+    }
 }
 
 void
@@ -22,6 +22,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv4EndPointDemux;
 class Packet;
 
 /**
@@ -180,6 +181,13 @@ class Ipv4EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv4EndPointDemux;
+
+    /**
+     * @brief The demux this endpoint was allocated by and is indexed in, if any.
+     */
+    Ipv4EndPointDemux* m_demux;
+
     /**
      * @brief The local address.
      */
@@ -96,6 +96,7 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     void SetIpv4(Ptr<Ipv4> ipv4) override;
     void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                            Time::Unit unit = Time::S) const override;
+    uint64_t GetRouteGeneration() const override;
 
     /**
      * @brief Add a host route to the global routing table.
@@ -266,7 +267,8 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
-    Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
+    Ptr<Ipv4> m_ipv4;              //!< associated IPv4 instance
+    uint64_t m_routeGeneration{1}; //!< generation of the routes, see GetRouteGeneration()
 };
 
 } // Namespace ns3
@@ -11,6 +11,7 @@
 #include "ns3/abort.h"
 #include "ns3/assert.h"
 #include "ns3/header.h"
+#include "ns3/ip-checksum.h"
 #include "ns3/log.h"
 
 namespace ns3
@@ -31,6 +32,7 @@ Ipv4Header::Ipv4Header()
       m_fragmentOffset(0),
       m_checksum(0),
       m_goodChecksum(true),
+      m_checksumValid(false),
       m_headerSize(5 * 4)
 {
 }
@@ -47,6 +49,7 @@ Ipv4Header::SetPayloadSize(uint16_t size)
 {
     NS_LOG_FUNCTION(this << size);
     m_payloadSize = size;
+    m_checksumValid = false;
 }
 
 uint16_t
@@ -68,6 +71,7 @@ Ipv4Header::SetIdentification(uint16_t identification)
 {
     NS_LOG_FUNCTION(this << identification);
     m_identification = identification;
+    m_checksumValid = false;
 }
 
 void
@@ -75,6 +79,7 @@ Ipv4Header::SetTos(uint8_t tos)
 {
     NS_LOG_FUNCTION(this << static_cast<uint32_t>(tos));
     m_tos = tos;
+    m_checksumValid = false;
 }
 
 void
@@ -83,6 +88,7 @@ Ipv4Header::SetDscp(DscpType dscp)
     NS_LOG_FUNCTION(this << dscp);
     m_tos &= 0x3; // Clear out the DSCP part, retain 2 bits of ECN
     m_tos |= (dscp << 2);
+    m_checksumValid = false;
 }
 
 void
@@ -91,6 +97,7 @@ Ipv4Header::SetEcn(EcnType ecn)
     NS_LOG_FUNCTION(this << ecn);
     m_tos &= 0xFC; // Clear out the ECN part, retain 6 bits of DSCP
     m_tos |= ecn;
+    m_checksumValid = false;
 }
 
 Ipv4Header::DscpType
@@ -193,6 +200,7 @@ Ipv4Header::SetMoreFragments()
 {
     NS_LOG_FUNCTION(this);
     m_flags |= MORE_FRAGMENTS;
+    m_checksumValid = false;
 }
 
 void
@@ -200,6 +208,7 @@ Ipv4Header::SetLastFragment()
 {
     NS_LOG_FUNCTION(this);
     m_flags &= ~MORE_FRAGMENTS;
+    m_checksumValid = false;
 }
 
 bool
@@ -214,6 +223,7 @@ Ipv4Header::SetDontFragment()
 {
     NS_LOG_FUNCTION(this);
     m_flags |= DONT_FRAGMENT;
+    m_checksumValid = false;
 }
 
 void
@@ -221,6 +231,7 @@ Ipv4Header::SetMayFragment()
 {
     NS_LOG_FUNCTION(this);
     m_flags &= ~DONT_FRAGMENT;
+    m_checksumValid = false;
 }
 
 bool
@@ -237,6 +248,7 @@ Ipv4Header::SetFragmentOffset(uint16_t offsetBytes)
     // check if the user is trying to set an invalid offset
     NS_ABORT_MSG_IF((offsetBytes & 0x7), "offsetBytes must be multiple of 8 bytes");
     m_fragmentOffset = offsetBytes;
+    m_checksumValid = false;
 }
 
 uint16_t
@@ -256,6 +268,13 @@ void
 Ipv4Header::SetTtl(uint8_t ttl)
 {
     NS_LOG_FUNCTION(this << static_cast<uint32_t>(ttl));
+    if (m_checksumValid)
+    {
+        // Update the checksum of the TTL and protocol word incrementally,
+        // as routers do when decrementing the TTL (see RFC 1624)
+        m_checksum =
+            IpChecksumUpdate(m_checksum, m_ttl | (m_protocol << 8), ttl | (m_protocol << 8));
+    }
     m_ttl = ttl;
 }
 
@@ -278,6 +297,7 @@ Ipv4Header::SetProtocol(uint8_t protocol)
 {
     NS_LOG_FUNCTION(this << static_cast<uint32_t>(protocol));
     m_protocol = protocol;
+    m_checksumValid = false;
 }
 
 void
@@ -285,6 +305,7 @@ Ipv4Header::SetSource(Ipv4Address source)
 {
     NS_LOG_FUNCTION(this << source);
     m_source = source;
+    m_checksumValid = false;
 }
 
 Ipv4Address
@@ -299,6 +320,7 @@ Ipv4Header::SetDestination(Ipv4Address dst)
 {
     NS_LOG_FUNCTION(this << dst);
     m_destination = dst;
+    m_checksumValid = false;
 }
 
 Ipv4Address
@@ -409,8 +431,12 @@ Ipv4Header::Serialize(Buffer::Iterator start) const
 
     if (m_calcChecksum)
     {
-        i = start;
-        uint16_t checksum = i.CalculateIpChecksum(20);
+        uint16_t checksum = m_checksum;
+        if (!m_checksumValid)
+        {
+            i = start;
+            checksum = i.CalculateIpChecksum(20);
+        }
         NS_LOG_LOGIC("checksum=" << checksum);
         i = start;
         i.Next(10);
@@ -469,6 +495,9 @@ Ipv4Header::Deserialize(Buffer::Iterator start)
 
         m_goodChecksum = (checksum == 0);
     }
+    // The received checksum can be reused when serializing this header
+    // again, unless it covers options, which are not serialized
+    m_checksumValid = m_calcChecksum && m_goodChecksum && headerSize == 5 * 4;
     return GetSerializedSize();
 }
 
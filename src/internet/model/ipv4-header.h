@@ -251,6 +251,7 @@ class Ipv4Header : public Header
     Ipv4Address m_destination; //!< destination address
     uint16_t m_checksum;       //!< checksum
     bool m_goodChecksum;       //!< true if checksum is correct
+    bool m_checksumValid;      //!< true if m_checksum matches the other fields
     uint16_t m_headerSize;     //!< IP header size
 };
 
@@ -325,6 +325,10 @@ Ipv4Interface::AddAddress(Ipv4InterfaceAddress addr)
 {
     NS_LOG_FUNCTION(this << addr);
     m_ifaddrs.push_back(addr);
+    if (!m_addressChangeCallback.IsNull())
+    {
+        m_addressChangeCallback();
+    }
     if (!m_addAddressCallback.IsNull())
     {
         m_addAddressCallback(this, addr);
@@ -372,6 +376,10 @@ Ipv4Interface::RemoveAddress(uint32_t index)
             Ipv4InterfaceAddress addr = *it;
 
             m_ifaddrs.erase(it);
+            if (!m_addressChangeCallback.IsNull())
+            {
+                m_addressChangeCallback();
+            }
             if (!m_removeAddressCallback.IsNull())
             {
                 m_removeAddressCallback(this, addr);
@@ -403,6 +411,10 @@ Ipv4Interface::RemoveAddress(Ipv4Address address)
             Ipv4InterfaceAddress ifAddr = *it;
 
             m_ifaddrs.erase(it);
+            if (!m_addressChangeCallback.IsNull())
+            {
+                m_addressChangeCallback();
+            }
             if (!m_removeAddressCallback.IsNull())
             {
                 m_removeAddressCallback(this, ifAddr);
@@ -429,4 +441,11 @@ Ipv4Interface::AddAddressCallback(
     m_addAddressCallback = addAddressCallback;
 }
 
+void
+Ipv4Interface::AddressChangeCallback(Callback<void> addressChangeCallback)
+{
+    NS_LOG_FUNCTION(this << &addressChangeCallback);
+    m_addressChangeCallback = addressChangeCallback;
+}
+
 } // namespace ns3
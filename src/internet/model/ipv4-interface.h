@@ -203,6 +203,15 @@ class Ipv4Interface : public Object
     void AddAddressCallback(
         Callback<void, Ptr<Ipv4Interface>, Ipv4InterfaceAddress> addAddressCallback);
 
+    /**
+     * This callback is set by the IPv4 stack the interface is added to, so
+     * that it can update its index of the node addresses when an address is
+     * added to or removed from the interface.
+     *
+     * @param addressChangeCallback Callback when the addresses change.
+     */
+    void AddressChangeCallback(Callback<void> addressChangeCallback);
+
   protected:
     void DoDispose() override;
 
@@ -239,6 +248,7 @@ class Ipv4Interface : public Object
         m_removeAddressCallback; //!< remove address callback
     Callback<void, Ptr<Ipv4Interface>, Ipv4InterfaceAddress>
         m_addAddressCallback; //!< add address callback
+    Callback<void> m_addressChangeCallback; //!< address change callback
 
     /**
      * The trace fired when the interface state changes.
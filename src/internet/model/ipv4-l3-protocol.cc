@@ -31,6 +31,8 @@
 #include "ns3/traffic-control-layer.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -308,6 +310,9 @@ Ipv4L3Protocol::DoDispose()
     }
     m_interfaces.clear();
     m_reverseInterfacesContainer.clear();
+    m_localAddresses.clear();
+    m_broadcastAddresses.clear();
+    m_indexedAddresses.clear();
 
     m_sockets.clear();
     m_node = nullptr;
@@ -330,6 +335,7 @@ Ipv4L3Protocol::DoDispose()
         m_cleanDpd.Cancel();
     }
     m_dups.clear();
+    m_dupExpiries.clear();
 
     Object::DoDispose();
 }
@@ -390,14 +396,19 @@ Ipv4L3Protocol::AddInterface(Ptr<NetDevice> device)
 
     m_node->RegisterProtocolHandler(MakeCallback(&TrafficControlLayer::Receive, tc),
                                     Ipv4L3Protocol::PROT_NUMBER,
-                                    device);
+                                    device,
+                                    false,
+                                    MakeCallback(&TrafficControlLayer::ReceiveBatch, tc));
     m_node->RegisterProtocolHandler(MakeCallback(&TrafficControlLayer::Receive, tc),
                                     ArpL3Protocol::PROT_NUMBER,
-                                    device);
+                                    device,
+                                    false,
+                                    MakeCallback(&TrafficControlLayer::ReceiveBatch, tc));
 
     tc->RegisterProtocolHandler(MakeCallback(&Ipv4L3Protocol::Receive, this),
                                 Ipv4L3Protocol::PROT_NUMBER,
-                                device);
+                                device,
+                                MakeCallback(&Ipv4L3Protocol::ReceiveBatch, this));
     tc->RegisterProtocolHandler(
         MakeCallback(&ArpL3Protocol::Receive, PeekPointer(GetObject<ArpL3Protocol>())),
         ArpL3Protocol::PROT_NUMBER,
@@ -418,9 +429,48 @@ Ipv4L3Protocol::AddIpv4Interface(Ptr<Ipv4Interface> interface)
     uint32_t index = m_interfaces.size();
     m_interfaces.push_back(interface);
     m_reverseInterfacesContainer[interface->GetDevice()] = index;
+    interface->AddressChangeCallback(
+        MakeCallback(&Ipv4L3Protocol::UpdateLocalAddresses, this, index));
+    UpdateLocalAddresses(index);
     return index;
 }
 
+void
+Ipv4L3Protocol::UpdateLocalAddresses(uint32_t i)
+{
+    NS_LOG_FUNCTION(this << i);
+
+    // Remove one entry for the interface from an index
+    auto removeEntry = [i](AddressInterfaces_t& index, Ipv4Address address) {
+        auto [begin, end] = index.equal_range(address);
+        auto it = std::find_if(begin, end, [i](const auto& entry) { return entry.second == i; });
+        if (it != end)
+        {
+            index.erase(it);
+        }
+    };
+
+    if (m_indexedAddresses.size() <= i)
+    {
+        m_indexedAddresses.resize(i + 1);
+    }
+    for (const auto& iaddr : m_indexedAddresses[i])
+    {
+        removeEntry(m_localAddresses, iaddr.GetLocal());
+        removeEntry(m_broadcastAddresses, iaddr.GetBroadcast());
+    }
+    m_indexedAddresses[i].clear();
+
+    Ptr<Ipv4Interface> interface = GetInterface(i);
+    for (uint32_t j = 0; j < interface->GetNAddresses(); j++)
+    {
+        Ipv4InterfaceAddress iaddr = interface->GetAddress(j);
+        m_localAddresses.emplace(iaddr.GetLocal(), i);
+        m_broadcastAddresses.emplace(iaddr.GetBroadcast(), i);
+        m_indexedAddresses[i].push_back(iaddr);
+    }
+}
+
 Ptr<Ipv4Interface>
 Ipv4L3Protocol::GetInterface(uint32_t index) const
 {
@@ -440,19 +490,17 @@ Ipv4L3Protocol::GetNInterfaces() const
 int32_t
 Ipv4L3Protocol::GetInterfaceForAddress(Ipv4Address address) const
 {
-    int32_t interface = 0;
-    for (auto i = m_interfaces.begin(); i != m_interfaces.end(); i++, interface++)
+    int32_t interface = -1;
+    auto [begin, end] = m_localAddresses.equal_range(address);
+    for (auto it = begin; it != end; it++)
     {
-        for (uint32_t j = 0; j < (*i)->GetNAddresses(); j++)
+        if (interface == -1 || it->second < uint32_t(interface))
         {
-            if ((*i)->GetAddress(j).GetLocal() == address)
-            {
-                return interface;
-            }
+            interface = it->second;
         }
     }
 
-    return -1;
+    return interface;
 }
 
 int32_t
@@ -488,20 +536,27 @@ Ipv4L3Protocol::GetInterfaceForDevice(Ptr<const NetDevice> device) const
 bool
 Ipv4L3Protocol::IsDestinationAddress(Ipv4Address address, uint32_t iif) const
 {
+    // Check whether an interface of the node owns the address
+    auto isOwnedBy = [iif](const AddressInterfaces_t& index,
+                           Ipv4Address address,
+                           bool& otherInterface) {
+        auto [begin, end] = index.equal_range(address);
+        otherInterface = begin != end;
+        return std::any_of(begin, end, [iif](const auto& entry) { return entry.second == iif; });
+    };
+    bool localOnOtherInterface;
+    bool broadcastOnOtherInterface;
+
     // First check the incoming interface for a unicast address match
-    for (uint32_t i = 0; i < GetNAddresses(iif); i++)
+    if (isOwnedBy(m_localAddresses, address, localOnOtherInterface))
     {
-        Ipv4InterfaceAddress iaddr = GetAddress(iif, i);
-        if (address == iaddr.GetLocal())
-        {
-            NS_LOG_LOGIC("For me (destination " << address << " match)");
-            return true;
-        }
-        if (address == iaddr.GetBroadcast())
-        {
-            NS_LOG_LOGIC("For me (interface broadcast address)");
-            return true;
-        }
+        NS_LOG_LOGIC("For me (destination " << address << " match)");
+        return true;
+    }
+    if (isOwnedBy(m_broadcastAddresses, address, broadcastOnOtherInterface))
+    {
+        NS_LOG_LOGIC("For me (interface broadcast address)");
+        return true;
     }
 
     if (address.IsMulticast())
@@ -523,28 +578,16 @@ Ipv4L3Protocol::IsDestinationAddress(Ipv4Address address, uint32_t iif) const
 
     if (!GetStrongEndSystemModel()) // Check other interfaces
     {
-        for (uint32_t j = 0; j < GetNInterfaces(); j++)
+        if (localOnOtherInterface)
         {
-            if (j == uint32_t(iif))
-            {
-                continue;
-            }
-            for (uint32_t i = 0; i < GetNAddresses(j); i++)
-            {
-                Ipv4InterfaceAddress iaddr = GetAddress(j, i);
-                if (address == iaddr.GetLocal())
-                {
-                    NS_LOG_LOGIC("For me (destination " << address
-                                                        << " match) on another interface");
-                    return true;
-                }
-                //  This is a small corner case:  match another interface's broadcast address
-                if (address == iaddr.GetBroadcast())
-                {
-                    NS_LOG_LOGIC("For me (interface broadcast address on another interface)");
-                    return true;
-                }
-            }
+            NS_LOG_LOGIC("For me (destination " << address << " match) on another interface");
+            return true;
+        }
+        //  This is a small corner case:  match another interface's broadcast address
+        if (broadcastOnOtherInterface)
+        {
+            NS_LOG_LOGIC("For me (interface broadcast address on another interface)");
+            return true;
         }
     }
     return false;
@@ -560,11 +603,43 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
 {
     NS_LOG_FUNCTION(this << device << p << protocol << from << to << packetType);
 
-    NS_LOG_LOGIC("Packet from " << from << " received on node " << m_node->GetId());
+    int32_t interface = GetInterfaceForDevice(device);
+    NS_ASSERT_MSG(interface != -1, "Received a packet from an interface that is not known to IPv4");
+
+    ReceivePacket(device, interface, p, from, Node::ChecksumEnabled());
+}
+
+void
+Ipv4L3Protocol::ReceiveBatch(Ptr<NetDevice> device,
+                             const std::vector<Ptr<const Packet>>& packets,
+                             uint16_t protocol,
+                             const Address& from,
+                             const Address& to,
+                             NetDevice::PacketType packetType)
+{
+    NS_LOG_FUNCTION(this << device << packets.size() << protocol << from << to << packetType);
 
     int32_t interface = GetInterfaceForDevice(device);
     NS_ASSERT_MSG(interface != -1, "Received a packet from an interface that is not known to IPv4");
 
+    bool checksumEnabled = Node::ChecksumEnabled();
+    for (const auto& p : packets)
+    {
+        ReceivePacket(device, interface, p, from, checksumEnabled);
+    }
+}
+
+void
+Ipv4L3Protocol::ReceivePacket(Ptr<NetDevice> device,
+                              uint32_t interface,
+                              Ptr<const Packet> p,
+                              const Address& from,
+                              bool checksumEnabled)
+{
+    NS_LOG_FUNCTION(this << device << interface << p << from << checksumEnabled);
+
+    NS_LOG_LOGIC("Packet from " << from << " received on node " << m_node->GetId());
+
     Ptr<Packet> packet = p->Copy();
 
     Ptr<Ipv4Interface> ipv4Interface = m_interfaces[interface];
@@ -583,7 +658,7 @@ Ipv4L3Protocol::Receive(Ptr<NetDevice> device,
     }
 
     Ipv4Header ipHeader;
-    if (Node::ChecksumEnabled())
+    if (checksumEnabled)
     {
         ipHeader.EnableChecksum();
     }
@@ -1521,7 +1596,6 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
         uint32_t(ipHeader.GetIdentification()) << 16 | uint32_t(ipHeader.GetProtocol());
     FragmentKey_t key;
     bool ret = false;
-    Ptr<Packet> p = packet->Copy();
 
     key.first = addressCombination;
     key.second = idProto;
@@ -1545,7 +1619,7 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
     NS_LOG_LOGIC("Adding fragment - Size: " << packet->GetSize()
                                             << " - Offset: " << (ipHeader.GetFragmentOffset()));
 
-    fragments->AddFragment(p, ipHeader.GetFragmentOffset(), !ipHeader.IsLastFragment());
+    fragments->AddFragment(packet, ipHeader.GetFragmentOffset(), !ipHeader.IsLastFragment());
 
     if (fragments->IsEntire())
     {
@@ -1560,7 +1634,9 @@ Ipv4L3Protocol::ProcessFragment(Ptr<Packet>& packet, Ipv4Header& ipHeader, uint3
 }
 
 Ipv4L3Protocol::Fragments::Fragments()
-    : m_moreFragment(false)
+    : m_moreFragment(false),
+      m_coveredBlocks(0),
+      m_endOffset(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -1572,22 +1648,28 @@ Ipv4L3Protocol::Fragments::AddFragment(Ptr<Packet> fragment,
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
 
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
-
-    for (it = m_fragments.begin(); it != m_fragments.end(); it++)
+    // fragments at the same offset are kept in their order of arrival
+    auto it = m_fragments.emplace(fragmentOffset, fragment);
+    if (std::next(it) == m_fragments.end())
     {
-        if (it->second > fragmentOffset)
-        {
-            break;
-        }
+        m_moreFragment = moreFragment;
     }
 
-    if (it == m_fragments.end())
+    // mark the 8-byte blocks entirely covered by the fragment
+    uint32_t fragmentEnd = fragmentOffset + fragment->GetSize();
+    m_endOffset = std::max(m_endOffset, fragmentEnd);
+    if (m_blocks.size() < fragmentEnd / 8)
     {
-        m_moreFragment = moreFragment;
+        m_blocks.resize(fragmentEnd / 8);
+    }
+    for (uint32_t block = fragmentOffset / 8; block < fragmentEnd / 8; block++)
+    {
+        if (!m_blocks[block])
+        {
+            m_blocks[block] = true;
+            m_coveredBlocks++;
+        }
     }
-
-    m_fragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
 }
 
 bool
@@ -1595,29 +1677,10 @@ Ipv4L3Protocol::Fragments::IsEntire() const
 {
     NS_LOG_FUNCTION(this);
 
-    bool ret = !m_moreFragment && !m_fragments.empty();
-
-    if (ret)
-    {
-        uint16_t lastEndOffset = 0;
-
-        for (auto it = m_fragments.begin(); it != m_fragments.end(); it++)
-        {
-            // overlapping fragments do exist
-            NS_LOG_LOGIC("Checking overlaps " << lastEndOffset << " - " << it->second);
-
-            if (lastEndOffset < it->second)
-            {
-                ret = false;
-                break;
-            }
-            // fragments might overlap in strange ways
-            uint16_t fragmentEnd = it->first->GetSize() + it->second;
-            lastEndOffset = std::max(lastEndOffset, fragmentEnd);
-        }
-    }
-
-    return ret;
+    // Fragments start on 8-byte boundaries, hence the last block, which may be
+    // incomplete, is covered by the fragment ending the packet. Overlapping
+    // fragments do exist, and are merged when building the packet.
+    return !m_moreFragment && !m_fragments.empty() && m_coveredBlocks == m_endOffset / 8;
 }
 
 Ptr<Packet>
@@ -1627,30 +1690,30 @@ Ipv4L3Protocol::Fragments::GetPacket() const
 
     auto it = m_fragments.begin();
 
-    Ptr<Packet> p = it->first->Copy();
+    Ptr<Packet> p = it->second->Copy();
     uint16_t lastEndOffset = p->GetSize();
     it++;
 
     for (; it != m_fragments.end(); it++)
     {
-        if (lastEndOffset > it->second)
+        if (lastEndOffset > it->first)
         {
             // The fragments are overlapping.
             // We do not overwrite the "old" with the "new" because we do not know when each
             // arrived. This is different from what Linux does. It is not possible to emulate a
             // fragmentation attack.
-            uint32_t newStart = lastEndOffset - it->second;
-            if (it->first->GetSize() > newStart)
+            uint32_t newStart = lastEndOffset - it->first;
+            if (it->second->GetSize() > newStart)
             {
-                uint32_t newSize = it->first->GetSize() - newStart;
-                Ptr<Packet> tempFragment = it->first->CreateFragment(newStart, newSize);
+                uint32_t newSize = it->second->GetSize() - newStart;
+                Ptr<Packet> tempFragment = it->second->CreateFragment(newStart, newSize);
                 p->AddAtEnd(tempFragment);
             }
         }
         else
         {
-            NS_LOG_LOGIC("Adding: " << *(it->first));
-            p->AddAtEnd(it->first);
+            NS_LOG_LOGIC("Adding: " << *(it->second));
+            p->AddAtEnd(it->second);
         }
         lastEndOffset = p->GetSize();
     }
@@ -1668,24 +1731,24 @@ Ipv4L3Protocol::Fragments::GetPartialPacket() const
     Ptr<Packet> p = Create<Packet>();
     uint16_t lastEndOffset = 0;
 
-    if (m_fragments.begin()->second > 0)
+    if (m_fragments.begin()->first > 0)
     {
         return p;
     }
 
     for (it = m_fragments.begin(); it != m_fragments.end(); it++)
     {
-        if (lastEndOffset > it->second)
+        if (lastEndOffset > it->first)
         {
-            uint32_t newStart = lastEndOffset - it->second;
-            uint32_t newSize = it->first->GetSize() - newStart;
-            Ptr<Packet> tempFragment = it->first->CreateFragment(newStart, newSize);
+            uint32_t newStart = lastEndOffset - it->first;
+            uint32_t newSize = it->second->GetSize() - newStart;
+            Ptr<Packet> tempFragment = it->second->CreateFragment(newStart, newSize);
             p->AddAtEnd(tempFragment);
         }
-        else if (lastEndOffset == it->second)
+        else if (lastEndOffset == it->first)
         {
-            NS_LOG_LOGIC("Adding: " << *(it->first));
-            p->AddAtEnd(it->first);
+            NS_LOG_LOGIC("Adding: " << *(it->second));
+            p->AddAtEnd(it->second);
         }
         lastEndOffset = p->GetSize();
     }
@@ -1791,6 +1854,10 @@ Ipv4L3Protocol::UpdateDuplicate(Ptr<const Packet> p, const Ipv4Header& header)
 
     // set the expiration event
     iter->second = Simulator::Now() + m_expire;
+    if (m_purge.IsStrictlyPositive())
+    {
+        m_dupExpiries.emplace_back(iter->second, key);
+    }
     return isDup;
 }
 
@@ -1801,22 +1868,20 @@ Ipv4L3Protocol::RemoveDuplicates()
 
     DupMap_t::size_type n = 0;
     Time expire = Simulator::Now();
-    auto iter = m_dups.cbegin();
-    while (iter != m_dups.cend())
+    while (!m_dupExpiries.empty() && m_dupExpiries.front().first < expire)
     {
-        if (iter->second < expire)
+        const auto& [time, key] = m_dupExpiries.front();
+        // an entry refreshed since it was queued has been queued again
+        auto iter = m_dups.find(key);
+        if (iter != m_dups.end() && iter->second == time)
         {
-            NS_LOG_LOGIC("Remove key = (" << std::hex << std::get<0>(iter->first) << ", "
-                                          << std::dec << +std::get<1>(iter->first) << ", "
-                                          << std::get<2>(iter->first) << ", "
-                                          << std::get<3>(iter->first) << ")");
-            iter = m_dups.erase(iter);
+            NS_LOG_LOGIC("Remove key = (" << std::hex << std::get<0>(key) << ", " << std::dec
+                                          << +std::get<1>(key) << ", " << std::get<2>(key)
+                                          << ", " << std::get<3>(key) << ")");
+            m_dups.erase(iter);
             ++n;
         }
-        else
-        {
-            ++iter;
-        }
+        m_dupExpiries.pop_front();
     }
 
     NS_LOG_DEBUG("Purged " << n << " expired duplicate entries out of " << (n + m_dups.size()));
@@ -1828,6 +1893,20 @@ Ipv4L3Protocol::RemoveDuplicates()
     }
 }
 
+size_t
+Ipv4L3Protocol::FragmentKeyHash::operator()(const FragmentKey_t& key) const
+{
+    return std::hash<uint64_t>()(key.first) ^ std::hash<uint32_t>()(key.second) * 0x9e3779b9;
+}
+
+size_t
+Ipv4L3Protocol::DupTupleHash::operator()(const DupTuple_t& tuple) const
+{
+    const auto& [hash, proto, src, dst] = tuple;
+    uint64_t addresses = uint64_t(src.Get()) << 32 | dst.Get();
+    return std::hash<uint64_t>()(hash ^ addresses) ^ std::hash<uint8_t>()(proto) * 0x9e3779b9;
+}
+
 Ipv4L3Protocol::FragmentsTimeoutsListI_t
 Ipv4L3Protocol::SetTimeout(FragmentKey_t key, Ipv4Header ipHeader, uint32_t iif)
 {
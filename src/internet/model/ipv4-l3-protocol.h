@@ -21,12 +21,16 @@
 #include "ns3/simulator.h"
 #include "ns3/traced-callback.h"
 
+#include <deque>
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 class Ipv4L3ProtocolTestCase;
+class Ipv4FragmentsTest;
+class Ipv4DuplicateExpiryTest;
 
 namespace ns3
 {
@@ -155,6 +159,25 @@ class Ipv4L3Protocol : public Ipv4
                  const Address& to,
                  NetDevice::PacketType packetType);
 
+    /**
+     * Lower layer calls this method to pass up a batch of packets received
+     * by a NetDevice, which are processed as if passed one by one to
+     * Receive, except that the work common to the whole batch, such as
+     * finding the receiving interface, is done only once.
+     * @param device network device
+     * @param packets the packets, in order of reception
+     * @param protocol protocol value
+     * @param from address of the correspondent
+     * @param to address of the destination
+     * @param packetType type of the packets
+     */
+    void ReceiveBatch(Ptr<NetDevice> device,
+                      const std::vector<Ptr<const Packet>>& packets,
+                      uint16_t protocol,
+                      const Address& from,
+                      const Address& to,
+                      NetDevice::PacketType packetType);
+
     /**
      * @param packet packet to send
      * @param source source address of packet
@@ -284,6 +307,10 @@ class Ipv4L3Protocol : public Ipv4
      * @relates Ipv4L3ProtocolTestCase
      */
     friend class ::Ipv4L3ProtocolTestCase;
+    /// allow Ipv4FragmentsTest class access
+    friend class ::Ipv4FragmentsTest;
+    /// allow Ipv4DuplicateExpiryTest class access
+    friend class ::Ipv4DuplicateExpiryTest;
 
     // class Ipv4 attributes
     void SetIpForward(bool forward) override;
@@ -319,6 +346,20 @@ class Ipv4L3Protocol : public Ipv4
                            uint8_t tos,
                            bool mayFragment);
 
+    /**
+     * @brief Process a packet received on an interface.
+     * @param device network device
+     * @param interface the index of the interface of the device
+     * @param p the packet
+     * @param from address of the correspondent
+     * @param checksumEnabled true if checksums are enabled
+     */
+    void ReceivePacket(Ptr<NetDevice> device,
+                       uint32_t interface,
+                       Ptr<const Packet> p,
+                       const Address& from,
+                       bool checksumEnabled);
+
     /**
      * @brief Send packet with route.
      * @param route route
@@ -370,6 +411,13 @@ class Ipv4L3Protocol : public Ipv4
      */
     uint32_t AddIpv4Interface(Ptr<Ipv4Interface> interface);
 
+    /**
+     * @brief Update the index of the node addresses with the current
+     * addresses of an interface.
+     * @param i interface index
+     */
+    void UpdateLocalAddresses(uint32_t i);
+
     /**
      * @brief Setup loopback interface.
      */
@@ -453,12 +501,21 @@ class Ipv4L3Protocol : public Ipv4
      */
     typedef std::map<L4ListKey_t, Ptr<IpL4Protocol>> L4List_t;
 
+    /**
+     * @brief Container of the interfaces owning an address, once per address.
+     */
+    typedef std::unordered_multimap<Ipv4Address, uint32_t, Ipv4AddressHash> AddressInterfaces_t;
+
     bool m_ipForward;               //!< Forwarding packets (i.e. router mode) state.
     bool m_strongEndSystemModel;    //!< Strong End System Model state
     L4List_t m_protocols;           //!< List of transport protocol.
     Ipv4InterfaceList m_interfaces; //!< List of IPv4 interfaces.
     Ipv4InterfaceReverseContainer
         m_reverseInterfacesContainer; //!< Container of NetDevice / Interface index associations.
+    AddressInterfaces_t m_localAddresses;     //!< Interfaces by local address
+    AddressInterfaces_t m_broadcastAddresses; //!< Interfaces by interface broadcast address
+    std::vector<std::vector<Ipv4InterfaceAddress>>
+        m_indexedAddresses; //!< Addresses of each interface in the above indexes
     uint8_t m_defaultTtl;             //!< Default TTL
     std::map<std::pair<uint64_t, uint8_t>, uint16_t>
         m_identification; //!< Identification (for each {src, dst, proto} tuple)
@@ -499,6 +556,19 @@ class Ipv4L3Protocol : public Ipv4
     /// Key identifying a fragmented packet
     typedef std::pair<uint64_t, uint32_t> FragmentKey_t;
 
+    /**
+     * @brief Hash function of the fragmented packets keys.
+     */
+    struct FragmentKeyHash
+    {
+        /**
+         * @brief Hash a key.
+         * @param key the key
+         * @return the hash
+         */
+        size_t operator()(const FragmentKey_t& key) const;
+    };
+
     /// Container for fragment timeouts.
     typedef std::list<std::tuple<Time, FragmentKey_t, Ipv4Header, uint32_t>>
         FragmentsTimeoutsList_t;
@@ -588,9 +658,24 @@ class Ipv4L3Protocol : public Ipv4
         bool m_moreFragment;
 
         /**
-         * @brief The current fragments.
+         * @brief The current fragments, by offset.
+         */
+        std::multimap<uint16_t, Ptr<Packet>> m_fragments;
+
+        /**
+         * @brief The 8-byte blocks of the packet entirely covered by the fragments.
+         */
+        std::vector<bool> m_blocks;
+
+        /**
+         * @brief The number of blocks covered by the fragments.
          */
-        std::list<std::pair<Ptr<Packet>, uint16_t>> m_fragments;
+        uint32_t m_coveredBlocks;
+
+        /**
+         * @brief The end offset of the packet, as far as it is known.
+         */
+        uint32_t m_endOffset;
 
         /**
          * @brief Timeout iterator to "event" handler
@@ -599,7 +684,7 @@ class Ipv4L3Protocol : public Ipv4
     };
 
     /// Container of fragments, stored as pairs(src+dst addr, src+dst port) / fragment
-    typedef std::map<FragmentKey_t, Ptr<Fragments>> MapFragments_t;
+    typedef std::unordered_map<FragmentKey_t, Ptr<Fragments>, FragmentKeyHash> MapFragments_t;
 
     MapFragments_t m_fragments;       //!< Fragmented packets.
     Time m_fragmentExpirationTimeout; //!< Expiration timeout
@@ -608,8 +693,24 @@ class Ipv4L3Protocol : public Ipv4
     /// RFC 6621 recommended duplicate packet tuple: {IPV hash, IP protocol, IP source address, IP
     /// destination address}
     typedef std::tuple<uint64_t, uint8_t, Ipv4Address, Ipv4Address> DupTuple_t;
+
+    /**
+     * @brief Hash function of the packet duplicate tuples.
+     */
+    struct DupTupleHash
+    {
+        /**
+         * @brief Hash a tuple.
+         * @param tuple the tuple
+         * @return the hash
+         */
+        size_t operator()(const DupTuple_t& tuple) const;
+    };
+
     /// Maps packet duplicate tuple to expiration time
-    typedef std::map<DupTuple_t, Time> DupMap_t;
+    typedef std::unordered_map<DupTuple_t, Time, DupTupleHash> DupMap_t;
+    /// Duplicate tuples in the order of their expiration, with their expiration time then
+    typedef std::deque<std::pair<Time, DupTuple_t>> DupExpiryQueue_t;
 
     /**
      * Registers duplicate entry, return false if new
@@ -623,11 +724,12 @@ class Ipv4L3Protocol : public Ipv4
      */
     void RemoveDuplicates();
 
-    bool m_enableDpd;   //!< Enable multicast duplicate packet detection
-    DupMap_t m_dups;    //!< map of packet duplicate tuples to expiry event
-    Time m_expire;      //!< duplicate entry expiration delay
-    Time m_purge;       //!< time between purging expired duplicate entries
-    EventId m_cleanDpd; //!< event to cleanup expired duplicate entries
+    bool m_enableDpd;               //!< Enable multicast duplicate packet detection
+    DupMap_t m_dups;                //!< map of packet duplicate tuples to expiry event
+    DupExpiryQueue_t m_dupExpiries; //!< duplicate tuples in the order of their expiration
+    Time m_expire;                  //!< duplicate entry expiration delay
+    Time m_purge;                   //!< time between purging expired duplicate entries
+    EventId m_cleanDpd;             //!< event to cleanup expired duplicate entries
 
     Ipv4RoutingProtocol::UnicastForwardCallback m_ucb;   ///< Unicast forward callback
     Ipv4RoutingProtocol::MulticastForwardCallback m_mcb; ///< Multicast forward callback
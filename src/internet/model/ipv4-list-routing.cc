@@ -73,6 +73,24 @@ Ipv4ListRouting::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit u
     }
 }
 
+uint64_t
+Ipv4ListRouting::GetRouteGeneration() const
+{
+    // The sum of the generations of the protocols changes whenever one of
+    // them changes, since they never decrease
+    uint64_t generation = m_routeGeneration;
+    for (const auto& [priority, protocol] : m_routingProtocols)
+    {
+        uint64_t protocolGeneration = protocol->GetRouteGeneration();
+        if (protocolGeneration == 0)
+        {
+            return 0;
+        }
+        generation += protocolGeneration;
+    }
+    return generation;
+}
+
 void
 Ipv4ListRouting::DoInitialize()
 {
@@ -242,6 +260,7 @@ Ipv4ListRouting::AddRoutingProtocol(Ptr<Ipv4RoutingProtocol> routingProtocol, in
     NS_LOG_FUNCTION(this << routingProtocol->GetInstanceTypeId() << priority);
     m_routingProtocols.emplace_back(priority, routingProtocol);
     m_routingProtocols.sort(Compare);
+    m_routeGeneration++;
     if (m_ipv4)
     {
         routingProtocol->SetIpv4(m_ipv4);
@@ -24,4 +24,54 @@ Ipv4RoutingProtocol::GetTypeId()
     return tid;
 }
 
+uint64_t
+Ipv4RoutingProtocol::GetRouteGeneration() const
+{
+    return 0;
+}
+
+Ptr<Ipv4Route>
+Ipv4RouteCache::RouteOutput(Ptr<Ipv4RoutingProtocol> routing,
+                            Ptr<Packet> p,
+                            const Ipv4Header& header,
+                            Ptr<NetDevice> oif,
+                            Socket::SocketErrno& sockerr)
+{
+    NS_LOG_FUNCTION(this << routing << p << &header << oif << &sockerr);
+    uint64_t generation = routing->GetRouteGeneration();
+    if (m_route && generation != 0 && generation == m_generation && routing == m_routing &&
+        header.GetDestination() == m_destination && header.GetSource() == m_source &&
+        oif == m_oif)
+    {
+        NS_LOG_LOGIC("Using the cached route " << *m_route);
+        sockerr = Socket::ERROR_NOTERROR;
+        return m_route;
+    }
+
+    Ptr<Ipv4Route> route = routing->RouteOutput(p, header, oif, sockerr);
+    if (route && generation != 0)
+    {
+        m_routing = routing;
+        m_generation = generation;
+        m_destination = header.GetDestination();
+        m_source = header.GetSource();
+        m_oif = oif;
+        m_route = route;
+    }
+    else
+    {
+        Flush();
+    }
+    return route;
+}
+
+void
+Ipv4RouteCache::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    m_routing = nullptr;
+    m_oif = nullptr;
+    m_route = nullptr;
+}
+
 } // namespace ns3
@@ -8,6 +8,7 @@
 
 #include "ipv4-header.h"
 #include "ipv4-interface-address.h"
+#include "ipv4-route.h"
 #include "ipv4.h"
 
 #include "ns3/callback.h"
@@ -21,7 +22,6 @@ namespace ns3
 {
 
 class Ipv4MulticastRoute;
-class Ipv4Route;
 class NetDevice;
 
 /**
@@ -170,6 +170,67 @@ class Ipv4RoutingProtocol : public Object
      */
     virtual void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                                    Time::Unit unit = Time::S) const = 0;
+
+    /**
+     * @brief Get the generation of the routes returned by RouteOutput()
+     *
+     * Protocols whose RouteOutput() only depends on the destination and
+     * source addresses of the header and on the output device, and has no
+     * side effect, let the sockets cache the routes it returns (see
+     * Ipv4RouteCache). Such protocols return a generation number, which
+     * they increment whenever the routes returned may change: when a route
+     * is added or removed, an interface goes up or down, or an address is
+     * added or removed.
+     *
+     * The default implementation returns zero, which forbids the caching.
+     *
+     * @returns the generation of the routes, or zero if they must not be cached
+     */
+    virtual uint64_t GetRouteGeneration() const;
+};
+
+/**
+ * @ingroup ipv4Routing
+ * @brief Cache of the route used by a socket to send its packets.
+ *
+ * The route returned by the routing protocol for a destination, a source
+ * address and an output device is reused for the following packets sent
+ * with the same parameters, as long as the generation of the routes of the
+ * protocol (see Ipv4RoutingProtocol::GetRouteGeneration) is unchanged.
+ */
+class Ipv4RouteCache
+{
+  public:
+    /**
+     * @brief Get the route for an outbound packet from the cache, or from
+     *        the routing protocol if the cached route is not valid
+     *
+     * @param routing the routing protocol
+     * @param p packet to be routed
+     * @param header input parameter, used to form key to search for the route
+     * @param oif output interface device. May be zero, or may be bound via
+     *            socket options to a particular output interface.
+     * @param sockerr output parameter; socket errno
+     * @returns a code that indicates what happened in the lookup
+     */
+    Ptr<Ipv4Route> RouteOutput(Ptr<Ipv4RoutingProtocol> routing,
+                               Ptr<Packet> p,
+                               const Ipv4Header& header,
+                               Ptr<NetDevice> oif,
+                               Socket::SocketErrno& sockerr);
+
+    /**
+     * @brief Remove the cached route
+     */
+    void Flush();
+
+  private:
+    Ptr<Ipv4RoutingProtocol> m_routing; //!< routing protocol which returned the route
+    uint64_t m_generation{0};           //!< generation of the routes of the protocol
+    Ipv4Address m_destination;          //!< destination of the packets
+    Ipv4Address m_source;               //!< source address of the packets, if set
+    Ptr<NetDevice> m_oif;               //!< output device requested
+    Ptr<Ipv4Route> m_route;             //!< route returned by the protocol
 };
 
 } // namespace ns3
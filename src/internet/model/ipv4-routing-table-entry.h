@@ -9,7 +9,9 @@
 #define IPV4_ROUTING_TABLE_ENTRY_H
 
 #include "ns3/ipv4-address.h"
+#include "ns3/object-accounting.h"
 
+#include <cstddef>
 #include <list>
 #include <ostream>
 #include <vector>
@@ -122,6 +124,8 @@ class Ipv4RoutingTableEntry
      */
     static Ipv4RoutingTableEntry CreateDefaultRoute(Ipv4Address nextHop, uint32_t interface);
 
+    NS_OBJECT_ACCOUNTING_ALLOCATION("ns3::Ipv4RoutingTableEntry", ObjectAccounting::HeapAllocator)
+
   private:
     /**
      * @brief Constructor.
@@ -240,6 +244,9 @@ class Ipv4MulticastRoutingTableEntry
         uint32_t inputInterface,
         std::vector<uint32_t> outputInterfaces);
 
+    NS_OBJECT_ACCOUNTING_ALLOCATION("ns3::Ipv4MulticastRoutingTableEntry",
+                                    ObjectAccounting::HeapAllocator)
+
   private:
     /**
      * @brief Constructor.
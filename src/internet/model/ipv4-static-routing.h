@@ -85,6 +85,7 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     void SetIpv4(Ptr<Ipv4> ipv4) override;
     void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                            Time::Unit unit = Time::S) const override;
+    uint64_t GetRouteGeneration() const override;
 
     /**
      * @brief Add a network route to the static routing table.
@@ -409,6 +410,11 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      * @brief Ipv4 reference.
      */
     Ptr<Ipv4> m_ipv4;
+
+    /**
+     * @brief Generation of the routes, incremented whenever they may change.
+     */
+    uint64_t m_routeGeneration{1};
 };
 
 } // Namespace ns3
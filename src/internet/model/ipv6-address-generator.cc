@@ -12,7 +12,8 @@
 #include "ns3/log.h"
 #include "ns3/simulation-singleton.h"
 
-#include <list>
+#include <iterator>
+#include <map>
 
 namespace ns3
 {
@@ -151,6 +152,13 @@ class Ipv6AddressGeneratorImpl
      */
     uint32_t PrefixToIndex(Ipv6Prefix prefix) const;
 
+    /**
+     * @brief Get the address following an address
+     * @param address the address, which must not be the highest address
+     * @returns the following address
+     */
+    static Ipv6Address GetNextAddress(Ipv6Address address);
+
     /**
      * @brief This class holds the state for a given network
      */
@@ -167,18 +175,14 @@ class Ipv6AddressGeneratorImpl
     NetworkState m_netTable[N_BITS]; //!< the available networks
 
     /**
-     * @brief This class holds the allocated addresses
+     * @brief The allocated addresses, as ranges of consecutive addresses, each
+     * indexed by its lowest address and holding its highest address, so that
+     * finding the range an address belongs to, or may extend, is logarithmic
+     * in the number of ranges.
      */
-    class Entry
-    {
-      public:
-        uint8_t addrLow[16];  //!< the lowest allocated address
-        uint8_t addrHigh[16]; //!< the highest allocated address
-    };
-
-    std::list<Entry> m_entries; //!< contained of allocated addresses
-    Ipv6Address m_base;         //!< base address
-    bool m_test;                //!< test mode (if true)
+    std::map<Ipv6Address, Ipv6Address> m_entries;
+    Ipv6Address m_base; //!< base address
+    bool m_test;        //!< test mode (if true)
 };
 
 Ipv6AddressGeneratorImpl::Ipv6AddressGeneratorImpl()
@@ -449,116 +453,52 @@ Ipv6AddressGeneratorImpl::AddAllocated(const Ipv6Address address)
 {
     NS_LOG_FUNCTION(this << address);
 
-    uint8_t addr[16];
-    address.GetBytes(addr);
-
-    std::list<Entry>::iterator i;
-
-    for (i = m_entries.begin(); i != m_entries.end(); ++i)
+    //
+    // The only range which may hold the new address, or be extended up to
+    // include it, is the last range starting at or below it.  The only range
+    // which may be extended down to include it is the next one.
+    //
+    auto next = m_entries.upper_bound(address);
+    auto prev = m_entries.end();
+    if (next != m_entries.begin())
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv6Address((*i).addrLow) << " to "
-                                       << Ipv6Address((*i).addrHigh));
-        //
-        // First things first.  Is there an address collision -- that is, does the
-        // new address fall in a previously allocated block of addresses.
-        //
-        if (!(Ipv6Address(addr) < Ipv6Address((*i).addrLow)) &&
-            ((Ipv6Address(addr) < Ipv6Address((*i).addrHigh)) ||
-             (Ipv6Address(addr) == Ipv6Address((*i).addrHigh))))
+        prev = std::prev(next);
+        NS_LOG_LOGIC("examine entry: " << prev->first << " to " << prev->second);
+        if (!(prev->second < address))
         {
-            NS_LOG_LOGIC(
-                "Ipv6AddressGeneratorImpl::Add(): Address Collision: " << Ipv6Address(addr));
+            NS_LOG_LOGIC("Ipv6AddressGeneratorImpl::Add(): Address Collision: " << address);
             if (!m_test)
             {
-                NS_FATAL_ERROR(
-                    "Ipv6AddressGeneratorImpl::Add(): Address Collision: " << Ipv6Address(addr));
+                NS_FATAL_ERROR("Ipv6AddressGeneratorImpl::Add(): Address Collision: " << address);
             }
             return false;
         }
-        //
-        // If the new address is less than the lowest address in the current
-        // block and can't be merged into to the current block, then insert it
-        // as a new block before the current block.
-        //
-        uint8_t taddr[16];
-        for (uint32_t j = 0; j < 16; j++)
-        {
-            taddr[j] = (*i).addrLow[j];
-        }
-        taddr[15] -= 1;
-        if (Ipv6Address(addr) < Ipv6Address(taddr))
-        {
-            break;
-        }
-        //
-        // If the new address fits at the end of the block, look ahead to the next
-        // block and make sure it's not a collision there.  If we won't overlap,
-        // then just extend the current block by one address.  We expect that
-        // completely filled network ranges will be a fairly rare occurrence,
-        // so we don't worry about collapsing address range blocks.
-        //
-        for (uint32_t j = 0; j < 16; j++)
-        {
-            taddr[j] = (*i).addrLow[j];
-        }
-        taddr[15] += 1;
-        if (Ipv6Address(addr) == Ipv6Address(taddr))
-        {
-            auto j = i;
-            ++j;
-
-            if (j != m_entries.end())
-            {
-                if (Ipv6Address(addr) == Ipv6Address((*j).addrLow))
-                {
-                    NS_LOG_LOGIC("Ipv6AddressGeneratorImpl::Add(): "
-                                 "Address Collision: "
-                                 << Ipv6Address(addr));
-                    if (!m_test)
-                    {
-                        NS_FATAL_ERROR("Ipv6AddressGeneratorImpl::Add(): Address Collision: "
-                                       << Ipv6Address(addr));
-                    }
-                    return false;
-                }
-            }
-
-            NS_LOG_LOGIC("New addrHigh = " << Ipv6Address(addr));
-            for (uint32_t j = 0; j < 16; j++)
-            {
-                (*i).addrHigh[j] = addr[j];
-            }
-            return true;
-        }
-        //
-        // If we get here, we know that the next lower block of addresses
-        // couldn't have been extended to include this new address since the
-        // code immediately above would have been executed and that next lower
-        // block extended upward.  So we know it's safe to extend the current
-        // block down to include the new address.
-        //
-        for (uint32_t j = 0; j < 16; j++)
-        {
-            taddr[j] = (*i).addrLow[j];
-        }
-        taddr[15] -= 1;
-        if (Ipv6Address(addr) == Ipv6Address(taddr))
-        {
-            NS_LOG_LOGIC("New addrLow = " << Ipv6Address(addr));
-            for (uint32_t j = 0; j < 16; j++)
-            {
-                (*i).addrLow[j] = addr[j];
-            }
-            return true;
-        }
     }
 
-    Entry entry;
-    for (uint32_t j = 0; j < 16; j++)
+    bool extendPrev = (prev != m_entries.end() && GetNextAddress(prev->second) == address);
+    bool extendNext = (next != m_entries.end() && GetNextAddress(address) == next->first);
+    if (extendPrev && extendNext)
     {
-        entry.addrLow[j] = entry.addrHigh[j] = addr[j];
+        NS_LOG_LOGIC("Merge " << prev->first << " to " << next->second);
+        prev->second = next->second;
+        m_entries.erase(next);
+    }
+    else if (extendPrev)
+    {
+        NS_LOG_LOGIC("New addrHigh = " << address);
+        prev->second = address;
+    }
+    else if (extendNext)
+    {
+        NS_LOG_LOGIC("New addrLow = " << address);
+        Ipv6Address addrHigh = next->second;
+        next = m_entries.erase(next);
+        m_entries.emplace_hint(next, address, addrHigh);
+    }
+    else
+    {
+        m_entries.emplace_hint(next, address, address);
     }
-    m_entries.insert(i, entry);
     return true;
 }
 
@@ -567,20 +507,15 @@ Ipv6AddressGeneratorImpl::IsAddressAllocated(const Ipv6Address address)
 {
     NS_LOG_FUNCTION(this << address);
 
-    uint8_t addr[16];
-    address.GetBytes(addr);
-
-    for (auto i = m_entries.begin(); i != m_entries.end(); ++i)
+    auto i = m_entries.upper_bound(address);
+    if (i != m_entries.begin())
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv6Address((*i).addrLow) << " to "
-                                       << Ipv6Address((*i).addrHigh));
-
-        if (!(Ipv6Address(addr) < Ipv6Address((*i).addrLow)) &&
-            ((Ipv6Address(addr) < Ipv6Address((*i).addrHigh)) ||
-             (Ipv6Address(addr) == Ipv6Address((*i).addrHigh))))
+        --i;
+        NS_LOG_LOGIC("examine entry: " << i->first << " to " << i->second);
+        if (!(i->second < address))
         {
-            NS_LOG_LOGIC("Ipv6AddressGeneratorImpl::IsAddressAllocated(): Address Collision: "
-                         << Ipv6Address(addr));
+            NS_LOG_LOGIC(
+                "Ipv6AddressGeneratorImpl::IsAddressAllocated(): Address Collision: " << address);
             return true;
         }
     }
@@ -597,18 +532,28 @@ Ipv6AddressGeneratorImpl::IsNetworkAllocated(const Ipv6Address address, const Ip
         "Ipv6AddressGeneratorImpl::IsNetworkAllocated(): network address and mask don't match "
             << address << " " << prefix);
 
-    for (auto i = m_entries.begin(); i != m_entries.end(); ++i)
+    //
+    // The network is allocated if the last range starting at or below its
+    // highest address ends at or above its lowest address.
+    //
+    uint8_t addr[16];
+    uint8_t mask[16];
+    address.GetBytes(addr);
+    prefix.GetBytes(mask);
+    for (uint32_t j = 0; j < 16; j++)
     {
-        NS_LOG_LOGIC("examine entry: " << Ipv6Address((*i).addrLow) << " to "
-                                       << Ipv6Address((*i).addrHigh));
-        Ipv6Address low = Ipv6Address((*i).addrLow);
-        Ipv6Address high = Ipv6Address((*i).addrHigh);
-
-        if (address == low.CombinePrefix(prefix) || address == high.CombinePrefix(prefix))
+        addr[j] |= ~mask[j];
+    }
+    auto i = m_entries.upper_bound(Ipv6Address(addr));
+    if (i != m_entries.begin())
+    {
+        --i;
+        NS_LOG_LOGIC("examine entry: " << i->first << " to " << i->second);
+        if (!(i->second < address))
         {
             NS_LOG_LOGIC(
                 "Ipv6AddressGeneratorImpl::IsNetworkAllocated(): Network already allocated: "
-                << address << " " << low << "-" << high);
+                << address << " " << i->first << "-" << i->second);
             return false;
         }
     }
@@ -622,6 +567,21 @@ Ipv6AddressGeneratorImpl::TestMode()
     m_test = true;
 }
 
+Ipv6Address
+Ipv6AddressGeneratorImpl::GetNextAddress(Ipv6Address address)
+{
+    uint8_t addr[16];
+    address.GetBytes(addr);
+    for (uint32_t j = 16; j-- > 0;)
+    {
+        if (++addr[j] != 0)
+        {
+            break;
+        }
+    }
+    return Ipv6Address(addr);
+}
+
 uint32_t
 Ipv6AddressGeneratorImpl::PrefixToIndex(Ipv6Prefix prefix) const
 {
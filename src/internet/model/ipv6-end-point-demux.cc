@@ -12,6 +12,8 @@
 
 #include "ns3/log.h"
 
+#include <algorithm>
+
 namespace ns3
 {
 
@@ -31,29 +33,52 @@ Ipv6EndPointDemux::~Ipv6EndPointDemux()
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         Ipv6EndPoint* endPoint = *i;
+        endPoint->m_demux = nullptr;
         delete endPoint;
     }
     m_endPoints.clear();
+    m_positions.clear();
+    m_connected.clear();
+    m_unconnected.clear();
+    m_localPorts.clear();
 }
 
 bool
 Ipv6EndPointDemux::LookupPortLocal(uint16_t port)
 {
     NS_LOG_FUNCTION(this << port);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        if ((*i)->GetLocalPort() == port)
-        {
-            return true;
-        }
-    }
-    return false;
+    return m_localPorts.contains(port);
 }
 
 bool
 Ipv6EndPointDemux::LookupLocal(Ptr<NetDevice> boundNetDevice, Ipv6Address addr, uint16_t port)
 {
     NS_LOG_FUNCTION(this << addr << port);
+    auto count = m_localPorts.find(port);
+    if (count == m_localPorts.end())
+    {
+        return false;
+    }
+
+    uint32_t unconnected = 0;
+    EndPointBucket* bucket = FindUnconnected(port);
+    if (bucket)
+    {
+        for (auto endP : *bucket)
+        {
+            if (endP->GetLocalAddress() == addr && endP->GetBoundNetDevice() == boundNetDevice)
+            {
+                return true;
+            }
+        }
+        unconnected = bucket->size();
+    }
+    if (count->second == unconnected)
+    {
+        return false;
+    }
+
+    // Connected end points are not indexed by local port alone.
     for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
     {
         if ((*i)->GetLocalPort() == port && (*i)->GetLocalAddress() == addr &&
@@ -76,7 +101,7 @@ Ipv6EndPointDemux::Allocate()
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(Ipv6Address::GetAny(), port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -92,7 +117,7 @@ Ipv6EndPointDemux::Allocate(Ipv6Address address)
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -115,7 +140,7 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice, Ipv6Address address,
         return nullptr;
     }
     auto endPoint = new Ipv6EndPoint(address, port);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
     return endPoint;
 }
@@ -128,19 +153,24 @@ Ipv6EndPointDemux::Allocate(Ptr<NetDevice> boundNetDevice,
                             uint16_t peerPort)
 {
     NS_LOG_FUNCTION(this << boundNetDevice << localAddress << localPort << peerAddress << peerPort);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto endPoint = new Ipv6EndPoint(localAddress, localPort);
+    endPoint->SetPeer(peerAddress, peerPort);
+    EndPointBucket* bucket = FindBucket(endPoint);
+    if (bucket)
     {
-        if ((*i)->GetLocalPort() == localPort && (*i)->GetLocalAddress() == localAddress &&
-            (*i)->GetPeerPort() == peerPort && (*i)->GetPeerAddress() == peerAddress &&
-            ((*i)->GetBoundNetDevice() == boundNetDevice || !(*i)->GetBoundNetDevice()))
+        for (auto endP : *bucket)
         {
-            NS_LOG_WARN("Duplicated endpoint.");
-            return nullptr;
+            if (endP->GetLocalPort() == localPort && endP->GetLocalAddress() == localAddress &&
+                endP->GetPeerPort() == peerPort && endP->GetPeerAddress() == peerAddress &&
+                (endP->GetBoundNetDevice() == boundNetDevice || !endP->GetBoundNetDevice()))
+            {
+                NS_LOG_WARN("Duplicated endpoint.");
+                delete endPoint;
+                return nullptr;
+            }
         }
     }
-    auto endPoint = new Ipv6EndPoint(localAddress, localPort);
-    endPoint->SetPeer(peerAddress, peerPort);
-    m_endPoints.push_back(endPoint);
+    Insert(endPoint);
 
     NS_LOG_DEBUG("Now have >>" << m_endPoints.size() << "<< endpoints.");
 
@@ -151,15 +181,16 @@ void
 Ipv6EndPointDemux::DeAllocate(Ipv6EndPoint* endPoint)
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
+    auto position = m_positions.find(endPoint);
+    if (position == m_positions.end())
     {
-        if (*i == endPoint)
-        {
-            delete endPoint;
-            m_endPoints.erase(i);
-            break;
-        }
+        return;
     }
+    Unindex(endPoint);
+    m_endPoints.erase(position->second);
+    m_positions.erase(position);
+    endPoint->m_demux = nullptr;
+    delete endPoint;
 }
 
 /*
@@ -182,92 +213,101 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
     EndPoints retval4; /* Exact match on all 4 */
 
     NS_LOG_DEBUG("Looking up endpoint for destination address " << daddr);
-    for (auto i = m_endPoints.begin(); i != m_endPoints.end(); i++)
-    {
-        Ipv6EndPoint* endP = *i;
 
-        NS_LOG_DEBUG("Looking at endpoint dport="
-                     << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
-                     << " sport=" << endP->GetPeerPort() << " saddr=" << endP->GetPeerAddress());
-
-        if (!endP->IsRxEnabled())
+    // Only the end points connected to the source of the packet and the
+    // unconnected ones bound to the destination port can match.
+    for (EndPointBucket* bucket : {FindConnected(saddr, sport, dport), FindUnconnected(dport)})
+    {
+        if (!bucket)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP
-                                              << " because endpoint can not receive packets");
             continue;
         }
-
-        if (endP->GetLocalPort() != dport)
+        for (Ipv6EndPoint* endP : *bucket)
         {
-            NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
-                                              << endP->GetLocalPort()
-                                              << " does not match packet dport " << dport);
-            continue;
-        }
+            NS_LOG_DEBUG("Looking at endpoint dport="
+                         << endP->GetLocalPort() << " daddr=" << endP->GetLocalAddress()
+                         << " sport=" << endP->GetPeerPort()
+                         << " saddr=" << endP->GetPeerAddress());
 
-        if (endP->GetBoundNetDevice())
-        {
-            if (!incomingInterface)
+            if (!endP->IsRxEnabled())
             {
+                NS_LOG_LOGIC("Skipping endpoint " << &endP
+                                                  << " because endpoint can not receive packets");
                 continue;
             }
-            if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+
+            if (endP->GetLocalPort() != dport)
             {
-                NS_LOG_LOGIC("Skipping endpoint "
-                             << &endP << " because endpoint is bound to specific device and"
-                             << endP->GetBoundNetDevice() << " does not match packet device "
-                             << incomingInterface->GetDevice());
+                NS_LOG_LOGIC("Skipping endpoint " << &endP << " because endpoint dport "
+                                                  << endP->GetLocalPort()
+                                                  << " does not match packet dport " << dport);
                 continue;
             }
-        }
 
-        /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
-        NS_LOG_DEBUG("dest addr " << daddr);
+            if (endP->GetBoundNetDevice())
+            {
+                if (!incomingInterface)
+                {
+                    continue;
+                }
+                if (endP->GetBoundNetDevice() != incomingInterface->GetDevice())
+                {
+                    NS_LOG_LOGIC("Skipping endpoint "
+                                 << &endP << " because endpoint is bound to specific device and"
+                                 << endP->GetBoundNetDevice() << " does not match packet device "
+                                 << incomingInterface->GetDevice());
+                    continue;
+                }
+            }
 
-        bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
-        bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
-        bool localAddressMatchesAllRouters =
-            endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
+            /*    Ipv6Address incomingInterfaceAddr = incomingInterface->GetAddress (); */
+            NS_LOG_DEBUG("dest addr " << daddr);
 
-        /* if no match here, keep looking */
-        if (!(localAddressMatchesExact || localAddressMatchesWildCard))
-        {
-            continue;
-        }
-        bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
-        bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
-        bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
-        bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
-
-        /* If remote does not match either with exact or wildcard,i
-           skip this one */
-        if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
-        {
-            continue;
-        }
-        if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
-        {
-            continue;
-        }
+            bool localAddressMatchesWildCard = endP->GetLocalAddress() == Ipv6Address::GetAny();
+            bool localAddressMatchesExact = endP->GetLocalAddress() == daddr;
+            bool localAddressMatchesAllRouters =
+                endP->GetLocalAddress() == Ipv6Address::GetAllRoutersMulticast();
 
-        /* Now figure out which return list to add this one to */
-        if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
-            remoteAddressMatchesWildCard)
-        { /* Only local port matches exactly */
-            retval1.push_back(endP);
-        }
-        if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
-            remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
-        { /* Only local port and local address matches exactly */
-            retval2.push_back(endP);
-        }
-        if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All but local address */
-            retval3.push_back(endP);
-        }
-        if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
-        { /* All 4 match */
-            retval4.push_back(endP);
+            /* if no match here, keep looking */
+            if (!(localAddressMatchesExact || localAddressMatchesWildCard))
+            {
+                continue;
+            }
+            bool remotePeerMatchesExact = endP->GetPeerPort() == sport;
+            bool remotePeerMatchesWildCard = endP->GetPeerPort() == 0;
+            bool remoteAddressMatchesExact = endP->GetPeerAddress() == saddr;
+            bool remoteAddressMatchesWildCard = endP->GetPeerAddress() == Ipv6Address::GetAny();
+
+            /* If remote does not match either with exact or wildcard,i
+               skip this one */
+            if (!(remotePeerMatchesExact || remotePeerMatchesWildCard))
+            {
+                continue;
+            }
+            if (!(remoteAddressMatchesExact || remoteAddressMatchesWildCard))
+            {
+                continue;
+            }
+
+            /* Now figure out which return list to add this one to */
+            if (localAddressMatchesWildCard && remotePeerMatchesWildCard &&
+                remoteAddressMatchesWildCard)
+            { /* Only local port matches exactly */
+                retval1.push_back(endP);
+            }
+            if ((localAddressMatchesExact || (localAddressMatchesAllRouters)) &&
+                remotePeerMatchesWildCard && remoteAddressMatchesWildCard)
+            { /* Only local port and local address matches exactly */
+                retval2.push_back(endP);
+            }
+            if (localAddressMatchesWildCard && remotePeerMatchesExact && remoteAddressMatchesExact)
+            { /* All but local address */
+                retval3.push_back(endP);
+            }
+            if (localAddressMatchesExact && remotePeerMatchesExact && remoteAddressMatchesExact)
+            { /* All 4 match */
+                retval4.push_back(endP);
+            }
         }
     }
 
@@ -299,6 +339,19 @@ Ipv6EndPointDemux::Lookup(Ipv6Address daddr,
 Ipv6EndPoint*
 Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src, uint16_t sport)
 {
+    EndPointBucket* bucket = FindConnected(src, sport, dport);
+    if (bucket)
+    {
+        for (auto endP : *bucket)
+        {
+            if (endP->GetLocalAddress() == dst)
+            {
+                /* this is an exact match. */
+                return endP;
+            }
+        }
+    }
+
     uint32_t genericity = 3;
     Ipv6EndPoint* generic = nullptr;
 
@@ -337,6 +390,101 @@ Ipv6EndPointDemux::SimpleLookup(Ipv6Address dst, uint16_t dport, Ipv6Address src
     return generic;
 }
 
+void
+Ipv6EndPointDemux::Insert(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    endPoint->m_demux = this;
+    m_positions[endPoint] = m_endPoints.insert(m_endPoints.end(), endPoint);
+    Index(endPoint);
+}
+
+void
+Ipv6EndPointDemux::Index(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    m_localPorts[endPoint->GetLocalPort()]++;
+    if (IsConnected(endPoint))
+    {
+        ConnectedKey key{endPoint->GetPeerAddress(),
+                         endPoint->GetPeerPort(),
+                         endPoint->GetLocalPort()};
+        m_connected[key].push_back(endPoint);
+    }
+    else
+    {
+        m_unconnected[endPoint->GetLocalPort()].push_back(endPoint);
+    }
+}
+
+void
+Ipv6EndPointDemux::Unindex(Ipv6EndPoint* endPoint)
+{
+    NS_LOG_FUNCTION(this << endPoint);
+    auto count = m_localPorts.find(endPoint->GetLocalPort());
+    NS_ASSERT(count != m_localPorts.end());
+    if (--count->second == 0)
+    {
+        m_localPorts.erase(count);
+    }
+
+    EndPointBucket* bucket = FindBucket(endPoint);
+    NS_ASSERT(bucket);
+    bucket->erase(std::find(bucket->begin(), bucket->end(), endPoint));
+    if (bucket->empty())
+    {
+        if (IsConnected(endPoint))
+        {
+            m_connected.erase(ConnectedKey{endPoint->GetPeerAddress(),
+                                           endPoint->GetPeerPort(),
+                                           endPoint->GetLocalPort()});
+        }
+        else
+        {
+            m_unconnected.erase(endPoint->GetLocalPort());
+        }
+    }
+}
+
+Ipv6EndPointDemux::EndPointBucket*
+Ipv6EndPointDemux::FindBucket(Ipv6EndPoint* endPoint)
+{
+    if (IsConnected(endPoint))
+    {
+        return FindConnected(endPoint->GetPeerAddress(),
+                             endPoint->GetPeerPort(),
+                             endPoint->GetLocalPort());
+    }
+    return FindUnconnected(endPoint->GetLocalPort());
+}
+
+Ipv6EndPointDemux::EndPointBucket*
+Ipv6EndPointDemux::FindConnected(Ipv6Address peerAddress, uint16_t peerPort, uint16_t localPort)
+{
+    auto it = m_connected.find(ConnectedKey{peerAddress, peerPort, localPort});
+    return it != m_connected.end() ? &it->second : nullptr;
+}
+
+Ipv6EndPointDemux::EndPointBucket*
+Ipv6EndPointDemux::FindUnconnected(uint16_t localPort)
+{
+    auto it = m_unconnected.find(localPort);
+    return it != m_unconnected.end() ? &it->second : nullptr;
+}
+
+bool
+Ipv6EndPointDemux::IsConnected(const Ipv6EndPoint* endPoint)
+{
+    return endPoint->GetPeerPort() != 0 && endPoint->GetPeerAddress() != Ipv6Address::GetAny();
+}
+
+size_t
+Ipv6EndPointDemux::ConnectedKeyHash::operator()(const ConnectedKey& key) const
+{
+    uint32_t ports = (static_cast<uint32_t>(key.peerPort) << 16) | key.localPort;
+    return Ipv6AddressHash()(key.peerAddress) ^ std::hash<uint32_t>()(ports) * 0x9e3779b9;
+}
+
 uint16_t
 Ipv6EndPointDemux::AllocateEphemeralPort()
 {
@@ -15,6 +15,8 @@
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -25,6 +27,11 @@ class Ipv6EndPoint;
  * @ingroup ipv6
  *
  * @brief Demultiplexer for end points.
+ *
+ * As in Ipv4EndPointDemux, end points with a known peer address and port are
+ * hashed on the peer address, the peer port and the local port, and the other
+ * ones on their local port, so that a packet is only matched against the end
+ * points found in these two buckets.
  */
 class Ipv6EndPointDemux
 {
@@ -150,12 +157,100 @@ class Ipv6EndPointDemux
     EndPoints GetEndPoints() const;
 
   private:
+    friend class Ipv6EndPoint;
+
+    /**
+     * @brief Container of the IPv6 end points sharing the same index key.
+     */
+    typedef std::vector<Ipv6EndPoint*> EndPointBucket;
+
+    /**
+     * @brief Key of the connected end points index.
+     */
+    struct ConnectedKey
+    {
+        Ipv6Address peerAddress; //!< Peer address
+        uint16_t peerPort;       //!< Peer port
+        uint16_t localPort;      //!< Local port
+
+        /**
+         * @brief Equality operator.
+         * @param other the key to compare to
+         * @return true if both keys are equal
+         */
+        bool operator==(const ConnectedKey& other) const = default;
+    };
+
+    /**
+     * @brief Hash function of the connected end points index.
+     */
+    struct ConnectedKeyHash
+    {
+        /**
+         * @brief Hash a key.
+         * @param key the key
+         * @return the hash
+         */
+        size_t operator()(const ConnectedKey& key) const;
+    };
+
     /**
      * @brief Allocate a ephemeral port.
      * @return a port
      */
     uint16_t AllocateEphemeralPort();
 
+    /**
+     * @brief Add an end point to the list of end points and to the index.
+     * @param endPoint the end point
+     */
+    void Insert(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Add an end point to the index, according to its current
+     * local port and peer.
+     * @param endPoint the end point
+     */
+    void Index(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Remove an end point from the index.
+     *
+     * Must be called before the local port or peer of the end point change.
+     * @param endPoint the end point
+     */
+    void Unindex(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Get the bucket of the index an end point is stored in.
+     * @param endPoint the end point
+     * @return the bucket, nullptr if the bucket does not exist
+     */
+    EndPointBucket* FindBucket(Ipv6EndPoint* endPoint);
+
+    /**
+     * @brief Get the bucket of connected end points for a peer and local port.
+     * @param peerAddress the peer address
+     * @param peerPort the peer port
+     * @param localPort the local port
+     * @return the bucket, nullptr if there are no such end points
+     */
+    EndPointBucket* FindConnected(Ipv6Address peerAddress, uint16_t peerPort, uint16_t localPort);
+
+    /**
+     * @brief Get the bucket of unconnected end points for a local port.
+     * @param localPort the local port
+     * @return the bucket, nullptr if there are no such end points
+     */
+    EndPointBucket* FindUnconnected(uint16_t localPort);
+
+    /**
+     * @brief Check whether an end point is indexed as a connected end point.
+     * @param endPoint the end point
+     * @return true if both the peer address and port of the end point are set
+     */
+    static bool IsConnected(const Ipv6EndPoint* endPoint);
+
     /**
      * @brief The ephemeral port.
      */
@@ -175,6 +270,26 @@ class Ipv6EndPointDemux
      * @brief A list of IPv6 end points.
      */
     EndPoints m_endPoints;
+
+    /**
+     * @brief Position of each end point in the list of end points.
+     */
+    std::unordered_map<Ipv6EndPoint*, EndPointsI> m_positions;
+
+    /**
+     * @brief Connected end points, indexed by peer address, peer port and local port.
+     */
+    std::unordered_map<ConnectedKey, EndPointBucket, ConnectedKeyHash> m_connected;
+
+    /**
+     * @brief Unconnected end points, indexed by local port.
+     */
+    std::unordered_map<uint16_t, EndPointBucket> m_unconnected;
+
+    /**
+     * @brief Number of end points using each local port.
+     */
+    std::unordered_map<uint16_t, uint32_t> m_localPorts;
 };
 
 } /* namespace ns3 */
@@ -22,6 +22,7 @@ namespace ns3
 {
 
 class Header;
+class Ipv6EndPointDemux;
 class Packet;
 
 /**
@@ -184,6 +185,13 @@ class Ipv6EndPoint
     bool IsRxEnabled() const;
 
   private:
+    friend class Ipv6EndPointDemux;
+
+    /**
+     * @brief The demux this endpoint was allocated by and is indexed in, if any.
+     */
+    Ipv6EndPointDemux* m_demux;
+
     /**
      * @brief The local address.
      */
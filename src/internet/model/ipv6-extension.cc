@@ -655,6 +655,12 @@ Ipv6ExtensionFragment::HandleFragmentsTimeout(FragmentKey_t fragmentKey, Ipv6Hea
     m_fragments.erase(fragmentKey);
 }
 
+size_t
+Ipv6ExtensionFragment::FragmentKeyHash::operator()(const FragmentKey_t& key) const
+{
+    return Ipv6AddressHash()(key.first) ^ std::hash<uint32_t>()(key.second) * 0x9e3779b9;
+}
+
 Ipv6ExtensionFragment::FragmentsTimeoutsListI_t
 Ipv6ExtensionFragment::SetTimeout(FragmentKey_t key, Ipv6Header ipHeader)
 {
@@ -709,7 +715,10 @@ Ipv6ExtensionFragment::HandleTimeout()
 }
 
 Ipv6ExtensionFragment::Fragments::Fragments()
-    : m_moreFragment(false)
+    : m_moreFragment(false),
+      m_coveredBytes(0),
+      m_endOffset(0),
+      m_overlapping(false)
 {
 }
 
@@ -723,22 +732,32 @@ Ipv6ExtensionFragment::Fragments::AddFragment(Ptr<Packet> fragment,
                                               bool moreFragment)
 {
     NS_LOG_FUNCTION(this << fragment << fragmentOffset << moreFragment);
-    std::list<std::pair<Ptr<Packet>, uint16_t>>::iterator it;
+    // fragments at the same offset are kept in their order of arrival
+    auto it = m_packetFragments.emplace(fragmentOffset, fragment);
+    uint32_t fragmentEnd = fragmentOffset + fragment->GetSize();
 
-    for (it = m_packetFragments.begin(); it != m_packetFragments.end(); it++)
+    // the fragments received so far do not overlap, hence the fragment
+    // overlaps one of them only if it overlaps one of its neighbors
+    if (it != m_packetFragments.begin())
     {
-        if (it->second > fragmentOffset)
+        auto previous = std::prev(it);
+        if (previous->first + previous->second->GetSize() > fragmentOffset)
         {
-            break;
+            m_overlapping = true;
         }
     }
-
-    if (it == m_packetFragments.end())
+    auto next = std::next(it);
+    if (next == m_packetFragments.end())
     {
         m_moreFragment = moreFragment;
     }
+    else if (fragmentEnd > next->first)
+    {
+        m_overlapping = true;
+    }
 
-    m_packetFragments.insert(it, std::pair<Ptr<Packet>, uint16_t>(fragment, fragmentOffset));
+    m_coveredBytes += fragment->GetSize();
+    m_endOffset = std::max(m_endOffset, fragmentEnd);
 }
 
 void
@@ -751,25 +770,10 @@ Ipv6ExtensionFragment::Fragments::SetUnfragmentablePart(Ptr<Packet> unfragmentab
 bool
 Ipv6ExtensionFragment::Fragments::IsEntire() const
 {
-    bool ret = !m_moreFragment && !m_packetFragments.empty();
-
-    if (ret)
-    {
-        uint16_t lastEndOffset = 0;
-
-        for (auto it = m_packetFragments.begin(); it != m_packetFragments.end(); it++)
-        {
-            if (lastEndOffset != it->second)
-            {
-                ret = false;
-                break;
-            }
-
-            lastEndOffset += it->first->GetSize();
-        }
-    }
-
-    return ret;
+    // Without overlaps, the fragments cover the whole packet if their sizes
+    // add up to its end. Overlapping fragments are never reassembled (RFC 8200).
+    return !m_moreFragment && !m_packetFragments.empty() && !m_overlapping &&
+           m_coveredBytes == m_endOffset;
 }
 
 Ptr<Packet>
@@ -779,7 +783,7 @@ Ipv6ExtensionFragment::Fragments::GetPacket() const
 
     for (auto it = m_packetFragments.begin(); it != m_packetFragments.end(); it++)
     {
-        p->AddAtEnd(it->first);
+        p->AddAtEnd(it->second);
     }
 
     return p;
@@ -803,12 +807,12 @@ Ipv6ExtensionFragment::Fragments::GetPartialPacket() const
 
     for (auto it = m_packetFragments.begin(); it != m_packetFragments.end(); it++)
     {
-        if (lastEndOffset != it->second)
+        if (lastEndOffset != it->first)
         {
             break;
         }
-        p->AddAtEnd(it->first);
-        lastEndOffset += it->first->GetSize();
+        p->AddAtEnd(it->second);
+        lastEndOffset += it->second->GetSize();
     }
 
     return p;
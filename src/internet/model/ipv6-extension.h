@@ -26,6 +26,9 @@
 #include <list>
 #include <map>
 #include <tuple>
+#include <unordered_map>
+
+class Ipv6FragmentsTest;
 
 namespace ns3
 {
@@ -310,11 +313,27 @@ class Ipv6ExtensionFragment : public Ipv6Extension
     void DoDispose() override;
 
   private:
+    /// allow Ipv6FragmentsTest class access
+    friend class ::Ipv6FragmentsTest;
+
     /**
      * Key identifying a fragmented packet
      */
     typedef std::pair<Ipv6Address, uint32_t> FragmentKey_t;
 
+    /**
+     * @brief Hash function of the fragmented packets keys.
+     */
+    struct FragmentKeyHash
+    {
+        /**
+         * @brief Hash a key.
+         * @param key the key
+         * @return the hash
+         */
+        size_t operator()(const FragmentKey_t& key) const;
+    };
+
     /**
      * Container for fragment timeouts.
      */
@@ -394,9 +413,24 @@ class Ipv6ExtensionFragment : public Ipv6Extension
         bool m_moreFragment;
 
         /**
-         * @brief The current fragments.
+         * @brief The current fragments, by offset.
+         */
+        std::multimap<uint16_t, Ptr<Packet>> m_packetFragments;
+
+        /**
+         * @brief The number of bytes covered by the fragments.
+         */
+        uint32_t m_coveredBytes;
+
+        /**
+         * @brief The end offset of the packet, as far as it is known.
+         */
+        uint32_t m_endOffset;
+
+        /**
+         * @brief If some fragments overlap.
          */
-        std::list<std::pair<Ptr<Packet>, uint16_t>> m_packetFragments;
+        bool m_overlapping;
 
         /**
          * @brief The unfragmentable part.
@@ -436,7 +470,7 @@ class Ipv6ExtensionFragment : public Ipv6Extension
     /**
      * @brief Container for the packet fragments.
      */
-    typedef std::map<FragmentKey_t, Ptr<Fragments>> MapFragments_t;
+    typedef std::unordered_map<FragmentKey_t, Ptr<Fragments>, FragmentKeyHash> MapFragments_t;
 
     /**
      * @brief The hash of fragmented packets.
@@ -190,6 +190,10 @@ Ipv6Interface::SetDown()
     NS_LOG_FUNCTION(this);
     m_ifup = false;
     m_addresses.clear();
+    if (!m_addressChangeCallback.IsNull())
+    {
+        m_addressChangeCallback();
+    }
     m_ndCache->Flush();
 
     Ptr<Ipv6> ip = m_node->GetObject<Ipv6>();
@@ -231,6 +235,10 @@ Ipv6Interface::AddAddress(Ipv6InterfaceAddress iface)
 
         Ipv6Address solicited = Ipv6Address::MakeSolicitedAddress(iface.GetAddress());
         m_addresses.emplace_back(iface, solicited);
+        if (!m_addressChangeCallback.IsNull())
+        {
+            m_addressChangeCallback();
+        }
         if (!m_addAddressCallback.IsNull())
         {
             m_addAddressCallback(this, addr);
@@ -348,6 +356,10 @@ Ipv6Interface::RemoveAddress(uint32_t index)
         {
             Ipv6InterfaceAddress iface = it->first;
             m_addresses.erase(it);
+            if (!m_addressChangeCallback.IsNull())
+            {
+                m_addressChangeCallback();
+            }
             if (!m_removeAddressCallback.IsNull())
             {
                 m_removeAddressCallback(this, iface);
@@ -379,6 +391,10 @@ Ipv6Interface::RemoveAddress(Ipv6Address address)
         {
             Ipv6InterfaceAddress iface = it->first;
             m_addresses.erase(it);
+            if (!m_addressChangeCallback.IsNull())
+            {
+                m_addressChangeCallback();
+            }
             if (!m_removeAddressCallback.IsNull())
             {
                 m_removeAddressCallback(this, iface);
@@ -616,4 +632,11 @@ Ipv6Interface::AddAddressCallback(
     m_addAddressCallback = addAddressCallback;
 }
 
+void
+Ipv6Interface::AddressChangeCallback(Callback<void> addressChangeCallback)
+{
+    NS_LOG_FUNCTION(this << &addressChangeCallback);
+    m_addressChangeCallback = addressChangeCallback;
+}
+
 } /* namespace ns3 */
@@ -286,6 +286,15 @@ class Ipv6Interface : public Object
     void AddAddressCallback(
         Callback<void, Ptr<Ipv6Interface>, Ipv6InterfaceAddress> addAddressCallback);
 
+    /**
+     * This callback is set by the IPv6 stack the interface is added to, so
+     * that it can update its index of the node addresses when an address is
+     * added to or removed from the interface.
+     *
+     * @param addressChangeCallback Callback when the addresses change.
+     */
+    void AddressChangeCallback(Callback<void> addressChangeCallback);
+
   protected:
     /**
      * @brief Dispose this object.
@@ -388,6 +397,8 @@ class Ipv6Interface : public Object
     Callback<void, Ptr<Ipv6Interface>, Ipv6InterfaceAddress>
         m_addAddressCallback; //!< add address callback
 
+    Callback<void> m_addressChangeCallback; //!< address change callback
+
     /**
      * The trace fired when the interface state changes.
      * Includes state (true if interface is up) and the interface index.
@@ -34,6 +34,8 @@
 #include "ns3/uinteger.h"
 #include "ns3/vector.h"
 
+#include <algorithm>
+
 /// Minimum IPv6 MTU, as defined by \RFC{2460}
 #define IPV6_MIN_MTU 1280
 
@@ -144,6 +146,8 @@ Ipv6L3Protocol::DoDispose()
     }
     m_interfaces.clear();
     m_reverseInterfacesContainer.clear();
+    m_localAddresses.clear();
+    m_indexedAddresses.clear();
 
     /* remove raw sockets */
     for (auto it = m_sockets.begin(); it != m_sockets.end(); ++it)
@@ -193,7 +197,9 @@ Ipv6L3Protocol::AddInterface(Ptr<NetDevice> device)
 
     m_node->RegisterProtocolHandler(MakeCallback(&TrafficControlLayer::Receive, tc),
                                     Ipv6L3Protocol::PROT_NUMBER,
-                                    device);
+                                    device,
+                                    false,
+                                    MakeCallback(&TrafficControlLayer::ReceiveBatch, tc));
 
     tc->RegisterProtocolHandler(MakeCallback(&Ipv6L3Protocol::Receive, this),
                                 Ipv6L3Protocol::PROT_NUMBER,
@@ -215,9 +221,41 @@ Ipv6L3Protocol::AddIpv6Interface(Ptr<Ipv6Interface> interface)
     m_interfaces.push_back(interface);
     m_reverseInterfacesContainer[interface->GetDevice()] = index;
     m_nInterfaces++;
+    interface->AddressChangeCallback(
+        MakeCallback(&Ipv6L3Protocol::UpdateLocalAddresses, this, index));
+    UpdateLocalAddresses(index);
     return index;
 }
 
+void
+Ipv6L3Protocol::UpdateLocalAddresses(uint32_t i)
+{
+    NS_LOG_FUNCTION(this << i);
+
+    if (m_indexedAddresses.size() <= i)
+    {
+        m_indexedAddresses.resize(i + 1);
+    }
+    for (const auto& address : m_indexedAddresses[i])
+    {
+        auto [begin, end] = m_localAddresses.equal_range(address);
+        auto it = std::find_if(begin, end, [i](const auto& entry) { return entry.second == i; });
+        if (it != end)
+        {
+            m_localAddresses.erase(it);
+        }
+    }
+    m_indexedAddresses[i].clear();
+
+    Ptr<Ipv6Interface> interface = GetInterface(i);
+    for (uint32_t j = 0; j < interface->GetNAddresses(); j++)
+    {
+        Ipv6Address address = interface->GetAddress(j).GetAddress();
+        m_localAddresses.emplace(address, i);
+        m_indexedAddresses[i].push_back(address);
+    }
+}
+
 Ptr<Ipv6Interface>
 Ipv6L3Protocol::GetInterface(uint32_t index) const
 {
@@ -237,23 +275,16 @@ Ipv6L3Protocol::GetNInterfaces() const
 int32_t
 Ipv6L3Protocol::GetInterfaceForAddress(Ipv6Address address) const
 {
-    int32_t index = 0;
-
-    for (auto it = m_interfaces.begin(); it != m_interfaces.end(); it++)
+    int32_t index = -1;
+    auto [begin, end] = m_localAddresses.equal_range(address);
+    for (auto it = begin; it != end; it++)
     {
-        uint32_t j = 0;
-        uint32_t max = (*it)->GetNAddresses();
-
-        for (j = 0; j < max; j++)
+        if (index == -1 || it->second < uint32_t(index))
         {
-            if ((*it)->GetAddress(j).GetAddress() == address)
-            {
-                return index;
-            }
+            index = it->second;
         }
-        index++;
     }
-    return -1;
+    return index;
 }
 
 int32_t
@@ -1108,41 +1139,36 @@ Ipv6L3Protocol::Receive(Ptr<NetDevice> device,
         }
     }
 
-    for (uint32_t j = 0; j < GetNInterfaces(); j++)
+    auto [begin, end] = m_localAddresses.equal_range(hdr.GetDestination());
+    if (begin != end)
     {
-        for (uint32_t i = 0; i < GetNAddresses(j); i++)
+        Ipv6Address addr = hdr.GetDestination();
+        bool onInterface = std::any_of(begin, end, [interface](const auto& entry) {
+            return entry.second == interface;
+        });
+        if (onInterface)
         {
-            Ipv6InterfaceAddress iaddr = GetAddress(j, i);
-            Ipv6Address addr = iaddr.GetAddress();
-            if (addr == hdr.GetDestination())
-            {
-                if (j == interface)
-                {
-                    NS_LOG_LOGIC("For me (destination " << addr << " match)");
-                    LocalDeliver(packet, hdr, interface);
-                    return;
-                }
-                else if (!GetStrongEndSystemModel())
-                {
-                    NS_LOG_LOGIC("For me (destination "
-                                 << addr
-                                 << " match) on another interface with Weak End System Model"
-                                 << hdr.GetDestination());
-                    LocalDeliver(packet, hdr, interface);
-                    return;
-                }
-                else
-                {
-                    NS_LOG_LOGIC(
-                        "For me (destination "
-                        << addr
-                        << " match) on another interface with Strong End System Model - discarding"
-                        << hdr.GetDestination());
-                    m_dropTrace(hdr, packet, DROP_NO_ROUTE, this, interface);
-                    return;
-                }
-            }
-            NS_LOG_LOGIC("Address " << addr << " not a match");
+            NS_LOG_LOGIC("For me (destination " << addr << " match)");
+            LocalDeliver(packet, hdr, interface);
+            return;
+        }
+        else if (!GetStrongEndSystemModel())
+        {
+            NS_LOG_LOGIC("For me (destination "
+                         << addr << " match) on another interface with Weak End System Model"
+                         << hdr.GetDestination());
+            LocalDeliver(packet, hdr, interface);
+            return;
+        }
+        else
+        {
+            NS_LOG_LOGIC(
+                "For me (destination "
+                << addr
+                << " match) on another interface with Strong End System Model - discarding"
+                << hdr.GetDestination());
+            m_dropTrace(hdr, packet, DROP_NO_ROUTE, this, interface);
+            return;
         }
     }
 
@@ -19,6 +19,8 @@
 #include "ns3/traced-callback.h"
 
 #include <list>
+#include <unordered_map>
+#include <vector>
 
 class Ipv6L3ProtocolTestCase;
 
@@ -660,6 +662,13 @@ class Ipv6L3Protocol : public Ipv6
      */
     uint32_t AddIpv6Interface(Ptr<Ipv6Interface> interface);
 
+    /**
+     * @brief Update the index of the node addresses with the current
+     * addresses of an interface.
+     * @param i interface index
+     */
+    void UpdateLocalAddresses(uint32_t i);
+
     /**
      * @brief Setup loopback interface.
      */
@@ -744,6 +753,16 @@ class Ipv6L3Protocol : public Ipv6
      */
     uint32_t m_nInterfaces;
 
+    /**
+     * @brief Interfaces by local address, once per address.
+     */
+    std::unordered_multimap<Ipv6Address, uint32_t, Ipv6AddressHash> m_localAddresses;
+
+    /**
+     * @brief Addresses of each interface in the local addresses index.
+     */
+    std::vector<std::vector<Ipv6Address>> m_indexedAddresses;
+
     /**
      * @brief Default TTL for outgoing packets.
      */
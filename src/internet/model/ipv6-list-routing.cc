@@ -222,6 +222,24 @@ Ipv6ListRouting::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit u
     }
 }
 
+uint64_t
+Ipv6ListRouting::GetRouteGeneration() const
+{
+    // The sum of the generations of the protocols changes whenever one of
+    // them changes, since they never decrease
+    uint64_t generation = m_routeGeneration;
+    for (const auto& [priority, protocol] : m_routingProtocols)
+    {
+        uint64_t protocolGeneration = protocol->GetRouteGeneration();
+        if (protocolGeneration == 0)
+        {
+            return 0;
+        }
+        generation += protocolGeneration;
+    }
+    return generation;
+}
+
 void
 Ipv6ListRouting::SetIpv6(Ptr<Ipv6> ipv6)
 {
@@ -241,6 +259,7 @@ Ipv6ListRouting::AddRoutingProtocol(Ptr<Ipv6RoutingProtocol> routingProtocol, in
     NS_LOG_FUNCTION(this << routingProtocol->GetInstanceTypeId() << priority);
     m_routingProtocols.emplace_back(priority, routingProtocol);
     m_routingProtocols.sort(Compare);
+    m_routeGeneration++;
     if (m_ipv6)
     {
         routingProtocol->SetIpv6(m_ipv6);
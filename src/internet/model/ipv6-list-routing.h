@@ -105,6 +105,7 @@ class Ipv6ListRouting : public Ipv6RoutingProtocol
     void SetIpv6(Ptr<Ipv6> ipv6) override;
     void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                            Time::Unit unit = Time::S) const override;
+    uint64_t GetRouteGeneration() const override;
 
   protected:
     /**
@@ -133,6 +134,7 @@ class Ipv6ListRouting : public Ipv6RoutingProtocol
 
     Ipv6RoutingProtocolList m_routingProtocols; //!<  List of routing protocols.
     Ptr<Ipv6> m_ipv6;                           //!< Ipv6 this protocol is associated with.
+    uint64_t m_routeGeneration{1};              //!< incremented when a routing protocol is added
 };
 
 } // namespace ns3
@@ -9,10 +9,13 @@
 #include "ipv6-routing-protocol.h"
 
 #include "ns3/assert.h"
+#include "ns3/log.h"
 
 namespace ns3
 {
 
+NS_LOG_COMPONENT_DEFINE("Ipv6RoutingProtocol");
+
 NS_OBJECT_ENSURE_REGISTERED(Ipv6RoutingProtocol);
 
 TypeId
@@ -23,4 +26,54 @@ Ipv6RoutingProtocol::GetTypeId()
     return tid;
 }
 
+uint64_t
+Ipv6RoutingProtocol::GetRouteGeneration() const
+{
+    return 0;
+}
+
+Ptr<Ipv6Route>
+Ipv6RouteCache::RouteOutput(Ptr<Ipv6RoutingProtocol> routing,
+                            Ptr<Packet> p,
+                            const Ipv6Header& header,
+                            Ptr<NetDevice> oif,
+                            Socket::SocketErrno& sockerr)
+{
+    NS_LOG_FUNCTION(this << routing << p << &header << oif << &sockerr);
+    uint64_t generation = routing->GetRouteGeneration();
+    if (m_route && generation != 0 && generation == m_generation && routing == m_routing &&
+        header.GetDestination() == m_destination && header.GetSource() == m_source &&
+        oif == m_oif)
+    {
+        NS_LOG_LOGIC("Using the cached route " << *m_route);
+        sockerr = Socket::ERROR_NOTERROR;
+        return m_route;
+    }
+
+    Ptr<Ipv6Route> route = routing->RouteOutput(p, header, oif, sockerr);
+    if (route && generation != 0)
+    {
+        m_routing = routing;
+        m_generation = generation;
+        m_destination = header.GetDestination();
+        m_source = header.GetSource();
+        m_oif = oif;
+        m_route = route;
+    }
+    else
+    {
+        Flush();
+    }
+    return route;
+}
+
+void
+Ipv6RouteCache::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    m_routing = nullptr;
+    m_oif = nullptr;
+    m_route = nullptr;
+}
+
 } /* namespace ns3 */
@@ -11,6 +11,7 @@
 
 #include "ipv6-header.h"
 #include "ipv6-interface-address.h"
+#include "ipv6-route.h"
 #include "ipv6.h"
 
 #include "ns3/callback.h"
@@ -24,7 +25,6 @@ namespace ns3
 {
 
 class Ipv6MulticastRoute;
-class Ipv6Route;
 class NetDevice;
 
 /**
@@ -211,6 +211,63 @@ class Ipv6RoutingProtocol : public Object
      */
     virtual void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                                    Time::Unit unit = Time::S) const = 0;
+
+    /**
+     * @brief Get the generation of the routes returned by RouteOutput()
+     *
+     * Protocols whose RouteOutput() only depends on the destination and
+     * source addresses of the header and on the output device, and has no
+     * side effect, let the sockets cache the routes it returns (see
+     * Ipv6RouteCache). Such protocols return a generation number, which
+     * they increment whenever the routes returned may change, e.g., on
+     * NotifyAddRoute() or NotifyInterfaceDown().
+     *
+     * The default implementation returns zero, which forbids the caching.
+     *
+     * @returns the generation of the routes, or zero if they must not be cached
+     */
+    virtual uint64_t GetRouteGeneration() const;
+};
+
+/**
+ * @ingroup ipv6Routing
+ * @brief Cache of the route used by a socket to send its packets.
+ *
+ * This is the IPv6 counterpart of Ipv4RouteCache.
+ */
+class Ipv6RouteCache
+{
+  public:
+    /**
+     * @brief Get the route for an outbound packet from the cache, or from
+     *        the routing protocol if the cached route is not valid
+     *
+     * @param routing the routing protocol
+     * @param p packet to be routed
+     * @param header input parameter, used to form key to search for the route
+     * @param oif output interface device. May be zero, or may be bound via
+     *            socket options to a particular output interface.
+     * @param sockerr output parameter; socket errno
+     * @returns a code that indicates what happened in the lookup
+     */
+    Ptr<Ipv6Route> RouteOutput(Ptr<Ipv6RoutingProtocol> routing,
+                               Ptr<Packet> p,
+                               const Ipv6Header& header,
+                               Ptr<NetDevice> oif,
+                               Socket::SocketErrno& sockerr);
+
+    /**
+     * @brief Remove the cached route
+     */
+    void Flush();
+
+  private:
+    Ptr<Ipv6RoutingProtocol> m_routing; //!< routing protocol which returned the route
+    uint64_t m_generation{0};           //!< generation of the routes of the protocol
+    Ipv6Address m_destination;          //!< destination of the packets
+    Ipv6Address m_source;               //!< source address of the packets, if set
+    Ptr<NetDevice> m_oif;               //!< output device requested
+    Ptr<Ipv6Route> m_route;             //!< route returned by the protocol
 };
 
 } // namespace ns3
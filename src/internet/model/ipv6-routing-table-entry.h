@@ -10,7 +10,9 @@
 #define IPV6_ROUTING_TABLE_ENTRY_H
 
 #include "ns3/ipv6-address.h"
+#include "ns3/object-accounting.h"
 
+#include <cstddef>
 #include <list>
 #include <ostream>
 #include <vector>
@@ -182,6 +184,8 @@ class Ipv6RoutingTableEntry
      */
     static Ipv6RoutingTableEntry CreateDefaultRoute(Ipv6Address nextHop, uint32_t interface);
 
+    NS_OBJECT_ACCOUNTING_ALLOCATION("ns3::Ipv6RoutingTableEntry", ObjectAccounting::HeapAllocator)
+
   private:
     /**
      * @brief Constructor.
@@ -355,6 +359,9 @@ class Ipv6MulticastRoutingTableEntry
         uint32_t inputInterface,
         std::vector<uint32_t> outputInterfaces);
 
+    NS_OBJECT_ACCOUNTING_ALLOCATION("ns3::Ipv6MulticastRoutingTableEntry",
+                                    ObjectAccounting::HeapAllocator)
+
   private:
     /**
      * @brief Constructor.
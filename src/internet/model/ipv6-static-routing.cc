@@ -52,6 +52,7 @@ void
 Ipv6StaticRouting::SetIpv6(Ptr<Ipv6> ipv6)
 {
     NS_LOG_FUNCTION(this << ipv6);
+    m_routeGeneration++;
     NS_ASSERT(!m_ipv6 && ipv6);
     uint32_t i = 0;
     m_ipv6 = ipv6;
@@ -69,6 +70,12 @@ Ipv6StaticRouting::SetIpv6(Ptr<Ipv6> ipv6)
     }
 }
 
+uint64_t
+Ipv6StaticRouting::GetRouteGeneration() const
+{
+    return m_routeGeneration;
+}
+
 // Formatted like output of "route -n" command
 void
 Ipv6StaticRouting::PrintRoutingTable(Ptr<OutputStreamWrapper> stream, Time::Unit unit) const
@@ -164,6 +171,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
                                      uint32_t metric)
 {
     NS_LOG_FUNCTION(this << network << networkPrefix << nextHop << interface << metric);
+    m_routeGeneration++;
 
     Ipv6RoutingTableEntry route =
         Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkPrefix, nextHop, interface);
@@ -185,6 +193,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
 {
     NS_LOG_FUNCTION(this << network << networkPrefix << nextHop << interface << prefixToUse
                          << metric);
+    m_routeGeneration++;
     if (nextHop.IsLinkLocal())
     {
         NS_LOG_WARN("Ipv6StaticRouting::AddNetworkRouteTo - Next hop should be link-local");
@@ -209,6 +218,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
                                      uint32_t metric)
 {
     NS_LOG_FUNCTION(this << network << networkPrefix << interface);
+    m_routeGeneration++;
 
     Ipv6RoutingTableEntry route =
         Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkPrefix, interface);
@@ -241,6 +251,7 @@ Ipv6StaticRouting::AddMulticastRoute(Ipv6Address origin,
                                      std::vector<uint32_t> outputInterfaces)
 {
     NS_LOG_FUNCTION(this << origin << group << inputInterface);
+    m_routeGeneration++;
     auto route = new Ipv6MulticastRoutingTableEntry();
     *route = Ipv6MulticastRoutingTableEntry::CreateMulticastRoute(origin,
                                                                   group,
@@ -253,6 +264,7 @@ void
 Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
 {
     NS_LOG_FUNCTION(this << outputInterface);
+    m_routeGeneration++;
     auto route = new Ipv6RoutingTableEntry();
     Ipv6Address network = Ipv6Address("ff00::"); /* RFC 3513 */
     Ipv6Prefix networkMask = Ipv6Prefix(8);
@@ -295,6 +307,7 @@ Ipv6StaticRouting::RemoveMulticastRoute(Ipv6Address origin,
                                         uint32_t inputInterface)
 {
     NS_LOG_FUNCTION(this << origin << group << inputInterface);
+    m_routeGeneration++;
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end(); i++)
     {
         Ipv6MulticastRoutingTableEntry* route = *i;
@@ -313,6 +326,7 @@ void
 Ipv6StaticRouting::RemoveMulticastRoute(uint32_t index)
 {
     NS_LOG_FUNCTION(this << index);
+    m_routeGeneration++;
     uint32_t tmp = 0;
 
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end(); i++)
@@ -626,6 +640,7 @@ void
 Ipv6StaticRouting::RemoveRoute(uint32_t index)
 {
     NS_LOG_FUNCTION(this << index);
+    m_routeGeneration++;
     uint32_t tmp = 0;
 
     for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
@@ -648,6 +663,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
                                Ipv6Address prefixToUse)
 {
     NS_LOG_FUNCTION(this << network << prefix << ifIndex);
+    m_routeGeneration++;
 
     for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
     {
@@ -763,6 +779,7 @@ Ipv6StaticRouting::RouteInput(Ptr<const Packet> p,
 void
 Ipv6StaticRouting::NotifyInterfaceUp(uint32_t i)
 {
+    m_routeGeneration++;
     for (uint32_t j = 0; j < m_ipv6->GetNAddresses(i); j++)
     {
         Ipv6InterfaceAddress addr = m_ipv6->GetAddress(i, j);
@@ -791,6 +808,7 @@ void
 Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
 {
     NS_LOG_FUNCTION(this << i);
+    m_routeGeneration++;
 
     /* remove all static routes that are going through this interface */
     for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end();)
@@ -810,6 +828,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
 void
 Ipv6StaticRouting::NotifyAddAddress(uint32_t interface, Ipv6InterfaceAddress address)
 {
+    m_routeGeneration++;
     if (!m_ipv6->IsUp(interface))
     {
         return;
@@ -819,6 +838,7 @@ Ipv6StaticRouting::NotifyAddAddress(uint32_t interface, Ipv6InterfaceAddress add
 void
 Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress address)
 {
+    m_routeGeneration++;
     if (!m_ipv6->IsUp(interface))
     {
         return;
@@ -853,6 +873,7 @@ Ipv6StaticRouting::NotifyAddRoute(Ipv6Address dst,
                                   Ipv6Address prefixToUse)
 {
     NS_LOG_FUNCTION(this << dst << mask << nextHop << interface << prefixToUse);
+    m_routeGeneration++;
     if (nextHop == Ipv6Address::GetZero())
     {
         AddNetworkRouteTo(dst, mask, interface);
@@ -883,6 +904,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
                                      Ipv6Address prefixToUse)
 {
     NS_LOG_FUNCTION(this << dst << mask << nextHop << interface);
+    m_routeGeneration++;
     if (dst != Ipv6Address::GetZero())
     {
         for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end();)
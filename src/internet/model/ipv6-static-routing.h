@@ -269,6 +269,7 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
     void SetIpv6(Ptr<Ipv6> ipv6) override;
     void PrintRoutingTable(Ptr<OutputStreamWrapper> stream,
                            Time::Unit unit = Time::S) const override;
+    uint64_t GetRouteGeneration() const override;
 
   protected:
     /**
@@ -334,6 +335,11 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      * @brief Ipv6 reference.
      */
     Ptr<Ipv6> m_ipv6;
+
+    /**
+     * @brief Generation of the routes, incremented whenever they may change.
+     */
+    uint64_t m_routeGeneration{1};
 };
 
 } /* namespace ns3 */
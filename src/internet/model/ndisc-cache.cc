@@ -17,6 +17,9 @@
 #include "ns3/node.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace ns3
 {
 
@@ -107,14 +110,12 @@ NdiscCache::LookupInverse(Address dst)
     NS_LOG_FUNCTION(this << dst);
 
     std::list<NdiscCache::Entry*> entryList;
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto range = m_macIndex.equal_range(dst);
+    for (auto i = range.first; i != range.second; i++)
     {
         NdiscCache::Entry* entry = (*i).second;
-        if (entry->GetMacAddress() == dst)
-        {
-            NS_LOG_LOGIC("Found an entry:" << (*entry));
-            entryList.push_back(entry);
-        }
+        NS_LOG_LOGIC("Found an entry:" << (*entry));
+        entryList.push_back(entry);
     }
     return entryList;
 }
@@ -128,6 +129,7 @@ NdiscCache::Add(Ipv6Address to)
     auto entry = new NdiscCache::Entry(this);
     entry->SetIpv6Address(to);
     m_ndCache[to] = entry;
+    m_macIndex.emplace(entry->GetMacAddress(), entry);
     return entry;
 }
 
@@ -136,15 +138,14 @@ NdiscCache::Remove(NdiscCache::Entry* entry)
 {
     NS_LOG_FUNCTION(this << entry);
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    auto i = m_ndCache.find(entry->GetIpv6Address());
+    if (i != m_ndCache.end() && (*i).second == entry)
     {
-        if ((*i).second == entry)
-        {
-            m_ndCache.erase(i);
-            entry->ClearWaitingPacket();
-            delete entry;
-            return;
-        }
+        m_ndCache.erase(i);
+        RemoveMacAddress(entry);
+        entry->StopNudTimer();
+        entry->ClearWaitingPacket();
+        delete entry;
     }
 }
 
@@ -159,6 +160,9 @@ NdiscCache::Flush()
     }
 
     m_ndCache.erase(m_ndCache.begin(), m_ndCache.end());
+    m_macIndex.clear();
+    m_nudTimers.clear();
+    m_nudTimerEvent.Cancel();
 }
 
 void
@@ -181,7 +185,13 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     NS_LOG_FUNCTION(this << stream);
     std::ostream* os = stream->GetStream();
 
-    for (auto i = m_ndCache.begin(); i != m_ndCache.end(); i++)
+    // print the entries in address order, as the cache is not sorted
+    std::vector<std::pair<Ipv6Address, NdiscCache::Entry*>> entries(m_ndCache.begin(),
+                                                                    m_ndCache.end());
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (auto i = entries.begin(); i != entries.end(); i++)
     {
         *os << i->first << " dev ";
         std::string found = Names::FindName(m_device);
@@ -232,11 +242,95 @@ NdiscCache::PrintNdiscCache(Ptr<OutputStreamWrapper> stream)
     }
 }
 
+void
+NdiscCache::ScheduleNudTimer(NdiscCache::Entry* entry, Time expiration)
+{
+    NS_LOG_FUNCTION(this << entry << expiration);
+    m_nudTimers.emplace(expiration, entry);
+    if (!m_nudTimerEvent.IsPending() ||
+        expiration < Simulator::Now() + Simulator::GetDelayLeft(m_nudTimerEvent))
+    {
+        UpdateNudTimerEvent();
+    }
+}
+
+void
+NdiscCache::CancelNudTimer(NdiscCache::Entry* entry, Time expiration)
+{
+    NS_LOG_FUNCTION(this << entry << expiration);
+    // The event is left alone: if it was scheduled for this timer, it
+    // finds nothing to expire and is scheduled again for the next one
+    auto range = m_nudTimers.equal_range(expiration);
+    auto i = std::find_if(range.first, range.second, [entry](const auto& timer) {
+        return timer.second == entry;
+    });
+    NS_ASSERT_MSG(i != range.second, "NUD timer not found");
+    m_nudTimers.erase(i);
+}
+
+void
+NdiscCache::HandleNudTimers()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_nudTimers.empty() && m_nudTimers.begin()->first <= Simulator::Now())
+    {
+        NdiscCache::Entry* entry = m_nudTimers.begin()->second;
+        m_nudTimers.erase(m_nudTimers.begin());
+        entry->FunctionNudTimeout();
+    }
+    UpdateNudTimerEvent();
+}
+
+void
+NdiscCache::UpdateNudTimerEvent()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_nudTimers.empty())
+    {
+        m_nudTimerEvent.Cancel();
+        return;
+    }
+    Time delay = m_nudTimers.begin()->first - Simulator::Now();
+    if (m_nudTimerEvent.IsPending() && Simulator::GetDelayLeft(m_nudTimerEvent) == delay)
+    {
+        return;
+    }
+    m_nudTimerEvent.Cancel();
+    m_nudTimerEvent = Simulator::Schedule(delay, &NdiscCache::HandleNudTimers, this);
+}
+
+void
+NdiscCache::UpdateMacAddress(NdiscCache::Entry* entry, const Address& mac)
+{
+    NS_LOG_FUNCTION(this << entry << mac);
+    if (entry->GetMacAddress() == mac)
+    {
+        return;
+    }
+    RemoveMacAddress(entry);
+    m_macIndex.emplace(mac, entry);
+}
+
+void
+NdiscCache::RemoveMacAddress(NdiscCache::Entry* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    auto range = m_macIndex.equal_range(entry->GetMacAddress());
+    auto i = std::find_if(range.first, range.second, [entry](const auto& indexed) {
+        return indexed.second == entry;
+    });
+    if (i != range.second)
+    {
+        m_macIndex.erase(i);
+    }
+}
+
 NdiscCache::Entry::Entry(NdiscCache* nd)
     : m_ndCache(nd),
       m_waiting(),
       m_router(false),
-      m_nudTimer(Timer::CANCEL_ON_DESTROY),
+      m_nudFunction(nullptr),
+      m_nudTimerRunning(false),
       m_lastReachabilityConfirmation(),
       m_nsRetransmit(0)
 {
@@ -458,15 +552,9 @@ void
 NdiscCache::Entry::StartReachableTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
     m_lastReachabilityConfirmation = Simulator::Now();
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionReachableTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetReachableTime());
-    m_nudTimer.Schedule();
+    ArmNudTimer(&NdiscCache::Entry::FunctionReachableTimeout,
+                m_ndCache->m_icmpv6->GetReachableTime());
 }
 
 void
@@ -477,11 +565,7 @@ NdiscCache::Entry::UpdateReachableTimer()
     if (m_state == REACHABLE)
     {
         m_lastReachabilityConfirmation = Simulator::Now();
-        if (m_nudTimer.IsRunning())
-        {
-            m_nudTimer.Cancel();
-        }
-        m_nudTimer.Schedule();
+        ArmNudTimer(m_nudFunction, m_nudDelay);
     }
 }
 
@@ -489,50 +573,59 @@ void
 NdiscCache::Entry::StartProbeTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionProbeTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+    ArmNudTimer(&NdiscCache::Entry::FunctionProbeTimeout,
+                m_ndCache->m_icmpv6->GetRetransmissionTime());
 }
 
 void
 NdiscCache::Entry::StartDelayTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
-    {
-        m_nudTimer.Cancel();
-    }
-
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionDelayTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetDelayFirstProbe());
-    m_nudTimer.Schedule();
+    ArmNudTimer(&NdiscCache::Entry::FunctionDelayTimeout,
+                m_ndCache->m_icmpv6->GetDelayFirstProbe());
 }
 
 void
 NdiscCache::Entry::StartRetransmitTimer()
 {
     NS_LOG_FUNCTION(this);
-    if (m_nudTimer.IsRunning())
+    ArmNudTimer(&NdiscCache::Entry::FunctionRetransmitTimeout,
+                m_ndCache->m_icmpv6->GetRetransmissionTime());
+}
+
+void
+NdiscCache::Entry::StopNudTimer()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_nudTimerRunning)
     {
-        m_nudTimer.Cancel();
+        m_ndCache->CancelNudTimer(this, m_nudExpiration);
+        m_nudTimerRunning = false;
     }
+    m_nsRetransmit = 0;
+}
 
-    m_nudTimer.SetFunction(&NdiscCache::Entry::FunctionRetransmitTimeout, this);
-    m_nudTimer.SetDelay(m_ndCache->m_icmpv6->GetRetransmissionTime());
-    m_nudTimer.Schedule();
+void
+NdiscCache::Entry::ArmNudTimer(void (NdiscCache::Entry::*function)(), Time delay)
+{
+    NS_LOG_FUNCTION(this << delay);
+    if (m_nudTimerRunning)
+    {
+        m_ndCache->CancelNudTimer(this, m_nudExpiration);
+    }
+    m_nudFunction = function;
+    m_nudDelay = delay;
+    m_nudExpiration = Simulator::Now() + delay;
+    m_nudTimerRunning = true;
+    m_ndCache->ScheduleNudTimer(this, m_nudExpiration);
 }
 
 void
-NdiscCache::Entry::StopNudTimer()
+NdiscCache::Entry::FunctionNudTimeout()
 {
     NS_LOG_FUNCTION(this);
-    m_nudTimer.Cancel();
-    m_nsRetransmit = 0;
+    m_nudTimerRunning = false;
+    (this->*m_nudFunction)();
 }
 
 void
@@ -552,7 +645,7 @@ NdiscCache::Entry::MarkReachable(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = REACHABLE;
-    m_macAddress = mac;
+    SetMacAddress(mac);
     return m_waiting;
 }
 
@@ -582,7 +675,7 @@ NdiscCache::Entry::MarkStale(Address mac)
 {
     NS_LOG_FUNCTION(this << mac);
     m_state = STALE;
-    m_macAddress = mac;
+    SetMacAddress(mac);
     return m_waiting;
 }
 
@@ -669,6 +762,7 @@ void
 NdiscCache::Entry::SetMacAddress(Address mac)
 {
     NS_LOG_FUNCTION(this << mac << int(m_state));
+    m_ndCache->UpdateMacAddress(this, mac);
     m_macAddress = mac;
 }
 
@@ -711,8 +805,9 @@ NdiscCache::RemoveAutoGeneratedEntries()
         if (i->second->IsAutoGenerated())
         {
             i->second->ClearWaitingPacket();
+            RemoveMacAddress(i->second);
             delete i->second;
-            m_ndCache.erase(i++);
+            i = m_ndCache.erase(i);
             continue;
         }
         i++;
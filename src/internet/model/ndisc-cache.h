@@ -9,17 +9,19 @@
 #ifndef NDISC_CACHE_H
 #define NDISC_CACHE_H
 
+#include "ns3/event-id.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
-#include "ns3/timer.h"
+#include "ns3/simulator.h"
 
 #include <list>
 #include <map>
 #include <stdint.h>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -369,6 +371,12 @@ class NdiscCache : public Object
          */
         void FunctionDelayTimeout();
 
+        /**
+         * @brief Function called by the cache when the NUD timer expires.
+         * It calls the function of the timer which was started last.
+         */
+        void FunctionNudTimeout();
+
         /**
          * @brief Set the IPv6 address.
          * @param ipv6Address IPv6 address
@@ -401,6 +409,13 @@ class NdiscCache : public Object
         NdiscCache* m_ndCache;
 
       private:
+        /**
+         * @brief Start the NUD timer.
+         * @param function the function to call when the timer expires
+         * @param delay the delay before the timer expires
+         */
+        void ArmNudTimer(void (NdiscCache::Entry::*function)(), Time delay);
+
         /**
          * @brief The IPv6 address.
          */
@@ -422,9 +437,24 @@ class NdiscCache : public Object
         bool m_router;
 
         /**
-         * @brief Timer (used for NUD).
+         * @brief Function called when the NUD timer expires.
+         */
+        void (NdiscCache::Entry::*m_nudFunction)();
+
+        /**
+         * @brief Delay of the NUD timer.
+         */
+        Time m_nudDelay;
+
+        /**
+         * @brief Expiration time of the NUD timer.
+         */
+        Time m_nudExpiration;
+
+        /**
+         * @brief Whether the NUD timer is running.
          */
-        Timer m_nudTimer;
+        bool m_nudTimerRunning;
 
         /**
          * @brief Last time we see a reachability confirmation.
@@ -446,11 +476,11 @@ class NdiscCache : public Object
     /**
      * @brief Neighbor Discovery Cache container
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*> Cache;
+    typedef std::unordered_map<Ipv6Address, NdiscCache::Entry*, Ipv6AddressHash> Cache;
     /**
      * @brief Neighbor Discovery Cache container iterator
      */
-    typedef std::map<Ipv6Address, NdiscCache::Entry*>::iterator CacheI;
+    typedef Cache::iterator CacheI;
 
     /**
      * @brief A list of Entry.
@@ -458,6 +488,63 @@ class NdiscCache : public Object
     Cache m_ndCache;
 
   private:
+    /**
+     * @brief Add an entry to the NUD timers of the cache.
+     * @param entry the entry
+     * @param expiration the expiration time of the timer of the entry
+     */
+    void ScheduleNudTimer(NdiscCache::Entry* entry, Time expiration);
+
+    /**
+     * @brief Remove an entry from the NUD timers of the cache.
+     * @param entry the entry
+     * @param expiration the expiration time of the timer of the entry
+     */
+    void CancelNudTimer(NdiscCache::Entry* entry, Time expiration);
+
+    /**
+     * @brief Expire the NUD timers which are due, and schedule the event
+     * for the next one.
+     */
+    void HandleNudTimers();
+
+    /**
+     * @brief Schedule the NUD timer event at the first expiration time.
+     */
+    void UpdateNudTimerEvent();
+
+    /**
+     * @brief Update the index of the entries by MAC address after the MAC
+     * address of an entry changed.
+     * @param entry the entry
+     * @param mac the new MAC address of the entry
+     */
+    void UpdateMacAddress(NdiscCache::Entry* entry, const Address& mac);
+
+    /**
+     * @brief Remove an entry from the index of the entries by MAC address.
+     * @param entry the entry
+     */
+    void RemoveMacAddress(NdiscCache::Entry* entry);
+
+    /**
+     * @brief The NUD timers of the entries, by expiration time.
+     *
+     * A single event, for the first expiration time, is scheduled for
+     * the whole cache rather than one event per entry.
+     */
+    std::multimap<Time, NdiscCache::Entry*> m_nudTimers;
+
+    /**
+     * @brief The event expiring the NUD timers.
+     */
+    EventId m_nudTimerEvent;
+
+    /**
+     * @brief The entries, indexed by MAC address.
+     */
+    std::unordered_multimap<Address, NdiscCache::Entry*, AddressHash> m_macIndex;
+
     /**
      * @brief The NetDevice.
      */
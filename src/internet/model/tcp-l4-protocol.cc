@@ -574,7 +574,8 @@ TcpL4Protocol::SendPacketV4(Ptr<Packet> packet,
                             const TcpHeader& outgoing,
                             const Ipv4Address& saddr,
                             const Ipv4Address& daddr,
-                            Ptr<NetDevice> oif) const
+                            Ptr<NetDevice> oif,
+                            Ipv4RouteCache* routeCache) const
 {
     NS_LOG_FUNCTION(this << packet << saddr << daddr << oif);
     NS_LOG_LOGIC("TcpL4Protocol " << this << " sending seq " << outgoing.GetSequenceNumber()
@@ -603,7 +604,15 @@ TcpL4Protocol::SendPacketV4(Ptr<Packet> packet,
         header.SetProtocol(PROT_NUMBER);
         Socket::SocketErrno errno_;
         Ptr<Ipv4Route> route;
-        if (ipv4->GetRoutingProtocol())
+        if (ipv4->GetRoutingProtocol() && routeCache)
+        {
+            route = routeCache->RouteOutput(ipv4->GetRoutingProtocol(),
+                                            packet,
+                                            header,
+                                            oif,
+                                            errno_);
+        }
+        else if (ipv4->GetRoutingProtocol())
         {
             route = ipv4->GetRoutingProtocol()->RouteOutput(packet, header, oif, errno_);
         }
@@ -625,7 +634,9 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
                             const TcpHeader& outgoing,
                             const Ipv6Address& saddr,
                             const Ipv6Address& daddr,
-                            Ptr<NetDevice> oif) const
+                            Ptr<NetDevice> oif,
+                            Ipv4RouteCache* routeCache,
+                            Ipv6RouteCache* routeCache6) const
 {
     NS_LOG_FUNCTION(this << packet << saddr << daddr << oif);
     NS_LOG_LOGIC("TcpL4Protocol " << this << " sending seq " << outgoing.GetSequenceNumber()
@@ -640,7 +651,8 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
                            outgoing,
                            saddr.GetIpv4MappedAddress(),
                            daddr.GetIpv4MappedAddress(),
-                           oif));
+                           oif,
+                           routeCache));
     }
     TcpHeader outgoingHeader = outgoing;
     /** @todo UrgentPointer */
@@ -662,7 +674,15 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
         header.SetNextHeader(PROT_NUMBER);
         Socket::SocketErrno errno_;
         Ptr<Ipv6Route> route;
-        if (ipv6->GetRoutingProtocol())
+        if (ipv6->GetRoutingProtocol() && routeCache6)
+        {
+            route = routeCache6->RouteOutput(ipv6->GetRoutingProtocol(),
+                                             packet,
+                                             header,
+                                             oif,
+                                             errno_);
+        }
+        else if (ipv6->GetRoutingProtocol())
         {
             route = ipv6->GetRoutingProtocol()->RouteOutput(packet, header, oif, errno_);
         }
@@ -684,7 +704,9 @@ TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
                           const TcpHeader& outgoing,
                           const Address& saddr,
                           const Address& daddr,
-                          Ptr<NetDevice> oif) const
+                          Ptr<NetDevice> oif,
+                          Ipv4RouteCache* routeCache,
+                          Ipv6RouteCache* routeCache6) const
 {
     NS_LOG_FUNCTION(this << pkt << outgoing << saddr << daddr << oif);
     if (Ipv4Address::IsMatchingType(saddr))
@@ -695,7 +717,8 @@ TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
                      outgoing,
                      Ipv4Address::ConvertFrom(saddr),
                      Ipv4Address::ConvertFrom(daddr),
-                     oif);
+                     oif,
+                     routeCache);
 
         return;
     }
@@ -707,7 +730,9 @@ TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
                      outgoing,
                      Ipv6Address::ConvertFrom(saddr),
                      Ipv6Address::ConvertFrom(daddr),
-                     oif);
+                     oif,
+                     routeCache,
+                     routeCache6);
 
         return;
     }
@@ -716,7 +741,7 @@ TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
         InetSocketAddress s = InetSocketAddress::ConvertFrom(saddr);
         InetSocketAddress d = InetSocketAddress::ConvertFrom(daddr);
 
-        SendPacketV4(pkt, outgoing, s.GetIpv4(), d.GetIpv4(), oif);
+        SendPacketV4(pkt, outgoing, s.GetIpv4(), d.GetIpv4(), oif, routeCache);
 
         return;
     }
@@ -725,7 +750,7 @@ TcpL4Protocol::SendPacket(Ptr<Packet> pkt,
         Inet6SocketAddress s = Inet6SocketAddress::ConvertFrom(saddr);
         Inet6SocketAddress d = Inet6SocketAddress::ConvertFrom(daddr);
 
-        SendPacketV6(pkt, outgoing, s.GetIpv6(), d.GetIpv6(), oif);
+        SendPacketV6(pkt, outgoing, s.GetIpv6(), d.GetIpv6(), oif, routeCache, routeCache6);
 
         return;
     }
@@ -27,6 +27,8 @@ class TcpHeader;
 class Ipv4EndPointDemux;
 class Ipv6EndPointDemux;
 class Ipv4Interface;
+class Ipv4RouteCache;
+class Ipv6RouteCache;
 class TcpSocketBase;
 class Ipv4EndPoint;
 class Ipv6EndPoint;
@@ -213,12 +215,16 @@ class TcpL4Protocol : public IpL4Protocol
      * @param saddr The source Ipv4Address
      * @param daddr The destination Ipv4Address
      * @param oif The output interface bound. Defaults to null (unspecified).
+     * @param routeCache The cache of the IPv4 route of the socket, if any
+     * @param routeCache6 The cache of the IPv6 route of the socket, if any
      */
     void SendPacket(Ptr<Packet> pkt,
                     const TcpHeader& outgoing,
                     const Address& saddr,
                     const Address& daddr,
-                    Ptr<NetDevice> oif = nullptr) const;
+                    Ptr<NetDevice> oif = nullptr,
+                    Ipv4RouteCache* routeCache = nullptr,
+                    Ipv6RouteCache* routeCache6 = nullptr) const;
 
     /**
      * @brief Make a socket fully operational
@@ -346,12 +352,14 @@ class TcpL4Protocol : public IpL4Protocol
      * @param saddr The source Ipv4Address
      * @param daddr The destination Ipv4Address
      * @param oif The output interface bound. Defaults to null (unspecified).
+     * @param routeCache The cache of the route of the socket, if any
      */
     void SendPacketV4(Ptr<Packet> pkt,
                       const TcpHeader& outgoing,
                       const Ipv4Address& saddr,
                       const Ipv4Address& daddr,
-                      Ptr<NetDevice> oif = nullptr) const;
+                      Ptr<NetDevice> oif = nullptr,
+                      Ipv4RouteCache* routeCache = nullptr) const;
 
     /**
      * @brief Send a packet via TCP (IPv6)
@@ -361,12 +369,17 @@ class TcpL4Protocol : public IpL4Protocol
      * @param saddr The source Ipv4Address
      * @param daddr The destination Ipv4Address
      * @param oif The output interface bound. Defaults to null (unspecified).
+     * @param routeCache The cache of the IPv4 route of the socket, if any,
+     *        used for IPv4-mapped addresses
+     * @param routeCache6 The cache of the IPv6 route of the socket, if any
      */
     void SendPacketV6(Ptr<Packet> pkt,
                       const TcpHeader& outgoing,
                       const Ipv6Address& saddr,
                       const Ipv6Address& daddr,
-                      Ptr<NetDevice> oif = nullptr) const;
+                      Ptr<NetDevice> oif = nullptr,
+                      Ipv4RouteCache* routeCache = nullptr,
+                      Ipv6RouteCache* routeCache6 = nullptr) const;
 };
 
 } // namespace ns3
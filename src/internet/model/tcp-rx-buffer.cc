@@ -11,6 +11,9 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace ns3
 {
 
@@ -160,8 +163,13 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
             headSeq = tailSeq;
         }
     }
-    // Remove overlapped bytes from packet
-    auto i = m_data.begin();
+    // Remove overlapped bytes from packet, starting from the last buffered
+    // packet that does not begin after the head of the new one
+    auto i = m_data.upper_bound(headSeq);
+    if (i != m_data.begin())
+    {
+        --i;
+    }
     while (i != m_data.end() && i->first <= tailSeq)
     {
         SequenceNumber32 lastByteSeq = i->first + SequenceNumber32(i->second->GetSize());
@@ -201,27 +209,32 @@ TcpRxBuffer::Add(Ptr<Packet> p, const TcpHeader& tcph)
     NS_ASSERT(m_data.find(headSeq) == m_data.end()); // Shouldn't be there yet
     m_data[headSeq] = p;
 
-    if (headSeq > m_nextRxSeq)
-    {
-        // Generate a new SACK block
-        UpdateSackList(headSeq, tailSeq);
-    }
-
     NS_LOG_LOGIC("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize());
     // Update variables
     m_size += p->GetSize(); // Occupancy
-    for (i = m_data.begin(); i != m_data.end(); ++i)
+    if (headSeq > m_nextRxSeq)
+    {
+        // Generate a new SACK block, covering the whole block of contiguous
+        // data the packet belongs to
+        TcpOptionSack::SackBlock block = AddInterval(headSeq, tailSeq);
+        UpdateSackList(block.first, block.second);
+    }
+    else
     {
-        if (i->first < m_nextRxSeq)
+        // In-sequence data, which may fill the hole before the first blocks
+        SequenceNumber32 nextRxSeq = tailSeq;
+        m_availBytes += p->GetSize();
+        auto first = m_intervals.begin();
+        while (first != m_intervals.end() && first->first <= nextRxSeq)
         {
-            continue;
+            if (first->second > nextRxSeq)
+            {
+                m_availBytes += static_cast<uint32_t>(first->second - nextRxSeq);
+                nextRxSeq = first->second;
+            }
+            first = m_intervals.erase(first);
         }
-        else if (i->first > m_nextRxSeq)
-        {
-            break;
-        };
-        m_nextRxSeq = i->first + SequenceNumber32(i->second->GetSize());
-        m_availBytes += i->second->GetSize();
+        m_nextRxSeq = nextRxSeq;
         ClearSackList(m_nextRxSeq);
     }
     NS_LOG_LOGIC("Updated buffer occupancy=" << m_size << " nextRxSeq=" << m_nextRxSeq);
@@ -276,53 +289,21 @@ TcpRxBuffer::UpdateSackList(const SequenceNumber32& head, const SequenceNumber32
     //     following SACK blocks in the SACK option may be listed in
     //     arbitrary order.
 
-    m_sackList.push_front(current);
-
-    // We have inserted the block at the beginning of the list. Now, we should
-    // check if any existing blocks overlap with that.
-    bool updated = false;
-    auto it = m_sackList.begin();
-    TcpOptionSack::SackBlock begin = *it;
-    TcpOptionSack::SackBlock merged;
-    ++it;
-
-    // Iterates until we examined all blocks in the list (maximum 4)
-    while (it != m_sackList.end())
+    // The block "current" is the contiguous block of data containing the
+    // segment, taken from the interval set. Blocks previously reported
+    // that are now part of it are removed, the others are repeated after it.
+    for (auto it = m_sackList.begin(); it != m_sackList.end();)
     {
-        current = *it;
-
-        // This is a left merge:
-        // [current_first; current_second] [beg_first; beg_second]
-        if (begin.first == current.second)
+        if (current.first <= it->first && it->second <= current.second)
         {
-            NS_ASSERT(current.first < begin.second);
-            merged = TcpOptionSack::SackBlock(current.first, begin.second);
-            updated = true;
-        }
-        // while this is a right merge
-        // [begin_first; begin_second] [current_first; current_second]
-        else if (begin.second == current.first)
-        {
-            NS_ASSERT(begin.first < current.second);
-            merged = TcpOptionSack::SackBlock(begin.first, current.second);
-            updated = true;
+            it = m_sackList.erase(it);
         }
-
-        // If we have merged the blocks (and the result is in merged) we should
-        // delete the current block (it), the first block, and insert the merged
-        // one at the beginning.
-        if (updated)
+        else
         {
-            m_sackList.erase(it);
-            m_sackList.pop_front();
-            m_sackList.push_front(merged);
-            it = m_sackList.begin();
-            begin = *it;
-            updated = false;
+            ++it;
         }
-
-        ++it;
     }
+    m_sackList.push_front(current);
 
     // Since the maximum blocks that fits into a TCP header are 4, there's no
     // point on maintaining the others.
@@ -330,11 +311,6 @@ TcpRxBuffer::UpdateSackList(const SequenceNumber32& head, const SequenceNumber32
     {
         m_sackList.pop_back();
     }
-
-    // Please note that, if a block b is discarded and then a block contiguous
-    // to b is received, only that new block (without the b part) is reported.
-    // This is perfectly fine for the RFC point (a), given that we do not report any
-    // overlapping blocks shortly after.
 }
 
 void
@@ -358,6 +334,30 @@ TcpRxBuffer::ClearSackList(const SequenceNumber32& seq)
     }
 }
 
+TcpOptionSack::SackBlock
+TcpRxBuffer::AddInterval(const SequenceNumber32& head, const SequenceNumber32& tail)
+{
+    NS_LOG_FUNCTION(this << head << tail);
+
+    TcpOptionSack::SackBlock merged(head, tail);
+
+    // Start from the interval before the block, if it reaches the block
+    auto it = m_intervals.upper_bound(head);
+    if (it != m_intervals.begin() && std::prev(it)->second >= head)
+    {
+        --it;
+        merged.first = it->first;
+    }
+    // and absorb all the intervals overlapping or adjacent to the block
+    while (it != m_intervals.end() && it->first <= tail)
+    {
+        merged.second = std::max(merged.second, it->second);
+        it = m_intervals.erase(it);
+    }
+    m_intervals.emplace(merged.first, merged.second);
+    return merged;
+}
+
 TcpOptionSack::SackList
 TcpRxBuffer::GetSackList() const
 {
@@ -376,35 +376,47 @@ TcpRxBuffer::Extract(uint32_t maxSize)
     {
         return nullptr; // No contiguous block to return
     }
-    NS_ASSERT(!m_data.empty());            // At least we have something to extract
-    Ptr<Packet> outPkt = Create<Packet>(); // The packet that contains all the data to return
-    BufIterator i;
+    NS_ASSERT(!m_data.empty()); // At least we have something to extract
+    Ptr<Packet> outPkt;         // The packet that contains all the data to return
     while (extractSize)
     { // Check the buffered data for delivery
-        i = m_data.begin();
+        auto i = m_data.begin();
         NS_ASSERT(i->first <= m_nextRxSeq); // in-sequence data expected
         // Check if we send the whole pkt or just a partial
         uint32_t pktSize = i->second->GetSize();
+        Ptr<Packet> extracted;
         if (pktSize <= extractSize)
         { // Whole packet is extracted
-            outPkt->AddAtEnd(i->second);
+            extracted = i->second;
             m_data.erase(i);
             m_size -= pktSize;
             m_availBytes -= pktSize;
             extractSize -= pktSize;
         }
         else
-        { // Partial is extracted and done
-            outPkt->AddAtEnd(i->second->CreateFragment(0, extractSize));
-            m_data[i->first + SequenceNumber32(extractSize)] =
-                i->second->CreateFragment(extractSize, pktSize - extractSize);
-            m_data.erase(i);
+        { // Partial is extracted and done; the rest stays in its map node
+            extracted = i->second->CreateFragment(0, extractSize);
+            i->second->RemoveAtStart(extractSize);
+            auto node = m_data.extract(i);
+            node.key() = node.key() + SequenceNumber32(extractSize);
+            m_data.insert(std::move(node));
             m_size -= extractSize;
             m_availBytes -= extractSize;
             extractSize = 0;
         }
+        // The buffer holds the only reference to its packets, so the first
+        // one can be returned as is, and the next ones appended to it
+        if (!outPkt)
+        {
+            outPkt = extracted;
+            outPkt->RemoveAllPacketTags();
+        }
+        else
+        {
+            outPkt->AddAtEnd(extracted);
+        }
     }
-    if (outPkt->GetSize() == 0)
+    if (!outPkt || outPkt->GetSize() == 0)
     {
         NS_LOG_LOGIC("Nothing extracted.");
         return nullptr;
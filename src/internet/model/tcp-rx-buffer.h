@@ -44,6 +44,13 @@ class Packet;
  * To store data, use Add; for retrieving a certain amount of ordered data, use
  * the method Extract.
  *
+ * Besides the segments themselves, the buffer keeps the blocks of contiguous
+ * out-of-order data as a set of merged intervals, so that the arrival of a
+ * segment updates NextRxSequence and the SACK list without walking the
+ * buffered segments. The segments are handed to the application without
+ * being copied when possible: the first one extracted is returned as is, and
+ * the following ones are appended to it.
+ *
  * SACK list
  * ---------
  *
@@ -144,6 +151,9 @@ class TcpRxBuffer : public Object
      * Extract data from the head of the buffer as indicated by nextRxSeq.
      * The extracted data is going to be forwarded to the application.
      *
+     * The returned packet is the first buffered segment, with the following
+     * segments appended to it; its packet tags are removed.
+     *
      * @param maxSize maximum number of bytes to extract
      * @returns a packet
      */
@@ -191,8 +201,9 @@ class TcpRxBuffer : public Object
      * (or other) options, it is even less. For more detail about this function,
      * please see the source code and in-line comments.
      *
-     * @param head sequence number of the block at the beginning
-     * @param tail sequence number of the block at the end
+     * @param head first sequence number of the contiguous block of data
+     *        containing the segment just received
+     * @param tail sequence number following the end of that block
      */
     void UpdateSackList(const SequenceNumber32& head, const SequenceNumber32& tail);
 
@@ -209,6 +220,18 @@ class TcpRxBuffer : public Object
      */
     void ClearSackList(const SequenceNumber32& seq);
 
+    /**
+     * @brief Add a block of out-of-order data to the interval set
+     *
+     * The block is merged with the intervals it overlaps or is adjacent to.
+     *
+     * @param head first sequence number of the block
+     * @param tail sequence number following the end of the block
+     * @return the merged interval containing the block
+     */
+    TcpOptionSack::SackBlock AddInterval(const SequenceNumber32& head,
+                                         const SequenceNumber32& tail);
+
     TcpOptionSack::SackList m_sackList; //!< Sack list (updated constantly)
 
     /// container for data stored in the buffer
@@ -221,6 +244,9 @@ class TcpRxBuffer : public Object
     uint32_t m_maxBuffer;  //!< Upper bound of the number of data bytes in buffer (RCV.WND)
     uint32_t m_availBytes; //!< Number of bytes available to read, i.e. contiguous block at head
     std::map<SequenceNumber32, Ptr<Packet>> m_data; //!< Corresponding data (may be null)
+    /// Blocks of contiguous data beyond m_nextRxSeq: the first sequence number of
+    /// each block, mapped to the sequence number following its end
+    std::map<SequenceNumber32, SequenceNumber32> m_intervals;
 };
 
 } // namespace ns3
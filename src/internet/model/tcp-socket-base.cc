@@ -2905,7 +2905,9 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
                           header,
                           m_endPoint->GetLocalAddress(),
                           m_endPoint->GetPeerAddress(),
-                          m_boundnetdevice);
+                          m_boundnetdevice,
+                          &m_routeCache,
+                          &m_routeCache6);
     }
     else
     {
@@ -2913,7 +2915,9 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
                           header,
                           m_endPoint6->GetLocalAddress(),
                           m_endPoint6->GetPeerAddress(),
-                          m_boundnetdevice);
+                          m_boundnetdevice,
+                          &m_routeCache,
+                          &m_routeCache6);
     }
 
     if (m_retxEvent.IsExpired() && (hasSyn || hasFin) && !isAck)
@@ -3307,7 +3311,9 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
                           header,
                           m_endPoint->GetLocalAddress(),
                           m_endPoint->GetPeerAddress(),
-                          m_boundnetdevice);
+                          m_boundnetdevice,
+                          &m_routeCache,
+                          &m_routeCache6);
         NS_LOG_DEBUG("Send segment of size "
                      << sz << " with remaining data " << remainingData << " via TcpL4Protocol to "
                      << m_endPoint->GetPeerAddress() << ". Header " << header);
@@ -3318,7 +3324,9 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
                           header,
                           m_endPoint6->GetLocalAddress(),
                           m_endPoint6->GetPeerAddress(),
-                          m_boundnetdevice);
+                          m_boundnetdevice,
+                          &m_routeCache,
+                          &m_routeCache6);
         NS_LOG_DEBUG("Send segment of size "
                      << sz << " with remaining data " << remainingData << " via TcpL4Protocol to "
                      << m_endPoint6->GetPeerAddress() << ". Header " << header);
@@ -4061,7 +4069,9 @@ TcpSocketBase::PersistTimeout()
                           tcpHeader,
                           m_endPoint->GetLocalAddress(),
                           m_endPoint->GetPeerAddress(),
-                          m_boundnetdevice);
+                          m_boundnetdevice,
+                          &m_routeCache,
+                          &m_routeCache6);
     }
     else
     {
@@ -4069,7 +4079,9 @@ TcpSocketBase::PersistTimeout()
                           tcpHeader,
                           m_endPoint6->GetLocalAddress(),
                           m_endPoint6->GetPeerAddress(),
-                          m_boundnetdevice);
+                          m_boundnetdevice,
+                          &m_routeCache,
+                          &m_routeCache6);
     }
 
     NS_LOG_LOGIC("Schedule persist timeout at time "
@@ -10,7 +10,9 @@
 #define TCP_SOCKET_BASE_H
 
 #include "ipv4-header.h"
+#include "ipv4-routing-protocol.h"
 #include "ipv6-header.h"
+#include "ipv6-routing-protocol.h"
 #include "tcp-socket-state.h"
 #include "tcp-socket.h"
 
@@ -1372,6 +1374,8 @@ class TcpSocketBase : public TcpSocket
     // Connections to other layers of TCP/IP
     Ipv4EndPoint* m_endPoint{nullptr};  //!< the IPv4 endpoint
     Ipv6EndPoint* m_endPoint6{nullptr}; //!< the IPv6 endpoint
+    Ipv4RouteCache m_routeCache;        //!< the cached IPv4 route to the peer
+    Ipv6RouteCache m_routeCache6;       //!< the cached IPv6 route to the peer
     Ptr<Node> m_node;                   //!< the associated node
     Ptr<TcpL4Protocol> m_tcp;           //!< the associated TCP L4 protocol
     Callback<void, Ipv4Address, uint8_t, uint8_t, uint8_t, uint32_t>
@@ -48,7 +48,8 @@ TcpTxBuffer::TcpTxBuffer(uint32_t n)
     : m_maxBuffer(32768),
       m_size(0),
       m_sentSize(0),
-      m_firstByteSeq(n)
+      m_firstByteSeq(n),
+      m_lostFrontier(n)
 {
     m_rWndCallback = MakeNullCallback<uint32_t>();
 }
@@ -163,6 +164,7 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
     NS_ASSERT(m_sentList.empty());
     m_sackSeen = false;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostFrontier = seq;
 }
 
 bool
@@ -283,7 +285,7 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     NS_ASSERT(it != m_appList.end());
 
     m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    IndexSentItem(m_sentList.insert(m_sentList.end(), item));
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -297,37 +299,34 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(!m_sentList.empty());
 
-    auto it = m_sentList.begin();
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    auto found = m_sentIndex.find(seq);
+    if (found != m_sentIndex.end())
     {
-        if ((*it)->m_startSeq == seq)
+        auto it = found->second;
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -389,7 +388,7 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                const SequenceNumber32& listStartFrom,
                                uint32_t numBytes,
                                const SequenceNumber32& seq,
-                               bool* listEdited) const
+                               bool* listEdited)
 {
     NS_LOG_FUNCTION(this << numBytes << seq);
 
@@ -425,6 +424,18 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     TcpTxItem* outItem = nullptr;
     auto it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+    bool isSentList = (&list == &m_sentList);
+
+    if (isSentList)
+    {
+        // Start from the item holding seq, instead of walking from SND.UNA
+        auto found = FindSentItem(seq);
+        if (found != m_sentIndex.end())
+        {
+            it = found->second;
+            beginOfCurrentPacket = found->first;
+        }
+    }
 
     while (it != list.end())
     {
@@ -456,10 +467,19 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                          << " and now we recurse because packet ends at "
                                          << beginOfCurrentPacket + currentPacket->GetSize());
                 auto firstPart = new TcpTxItem();
+                if (isSentList)
+                {
+                    UnindexSentItem(currentItem);
+                }
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    IndexSentItem(firstPartIt);
+                    IndexSentItem(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -505,6 +525,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                     NS_ASSERT(it != list.begin());
                     TcpTxItem* previous = *(--it);
 
+                    if (isSentList)
+                    {
+                        UnindexSentItem(previous);
+                    }
                     list.erase(it);
 
                     MergeItems(previous, currentItem);
@@ -522,10 +546,19 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 // the end is inside the current packet, but it isn't exactly
                 // the packet end. Just fragment, fix the list, and return.
                 auto firstPart = new TcpTxItem();
+                if (isSentList)
+                {
+                    UnindexSentItem(currentItem);
+                }
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    IndexSentItem(firstPartIt);
+                    IndexSentItem(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -554,6 +587,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                      // in the previous if
 
             MergeItems(currentItem, next);
+            if (isSentList)
+            {
+                UnindexSentItem(next);
+            }
             list.erase(it);
 
             delete next;
@@ -638,9 +675,11 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // Only the item holding the byte before ack can end at ack
+    auto found = FindSentItem(ack - 1);
+    if (found != m_sentIndex.end())
     {
-        TcpTxItem* item = it;
+        TcpTxItem* item = *found->second;
         Ptr<Packet> p = item->m_packet;
         if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
         {
@@ -695,6 +734,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
             RemoveFromCounts(item, pktSize);
 
+            UnindexSentItem(item);
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
                                    << " sacked: " << m_sackedOut << ". Remaining data " << m_size);
@@ -713,7 +753,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             NS_LOG_INFO(*item);
             // PacketTags are preserved when fragmenting
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
+            UnindexSentItem(item);
             item->m_startSeq += offset;
+            IndexSentItem(i);
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -744,8 +786,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             head->m_sacked = false;
             m_sackedOut -= head->m_packet->GetSize();
             NS_LOG_INFO("Moving the SACK flag from the HEAD to another segment");
-            AddRenoSack();
+            // Mark the head as lost first, as it may be below the lost frontier
             MarkHeadAsLost();
+            AddRenoSack();
         }
 
         NS_ASSERT_MSG(head->m_startSeq == seq,
@@ -777,15 +820,22 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
 
     for (auto option_it = list.begin(); option_it != list.end(); ++option_it)
     {
-        auto item_it = m_sentList.begin();
-        SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
         if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
             NS_LOG_INFO("Not updating scoreboard, the option block is outside the sent list");
             return bytesSacked;
         }
 
+        // Items starting before the block can not be mapped over it: start
+        // from the first item starting at or after the block
+        auto index_it = m_sentIndex.lower_bound((*option_it).first);
+        if (index_it == m_sentIndex.end())
+        {
+            continue;
+        }
+        auto item_it = index_it->second;
+        SequenceNumber32 beginOfCurrentPacket = index_it->first;
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
@@ -867,7 +917,6 @@ TcpTxBuffer::UpdateLostCount()
 {
     NS_LOG_FUNCTION(this);
     uint32_t sacked = 0;
-    SequenceNumber32 beginOfCurrentPacket = m_highestSack.second;
     if (m_highestSack.first == m_sentList.end())
     {
         NS_LOG_INFO("Status before the update: " << *this
@@ -879,33 +928,48 @@ TcpTxBuffer::UpdateLostCount()
                                                  << *(*m_highestSack.first));
     }
 
-    for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
+    // Find the highest item with at least m_dupAckThresh sacked items at or
+    // above it (the head excluded): it and every item below are lost, unless
+    // sacked.
+    auto it = m_highestSack.first;
+    for (; it != m_sentList.begin(); --it)
     {
-        TcpTxItem* item = *it;
-        if (item->m_sacked)
+        if ((*it)->m_sacked)
         {
             sacked++;
         }
-
         if (sacked >= m_dupAckThresh)
         {
+            break;
+        }
+    }
+
+    if (sacked >= m_dupAckThresh)
+    {
+        SequenceNumber32 frontier = (*it)->m_startSeq;
+
+        // Items below m_lostFrontier are already lost or sacked
+        for (; it != m_sentList.begin() && (*it)->m_startSeq >= m_lostFrontier; --it)
+        {
+            TcpTxItem* item = *it;
             if (!item->m_sacked && !item->m_lost)
             {
                 item->m_lost = true;
                 m_lostOut += item->m_packet->GetSize();
             }
         }
-        beginOfCurrentPacket -= item->m_packet->GetSize();
-    }
 
-    if (sacked >= m_dupAckThresh)
-    {
         TcpTxItem* item = *m_sentList.begin();
         if (!item->m_lost)
         {
             item->m_lost = true;
             m_lostOut += item->m_packet->GetSize();
         }
+
+        if (m_lostFrontier < frontier)
+        {
+            m_lostFrontier = frontier;
+        }
     }
     NS_LOG_INFO("Status after the update: " << *this);
     ConsistencyCheck();
@@ -921,24 +985,20 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    auto found = FindSentItem(seq);
+    if (found != m_sentIndex.end())
     {
-        // Search for the right iterator before calling IsLost()
-        if ((*it)->m_startSeq <= seq && seq < (*it)->m_startSeq + (*it)->m_packet->GetSize())
+        const TcpTxItem* item = *found->second;
+        if (item->m_lost)
         {
-            if ((*it)->m_lost)
-            {
-                NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
-                return true;
-            }
+            NS_LOG_INFO("seq=" << seq << " is lost because of lost flag");
+            return true;
+        }
 
-            if ((*it)->m_sacked)
-            {
-                NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
-                return false;
-            }
+        if (item->m_sacked)
+        {
+            NS_LOG_INFO("seq=" << seq << " is not lost because of sacked flag");
+            return false;
         }
     }
 
@@ -972,6 +1032,12 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
     {
         item = *it;
 
+        if (m_sackSeen && item->m_startSeq >= m_highestSack.second)
+        {
+            // No item above the highest SACK byte can satisfy 1.b
+            break;
+        }
+
         // Condition 1.a , 1.b , and 1.c
         if (!item->m_retrans && !item->m_sacked &&
             ((m_sackSeen && item->m_startSeq < m_highestSack.second) || !m_sackSeen))
@@ -1205,6 +1271,7 @@ TcpTxBuffer::ResetRenoSack()
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     m_sackSeen = false;
+    m_lostFrontier = m_firstByteSeq;
 }
 
 void
@@ -1229,12 +1296,14 @@ TcpTxBuffer::ResetSentList()
         m_sentList.pop_back();
     }
 
+    m_sentIndex.clear();
     m_sentSize = 0;
     m_lostOut = 0;
     m_retrans = 0;
     m_sackedOut = 0;
     m_sackSeen = false;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    m_lostFrontier = m_firstByteSeq;
 }
 
 void
@@ -1245,6 +1314,7 @@ TcpTxBuffer::ResetLastSegmentSent()
     {
         TcpTxItem* item = m_sentList.back();
 
+        UnindexSentItem(item);
         m_sentList.pop_back();
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
@@ -1410,9 +1480,7 @@ TcpTxBuffer::AddRenoSack()
 void
 TcpTxBuffer::ConsistencyCheck() const
 {
-    static const bool enable = false;
-
-    if (!enable)
+    if (!m_consistencyCheck)
     {
         return;
     }
@@ -1442,6 +1510,50 @@ TcpTxBuffer::ConsistencyCheck() const
     NS_ASSERT_MSG(lost == m_lostOut, " Counted lost: " << lost << " stored lost: " << m_lostOut);
     NS_ASSERT_MSG(retrans == m_retrans,
                   " Counted retrans: " << retrans << " stored retrans: " << m_retrans);
+
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  "Indexed " << m_sentIndex.size() << " items out of " << m_sentList.size());
+    for (auto it = m_sentIndex.begin(); it != m_sentIndex.end(); ++it)
+    {
+        NS_ASSERT_MSG(it->first == (*it->second)->m_startSeq,
+                      "Item " << **it->second << " indexed at " << it->first);
+    }
+
+    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    {
+        NS_ASSERT_MSG((*it)->m_startSeq >= m_lostFrontier || (*it)->m_lost || (*it)->m_sacked,
+                      "Item " << **it << " below the lost frontier " << m_lostFrontier
+                              << " is neither lost nor sacked");
+    }
+}
+
+void
+TcpTxBuffer::IndexSentItem(PacketList::iterator it)
+{
+    m_sentIndex[(*it)->m_startSeq] = it;
+}
+
+void
+TcpTxBuffer::UnindexSentItem(const TcpTxItem* item)
+{
+    m_sentIndex.erase(item->m_startSeq);
+}
+
+TcpTxBuffer::SentIndex::const_iterator
+TcpTxBuffer::FindSentItem(const SequenceNumber32& seq) const
+{
+    auto it = m_sentIndex.upper_bound(seq);
+    if (it == m_sentIndex.begin())
+    {
+        return m_sentIndex.end();
+    }
+    --it;
+    const TcpTxItem* item = *it->second;
+    if (seq < item->m_startSeq + item->m_packet->GetSize())
+    {
+        return it;
+    }
+    return m_sentIndex.end();
 }
 
 std::ostream&
@@ -18,6 +18,12 @@
 #include "ns3/sequence-number.h"
 #include "ns3/traced-value.h"
 
+#include <list>
+#include <map>
+
+class TcpTxBufferTestCase;
+class TcpTxBufferIndexTestCase;
+
 namespace ns3
 {
 class Packet;
@@ -64,6 +70,13 @@ class Packet;
  * documentation) and maintaining the scoreboard is a matter of travelling the
  * list and set the SACK flag on the corresponding segment sent.
  *
+ * The sent list is also indexed by the starting sequence number of each
+ * item, so that the item holding a sequence number, and the first item of a
+ * SACK block, are found in logarithmic time instead of by walking the list
+ * from SND.UNA.  This keeps the cost of a SACK update proportional to the
+ * size of the SACK blocks, even with hundreds of thousands of segments in
+ * flight.
+ *
  * Item properties
  * ---------------
  *
@@ -400,8 +413,36 @@ class TcpTxBuffer : public Object
 
   private:
     friend std::ostream& operator<<(std::ostream& os, const TcpTxBuffer& tcpTxBuf);
+    /// allow TcpTxBufferTestCase class to enable the consistency check
+    friend class ::TcpTxBufferTestCase;
+    /// allow TcpTxBufferIndexTestCase class access
+    friend class ::TcpTxBufferIndexTestCase;
 
     typedef std::list<TcpTxItem*> PacketList; //!< container for data stored in the buffer
+    typedef std::map<SequenceNumber32, PacketList::iterator>
+        SentIndex; //!< index of the sent list by starting sequence number
+
+    /**
+     * @brief Add an item of the sent list to the index
+     * @param it iterator to the item in m_sentList
+     */
+    void IndexSentItem(PacketList::iterator it);
+
+    /**
+     * @brief Remove an item of the sent list from the index
+     *
+     * Must be called before the starting sequence of the item changes.
+     * @param item the item
+     */
+    void UnindexSentItem(const TcpTxItem* item);
+
+    /**
+     * @brief Find the item of the sent list which holds a sequence number
+     * @param seq the sequence number
+     * @return iterator to the entry of the item in m_sentIndex, or
+     * m_sentIndex.end() if the sequence is not in the sent list
+     */
+    SentIndex::const_iterator FindSentItem(const SequenceNumber32& seq) const;
 
     /**
      * @brief Update the lost count
@@ -418,8 +459,9 @@ class TcpTxBuffer : public Object
      * The {New}Reno cases, for now, are managed in TcpSocketBase through the
      * call to MarkHeadAsLost.
      * This function is, therefore, called after a SACK option has been received,
-     * and updates the lost count. It can be probably optimized by not walking
-     * the entire list, but a subset.
+     * and updates the lost count. Since the segments below m_lostFrontier are
+     * already known to be lost or sacked, only the segments between it and the
+     * highest SACKed segment are walked.
      *
      */
     void UpdateLostCount();
@@ -554,7 +596,7 @@ class TcpTxBuffer : public Object
                                  const SequenceNumber32& startingSeq,
                                  uint32_t numBytes,
                                  const SequenceNumber32& requestedSeq,
-                                 bool* listEdited = nullptr) const;
+                                 bool* listEdited = nullptr);
 
     /**
      * @brief Merge two TcpTxItem
@@ -581,8 +623,11 @@ class TcpTxBuffer : public Object
     void SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const;
 
     /**
-     * @brief Check if the values of sacked, lost, retrans, are in sync
-     * with the sent list.
+     * @brief Check if the values of sacked, lost, retrans, the index of the
+     * sent list and the lost frontier are in sync with the sent list.
+     *
+     * The check walks the whole sent list, and is therefore only done if
+     * m_consistencyCheck is true, and in debug builds.
      */
     void ConsistencyCheck() const;
 
@@ -594,6 +639,7 @@ class TcpTxBuffer : public Object
 
     PacketList m_appList;              //!< Buffer for application data
     PacketList m_sentList;             //!< Buffer for sent (but not acked) data
+    SentIndex m_sentIndex;             //!< Index of m_sentList by starting sequence number
     uint32_t m_maxBuffer;              //!< Max number of data bytes in buffer (SND.WND)
     uint32_t m_size;                   //!< Size of all data in this buffer
     uint32_t m_sentSize;               //!< Size of sent (and not discarded) segments
@@ -602,6 +648,7 @@ class TcpTxBuffer : public Object
     TracedValue<SequenceNumber32>
         m_firstByteSeq; //!< Sequence number of the first byte in data (SND.UNA)
     std::pair<PacketList::const_iterator, SequenceNumber32> m_highestSack; //!< Highest SACK byte
+    SequenceNumber32 m_lostFrontier; //!< Sent items starting below are either lost or sacked
 
     uint32_t m_lostOut{0};   //!< Number of lost bytes
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
@@ -615,6 +662,9 @@ class TcpTxBuffer : public Object
 
     INTERNET_EXPORT static inline Callback<void, TcpTxItem*> m_nullCb =
         MakeNullCallback<void, TcpTxItem*>(); //!< Null callback for an item
+
+    INTERNET_EXPORT static inline bool m_consistencyCheck =
+        false; //!< Whether ConsistencyCheck() is done, enabled by the tests
 };
 
 /**
@@ -626,8 +626,7 @@ UdpSocketImpl::DoSendTo(Ptr<Packet> p, Ipv4Address dest, uint16_t port, uint8_t
         Socket::SocketErrno errno_;
         Ptr<Ipv4Route> route;
         Ptr<NetDevice> oif = m_boundnetdevice; // specify non-zero if bound to a specific device
-        // TBD-- we could cache the route and just check its validity
-        route = ipv4->GetRoutingProtocol()->RouteOutput(p, header, oif, errno_);
+        route = m_routeCache.RouteOutput(ipv4->GetRoutingProtocol(), p, header, oif, errno_);
         if (route)
         {
             NS_LOG_LOGIC("Route exists");
@@ -772,8 +771,7 @@ UdpSocketImpl::DoSendTo(Ptr<Packet> p, Ipv6Address dest, uint16_t port)
         Socket::SocketErrno errno_;
         Ptr<Ipv6Route> route;
         Ptr<NetDevice> oif = m_boundnetdevice; // specify non-zero if bound to a specific device
-        // TBD-- we could cache the route and just check its validity
-        route = ipv6->GetRoutingProtocol()->RouteOutput(p, header, oif, errno_);
+        route = m_routeCache6.RouteOutput(ipv6->GetRoutingProtocol(), p, header, oif, errno_);
         if (route)
         {
             NS_LOG_LOGIC("Route exists");
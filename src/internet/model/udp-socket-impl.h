@@ -10,6 +10,8 @@
 
 #include "icmpv4.h"
 #include "ipv4-interface.h"
+#include "ipv4-routing-protocol.h"
+#include "ipv6-routing-protocol.h"
 #include "udp-socket.h"
 
 #include "ns3/callback.h"
@@ -238,10 +240,12 @@ class UdpSocketImpl : public UdpSocket
                       uint32_t icmpInfo);
 
     // Connections to other layers of TCP/IP
-    Ipv4EndPoint* m_endPoint;  //!< the IPv4 endpoint
-    Ipv6EndPoint* m_endPoint6; //!< the IPv6 endpoint
-    Ptr<Node> m_node;          //!< the associated node
-    Ptr<UdpL4Protocol> m_udp;  //!< the associated UDP L4 protocol
+    Ipv4EndPoint* m_endPoint;     //!< the IPv4 endpoint
+    Ipv6EndPoint* m_endPoint6;    //!< the IPv6 endpoint
+    Ipv4RouteCache m_routeCache;  //!< the cached IPv4 route to the last destination
+    Ipv6RouteCache m_routeCache6; //!< the cached IPv6 route to the last destination
+    Ptr<Node> m_node;             //!< the associated node
+    Ptr<UdpL4Protocol> m_udp;     //!< the associated UDP L4 protocol
     Callback<void, Ipv4Address, uint8_t, uint8_t, uint8_t, uint32_t>
         m_icmpCallback; //!< ICMP callback
     Callback<void, Ipv6Address, uint8_t, uint8_t, uint8_t, uint32_t>
@@ -0,0 +1,169 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-end-point.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-end-point.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Check that Ipv4EndPointDemux finds the same end points as a
+ * linear search would, and keeps its index consistent when end points
+ * are connected and deallocated.
+ */
+class Ipv4EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv4EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4EndPointDemuxTestCase::Ipv4EndPointDemuxTestCase()
+    : TestCase("Check Ipv4EndPointDemux lookups")
+{
+}
+
+void
+Ipv4EndPointDemuxTestCase::DoRun()
+{
+    Ipv4EndPointDemux demux;
+    Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
+    Ipv4Address local("10.0.0.1");
+    Ipv4Address peer1("10.0.0.2");
+    Ipv4Address peer2("10.0.0.3");
+
+    Ipv4EndPoint* listener = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Listening end point not allocated");
+    Ipv4EndPoint* connected = demux.Allocate(nullptr, local, 80, peer1, 1000);
+    NS_TEST_ASSERT_MSG_NE(connected, nullptr, "Connected end point not allocated");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, local, 80, peer1, 1000),
+                          nullptr,
+                          "Duplicated end point allocated");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, 80), nullptr, "Duplicated end point allocated");
+
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), true, "Port 80 is in use");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(81), false, "Port 81 is not in use");
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupLocal(nullptr, local, 80),
+                          true,
+                          "Connected end point not found by local address");
+
+    auto endPoints = demux.Lookup(local, 80, peer1, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Unexpected number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), connected, "Connected end point not found");
+    endPoints = demux.Lookup(local, 80, peer2, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Unexpected number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), listener, "Listening end point not found");
+    endPoints = demux.Lookup(local, 81, peer1, 1000, interface);
+    NS_TEST_EXPECT_MSG_EQ(endPoints.size(), 0, "No end point is bound to port 81");
+    NS_TEST_EXPECT_MSG_EQ(demux.SimpleLookup(local, 80, peer1, 1000),
+                          connected,
+                          "Connected end point not found");
+
+    // An end point connected after its allocation, as done by TCP clients
+    Ipv4EndPoint* client = demux.Allocate(local);
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Ephemeral end point not allocated");
+    client->SetPeer(peer2, 2000);
+    endPoints = demux.Lookup(local, client->GetLocalPort(), peer2, 2000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Unexpected number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), client, "Client end point not found");
+    endPoints = demux.Lookup(local, client->GetLocalPort(), peer1, 2000, interface);
+    NS_TEST_EXPECT_MSG_EQ(endPoints.size(), 0, "Client end point must not match another peer");
+
+    demux.DeAllocate(connected);
+    endPoints = demux.Lookup(local, 80, peer1, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Unexpected number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), listener, "Listening end point not found");
+
+    demux.DeAllocate(listener);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(80), false, "Port 80 is no longer in use");
+    NS_TEST_EXPECT_MSG_EQ(demux.GetAllEndPoints().size(), 1, "Unexpected number of end points");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Check that Ipv6EndPointDemux finds the same end points as a
+ * linear search would, and keeps its index consistent when end points
+ * are connected and deallocated.
+ */
+class Ipv6EndPointDemuxTestCase : public TestCase
+{
+  public:
+    Ipv6EndPointDemuxTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv6EndPointDemuxTestCase::Ipv6EndPointDemuxTestCase()
+    : TestCase("Check Ipv6EndPointDemux lookups")
+{
+}
+
+void
+Ipv6EndPointDemuxTestCase::DoRun()
+{
+    Ipv6EndPointDemux demux;
+    Ptr<Ipv6Interface> interface = CreateObject<Ipv6Interface>();
+    Ipv6Address local("2001:db8::1");
+    Ipv6Address peer1("2001:db8::2");
+    Ipv6Address peer2("2001:db8::3");
+
+    Ipv6EndPoint* listener = demux.Allocate(nullptr, 80);
+    NS_TEST_ASSERT_MSG_NE(listener, nullptr, "Listening end point not allocated");
+    Ipv6EndPoint* connected = demux.Allocate(nullptr, local, 80, peer1, 1000);
+    NS_TEST_ASSERT_MSG_NE(connected, nullptr, "Connected end point not allocated");
+    NS_TEST_EXPECT_MSG_EQ(demux.Allocate(nullptr, local, 80, peer1, 1000),
+                          nullptr,
+                          "Duplicated end point allocated");
+
+    auto endPoints = demux.Lookup(local, 80, peer1, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Unexpected number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), connected, "Connected end point not found");
+    endPoints = demux.Lookup(local, 80, peer2, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Unexpected number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), listener, "Listening end point not found");
+
+    Ipv6EndPoint* client = demux.Allocate(local);
+    NS_TEST_ASSERT_MSG_NE(client, nullptr, "Ephemeral end point not allocated");
+    client->SetPeer(peer2, 2000);
+    client->SetLocalPort(8080);
+    NS_TEST_EXPECT_MSG_EQ(demux.LookupPortLocal(8080), true, "Port 8080 is in use");
+    endPoints = demux.Lookup(local, 8080, peer2, 2000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Unexpected number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), client, "Client end point not found");
+
+    demux.DeAllocate(connected);
+    endPoints = demux.Lookup(local, 80, peer1, 1000, interface);
+    NS_TEST_ASSERT_MSG_EQ(endPoints.size(), 1, "Unexpected number of end points");
+    NS_TEST_EXPECT_MSG_EQ(endPoints.front(), listener, "Listening end point not found");
+    NS_TEST_EXPECT_MSG_EQ(demux.GetEndPoints().size(), 2, "Unexpected number of end points");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief End point demultiplexer TestSuite
+ */
+class EndPointDemuxTestSuite : public TestSuite
+{
+  public:
+    EndPointDemuxTestSuite()
+        : TestSuite("end-point-demux", Type::UNIT)
+    {
+        AddTestCase(new Ipv4EndPointDemuxTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new Ipv6EndPointDemuxTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static EndPointDemuxTestSuite g_endPointDemuxTestSuite; //!< Static variable for test initialization
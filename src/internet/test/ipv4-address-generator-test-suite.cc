@@ -338,6 +338,88 @@ AddressCollisionTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(added, false, "404");
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 address collision Test on many allocated addresses
+ */
+class ManyAddressesCollisionTestCase : public TestCase
+{
+  public:
+    ManyAddressesCollisionTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+ManyAddressesCollisionTestCase::ManyAddressesCollisionTestCase()
+    : TestCase("Make sure that the address collision logic works with many addresses.")
+{
+}
+
+void
+ManyAddressesCollisionTestCase::DoTeardown()
+{
+    Ipv4AddressGenerator::Reset();
+    Simulator::Destroy();
+}
+
+void
+ManyAddressesCollisionTestCase::DoRun()
+{
+    //
+    // Assign 10^6 addresses, two per /30 network as on point-to-point links,
+    // so that the network and broadcast addresses of each network are left
+    // unallocated between the allocated ones.
+    //
+    const uint32_t nNetworks = 500000;
+    Ipv4Mask mask("255.255.255.252");
+    Ipv4AddressGenerator::Init(Ipv4Address("10.0.0.0"), mask, Ipv4Address("0.0.0.1"));
+    for (uint32_t i = 0; i < nNetworks; ++i)
+    {
+        Ipv4AddressGenerator::NextAddress(mask);
+        Ipv4AddressGenerator::NextAddress(mask);
+        Ipv4AddressGenerator::NextNetwork(mask);
+        Ipv4AddressGenerator::InitAddress(Ipv4Address("0.0.0.1"), mask);
+    }
+
+    Ipv4AddressGenerator::TestMode();
+    const uint32_t base = Ipv4Address("10.0.0.0").Get();
+    for (uint32_t network : {0U, 1U, nNetworks / 2, nNetworks - 1})
+    {
+        Ipv4Address first(base + network * 4 + 1);
+        Ipv4Address second(base + network * 4 + 2);
+        Ipv4Address broadcast(base + network * 4 + 3);
+
+        bool allocated = Ipv4AddressGenerator::IsAddressAllocated(first);
+        NS_TEST_EXPECT_MSG_EQ(allocated, true, first << " should be already allocated");
+        allocated = Ipv4AddressGenerator::IsAddressAllocated(second);
+        NS_TEST_EXPECT_MSG_EQ(allocated, true, second << " should be already allocated");
+        bool added = Ipv4AddressGenerator::AddAllocated(second);
+        NS_TEST_EXPECT_MSG_EQ(added, false, second << " should not get allocated");
+
+        allocated = Ipv4AddressGenerator::IsAddressAllocated(broadcast);
+        NS_TEST_EXPECT_MSG_EQ(allocated, false, broadcast << " should not be already allocated");
+        added = Ipv4AddressGenerator::AddAllocated(broadcast);
+        NS_TEST_EXPECT_MSG_EQ(added, true, broadcast << " should get allocated");
+        added = Ipv4AddressGenerator::AddAllocated(broadcast);
+        NS_TEST_EXPECT_MSG_EQ(added, false, broadcast << " should not get allocated");
+
+        bool free = Ipv4AddressGenerator::IsNetworkAllocated(Ipv4Address(base + network * 4),
+                                                               mask);
+        NS_TEST_EXPECT_MSG_EQ(free, false, "network " << network << " should be allocated");
+    }
+
+    Ipv4Address unused(base + nNetworks * 4);
+    bool allocated = Ipv4AddressGenerator::IsAddressAllocated(unused);
+    NS_TEST_EXPECT_MSG_EQ(allocated, false, unused << " should not be already allocated");
+    bool free = Ipv4AddressGenerator::IsNetworkAllocated(unused, mask);
+    NS_TEST_EXPECT_MSG_EQ(free, true, "network " << unused << " should not be allocated");
+    free = Ipv4AddressGenerator::IsNetworkAllocated(Ipv4Address("10.0.0.0"), Ipv4Mask("/16"));
+    NS_TEST_EXPECT_MSG_EQ(free, false, "network 10.0.0.0/16 should be allocated");
+}
+
 /**
  * @ingroup internet-test
  *
@@ -359,6 +441,7 @@ Ipv4AddressGeneratorTestSuite::Ipv4AddressGeneratorTestSuite()
     AddTestCase(new NetworkAndAddressTestCase(), TestCase::Duration::QUICK);
     AddTestCase(new ExampleAddressGeneratorTestCase(), TestCase::Duration::QUICK);
     AddTestCase(new AddressCollisionTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new ManyAddressesCollisionTestCase(), TestCase::Duration::EXTENSIVE);
 }
 
 static Ipv4AddressGeneratorTestSuite
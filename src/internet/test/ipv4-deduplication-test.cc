@@ -532,6 +532,110 @@ Ipv4DeduplicationTest::CheckDrops(const std::string& name)
     }
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 Deduplication cache expiry Test
+ *
+ * The duplicate entries are checked directly in the cache of an
+ * Ipv4L3Protocol, which removes the expired entries in batches, every
+ * PurgeExpiredPeriod, skipping the entries refreshed since they were queued.
+ */
+class Ipv4DuplicateExpiryTest : public TestCase
+{
+  public:
+    Ipv4DuplicateExpiryTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Register a packet in the duplicate cache.
+     * @param id the identification of the packet
+     * @return true if the packet is a duplicate
+     */
+    bool Update(uint16_t id);
+
+    /**
+     * @brief Check the size of the duplicate cache.
+     * @param entries the expected number of entries
+     * @param queued the expected number of queued expirations
+     */
+    void CheckCache(uint32_t entries, uint32_t queued);
+
+    Ptr<Ipv4L3Protocol> m_ipv4; //!< IPv4 protocol holding the duplicate cache
+};
+
+Ipv4DuplicateExpiryTest::Ipv4DuplicateExpiryTest()
+    : TestCase("Verify the expiry of the IPv4 duplicate cache entries")
+{
+}
+
+bool
+Ipv4DuplicateExpiryTest::Update(uint16_t id)
+{
+    Ipv4Header header;
+    header.SetSource(Ipv4Address("10.0.0.1"));
+    header.SetDestination(Ipv4Address("239.1.2.3"));
+    header.SetProtocol(17);
+    header.SetIdentification(id);
+    header.SetPayloadSize(100);
+    return m_ipv4->UpdateDuplicate(Create<Packet>(100), header);
+}
+
+void
+Ipv4DuplicateExpiryTest::CheckCache(uint32_t entries, uint32_t queued)
+{
+    NS_TEST_EXPECT_MSG_EQ(m_ipv4->m_dups.size(),
+                          entries,
+                          "Unexpected number of entries at " << Simulator::Now().As(Time::MS));
+    NS_TEST_EXPECT_MSG_EQ(m_ipv4->m_dupExpiries.size(),
+                          queued,
+                          "Unexpected queued expirations at " << Simulator::Now().As(Time::MS));
+}
+
+void
+Ipv4DuplicateExpiryTest::DoRun()
+{
+    m_ipv4 = CreateObject<Ipv4L3Protocol>();
+    m_ipv4->SetAttribute("DuplicateExpire", TimeValue(MilliSeconds(10)));
+    m_ipv4->SetAttribute("PurgeExpiredPeriod", TimeValue(MilliSeconds(20)));
+
+    // packet 1 expires at 10 ms, and is then refreshed until 15 ms
+    NS_TEST_EXPECT_MSG_EQ(Update(1), false, "New packet seen as a duplicate");
+    NS_TEST_EXPECT_MSG_EQ(Update(1), true, "Duplicate packet not detected");
+    CheckCache(1, 2);
+    Simulator::Schedule(MilliSeconds(5), [this]() {
+        NS_TEST_EXPECT_MSG_EQ(Update(1), true, "Duplicate packet not detected");
+        NS_TEST_EXPECT_MSG_EQ(Update(2), false, "New packet seen as a duplicate");
+        CheckCache(2, 4);
+    });
+    // the first purge, at 10 ms, removes nothing, as no entry has expired
+    Simulator::Schedule(MilliSeconds(12), [this]() { CheckCache(2, 4); });
+    // packet 2, expired, is seen again and refreshed until 35 ms
+    Simulator::Schedule(MilliSeconds(25), [this]() {
+        NS_TEST_EXPECT_MSG_EQ(Update(2), false, "Expired packet seen as a duplicate");
+        CheckCache(2, 5);
+    });
+    // the second purge, at 30 ms, removes packet 1, and skips the expiration
+    // of packet 2 queued before it was refreshed
+    Simulator::Schedule(MilliSeconds(31), [this]() {
+        CheckCache(1, 1);
+        NS_TEST_EXPECT_MSG_EQ(Update(2), true, "Duplicate packet not detected");
+        NS_TEST_EXPECT_MSG_EQ(Update(1), false, "Purged packet seen as a duplicate");
+        CheckCache(2, 3);
+    });
+    // the third purge, at 50 ms, removes everything, and is the last one
+    Simulator::Schedule(MilliSeconds(51), [this]() {
+        CheckCache(0, 0);
+        NS_TEST_EXPECT_MSG_EQ(m_ipv4->m_cleanDpd.IsPending(), false, "Purge of an empty cache");
+    });
+
+    Simulator::Run();
+    Simulator::Destroy();
+    m_ipv4 = nullptr;
+}
+
 /**
  * @ingroup internet-test
  *
@@ -552,6 +656,7 @@ Ipv4DeduplicationTestSuite::Ipv4DeduplicationTestSuite()
     AddTestCase(new Ipv4DeduplicationTest(false), TestCase::Duration::QUICK);
     // degenerate case is enabled RFC but with too short an expiry
     AddTestCase(new Ipv4DeduplicationTest(true, MicroSeconds(50)), TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4DuplicateExpiryTest, TestCase::Duration::QUICK);
 }
 
 static Ipv4DeduplicationTestSuite
@@ -39,6 +39,7 @@
 #include <netinet/in.h>
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <string>
 
@@ -564,6 +565,114 @@ Ipv4FragmentationTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 reassembly of out of order, duplicate and overlapping fragments
+ *
+ * The fragments are added directly to Ipv4L3Protocol::Fragments, which
+ * merges the overlapping fragments without overwriting the data received
+ * first, and completes the packet once its 8-byte blocks are covered.
+ */
+class Ipv4FragmentsTest : public TestCase
+{
+  public:
+    Ipv4FragmentsTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Add a fragment of the payload.
+     * @param fragments the fragments of the packet
+     * @param offset the offset of the fragment
+     * @param size the size of the fragment
+     * @param moreFragment the bit "More Fragment"
+     */
+    void Add(Ptr<Ipv4L3Protocol::Fragments> fragments,
+             uint16_t offset,
+             uint32_t size,
+             bool moreFragment);
+
+    /**
+     * @brief Check the reassembled packet.
+     * @param fragments the fragments of the packet
+     * @param size the expected size of the packet
+     */
+    void CheckPacket(Ptr<Ipv4L3Protocol::Fragments> fragments, uint32_t size);
+
+    std::vector<uint8_t> m_payload; //!< Payload of the fragmented packet
+};
+
+Ipv4FragmentsTest::Ipv4FragmentsTest()
+    : TestCase("Verify the IPv4 reassembly of out of order, duplicate and overlapping fragments")
+{
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        m_payload.push_back(static_cast<uint8_t>(i + 1));
+    }
+}
+
+void
+Ipv4FragmentsTest::Add(Ptr<Ipv4L3Protocol::Fragments> fragments,
+                       uint16_t offset,
+                       uint32_t size,
+                       bool moreFragment)
+{
+    fragments->AddFragment(Create<Packet>(m_payload.data() + offset, size), offset, moreFragment);
+}
+
+void
+Ipv4FragmentsTest::CheckPacket(Ptr<Ipv4L3Protocol::Fragments> fragments, uint32_t size)
+{
+    Ptr<Packet> packet = fragments->GetPacket();
+    NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), size, "Unexpected size of the reassembled packet");
+    std::vector<uint8_t> data(size);
+    packet->CopyData(data.data(), size);
+    NS_TEST_EXPECT_MSG_EQ(std::equal(data.begin(), data.end(), m_payload.begin()),
+                          true,
+                          "Unexpected data in the reassembled packet");
+}
+
+void
+Ipv4FragmentsTest::DoRun()
+{
+    // out of order
+    auto fragments = Create<Ipv4L3Protocol::Fragments>();
+    Add(fragments, 16, 8, false);
+    Add(fragments, 0, 8, true);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), false, "Missing fragment at offset 8");
+    Add(fragments, 8, 8, true);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), true, "Out of order fragments not reassembled");
+    CheckPacket(fragments, 24);
+
+    // duplicate fragments, including a final fragment shorter than a block
+    fragments = Create<Ipv4L3Protocol::Fragments>();
+    Add(fragments, 8, 5, false);
+    Add(fragments, 8, 5, false);
+    Add(fragments, 0, 8, true);
+    Add(fragments, 0, 8, true);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), true, "Duplicate fragments not reassembled");
+    CheckPacket(fragments, 13);
+
+    // overlapping fragments, merged
+    fragments = Create<Ipv4L3Protocol::Fragments>();
+    Add(fragments, 0, 12, true);
+    Add(fragments, 8, 8, false);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), true, "Overlapping fragments not reassembled");
+    CheckPacket(fragments, 16);
+
+    // a block partially covered is missing
+    fragments = Create<Ipv4L3Protocol::Fragments>();
+    Add(fragments, 0, 8, true);
+    Add(fragments, 16, 4, false);
+    Add(fragments, 8, 4, true);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), false, "Bytes 12 to 15 are missing");
+    Add(fragments, 8, 8, true);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), true, "Gap not filled");
+    CheckPacket(fragments, 20);
+}
+
 /**
  * @ingroup internet-test
  *
@@ -580,6 +689,7 @@ Ipv4FragmentationTestSuite::Ipv4FragmentationTestSuite()
 {
     AddTestCase(new Ipv4FragmentationTest(false), TestCase::Duration::QUICK);
     AddTestCase(new Ipv4FragmentationTest(true), TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4FragmentsTest, TestCase::Duration::QUICK);
 }
 
 static Ipv4FragmentationTestSuite
@@ -33,6 +33,7 @@
 #include <sys/socket.h>
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <sstream>
 #include <string>
@@ -279,6 +280,71 @@ Ipv4HeaderTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 Header checksum update Test
+ */
+class Ipv4HeaderChecksumTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    Ipv4HeaderChecksumTest();
+};
+
+Ipv4HeaderChecksumTest::Ipv4HeaderChecksumTest()
+    : TestCase("IPv4 Header checksum update")
+{
+}
+
+void
+Ipv4HeaderChecksumTest::DoRun()
+{
+    Ipv4Header header;
+    header.EnableChecksum();
+    header.SetSource(Ipv4Address("10.1.2.3"));
+    header.SetDestination(Ipv4Address("192.168.0.255"));
+    header.SetProtocol(17);
+    header.SetPayloadSize(1000);
+    header.SetIdentification(0xbeef);
+    header.SetTtl(64);
+    Ptr<Packet> packet = Create<Packet>(1000);
+    packet->AddHeader(header);
+
+    // The TTL of a received header is decremented, as when forwarding, and
+    // the checksum is then updated incrementally
+    for (uint8_t ttl = 63; ttl > 60; ttl--)
+    {
+        Ipv4Header received;
+        received.EnableChecksum();
+        packet->RemoveHeader(received);
+        NS_TEST_EXPECT_MSG_EQ(received.IsChecksumOk(), true, "Bad checksum");
+        received.SetTtl(ttl);
+        packet->AddHeader(received);
+
+        // The header must be serialized as one built from scratch
+        Ptr<Packet> expected = Create<Packet>(1000);
+        header.SetTtl(ttl);
+        expected->AddHeader(header);
+        uint8_t buf[20];
+        uint8_t expectedBuf[20];
+        packet->CopyData(buf, 20);
+        expected->CopyData(expectedBuf, 20);
+        NS_TEST_EXPECT_MSG_EQ(std::equal(buf, buf + 20, expectedBuf),
+                              true,
+                              "Bad header after TTL update to " << +ttl);
+    }
+
+    // Changing another field invalidates the received checksum
+    Ipv4Header received;
+    received.EnableChecksum();
+    packet->RemoveHeader(received);
+    received.SetDestination(Ipv4Address("10.0.0.1"));
+    packet->AddHeader(received);
+    packet->RemoveHeader(received);
+    NS_TEST_EXPECT_MSG_EQ(received.IsChecksumOk(), true, "Bad checksum after update");
+}
+
 /**
  * @ingroup internet-test
  *
@@ -291,6 +357,7 @@ class Ipv4HeaderTestSuite : public TestSuite
         : TestSuite("ipv4-header", Type::UNIT)
     {
         AddTestCase(new Ipv4HeaderTest, TestCase::Duration::QUICK);
+        AddTestCase(new Ipv4HeaderChecksumTest, TestCase::Duration::QUICK);
     }
 };
 
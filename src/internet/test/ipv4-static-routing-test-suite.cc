@@ -9,9 +9,15 @@
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-global-routing.h"
+#include "ns3/ipv4-list-routing.h"
+#include "ns3/ipv4-routing-protocol.h"
+#include "ns3/ipv4-routing-table-entry.h"
 #include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
 #include "ns3/node-container.h"
 #include "ns3/node.h"
+#include "ns3/object-accounting.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
 #include "ns3/simple-channel.h"
@@ -144,18 +150,18 @@ Ipv4StaticRoutingSlash32TestCase::DoRun()
     ipv4.SetBase("10.1.1.4", "255.255.255.252");
     Ipv4InterfaceContainer iBiC = ipv4.Assign(dBdC);
 
-    Ptr<Ipv4> ipv4A = nA->GetObject<Ipv4>();
+    Ptr<Ipv4> nodeIpv4 = nA->GetObject<Ipv4>();
     Ptr<Ipv4> ipv4B = nB->GetObject<Ipv4>();
     Ptr<Ipv4> ipv4C = nC->GetObject<Ipv4>();
 
-    int32_t ifIndexA = ipv4A->AddInterface(deviceA);
+    int32_t ifIndexA = nodeIpv4->AddInterface(deviceA);
     int32_t ifIndexC = ipv4C->AddInterface(deviceC);
 
     Ipv4InterfaceAddress ifInAddrA =
         Ipv4InterfaceAddress(Ipv4Address("172.16.1.1"), Ipv4Mask("/32"));
-    ipv4A->AddAddress(ifIndexA, ifInAddrA);
-    ipv4A->SetMetric(ifIndexA, 1);
-    ipv4A->SetUp(ifIndexA);
+    nodeIpv4->AddAddress(ifIndexA, ifInAddrA);
+    nodeIpv4->SetMetric(ifIndexA, 1);
+    nodeIpv4->SetUp(ifIndexA);
 
     Ipv4InterfaceAddress ifInAddrC =
         Ipv4InterfaceAddress(Ipv4Address("192.168.1.1"), Ipv4Mask("/32"));
@@ -165,7 +171,7 @@ Ipv4StaticRoutingSlash32TestCase::DoRun()
 
     Ipv4StaticRoutingHelper ipv4RoutingHelper;
     // Create static routes from A to C
-    Ptr<Ipv4StaticRouting> staticRoutingA = ipv4RoutingHelper.GetStaticRouting(ipv4A);
+    Ptr<Ipv4StaticRouting> staticRoutingA = ipv4RoutingHelper.GetStaticRouting(nodeIpv4);
     // The ifIndex for this outbound route is 1; the first p2p link added
     staticRoutingA->AddHostRouteTo(Ipv4Address("192.168.1.1"), Ipv4Address("10.1.1.2"), 1);
     Ptr<Ipv4StaticRouting> staticRoutingB = ipv4RoutingHelper.GetStaticRouting(ipv4B);
@@ -196,6 +202,187 @@ Ipv4StaticRoutingSlash32TestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 route cache Test
+ *
+ * Checks that Ipv4RouteCache returns the cached route as long as the routes
+ * of the routing protocols are unchanged, and looks the route up again when
+ * they change.
+ */
+class Ipv4RouteCacheTestCase : public TestCase
+{
+  public:
+    Ipv4RouteCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4RouteCacheTestCase::Ipv4RouteCacheTestCase()
+    : TestCase("Route cache invalidated by routing table changes")
+{
+}
+
+void
+Ipv4RouteCacheTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+
+    NetDeviceContainer devices;
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        device->SetChannel(CreateObject<SimpleChannel>());
+        node->AddDevice(device);
+        devices.Add(device);
+    }
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    ipv4.Assign(devices.Get(0));
+    ipv4.SetBase("10.2.2.0", "255.255.255.0");
+    ipv4.Assign(devices.Get(1));
+
+    Ptr<Ipv4> nodeIpv4 = node->GetObject<Ipv4>();
+    Ptr<Ipv4RoutingProtocol> routing = nodeIpv4->GetRoutingProtocol();
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    Ptr<Ipv4StaticRouting> staticRouting = ipv4RoutingHelper.GetStaticRouting(nodeIpv4);
+    staticRouting->SetDefaultRoute(Ipv4Address("10.1.1.2"), 1);
+
+    Ipv4RouteCache cache;
+    Ipv4Header header;
+    header.SetDestination(Ipv4Address("10.9.9.9"));
+    Socket::SocketErrno sockerr;
+
+    Ptr<Ipv4Route> route = cache.RouteOutput(routing, nullptr, header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "No route found");
+    NS_TEST_EXPECT_MSG_EQ(route->GetGateway(), Ipv4Address("10.1.1.2"), "Wrong gateway");
+    NS_TEST_EXPECT_MSG_EQ(cache.RouteOutput(routing, nullptr, header, nullptr, sockerr),
+                          route,
+                          "The route has not been cached");
+    NS_TEST_EXPECT_MSG_EQ(sockerr, Socket::ERROR_NOTERROR, "Wrong error for a cached route");
+
+    // A more specific route replaces the cached one
+    staticRouting->AddNetworkRouteTo(Ipv4Address("10.9.9.0"),
+                                     Ipv4Mask("255.255.255.0"),
+                                     Ipv4Address("10.2.2.2"),
+                                     2);
+    route = cache.RouteOutput(routing, nullptr, header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "No route found");
+    NS_TEST_EXPECT_MSG_EQ(route->GetGateway(),
+                          Ipv4Address("10.2.2.2"),
+                          "The cached route has not been invalidated by a new route");
+
+    // The route through an interface which goes down is removed
+    nodeIpv4->SetDown(2);
+    route = cache.RouteOutput(routing, nullptr, header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "No route found");
+    NS_TEST_EXPECT_MSG_EQ(route->GetGateway(),
+                          Ipv4Address("10.1.1.2"),
+                          "The cached route has not been invalidated by an interface down");
+
+    // A different destination is looked up
+    header.SetDestination(Ipv4Address("10.1.1.3"));
+    route = cache.RouteOutput(routing, nullptr, header, nullptr, sockerr);
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "No route found");
+    NS_TEST_EXPECT_MSG_EQ(route->GetGateway(),
+                          Ipv4Address::GetAny(),
+                          "The route cached for another destination has been used");
+
+    // The routes chosen at random among equal cost routes are not cached
+    int16_t priority;
+    Ptr<Ipv4ListRouting> listRouting = DynamicCast<Ipv4ListRouting>(routing);
+    for (uint32_t i = 0; i < listRouting->GetNRoutingProtocols(); i++)
+    {
+        Ptr<Ipv4GlobalRouting> globalRouting =
+            DynamicCast<Ipv4GlobalRouting>(listRouting->GetRoutingProtocol(i, priority));
+        if (globalRouting)
+        {
+            globalRouting->SetAttribute("RandomEcmpRouting", BooleanValue(true));
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(routing->GetRouteGeneration(), 0, "The routes should not be cached");
+    route = cache.RouteOutput(routing, nullptr, header, nullptr, sockerr);
+    NS_TEST_EXPECT_MSG_NE(cache.RouteOutput(routing, nullptr, header, nullptr, sockerr),
+                          route,
+                          "The route has been cached");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 routing table entries accounting Test
+ *
+ * Checks that the entries of a static routing table are counted by the
+ * ObjectAccounting until they are removed.
+ */
+class Ipv4StaticRoutingAccountingTestCase : public TestCase
+{
+  public:
+    Ipv4StaticRoutingAccountingTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4StaticRoutingAccountingTestCase::Ipv4StaticRoutingAccountingTestCase()
+    : TestCase("Routing table entries counted by the ObjectAccounting")
+{
+}
+
+void
+Ipv4StaticRoutingAccountingTestCase::DoRun()
+{
+    bool wasEnabled = ObjectAccounting::IsEnabled();
+    ObjectAccounting::Enable();
+    ObjectAccounting::Counter* routes =
+        ObjectAccounting::LookupCounter("ns3::Ipv4RoutingTableEntry");
+    ObjectAccounting::Counter* multicastRoutes =
+        ObjectAccounting::LookupCounter("ns3::Ipv4MulticastRoutingTableEntry");
+    ObjectAccounting::Counter routesBefore = *routes;
+    ObjectAccounting::Counter multicastRoutesBefore = *multicastRoutes;
+
+    Ptr<Ipv4StaticRouting> staticRouting = CreateObject<Ipv4StaticRouting>();
+    staticRouting->AddNetworkRouteTo(Ipv4Address("10.1.0.0"),
+                                     Ipv4Mask("255.255.0.0"),
+                                     Ipv4Address("10.2.2.2"),
+                                     1);
+    staticRouting->AddHostRouteTo(Ipv4Address("10.3.3.3"), 2);
+    staticRouting->AddMulticastRoute(Ipv4Address("10.1.1.1"),
+                                     Ipv4Address("225.1.2.3"),
+                                     1,
+                                     std::vector<uint32_t>{2});
+
+    NS_TEST_EXPECT_MSG_EQ(routes->live - routesBefore.live, 2, "Wrong number of live routes");
+    NS_TEST_EXPECT_MSG_EQ(routes->bytes - routesBefore.bytes,
+                          2 * sizeof(Ipv4RoutingTableEntry),
+                          "Wrong size of the live routes");
+    NS_TEST_EXPECT_MSG_EQ(multicastRoutes->live - multicastRoutesBefore.live,
+                          1,
+                          "Wrong number of live multicast routes");
+
+    staticRouting->RemoveRoute(0);
+    NS_TEST_EXPECT_MSG_EQ(routes->live - routesBefore.live, 1, "Removed route not uncounted");
+
+    staticRouting->Dispose();
+    NS_TEST_EXPECT_MSG_EQ(routes->live, routesBefore.live, "Routes not uncounted");
+    NS_TEST_EXPECT_MSG_EQ(routes->bytes, routesBefore.bytes, "Routes not uncounted");
+    NS_TEST_EXPECT_MSG_EQ(multicastRoutes->live,
+                          multicastRoutesBefore.live,
+                          "Multicast routes not uncounted");
+
+    if (!wasEnabled)
+    {
+        ObjectAccounting::Disable();
+    }
+}
+
 /**
  * @ingroup internet-test
  *
@@ -211,6 +398,8 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite()
     : TestSuite("ipv4-static-routing", Type::UNIT)
 {
     AddTestCase(new Ipv4StaticRoutingSlash32TestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4RouteCacheTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4StaticRoutingAccountingTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite
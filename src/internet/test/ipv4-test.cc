@@ -72,6 +72,32 @@ Ipv4L3ProtocolTestCase::DoRun()
     interface->AddAddress(ifaceAddr4);
     uint32_t num = interface->GetNAddresses();
     NS_TEST_ASSERT_MSG_EQ(num, 4, "Should find 4 interfaces??");
+
+    /* Test the index of the node addresses */
+    NS_TEST_ASSERT_MSG_EQ(ipv4->GetInterfaceForAddress(Ipv4Address::GetLoopback()),
+                          0,
+                          "Loopback address not found??");
+    NS_TEST_ASSERT_MSG_EQ(ipv4->GetInterfaceForAddress(Ipv4Address("10.30.0.1")),
+                          static_cast<int32_t>(index),
+                          "Address not found??");
+    NS_TEST_ASSERT_MSG_EQ(ipv4->IsDestinationAddress(Ipv4Address("192.168.0.2"), index),
+                          true,
+                          "Address not local??");
+    NS_TEST_ASSERT_MSG_EQ(ipv4->IsDestinationAddress(Ipv4Address("192.168.0.255"), index),
+                          true,
+                          "Broadcast address not local??");
+    NS_TEST_ASSERT_MSG_EQ(ipv4->IsDestinationAddress(Ipv4Address("192.168.0.3"), index),
+                          false,
+                          "Foreign address local??");
+    ipv4->SetAttribute("StrongEndSystemModel", BooleanValue(true));
+    NS_TEST_ASSERT_MSG_EQ(ipv4->IsDestinationAddress(Ipv4Address("10.30.0.1"), 0),
+                          false,
+                          "Address of another interface local with Strong End System Model??");
+    ipv4->SetAttribute("StrongEndSystemModel", BooleanValue(false));
+    NS_TEST_ASSERT_MSG_EQ(ipv4->IsDestinationAddress(Ipv4Address("10.30.0.1"), 0),
+                          true,
+                          "Address of another interface not local with Weak End System Model??");
+
     interface->RemoveAddress(2);
     num = interface->GetNAddresses();
     NS_TEST_ASSERT_MSG_EQ(num, 3, "Should find 3 interfaces??");
@@ -83,6 +109,9 @@ Ipv4L3ProtocolTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(ifaceAddr4, output, "Wrong Interface Address Removed??");
     num = interface->GetNAddresses();
     NS_TEST_ASSERT_MSG_EQ(num, 2, "Should find 2 addresses??");
+    NS_TEST_ASSERT_MSG_EQ(ipv4->GetInterfaceForAddress(Ipv4Address("250.0.0.1")),
+                          -1,
+                          "Removed address still found??");
 
     /* Remove a non-existent Address */
     output = interface->RemoveAddress(Ipv4Address("253.123.9.81"));
@@ -101,6 +130,9 @@ Ipv4L3ProtocolTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(true, result, "Unable to remove Address??");
     num = interface->GetNAddresses();
     NS_TEST_ASSERT_MSG_EQ(num, 1, "Should find 1 addresses??");
+    NS_TEST_ASSERT_MSG_EQ(ipv4->IsDestinationAddress(Ipv4Address("192.168.0.2"), index),
+                          false,
+                          "Removed address still local??");
 
     /* Remove a non-existent Address */
     result = ipv4->RemoveAddress(index, Ipv4Address("189.0.0.1"));
@@ -330,6 +330,96 @@ AddressCollision6TestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(added, false, "address should not get allocated");
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv6 address collision Test on many allocated addresses
+ */
+class ManyAddressesCollision6TestCase : public TestCase
+{
+  public:
+    ManyAddressesCollision6TestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+ManyAddressesCollision6TestCase::ManyAddressesCollision6TestCase()
+    : TestCase("Make sure that the address collision logic works with many addresses.")
+{
+}
+
+void
+ManyAddressesCollision6TestCase::DoTeardown()
+{
+    Ipv6AddressGenerator::Reset();
+    Simulator::Destroy();
+}
+
+void
+ManyAddressesCollision6TestCase::DoRun()
+{
+    //
+    // Assign 10^6 addresses, the interface identifiers ::1 and ::2 of
+    // consecutive /64 networks, so that the allocated addresses of different
+    // networks are not contiguous.
+    //
+    const uint32_t nNetworks = 500000;
+    Ipv6Prefix prefix(64);
+    Ipv6AddressGenerator::Init(Ipv6Address("2001:db8::"), prefix, Ipv6Address("::1"));
+    for (uint32_t i = 0; i < nNetworks; ++i)
+    {
+        Ipv6AddressGenerator::NextAddress(prefix);
+        Ipv6AddressGenerator::NextAddress(prefix);
+        Ipv6AddressGenerator::NextNetwork(prefix);
+    }
+
+    // Address of 2001:db8::/32 with the given network number and interface identifier
+    auto makeAddress = [](uint32_t network, uint8_t interfaceId) {
+        uint8_t buf[16] = {0x20, 0x01, 0x0d, 0xb8};
+        buf[4] = network >> 24;
+        buf[5] = network >> 16;
+        buf[6] = network >> 8;
+        buf[7] = network;
+        buf[15] = interfaceId;
+        return Ipv6Address(buf);
+    };
+
+    Ipv6AddressGenerator::TestMode();
+    for (uint32_t network : {0U, 1U, nNetworks / 2, nNetworks - 1})
+    {
+        Ipv6Address first = makeAddress(network, 1);
+        Ipv6Address second = makeAddress(network, 2);
+        Ipv6Address third = makeAddress(network, 3);
+
+        bool allocated = Ipv6AddressGenerator::IsAddressAllocated(first);
+        NS_TEST_EXPECT_MSG_EQ(allocated, true, first << " should be already allocated");
+        allocated = Ipv6AddressGenerator::IsAddressAllocated(second);
+        NS_TEST_EXPECT_MSG_EQ(allocated, true, second << " should be already allocated");
+        bool added = Ipv6AddressGenerator::AddAllocated(second);
+        NS_TEST_EXPECT_MSG_EQ(added, false, second << " should not get allocated");
+
+        allocated = Ipv6AddressGenerator::IsAddressAllocated(third);
+        NS_TEST_EXPECT_MSG_EQ(allocated, false, third << " should not be already allocated");
+        added = Ipv6AddressGenerator::AddAllocated(third);
+        NS_TEST_EXPECT_MSG_EQ(added, true, third << " should get allocated");
+        added = Ipv6AddressGenerator::AddAllocated(third);
+        NS_TEST_EXPECT_MSG_EQ(added, false, third << " should not get allocated");
+
+        bool free = Ipv6AddressGenerator::IsNetworkAllocated(makeAddress(network, 0), prefix);
+        NS_TEST_EXPECT_MSG_EQ(free, false, "network " << network << " should be allocated");
+    }
+
+    Ipv6Address unused = makeAddress(nNetworks, 1);
+    bool allocated = Ipv6AddressGenerator::IsAddressAllocated(unused);
+    NS_TEST_EXPECT_MSG_EQ(allocated, false, unused << " should not be already allocated");
+    bool free = Ipv6AddressGenerator::IsNetworkAllocated(makeAddress(nNetworks, 0), prefix);
+    NS_TEST_EXPECT_MSG_EQ(free, true, "network " << nNetworks << " should not be allocated");
+    free = Ipv6AddressGenerator::IsNetworkAllocated(Ipv6Address("2001:db8::"), Ipv6Prefix(32));
+    NS_TEST_EXPECT_MSG_EQ(free, false, "network 2001:db8::/32 should be allocated");
+}
+
 /**
  * @ingroup internet-test
  *
@@ -346,6 +436,7 @@ class Ipv6AddressGeneratorTestSuite : public TestSuite
         AddTestCase(new NetworkAndAddress6TestCase(), TestCase::Duration::QUICK);
         AddTestCase(new ExampleAddress6GeneratorTestCase(), TestCase::Duration::QUICK);
         AddTestCase(new AddressCollision6TestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new ManyAddressesCollision6TestCase(), TestCase::Duration::EXTENSIVE);
     }
 };
 
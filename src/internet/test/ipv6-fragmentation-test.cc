@@ -24,6 +24,7 @@
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/ipv4-raw-socket-factory.h"
 #include "ns3/ipv4-static-routing.h"
+#include "ns3/ipv6-extension.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-list-routing.h"
 #include "ns3/ipv6-raw-socket-factory.h"
@@ -47,6 +48,7 @@
 #include <netinet/in.h>
 #endif
 
+#include <algorithm>
 #include <limits>
 #include <string>
 
@@ -603,6 +605,125 @@ Ipv6FragmentationTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv6 reassembly of out of order, duplicate and overlapping fragments
+ *
+ * The fragments are added directly to Ipv6ExtensionFragment::Fragments,
+ * which never reassembles a packet with overlapping fragments, duplicates
+ * included (RFC 8200, Section 4.5).
+ */
+class Ipv6FragmentsTest : public TestCase
+{
+  public:
+    Ipv6FragmentsTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * @brief Create the fragments of a packet.
+     * @return the fragments, with an unfragmentable part of 40 bytes
+     */
+    Ptr<Ipv6ExtensionFragment::Fragments> CreateFragments() const;
+
+    /**
+     * @brief Add a fragment of the payload.
+     * @param fragments the fragments of the packet
+     * @param offset the offset of the fragment
+     * @param size the size of the fragment
+     * @param moreFragment the bit "More Fragment"
+     */
+    void Add(Ptr<Ipv6ExtensionFragment::Fragments> fragments,
+             uint16_t offset,
+             uint32_t size,
+             bool moreFragment);
+
+    std::vector<uint8_t> m_payload; //!< Payload of the fragmented packet
+};
+
+Ipv6FragmentsTest::Ipv6FragmentsTest()
+    : TestCase("Verify the IPv6 reassembly of out of order, duplicate and overlapping fragments")
+{
+    for (uint32_t i = 0; i < 64; i++)
+    {
+        m_payload.push_back(static_cast<uint8_t>(i + 1));
+    }
+}
+
+Ptr<Ipv6ExtensionFragment::Fragments>
+Ipv6FragmentsTest::CreateFragments() const
+{
+    auto fragments = Create<Ipv6ExtensionFragment::Fragments>();
+    fragments->SetUnfragmentablePart(Create<Packet>(40));
+    return fragments;
+}
+
+void
+Ipv6FragmentsTest::Add(Ptr<Ipv6ExtensionFragment::Fragments> fragments,
+                       uint16_t offset,
+                       uint32_t size,
+                       bool moreFragment)
+{
+    fragments->AddFragment(Create<Packet>(m_payload.data() + offset, size), offset, moreFragment);
+}
+
+void
+Ipv6FragmentsTest::DoRun()
+{
+    // out of order
+    auto fragments = CreateFragments();
+    Add(fragments, 16, 5, false);
+    Add(fragments, 0, 8, true);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), false, "Missing fragment at offset 8");
+    Add(fragments, 8, 8, true);
+    NS_TEST_ASSERT_MSG_EQ(fragments->IsEntire(), true, "Out of order fragments not reassembled");
+    Ptr<Packet> packet = fragments->GetPacket();
+    NS_TEST_ASSERT_MSG_EQ(packet->GetSize(), 40 + 21, "Unexpected size of the packet");
+    std::vector<uint8_t> data(packet->GetSize());
+    packet->CopyData(data.data(), data.size());
+    NS_TEST_EXPECT_MSG_EQ(std::equal(data.begin() + 40, data.end(), m_payload.begin()),
+                          true,
+                          "Unexpected data in the reassembled packet");
+
+    // overlapping fragments, not covering any block twice
+    fragments = CreateFragments();
+    Add(fragments, 0, 12, true);
+    Add(fragments, 8, 8, false);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), false, "Overlapping fragments reassembled");
+
+    // overlap with the next fragment
+    fragments = CreateFragments();
+    Add(fragments, 8, 8, false);
+    Add(fragments, 0, 12, true);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), false, "Overlapping fragments reassembled");
+
+    // duplicate of a final fragment shorter than a block
+    fragments = CreateFragments();
+    Add(fragments, 8, 5, false);
+    Add(fragments, 8, 5, false);
+    Add(fragments, 0, 8, true);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), false, "Duplicate fragments reassembled");
+
+    // duplicate of a fragment in the middle of the packet
+    fragments = CreateFragments();
+    Add(fragments, 0, 8, true);
+    Add(fragments, 8, 8, true);
+    Add(fragments, 8, 8, true);
+    Add(fragments, 16, 8, false);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), false, "Duplicate fragments reassembled");
+
+    // a gap is filled
+    fragments = CreateFragments();
+    Add(fragments, 0, 8, true);
+    Add(fragments, 16, 4, false);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), false, "Bytes 8 to 15 are missing");
+    Add(fragments, 8, 8, true);
+    NS_TEST_EXPECT_MSG_EQ(fragments->IsEntire(), true, "Gap not filled");
+    NS_TEST_EXPECT_MSG_EQ(fragments->GetPacket()->GetSize(), 40 + 20, "Unexpected size");
+}
+
 /**
  * @ingroup internet-test
  *
@@ -615,6 +736,7 @@ class Ipv6FragmentationTestSuite : public TestSuite
         : TestSuite("ipv6-fragmentation", Type::UNIT)
     {
         AddTestCase(new Ipv6FragmentationTest, TestCase::Duration::QUICK);
+        AddTestCase(new Ipv6FragmentsTest, TestCase::Duration::QUICK);
     }
 };
 
@@ -6,6 +6,7 @@
  * Author: Zhiheng Dong <dzh2077@gmail.com>
  */
 
+#include "ns3/arp-cache.h"
 #include "ns3/icmpv4-l4-protocol.h"
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/internet-stack-helper.h"
@@ -15,6 +16,8 @@
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/ipv6-routing-helper.h"
+#include "ns3/mac48-address.h"
+#include "ns3/ndisc-cache.h"
 #include "ns3/neighbor-cache-helper.h"
 #include "ns3/simple-channel.h"
 #include "ns3/simple-net-device-helper.h"
@@ -1210,6 +1213,69 @@ DynamicPartialTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief Neighbor Cache Lookup by MAC Address Test
+ */
+class InverseLookupTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    InverseLookupTest();
+};
+
+InverseLookupTest::InverseLookupTest()
+    : TestCase("The InverseLookupTest checks that the entries of the neighbor caches are found "
+               "by their MAC address, which is kept up to date when it changes.")
+{
+}
+
+void
+InverseLookupTest::DoRun()
+{
+    Address mac1 = Mac48Address("00:00:00:00:00:01");
+    Address mac2 = Mac48Address("00:00:00:00:00:02");
+
+    Ptr<ArpCache> arpCache = CreateObject<ArpCache>();
+    ArpCache::Entry* arpEntry1 = arpCache->Add(Ipv4Address("10.1.1.1"));
+    arpEntry1->SetMacAddress(mac1);
+    ArpCache::Entry* arpEntry2 = arpCache->Add(Ipv4Address("10.1.1.2"));
+    arpEntry2->SetMacAddress(mac1);
+    ArpCache::Entry* arpEntry3 = arpCache->Add(Ipv4Address("10.1.1.3"));
+    arpEntry3->SetMacAddress(mac2);
+
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac1).size(), 2, "Wrong number of entries.");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac2).size(), 1, "Wrong number of entries.");
+    arpEntry2->SetMacAddress(mac2);
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac1).front(), arpEntry1, "Wrong entry.");
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac2).size(), 2, "Wrong number of entries.");
+    arpCache->Remove(arpEntry3);
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac2).front(), arpEntry2, "Wrong entry.");
+    arpCache->Flush();
+    NS_TEST_EXPECT_MSG_EQ(arpCache->LookupInverse(mac1).empty(), true, "Cache not flushed.");
+    arpCache->Dispose();
+
+    Ptr<NdiscCache> ndiscCache = CreateObject<NdiscCache>();
+    NdiscCache::Entry* ndiscEntry1 = ndiscCache->Add(Ipv6Address("2001::1"));
+    ndiscEntry1->SetMacAddress(mac1);
+    NdiscCache::Entry* ndiscEntry2 = ndiscCache->Add(Ipv6Address("fe80::1"));
+    ndiscEntry2->MarkStale(mac1);
+    NdiscCache::Entry* ndiscEntry3 = ndiscCache->Add(Ipv6Address("2001::3"));
+    ndiscEntry3->MarkReachable(mac2);
+
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac1).size(), 2, "Wrong number of entries.");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac2).size(), 1, "Wrong number of entries.");
+    ndiscEntry2->SetMacAddress(mac2);
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac1).front(), ndiscEntry1, "Wrong entry.");
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac2).size(), 2, "Wrong number of entries.");
+    ndiscCache->Remove(ndiscEntry3);
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac2).front(), ndiscEntry2, "Wrong entry.");
+    ndiscCache->Flush();
+    NS_TEST_EXPECT_MSG_EQ(ndiscCache->LookupInverse(mac1).empty(), true, "Cache not flushed.");
+    ndiscCache->Dispose();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1228,6 +1294,7 @@ class NeighborCacheTestSuite : public TestSuite
         AddTestCase(new FlushTest, TestCase::Duration::QUICK);
         AddTestCase(new DuplicateTest, TestCase::Duration::QUICK);
         AddTestCase(new DynamicPartialTest, TestCase::Duration::QUICK);
+        AddTestCase(new InverseLookupTest, TestCase::Duration::QUICK);
     }
 };
 
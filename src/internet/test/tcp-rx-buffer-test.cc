@@ -31,6 +31,11 @@ class TcpRxBufferTestCase : public TestCase
      * @brief Test the SACK list update.
      */
     void TestUpdateSACKList();
+
+    /**
+     * @brief Test the reassembly of reordered and overlapping segments.
+     */
+    void TestReordering();
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase()
@@ -42,6 +47,7 @@ void
 TcpRxBufferTestCase::DoRun()
 {
     TestUpdateSACKList();
+    TestReordering();
 }
 
 void
@@ -277,6 +283,85 @@ TcpRxBufferTestCase::TestUpdateSACKList()
     NS_TEST_ASSERT_MSG_EQ(sackList.size(), 0, "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestReordering()
+{
+    TcpRxBuffer rxBuf;
+    rxBuf.SetMaxBufferSize(2000);
+    rxBuf.SetNextRxSequence(SequenceNumber32(1));
+    TcpHeader h;
+
+    uint8_t data[1000];
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        data[i] = i % 251;
+    }
+    auto addSegment = [&](uint32_t start, uint32_t size) {
+        h.SetSequenceNumber(SequenceNumber32(1 + start));
+        rxBuf.Add(Create<Packet>(data + start, size), h);
+    };
+
+    // Every other segment, in reverse order
+    for (uint32_t i : {9, 7, 5, 3, 1})
+    {
+        addSegment(i * 100, 100);
+    }
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(1),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 500, "Unexpected buffer occupancy");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 0, "No data should be available");
+
+    // A segment overlapping two blocks joins them, and replaces them in the SACK list
+    addSegment(150, 200);
+    TcpOptionSack::SackList sackList = rxBuf.GetSackList();
+    NS_TEST_ASSERT_MSG_EQ(sackList.size(), 3, "SACK list should contain three elements");
+    NS_TEST_ASSERT_MSG_EQ(sackList.front().first,
+                          SequenceNumber32(101),
+                          "SACK block different than expected");
+    NS_TEST_ASSERT_MSG_EQ(sackList.front().second,
+                          SequenceNumber32(401),
+                          "SACK block different than expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 600, "Unexpected buffer occupancy");
+
+    // Fill the first hole
+    addSegment(0, 100);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(401),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Available(), 400, "Unexpected available data");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 2, "SACK list should contain two elements");
+
+    uint8_t out[1000];
+    Ptr<Packet> p = rxBuf.Extract(1000);
+    NS_TEST_ASSERT_MSG_NE(p, nullptr, "Data should be extracted");
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), 400, "Unexpected extracted size");
+    p->CopyData(out, 400);
+
+    // Fill the other holes, and extract the data in two parts
+    for (uint32_t i : {4, 6, 8})
+    {
+        addSegment(i * 100, 100);
+    }
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.NextRxSequence(),
+                          SequenceNumber32(1001),
+                          "Sequence number differs from expected");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.GetSackListSize(), 0, "SACK list should be empty");
+    p = rxBuf.Extract(250);
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), 250, "Unexpected extracted size");
+    p->CopyData(out + 400, 250);
+    p = rxBuf.Extract(1000);
+    NS_TEST_ASSERT_MSG_EQ(p->GetSize(), 350, "Unexpected extracted size");
+    p->CopyData(out + 650, 350);
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Size(), 0, "Buffer should be empty");
+    NS_TEST_ASSERT_MSG_EQ(rxBuf.Extract(1000), nullptr, "Nothing should be extracted");
+
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(uint32_t(out[i]), i % 251, "Byte " << i << " differs from expected");
+    }
+}
+
 void
 TcpRxBufferTestCase::DoTeardown()
 {
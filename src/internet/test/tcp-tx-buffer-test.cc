@@ -57,6 +57,9 @@ TcpTxBufferTestCase::TcpTxBufferTestCase()
 void
 TcpTxBufferTestCase::DoRun()
 {
+    // Check the counters, the index and the lost frontier after each change
+    TcpTxBuffer::m_consistencyCheck = true;
+
     Simulator::Schedule(Seconds(0), &TcpTxBufferTestCase::TestIsLost, this);
     /*
      * Cases for new block:
@@ -417,6 +420,201 @@ TcpTxBufferTestCase::TestTransmittedBlock()
 void
 TcpTxBufferTestCase::DoTeardown()
 {
+    TcpTxBuffer::m_consistencyCheck = false;
+}
+
+/**
+ * @ingroup internet-test
+ * @ingroup tests
+ *
+ * @brief Test of the index of the sent list of TcpTxBuffer by sequence
+ * number, and of the lost frontier below which the items are lost or sacked.
+ */
+class TcpTxBufferIndexTestCase : public TestCase
+{
+  public:
+    /** @brief Constructor */
+    TcpTxBufferIndexTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /** @brief Test the mapping of SACK blocks over the index, and its update */
+    void TestSackOverIndex();
+    /** @brief Test the movement of the lost frontier with SACK, recovery and RTO */
+    void TestLostFrontier();
+    /**
+     * @brief Create a buffer and send 10 segments of 1000 bytes from sequence 1
+     * @returns the buffer
+     */
+    Ptr<TcpTxBuffer> CreateSentBuffer() const;
+    /**
+     * @brief Callback to provide a value of receiver window
+     * @returns the receiver window size
+     */
+    uint32_t GetRWnd() const;
+};
+
+TcpTxBufferIndexTestCase::TcpTxBufferIndexTestCase()
+    : TestCase("TcpTxBuffer sent list index and lost frontier Test")
+{
+}
+
+void
+TcpTxBufferIndexTestCase::DoRun()
+{
+    TcpTxBuffer::m_consistencyCheck = true;
+    TestSackOverIndex();
+    TestLostFrontier();
+}
+
+void
+TcpTxBufferIndexTestCase::DoTeardown()
+{
+    TcpTxBuffer::m_consistencyCheck = false;
+}
+
+uint32_t
+TcpTxBufferIndexTestCase::GetRWnd() const
+{
+    // Assume unlimited receiver window
+    return std::numeric_limits<uint32_t>::max();
+}
+
+Ptr<TcpTxBuffer>
+TcpTxBufferIndexTestCase::CreateSentBuffer() const
+{
+    Ptr<TcpTxBuffer> txBuf = CreateObject<TcpTxBuffer>();
+    txBuf->SetRWndCallback(MakeCallback(&TcpTxBufferIndexTestCase::GetRWnd, this));
+    txBuf->SetHeadSequence(SequenceNumber32(1));
+    txBuf->SetSegmentSize(1000);
+    txBuf->SetDupAckThresh(3);
+    txBuf->Add(Create<Packet>(10000));
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        txBuf->CopyFromSequence(1000, SequenceNumber32((i * 1000) + 1));
+    }
+    return txBuf;
+}
+
+void
+TcpTxBufferIndexTestCase::TestSackOverIndex()
+{
+    Ptr<TcpTxBuffer> txBuf = CreateSentBuffer();
+
+    NS_TEST_ASSERT_MSG_EQ(txBuf->m_sentIndex.size(), 10, "Every sent item must be indexed");
+    uint32_t i = 0;
+    for (const auto& [seq, it] : txBuf->m_sentIndex)
+    {
+        NS_TEST_EXPECT_MSG_EQ(seq, SequenceNumber32((i * 1000) + 1), "Unexpected indexed sequence");
+        NS_TEST_EXPECT_MSG_EQ((*it)->GetSeqSize(), 1000, "Unexpected size of the indexed item");
+        i++;
+    }
+
+    // A block exactly over the items 2 and 3, and a block starting inside
+    // the item 5: only the item 6, mapped exactly over it, is sacked
+    Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack>();
+    sack->AddSackBlock(TcpOptionSack::SackBlock(SequenceNumber32(2001), SequenceNumber32(4001)));
+    sack->AddSackBlock(TcpOptionSack::SackBlock(SequenceNumber32(5501), SequenceNumber32(7001)));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->Update(sack->GetSackList()), 3000, "Unexpected sacked bytes");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetSacked(), 3000, "Unexpected sacked count");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->IsLost(SequenceNumber32(5001)), false, "Item 5 is not lost");
+
+    // 3 items sacked above the items 0 and 1: they are lost
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetLost(), 2000, "Unexpected lost count");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->IsLost(SequenceNumber32(1)), true, "Item 0 is lost");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->IsLost(SequenceNumber32(1001)), true, "Item 1 is lost");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->IsLost(SequenceNumber32(4001)), false, "Item 4 is not lost");
+
+    // Retransmitting half of the item 1 splits it, and indexes its second half
+    txBuf->CopyFromSequence(500, SequenceNumber32(1001));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->m_sentIndex.size(), 11, "The split item must be indexed");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->m_sentIndex.count(SequenceNumber32(1501)),
+                          1,
+                          "The second half of the split item must be indexed");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetRetransmitsCount(), 500, "Unexpected retransmitted count");
+
+    // A block over the second half only
+    sack->ClearSackList();
+    sack->AddSackBlock(TcpOptionSack::SackBlock(SequenceNumber32(1501), SequenceNumber32(2001)));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->Update(sack->GetSackList()), 500, "Unexpected sacked bytes");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetLost(), 1500, "A sacked item is not lost anymore");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetSacked(), 3500, "Unexpected sacked count");
+
+    // Acknowledging up to the item 4 removes the items below from the index
+    txBuf->DiscardUpTo(SequenceNumber32(4001));
+    NS_TEST_ASSERT_MSG_EQ(txBuf->m_sentIndex.size(), 6, "Discarded items must be unindexed");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->m_sentIndex.begin()->first,
+                          SequenceNumber32(4001),
+                          "The head must be the first indexed item");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetSacked(), 1000, "Unexpected sacked count");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetLost(), 0, "Unexpected lost count");
+}
+
+void
+TcpTxBufferIndexTestCase::TestLostFrontier()
+{
+    Ptr<TcpTxBuffer> txBuf = CreateSentBuffer();
+    NS_TEST_EXPECT_MSG_EQ(txBuf->m_lostFrontier, SequenceNumber32(1), "Frontier not at the head");
+
+    // The items 3, 4 and 5 are sacked: the items below are lost
+    Ptr<TcpOptionSack> sack = CreateObject<TcpOptionSack>();
+    sack->AddSackBlock(TcpOptionSack::SackBlock(SequenceNumber32(3001), SequenceNumber32(6001)));
+    txBuf->Update(sack->GetSackList());
+    NS_TEST_EXPECT_MSG_EQ(txBuf->m_lostFrontier, SequenceNumber32(3001), "Unexpected frontier");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetLost(), 3000, "Unexpected lost count");
+
+    // The item 7 is sacked: the frontier moves to the item 4, but the item 6
+    // has only one item sacked above it
+    sack->ClearSackList();
+    sack->AddSackBlock(TcpOptionSack::SackBlock(SequenceNumber32(7001), SequenceNumber32(8001)));
+    txBuf->Update(sack->GetSackList());
+    NS_TEST_EXPECT_MSG_EQ(txBuf->m_lostFrontier, SequenceNumber32(4001), "Unexpected frontier");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetLost(), 3000, "Unexpected lost count");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->IsLost(SequenceNumber32(6001)), false, "Item 6 is not lost");
+
+    // The items 8 and 9 are sacked: the item 6 is now lost
+    sack->ClearSackList();
+    sack->AddSackBlock(TcpOptionSack::SackBlock(SequenceNumber32(8001), SequenceNumber32(10001)));
+    txBuf->Update(sack->GetSackList());
+    NS_TEST_EXPECT_MSG_EQ(txBuf->m_lostFrontier, SequenceNumber32(7001), "Unexpected frontier");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetLost(), 4000, "Unexpected lost count");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->IsLost(SequenceNumber32(6001)), true, "Item 6 is lost");
+
+    // A partial ACK during the recovery leaves the frontier below the head
+    txBuf->CopyFromSequence(1000, SequenceNumber32(1));
+    txBuf->DiscardUpTo(SequenceNumber32(1001));
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetLost(), 3000, "Unexpected lost count");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->IsLost(SequenceNumber32(1001)), true, "Item 1 is still lost");
+
+    // RTO with SACK: every item not sacked is lost, the frontier is kept
+    txBuf->SetSentListLost(false);
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetLost(), 3000, "Unexpected lost count after RTO");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetSacked(), 6000, "SACK information kept after RTO");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->m_lostFrontier, SequenceNumber32(7001), "Unexpected frontier");
+
+    // Recovery and RTO without SACK: the guessed SACKs are reset with the frontier
+    txBuf = CreateSentBuffer();
+    txBuf->SetSackEnabled(false);
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        txBuf->AddRenoSack();
+    }
+    txBuf->MarkHeadAsLost();
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetSacked(), 3000, "Unexpected Reno sacked count");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetLost(), 1000, "Unexpected Reno lost count");
+    txBuf->ResetRenoSack();
+    NS_TEST_EXPECT_MSG_EQ(txBuf->m_lostFrontier, SequenceNumber32(1), "Frontier not at the head");
+    txBuf->SetSentListLost(true);
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetSacked(), 0, "Unexpected sacked count after RTO");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->GetLost(), 10000, "Every item is lost after RTO");
+
+    // Resetting the sent list moves the frontier to the head
+    txBuf->DiscardUpTo(SequenceNumber32(2001));
+    txBuf->ResetSentList();
+    NS_TEST_EXPECT_MSG_EQ(txBuf->m_lostFrontier, SequenceNumber32(2001), "Frontier not at head");
+    NS_TEST_EXPECT_MSG_EQ(txBuf->m_sentIndex.empty(), true, "Index not reset with the list");
 }
 
 /**
@@ -431,6 +629,7 @@ class TcpTxBufferTestSuite : public TestSuite
         : TestSuite("tcp-tx-buffer", Type::UNIT)
     {
         AddTestCase(new TcpTxBufferTestCase, TestCase::Duration::QUICK);
+        AddTestCase(new TcpTxBufferIndexTestCase, TestCase::Duration::QUICK);
     }
 };
 
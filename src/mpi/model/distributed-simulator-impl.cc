@@ -366,7 +366,9 @@ DistributedSimulatorImpl::Run()
         if (nextTime > m_grantedTime || IsLocalFinished())
         {
             // Can't process next event, calculate a new LBTS
-            // First receive any pending messages
+            // First send the packets batched during this window
+            GrantedTimeWindowMpiInterface::FlushPendingPackets();
+            // Then receive any pending messages
             GrantedTimeWindowMpiInterface::ReceiveMessages();
             // reset next time
             nextTime = Next();
@@ -73,7 +73,9 @@ bool GrantedTimeWindowMpiInterface::g_enabled = false;
 bool GrantedTimeWindowMpiInterface::g_mpiInitCalled = false;
 uint32_t GrantedTimeWindowMpiInterface::g_rxCount = 0;
 uint32_t GrantedTimeWindowMpiInterface::g_txCount = 0;
+uint64_t GrantedTimeWindowMpiInterface::g_txMessageCount = 0;
 std::list<SentBuffer> GrantedTimeWindowMpiInterface::g_pendingTx;
+std::vector<MpiPacketBatch> GrantedTimeWindowMpiInterface::g_txBatches;
 
 MPI_Request* GrantedTimeWindowMpiInterface::g_requests;
 char** GrantedTimeWindowMpiInterface::g_pRxBuffers;
@@ -101,6 +103,7 @@ GrantedTimeWindowMpiInterface::Destroy()
     delete[] g_requests;
 
     g_pendingTx.clear();
+    g_txBatches.clear();
 }
 
 uint32_t
@@ -117,6 +120,20 @@ GrantedTimeWindowMpiInterface::GetTxCount()
     return g_txCount;
 }
 
+uint64_t
+GrantedTimeWindowMpiInterface::GetTxMessageCount()
+{
+    NS_ASSERT(g_enabled);
+    return g_txMessageCount;
+}
+
+uint64_t
+GrantedTimeWindowMpiInterface::GetTxPacketCount()
+{
+    NS_ASSERT(g_enabled);
+    return g_txCount;
+}
+
 uint32_t
 GrantedTimeWindowMpiInterface::GetSystemId()
 {
@@ -181,14 +198,15 @@ GrantedTimeWindowMpiInterface::Enable(MPI_Comm communicator)
     g_size = mpiSize;
 
     g_enabled = true;
+    g_txBatches.resize(g_size);
     // Post a non-blocking receive for all peers
     g_pRxBuffers = new char*[g_size];
     g_requests = new MPI_Request[g_size];
     for (uint32_t i = 0; i < GetSize(); ++i)
     {
-        g_pRxBuffers[i] = new char[MAX_MPI_MSG_SIZE];
+        g_pRxBuffers[i] = new char[MAX_MPI_BATCH_SIZE];
         MPI_Irecv(g_pRxBuffers[i],
-                  MAX_MPI_MSG_SIZE,
+                  MAX_MPI_BATCH_SIZE,
                   MPI_CHAR,
                   MPI_ANY_SOURCE,
                   0,
@@ -205,35 +223,55 @@ GrantedTimeWindowMpiInterface::SendPacket(Ptr<Packet> p,
 {
     NS_LOG_FUNCTION(this << p << rxTime.GetTimeStep() << node << dev);
 
+    // Find the system id for the destination node
+    Ptr<Node> destNode = NodeList::GetNode(node);
+    uint32_t nodeSysId = destNode->GetSystemId();
+
+    // Packets are held until the end of the granted time window, the
+    // receiver will not process them before then anyway.
+    MpiPacketBatch& batch = g_txBatches[nodeSysId];
+    if (!batch.CanAdd(p))
+    {
+        FlushPendingPackets(nodeSysId);
+    }
+    batch.Add(p, rxTime, node, dev);
+    g_txCount++;
+}
+
+void
+GrantedTimeWindowMpiInterface::FlushPendingPackets()
+{
+    NS_LOG_FUNCTION_NOARGS();
+
+    for (uint32_t rank = 0; rank < g_txBatches.size(); ++rank)
+    {
+        if (!g_txBatches[rank].IsEmpty())
+        {
+            FlushPendingPackets(rank);
+        }
+    }
+}
+
+void
+GrantedTimeWindowMpiInterface::FlushPendingPackets(uint32_t rank)
+{
+    NS_LOG_FUNCTION(rank);
+
     SentBuffer sendBuf;
     g_pendingTx.push_back(sendBuf);
     auto i = g_pendingTx.rbegin(); // Points to the last element
 
-    uint32_t serializedSize = p->GetSerializedSize();
-    auto buffer = new uint8_t[serializedSize + 16];
-    i->SetBuffer(buffer);
-    // Add the time, dest node and dest device
-    uint64_t t = rxTime.GetInteger();
-    auto pTime = reinterpret_cast<uint64_t*>(buffer);
-    *pTime++ = t;
-    auto pData = reinterpret_cast<uint32_t*>(pTime);
-    *pData++ = node;
-    *pData++ = dev;
-    // Serialize the packet
-    p->Serialize(reinterpret_cast<uint8_t*>(pData), serializedSize);
-
-    // Find the system id for the destination node
-    Ptr<Node> destNode = NodeList::GetNode(node);
-    uint32_t nodeSysId = destNode->GetSystemId();
+    uint32_t size;
+    i->SetBuffer(g_txBatches[rank].Detach(Time(0), size));
 
     MPI_Isend(reinterpret_cast<void*>(i->GetBuffer()),
-              serializedSize + 16,
+              size,
               MPI_CHAR,
-              nodeSysId,
+              rank,
               0,
               g_communicator,
               (i->GetRequest()));
-    g_txCount++;
+    g_txMessageCount++;
 }
 
 void
@@ -255,47 +293,44 @@ GrantedTimeWindowMpiInterface::ReceiveMessages()
         }
         int count;
         MPI_Get_count(&status, MPI_CHAR, &count);
-        g_rxCount++; // Count this receive
 
-        // Get the meta data first
-        auto pTime = reinterpret_cast<uint64_t*>(g_pRxBuffers[index]);
-        uint64_t time = *pTime++;
-        auto pData = reinterpret_cast<uint32_t*>(pTime);
-        uint32_t node = *pData++;
-        uint32_t dev = *pData++;
+        Time guarantee;
+        std::vector<MpiPacketBatch::Record> records;
+        MpiPacketBatch::Deserialize(reinterpret_cast<uint8_t*>(g_pRxBuffers[index]),
+                                    count,
+                                    guarantee,
+                                    records);
+        g_rxCount += records.size(); // Count the packets in this receive
 
-        Time rxTime(time);
-
-        count -= sizeof(time) + sizeof(node) + sizeof(dev);
-
-        Ptr<Packet> p = Create<Packet>(reinterpret_cast<uint8_t*>(pData), count, true);
-
-        // Find the correct node/device to schedule receive event
-        Ptr<Node> pNode = NodeList::GetNode(node);
-        Ptr<MpiReceiver> pMpiRec = nullptr;
-        uint32_t nDevices = pNode->GetNDevices();
-        for (uint32_t i = 0; i < nDevices; ++i)
+        for (const auto& record : records)
         {
-            Ptr<NetDevice> pThisDev = pNode->GetDevice(i);
-            if (pThisDev->GetIfIndex() == dev)
+            // Find the correct node/device to schedule receive event
+            Ptr<Node> pNode = NodeList::GetNode(record.node);
+            Ptr<MpiReceiver> pMpiRec = nullptr;
+            uint32_t nDevices = pNode->GetNDevices();
+            for (uint32_t i = 0; i < nDevices; ++i)
             {
-                pMpiRec = pThisDev->GetObject<MpiReceiver>();
-                break;
+                Ptr<NetDevice> pThisDev = pNode->GetDevice(i);
+                if (pThisDev->GetIfIndex() == record.dev)
+                {
+                    pMpiRec = pThisDev->GetObject<MpiReceiver>();
+                    break;
+                }
             }
-        }
 
-        NS_ASSERT(pNode && pMpiRec);
+            NS_ASSERT(pNode && pMpiRec);
 
-        // Schedule the rx event
-        Simulator::ScheduleWithContext(pNode->GetId(),
-                                       rxTime - Simulator::Now(),
-                                       &MpiReceiver::Receive,
-                                       pMpiRec,
-                                       p);
+            // Schedule the rx event
+            Simulator::ScheduleWithContext(pNode->GetId(),
+                                           record.rxTime - Simulator::Now(),
+                                           &MpiReceiver::Receive,
+                                           pMpiRec,
+                                           record.packet);
+        }
 
         // Re-queue the next read
         MPI_Irecv(g_pRxBuffers[index],
-                  MAX_MPI_MSG_SIZE,
+                  MAX_MPI_BATCH_SIZE,
                   MPI_CHAR,
                   MPI_ANY_SOURCE,
                   0,
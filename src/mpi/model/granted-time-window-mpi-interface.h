@@ -16,14 +16,17 @@
 #ifndef NS3_GRANTED_TIME_WINDOW_MPI_INTERFACE_H
 #define NS3_GRANTED_TIME_WINDOW_MPI_INTERFACE_H
 
+#include "mpi-packet-batch.h"
 #include "parallel-communication-interface.h"
 
 #include "ns3/buffer.h"
+#include "ns3/deprecated.h"
 #include "ns3/nstime.h"
 
 #include <list>
 #include <mpi.h>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -32,7 +35,8 @@ namespace ns3
  * maximum MPI message size for easy
  * buffer creation
  */
-const uint32_t MAX_MPI_MSG_SIZE = 2000;
+NS_DEPRECATED_3_46("Use MAX_MPI_BATCH_SIZE instead")
+const uint32_t MAX_MPI_MSG_SIZE = MAX_MPI_BATCH_SIZE;
 
 /**
  * @ingroup mpi
@@ -97,6 +101,8 @@ class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Obj
     void Disable() override;
     void SendPacket(Ptr<Packet> p, const Time& rxTime, uint32_t node, uint32_t dev) override;
     MPI_Comm GetCommunicator() override;
+    uint64_t GetTxMessageCount() override;
+    uint64_t GetTxPacketCount() override;
 
   private:
     /*
@@ -111,6 +117,17 @@ class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Obj
      * Check for received messages complete
      */
     static void ReceiveMessages();
+    /**
+     * Send the packets batched for every remote rank.  Must be called
+     * at the end of each granted time window, before the LBTS
+     * computation, so that no packet is left behind.
+     */
+    static void FlushPendingPackets();
+    /**
+     * Post a non-blocking send of the packets batched for one rank.
+     * @param rank the destination rank
+     */
+    static void FlushPendingPackets(uint32_t rank);
     /**
      * Check for completed sends
      */
@@ -135,6 +152,9 @@ class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Obj
     /** Total packets sent. */
     static uint32_t g_txCount;
 
+    /** Total MPI messages posted to carry packets. */
+    static uint64_t g_txMessageCount;
+
     /** Has this interface been enabled. */
     static bool g_enabled;
 
@@ -153,6 +173,9 @@ class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Obj
     /** List of pending non-blocking sends. */
     static std::list<SentBuffer> g_pendingTx;
 
+    /** Packets waiting to be sent, indexed by destination rank. */
+    static std::vector<MpiPacketBatch> g_txBatches;
+
     /** MPI communicator being used for ns-3 tasks. */
     static MPI_Comm g_communicator;
 
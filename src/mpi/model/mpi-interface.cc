@@ -138,6 +138,32 @@ MpiInterface::GetCommunicator()
     return g_parallelCommunicationInterface->GetCommunicator();
 }
 
+uint64_t
+MpiInterface::GetTxMessageCount()
+{
+    if (g_parallelCommunicationInterface)
+    {
+        return g_parallelCommunicationInterface->GetTxMessageCount();
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+uint64_t
+MpiInterface::GetTxPacketCount()
+{
+    if (g_parallelCommunicationInterface)
+    {
+        return g_parallelCommunicationInterface->GetTxPacketCount();
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 void
 MpiInterface::Disable()
 {
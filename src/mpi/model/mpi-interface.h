@@ -144,6 +144,27 @@ class MpiInterface
      */
     static MPI_Comm GetCommunicator();
 
+    /**
+     * @brief Get the number of MPI messages posted to carry packets.
+     *
+     * Packets sent to the same remote rank are batched into a single
+     * MPI message, so this is usually much smaller than
+     * GetTxPacketCount().  Null Messages are not counted.  When running
+     * a sequential simulation this will return 0.
+     *
+     * @return number of MPI messages sent by this rank
+     */
+    static uint64_t GetTxMessageCount();
+
+    /**
+     * @brief Get the number of packets sent to remote ranks.
+     *
+     * When running a sequential simulation this will return 0.
+     *
+     * @return number of packets sent by this rank
+     */
+    static uint64_t GetTxPacketCount();
+
   private:
     /**
      * Common enable logic.
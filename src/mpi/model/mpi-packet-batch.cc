@@ -0,0 +1,156 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mpi
+ * Implementation of class ns3::MpiPacketBatch.
+ */
+
+#include "mpi-packet-batch.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("MpiPacketBatch");
+
+MpiPacketBatch::MpiPacketBatch()
+    : m_count(0)
+{
+}
+
+uint32_t
+MpiPacketBatch::GetHeaderSize()
+{
+    return sizeof(uint64_t) + sizeof(uint32_t);
+}
+
+uint32_t
+MpiPacketBatch::GetRecordSize(Ptr<const Packet> p)
+{
+    return sizeof(uint64_t) + 3 * sizeof(uint32_t) + p->GetSerializedSize();
+}
+
+bool
+MpiPacketBatch::CanAdd(Ptr<const Packet> p) const
+{
+    return GetSize() + GetRecordSize(p) <= MAX_MPI_BATCH_SIZE;
+}
+
+void
+MpiPacketBatch::Add(Ptr<const Packet> p, const Time& rxTime, uint32_t node, uint32_t dev)
+{
+    NS_LOG_FUNCTION(this << p << rxTime.GetTimeStep() << node << dev);
+
+    uint32_t serializedSize = p->GetSerializedSize();
+    NS_ABORT_MSG_IF(GetHeaderSize() + GetRecordSize(p) > MAX_MPI_BATCH_SIZE,
+                    "Packet of " << serializedSize << " bytes exceeds the MPI message size");
+
+    std::size_t offset = m_records.size();
+    m_records.resize(offset + GetRecordSize(p));
+    uint8_t* pData = m_records.data() + offset;
+
+    // Add the time, dest node, dest device and packet size
+    uint64_t t = rxTime.GetInteger();
+    std::memcpy(pData, &t, sizeof(t));
+    pData += sizeof(t);
+    std::memcpy(pData, &node, sizeof(node));
+    pData += sizeof(node);
+    std::memcpy(pData, &dev, sizeof(dev));
+    pData += sizeof(dev);
+    std::memcpy(pData, &serializedSize, sizeof(serializedSize));
+    pData += sizeof(serializedSize);
+    // Serialize the packet
+    p->Serialize(pData, serializedSize);
+
+    m_count++;
+}
+
+uint32_t
+MpiPacketBatch::GetCount() const
+{
+    return m_count;
+}
+
+bool
+MpiPacketBatch::IsEmpty() const
+{
+    return m_count == 0;
+}
+
+uint32_t
+MpiPacketBatch::GetSize() const
+{
+    return GetHeaderSize() + static_cast<uint32_t>(m_records.size());
+}
+
+uint8_t*
+MpiPacketBatch::Detach(const Time& guarantee, uint32_t& size)
+{
+    NS_LOG_FUNCTION(this << guarantee.GetTimeStep());
+
+    size = GetSize();
+    auto buffer = new uint8_t[size];
+
+    uint64_t t = guarantee.GetInteger();
+    std::memcpy(buffer, &t, sizeof(t));
+    std::memcpy(buffer + sizeof(t), &m_count, sizeof(m_count));
+    if (!m_records.empty())
+    {
+        std::memcpy(buffer + GetHeaderSize(), m_records.data(), m_records.size());
+    }
+
+    // Keep the capacity for the next batch
+    m_records.clear();
+    m_count = 0;
+    return buffer;
+}
+
+void
+MpiPacketBatch::Deserialize(const uint8_t* buffer,
+                            uint32_t size,
+                            Time& guarantee,
+                            std::vector<Record>& records)
+{
+    NS_LOG_FUNCTION(buffer << size);
+
+    NS_ASSERT(size >= GetHeaderSize());
+
+    uint64_t t;
+    uint32_t count;
+    std::memcpy(&t, buffer, sizeof(t));
+    std::memcpy(&count, buffer + sizeof(t), sizeof(count));
+    guarantee = Time(t);
+
+    const uint8_t* pData = buffer + GetHeaderSize();
+    const uint8_t* pEnd = buffer + size;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        Record record;
+        uint32_t serializedSize;
+        NS_ASSERT(pData + sizeof(t) + 3 * sizeof(uint32_t) <= pEnd);
+        std::memcpy(&t, pData, sizeof(t));
+        pData += sizeof(t);
+        std::memcpy(&record.node, pData, sizeof(record.node));
+        pData += sizeof(record.node);
+        std::memcpy(&record.dev, pData, sizeof(record.dev));
+        pData += sizeof(record.dev);
+        std::memcpy(&serializedSize, pData, sizeof(serializedSize));
+        pData += sizeof(serializedSize);
+        NS_ASSERT(pData + serializedSize <= pEnd);
+
+        record.rxTime = Time(t);
+        record.packet = Create<Packet>(pData, serializedSize, true);
+        pData += serializedSize;
+        records.push_back(record);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,140 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mpi
+ * Declaration of class ns3::MpiPacketBatch.
+ */
+
+#ifndef NS3_MPI_PACKET_BATCH_H
+#define NS3_MPI_PACKET_BATCH_H
+
+#include "ns3/nstime.h"
+#include "ns3/packet.h"
+#include "ns3/ptr.h"
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * maximum MPI message size for easy
+ * buffer creation.  A single MPI message carries a whole batch of
+ * packets, so receive buffers must be able to hold a full batch.
+ */
+const uint32_t MAX_MPI_BATCH_SIZE = 65536;
+
+/**
+ * @ingroup mpi
+ *
+ * @brief Aggregates packets bound for one remote rank into a single
+ * MPI message.
+ *
+ * The parallel communication interfaces accumulate every packet sent
+ * to a given remote rank into a batch and post a single MPI send when
+ * the batch is flushed, instead of posting one MPI message per packet.
+ *
+ * The wire format is a fixed header followed by one record per packet:
+ *
+ * @verbatim
+   header:  uint64_t guarantee time, uint32_t packet count
+   record:  uint64_t rx time, uint32_t node, uint32_t device,
+            uint32_t serialized size, serialized packet
+   @endverbatim
+ *
+ * The guarantee time is only used by the Null Message implementation;
+ * a batch with no packets is a Null Message.
+ */
+class MpiPacketBatch
+{
+  public:
+    /** A packet extracted from a received batch. */
+    struct Record
+    {
+        Time rxTime;        //!< Receive time at the destination node.
+        uint32_t node;      //!< Destination node.
+        uint32_t dev;       //!< Destination device.
+        Ptr<Packet> packet; //!< The deserialized packet.
+    };
+
+    MpiPacketBatch();
+
+    /**
+     * Size of the fixed header preceding the packet records.
+     * @return the header size in bytes
+     */
+    static uint32_t GetHeaderSize();
+
+    /**
+     * Size the record for a packet will take in a batch.
+     * @param p the packet
+     * @return the record size in bytes
+     */
+    static uint32_t GetRecordSize(Ptr<const Packet> p);
+
+    /**
+     * Check if a packet fits in this batch without exceeding
+     * MAX_MPI_BATCH_SIZE.
+     * @param p the packet
+     * @return true if the packet can be added
+     */
+    bool CanAdd(Ptr<const Packet> p) const;
+
+    /**
+     * Append a packet to the batch.
+     * @param p packet to send
+     * @param rxTime received time at destination node
+     * @param node destination node
+     * @param dev destination device
+     */
+    void Add(Ptr<const Packet> p, const Time& rxTime, uint32_t node, uint32_t dev);
+
+    /**
+     * @return the number of packets in the batch
+     */
+    uint32_t GetCount() const;
+
+    /**
+     * @return true if the batch holds no packets
+     */
+    bool IsEmpty() const;
+
+    /**
+     * @return the size of the MPI message for the current batch, in bytes
+     */
+    uint32_t GetSize() const;
+
+    /**
+     * Build the MPI message for the current batch and reset the batch.
+     *
+     * @param [in] guarantee The guarantee time to store in the header.
+     * @param [out] size The size of the returned buffer.
+     * @return a buffer allocated with new[]; ownership is passed to the caller
+     */
+    uint8_t* Detach(const Time& guarantee, uint32_t& size);
+
+    /**
+     * Decode a received MPI message.
+     *
+     * @param [in] buffer The received message.
+     * @param [in] size The size of the received message.
+     * @param [out] guarantee The guarantee time stored in the header.
+     * @param [out] records The packets carried, appended in send order.
+     */
+    static void Deserialize(const uint8_t* buffer,
+                            uint32_t size,
+                            Time& guarantee,
+                            std::vector<Record>& records);
+
+  private:
+    std::vector<uint8_t> m_records; //!< Serialized packet records.
+    uint32_t m_count;               //!< Number of packets in m_records.
+};
+
+} // namespace ns3
+
+#endif /* NS3_MPI_PACKET_BATCH_H */
@@ -15,6 +15,7 @@
 
 #include "null-message-mpi-interface.h"
 
+#include "mpi-packet-batch.h"
 #include "mpi-receiver.h"
 #include "null-message-simulator-impl.h"
 #include "remote-channel-bundle-manager.h"
@@ -31,6 +32,7 @@
 #include <iostream>
 #include <list>
 #include <mpi.h>
+#include <vector>
 
 namespace ns3
 {
@@ -77,12 +79,6 @@ class NullMessageSentBuffer
     MPI_Request m_request;
 };
 
-/**
- * maximum MPI message size for easy
- * buffer creation
- */
-const uint32_t NULL_MESSAGE_MAX_MPI_MSG_SIZE = 2000;
-
 NullMessageSentBuffer::NullMessageSentBuffer()
 {
     m_buffer = nullptr;
@@ -115,6 +111,8 @@ NullMessageSentBuffer::GetRequest()
 uint32_t NullMessageMpiInterface::g_sid = 0;
 uint32_t NullMessageMpiInterface::g_size = 1;
 uint32_t NullMessageMpiInterface::g_numNeighbors = 0;
+uint64_t NullMessageMpiInterface::g_txPacketCount = 0;
+uint64_t NullMessageMpiInterface::g_txMessageCount = 0;
 bool NullMessageMpiInterface::g_enabled = false;
 bool NullMessageMpiInterface::g_mpiInitCalled = false;
 
@@ -170,6 +168,20 @@ NullMessageMpiInterface::GetCommunicator()
     return g_communicator;
 }
 
+uint64_t
+NullMessageMpiInterface::GetTxMessageCount()
+{
+    NS_ASSERT(g_enabled);
+    return g_txMessageCount;
+}
+
+uint64_t
+NullMessageMpiInterface::GetTxPacketCount()
+{
+    NS_ASSERT(g_enabled);
+    return g_txPacketCount;
+}
+
 bool
 NullMessageMpiInterface::IsEnabled()
 {
@@ -233,9 +245,9 @@ NullMessageMpiInterface::InitializeSendReceiveBuffers()
         Ptr<RemoteChannelBundle> bundle = RemoteChannelBundleManager::Find(rank);
         if (bundle)
         {
-            g_pRxBuffers[index] = new char[NULL_MESSAGE_MAX_MPI_MSG_SIZE];
+            g_pRxBuffers[index] = new char[MAX_MPI_BATCH_SIZE];
             MPI_Irecv(g_pRxBuffers[index],
-                      NULL_MESSAGE_MAX_MPI_MSG_SIZE,
+                      MAX_MPI_BATCH_SIZE,
                       MPI_CHAR,
                       rank,
                       0,
@@ -257,38 +269,33 @@ NullMessageMpiInterface::SendPacket(Ptr<Packet> p, const Time& rxTime, uint32_t
     Ptr<Node> destNode = NodeList::GetNode(node);
     uint32_t nodeSysId = destNode->GetSystemId();
 
-    NullMessageSentBuffer sendBuf;
-    g_pendingTx.push_back(sendBuf);
-    auto iter = g_pendingTx.rbegin(); // Points to the last element
+    Ptr<RemoteChannelBundle> bundle = RemoteChannelBundleManager::Find(nodeSysId);
+    NS_ASSERT(bundle);
 
-    uint32_t serializedSize = p->GetSerializedSize();
-    uint32_t bufferSize = serializedSize + (2 * sizeof(uint64_t)) + (2 * sizeof(uint32_t));
-    auto buffer = new uint8_t[bufferSize];
-    iter->SetBuffer(buffer);
-    // Add the time, dest node and dest device
-    uint64_t t = rxTime.GetInteger();
-    auto pTime = reinterpret_cast<uint64_t*>(buffer);
-    *pTime++ = t;
+    // Packets are held on the bundle until simulation time advances,
+    // see RemoteChannelBundleManager::FlushPendingPackets.
+    MpiPacketBatch& batch = bundle->GetPendingPackets();
+    if (!batch.CanAdd(p))
+    {
+        FlushPendingPackets(bundle);
+    }
+    batch.Add(p, rxTime, node, dev);
+    g_txPacketCount++;
+}
 
-    Time guarantee_update =
-        NullMessageSimulatorImpl::GetInstance()->CalculateGuaranteeTime(nodeSysId);
-    *pTime++ = guarantee_update.GetTimeStep();
+void
+NullMessageMpiInterface::FlushPendingPackets(Ptr<RemoteChannelBundle> bundle)
+{
+    NS_LOG_FUNCTION(bundle);
 
-    auto pData = reinterpret_cast<uint32_t*>(pTime);
-    *pData++ = node;
-    *pData++ = dev;
-    // Serialize the packet
-    p->Serialize(reinterpret_cast<uint8_t*>(pData), serializedSize);
+    NS_ASSERT(g_enabled);
 
-    MPI_Isend(reinterpret_cast<void*>(iter->GetBuffer()),
-              bufferSize,
-              MPI_CHAR,
-              nodeSysId,
-              0,
-              g_communicator,
-              (iter->GetRequest()));
+    uint32_t nodeSysId = bundle->GetSystemId();
+    Time guarantee_update =
+        NullMessageSimulatorImpl::GetInstance()->CalculateGuaranteeTime(nodeSysId);
+    SendNullMessage(guarantee_update, bundle);
 
-    NullMessageSimulatorImpl::GetInstance()->RescheduleNullMessageEvent(nodeSysId);
+    NullMessageSimulatorImpl::GetInstance()->RescheduleNullMessageEvent(bundle);
 }
 
 void
@@ -303,16 +310,14 @@ NullMessageMpiInterface::SendNullMessage(const Time& guarantee_update,
     g_pendingTx.push_back(sendBuf);
     auto iter = g_pendingTx.rbegin(); // Points to the last element
 
-    uint32_t bufferSize = 2 * sizeof(uint64_t) + 2 * sizeof(uint32_t);
-    auto buffer = new uint8_t[bufferSize];
-    iter->SetBuffer(buffer);
-    // Add the time, dest node and dest device
-    auto pTime = reinterpret_cast<uint64_t*>(buffer);
-    *pTime++ = 0;
-    *pTime++ = guarantee_update.GetInteger();
-    auto pData = reinterpret_cast<uint32_t*>(pTime);
-    *pData++ = 0;
-    *pData++ = 0;
+    // Pending packets, if any, travel with the guarantee time
+    MpiPacketBatch& batch = bundle->GetPendingPackets();
+    if (!batch.IsEmpty())
+    {
+        g_txMessageCount++;
+    }
+    uint32_t bufferSize;
+    iter->SetBuffer(batch.Detach(guarantee_update, bufferSize));
 
     // Find the system id for the destination MPI rank
     uint32_t nodeSysId = bundle->GetSystemId();
@@ -381,32 +386,24 @@ NullMessageMpiInterface::ReceiveMessages(bool blocking)
             int count;
             MPI_Get_count(&status, MPI_CHAR, &count);
 
-            // Get the meta data first
-            auto pTime = reinterpret_cast<uint64_t*>(g_pRxBuffers[index]);
-            uint64_t time = *pTime++;
-            uint64_t guaranteeUpdate = *pTime++;
+            // A Null Message is a batch without packets
+            Time guaranteeUpdate;
+            std::vector<MpiPacketBatch::Record> records;
+            MpiPacketBatch::Deserialize(reinterpret_cast<uint8_t*>(g_pRxBuffers[index]),
+                                        count,
+                                        guaranteeUpdate,
+                                        records);
 
-            auto pData = reinterpret_cast<uint32_t*>(pTime);
-            uint32_t node = *pData++;
-            uint32_t dev = *pData++;
-
-            Time rxTime(time);
-
-            // rxtime == 0 means this is a Null Message
-            if (rxTime.IsStrictlyPositive())
+            for (const auto& record : records)
             {
-                count -= sizeof(time) + sizeof(guaranteeUpdate) + sizeof(node) + sizeof(dev);
-
-                Ptr<Packet> p = Create<Packet>(reinterpret_cast<uint8_t*>(pData), count, true);
-
                 // Find the correct node/device to schedule receive event
-                Ptr<Node> pNode = NodeList::GetNode(node);
+                Ptr<Node> pNode = NodeList::GetNode(record.node);
                 Ptr<MpiReceiver> pMpiRec = nullptr;
                 uint32_t nDevices = pNode->GetNDevices();
                 for (uint32_t i = 0; i < nDevices; ++i)
                 {
                     Ptr<NetDevice> pThisDev = pNode->GetDevice(i);
-                    if (pThisDev->GetIfIndex() == dev)
+                    if (pThisDev->GetIfIndex() == record.dev)
                     {
                         pMpiRec = pThisDev->GetObject<MpiReceiver>();
                         break;
@@ -416,21 +413,21 @@ NullMessageMpiInterface::ReceiveMessages(bool blocking)
 
                 // Schedule the rx event
                 Simulator::ScheduleWithContext(pNode->GetId(),
-                                               rxTime - Simulator::Now(),
+                                               record.rxTime - Simulator::Now(),
                                                &MpiReceiver::Receive,
                                                pMpiRec,
-                                               p);
+                                               record.packet);
             }
 
             // Update guarantee time for both packet receives and Null Messages.
             Ptr<RemoteChannelBundle> bundle = RemoteChannelBundleManager::Find(status.MPI_SOURCE);
             NS_ASSERT(bundle);
 
-            bundle->SetGuaranteeTime(Time(guaranteeUpdate));
+            bundle->SetGuaranteeTime(guaranteeUpdate);
 
             // Re-queue the next read
             MPI_Irecv(g_pRxBuffers[index],
-                      NULL_MESSAGE_MAX_MPI_MSG_SIZE,
+                      MAX_MPI_BATCH_SIZE,
                       MPI_CHAR,
                       status.MPI_SOURCE,
                       0,
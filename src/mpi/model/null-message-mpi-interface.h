@@ -59,6 +59,8 @@ class NullMessageMpiInterface : public ParallelCommunicationInterface, Object
     void Disable() override;
     void SendPacket(Ptr<Packet> p, const Time& rxTime, uint32_t node, uint32_t dev) override;
     MPI_Comm GetCommunicator() override;
+    uint64_t GetTxMessageCount() override;
+    uint64_t GetTxPacketCount() override;
 
   private:
     /*
@@ -83,12 +85,24 @@ class NullMessageMpiInterface : public ParallelCommunicationInterface, Object
      *
      * @param [in] bundle The bundle of links between two ranks.
      *
-     * @internal The Null Message MPI buffer format uses the same packet
-     * metadata format as sending a normal packet with the time,
-     * destination node, and destination device set to zero.  Using the
-     * same packet metadata simplifies receive logic.
+     * Any packets batched on the bundle are carried by the same MPI
+     * message.
+     *
+     * @internal The Null Message MPI buffer format is an MpiPacketBatch
+     * holding no packets.  Using the same format for packets and Null
+     * Messages simplifies receive logic.
      */
     static void SendNullMessage(const Time& guaranteeUpdate, Ptr<RemoteChannelBundle> bundle);
+    /**
+     * @brief Send the packets batched on the specified bundle.
+     *
+     * The guarantee time sent with the packets is computed at the time
+     * of the flush and the Null Message event of the bundle is
+     * rescheduled.
+     *
+     * @param [in] bundle The bundle of links between two ranks.
+     */
+    static void FlushPendingPackets(Ptr<RemoteChannelBundle> bundle);
     /**
      * Non-blocking check for received messages complete.  Will
      * receive all messages that are queued up locally.
@@ -132,6 +146,12 @@ class NullMessageMpiInterface : public ParallelCommunicationInterface, Object
     /** Number of neighbor tasks, tasks that this task shares a link with. */
     static uint32_t g_numNeighbors;
 
+    /** Total packets sent. */
+    static uint64_t g_txPacketCount;
+
+    /** Total MPI messages posted to carry packets. */
+    static uint64_t g_txMessageCount;
+
     /** Has this interface been enabled. */
     static bool g_enabled;
 
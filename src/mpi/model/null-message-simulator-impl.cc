@@ -306,6 +306,11 @@ NullMessageSimulatorImpl::Run()
         if (nextTime <= GetSafeTime())
         {
             ProcessOneEvent();
+            // Packets are batched per bundle while time stands still.
+            if (IsFinished() || Next() > Now())
+            {
+                RemoteChannelBundleManager::FlushPendingPackets();
+            }
             HandleArrivingMessagesNonBlocking();
         }
         else
@@ -90,6 +90,14 @@ class ParallelCommunicationInterface
      * @copydoc MpiInterface::GetCommunicator
      */
     virtual MPI_Comm GetCommunicator() = 0;
+    /**
+     * @copydoc MpiInterface::GetTxMessageCount
+     */
+    virtual uint64_t GetTxMessageCount() = 0;
+    /**
+     * @copydoc MpiInterface::GetTxPacketCount
+     */
+    virtual uint64_t GetTxPacketCount() = 0;
 
   private:
 };
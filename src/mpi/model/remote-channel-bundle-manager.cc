@@ -92,6 +92,15 @@ RemoteChannelBundleManager::GetSafeTime()
     return safeTime;
 }
 
+void
+RemoteChannelBundleManager::FlushPendingPackets()
+{
+    for (auto kv = g_remoteChannelBundles.begin(); kv != g_remoteChannelBundles.end(); ++kv)
+    {
+        kv->second->Flush();
+    }
+}
+
 void
 RemoteChannelBundleManager::Destroy()
 {
@@ -72,6 +72,13 @@ class RemoteChannelBundleManager
      */
     static Time GetSafeTime();
 
+    /**
+     * Send the packets batched on every RemoteChannelBundle.  Must be
+     * invoked before simulation time advances so that remote tasks
+     * receive the packets before their guarantee time moves past them.
+     */
+    static void FlushPendingPackets();
+
     /** Destroy the singleton. */
     static void Destroy();
 
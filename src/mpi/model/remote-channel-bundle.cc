@@ -104,6 +104,21 @@ RemoteChannelBundle::Send(Time time)
     NullMessageMpiInterface::SendNullMessage(time, this);
 }
 
+MpiPacketBatch&
+RemoteChannelBundle::GetPendingPackets()
+{
+    return m_pendingPackets;
+}
+
+void
+RemoteChannelBundle::Flush()
+{
+    if (!m_pendingPackets.IsEmpty())
+    {
+        NullMessageMpiInterface::FlushPendingPackets(this);
+    }
+}
+
 std::ostream&
 operator<<(std::ostream& out, ns3::RemoteChannelBundle& bundle)
 {
@@ -16,6 +16,7 @@
 #ifndef NS3_REMOTE_CHANNEL_BUNDLE
 #define NS3_REMOTE_CHANNEL_BUNDLE
 
+#include "mpi-packet-batch.h"
 #include "null-message-simulator-impl.h"
 
 #include "ns3/channel.h"
@@ -122,6 +123,20 @@ class RemoteChannelBundle : public Object
      */
     void Send(Time time);
 
+    /**
+     * Get the packets waiting to be sent to the remote task
+     * associated with this bundle.
+     *
+     * @return The batch of pending packets.
+     */
+    MpiPacketBatch& GetPendingPackets();
+
+    /**
+     * Send the pending packets, if any, to the remote task associated
+     * with this bundle.
+     */
+    void Flush();
+
     /**
      * Output for debugging purposes.
      *
@@ -158,6 +173,9 @@ class RemoteChannelBundle : public Object
 
     /** Event scheduled to send Null Message for this bundle. */
     EventId m_nullEventId;
+
+    /** Packets sent across this bundle and not yet handed to MPI. */
+    MpiPacketBatch m_pendingPackets;
 };
 
 } // namespace ns3
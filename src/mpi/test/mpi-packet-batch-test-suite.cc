@@ -0,0 +1,164 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/mpi-packet-batch.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * @file
+ * @ingroup mpi-tests
+ * MpiPacketBatch test suite
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup mpi-tests
+ *
+ * @brief Test case checking that packets of mixed sizes are carried
+ * unchanged by a batch.
+ */
+class MpiPacketBatchMixedSizesTestCase : public TestCase
+{
+  public:
+    MpiPacketBatchMixedSizesTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MpiPacketBatchMixedSizesTestCase::MpiPacketBatchMixedSizesTestCase()
+    : TestCase("Check that packets of mixed sizes are packed and unpacked unchanged")
+{
+}
+
+void
+MpiPacketBatchMixedSizesTestCase::DoRun()
+{
+    const std::vector<uint32_t> sizes = {0, 1, 1500, 7, 9000, 64};
+
+    MpiPacketBatch batch;
+    std::vector<Ptr<Packet>> packets;
+    uint32_t expectedSize = MpiPacketBatch::GetHeaderSize();
+    for (uint32_t i = 0; i < sizes.size(); ++i)
+    {
+        std::vector<uint8_t> payload(sizes[i]);
+        for (uint32_t j = 0; j < sizes[i]; ++j)
+        {
+            payload[j] = static_cast<uint8_t>(i + j);
+        }
+        Ptr<Packet> p = Create<Packet>(payload.data(), payload.size());
+        packets.push_back(p);
+        NS_TEST_ASSERT_MSG_EQ(batch.CanAdd(p), true, "Packet " << i << " must fit");
+        batch.Add(p, MicroSeconds(10 * i), i, 100 + i);
+        expectedSize += MpiPacketBatch::GetRecordSize(p);
+    }
+    NS_TEST_ASSERT_MSG_EQ(batch.GetCount(), sizes.size(), "Unexpected packet count");
+    NS_TEST_ASSERT_MSG_EQ(batch.GetSize(), expectedSize, "Unexpected message size");
+
+    uint32_t size;
+    uint8_t* buffer = batch.Detach(MilliSeconds(3), size);
+    NS_TEST_ASSERT_MSG_EQ(size, expectedSize, "Unexpected detached message size");
+    NS_TEST_EXPECT_MSG_EQ(batch.IsEmpty(), true, "The batch must be reset once detached");
+    NS_TEST_EXPECT_MSG_EQ(batch.GetSize(),
+                          MpiPacketBatch::GetHeaderSize(),
+                          "The reset batch must only hold its header");
+
+    Time guarantee;
+    std::vector<MpiPacketBatch::Record> records;
+    MpiPacketBatch::Deserialize(buffer, size, guarantee, records);
+    delete[] buffer;
+
+    NS_TEST_EXPECT_MSG_EQ(guarantee, MilliSeconds(3), "Unexpected guarantee time");
+    NS_TEST_ASSERT_MSG_EQ(records.size(), sizes.size(), "Unexpected unpacked packet count");
+    for (uint32_t i = 0; i < sizes.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(records[i].rxTime, MicroSeconds(10 * i), "Unexpected rx time");
+        NS_TEST_EXPECT_MSG_EQ(records[i].node, i, "Unexpected node");
+        NS_TEST_EXPECT_MSG_EQ(records[i].dev, 100 + i, "Unexpected device");
+        NS_TEST_ASSERT_MSG_EQ(records[i].packet->GetSize(), sizes[i], "Unexpected packet size");
+        NS_TEST_EXPECT_MSG_EQ(records[i].packet->GetUid(), packets[i]->GetUid(), "Unexpected uid");
+        std::vector<uint8_t> sent(sizes[i]);
+        std::vector<uint8_t> received(sizes[i]);
+        packets[i]->CopyData(sent.data(), sent.size());
+        records[i].packet->CopyData(received.data(), received.size());
+        NS_TEST_EXPECT_MSG_EQ((sent == received), true, "Unexpected payload of packet " << i);
+    }
+}
+
+/**
+ * @ingroup mpi-tests
+ *
+ * @brief Test case checking that an empty batch, a Null Message, carries
+ * only its guarantee time, and that a full batch refuses more packets.
+ */
+class MpiPacketBatchEmptyTestCase : public TestCase
+{
+  public:
+    MpiPacketBatchEmptyTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+MpiPacketBatchEmptyTestCase::MpiPacketBatchEmptyTestCase()
+    : TestCase("Check that an empty batch only carries its guarantee time")
+{
+}
+
+void
+MpiPacketBatchEmptyTestCase::DoRun()
+{
+    MpiPacketBatch batch;
+    NS_TEST_ASSERT_MSG_EQ(batch.IsEmpty(), true, "A new batch must be empty");
+
+    uint32_t size;
+    uint8_t* buffer = batch.Detach(Seconds(2), size);
+    NS_TEST_ASSERT_MSG_EQ(size, MpiPacketBatch::GetHeaderSize(), "Unexpected empty message size");
+
+    Time guarantee;
+    std::vector<MpiPacketBatch::Record> records;
+    MpiPacketBatch::Deserialize(buffer, size, guarantee, records);
+    delete[] buffer;
+    NS_TEST_EXPECT_MSG_EQ(guarantee, Seconds(2), "Unexpected guarantee time");
+    NS_TEST_EXPECT_MSG_EQ(records.size(), 0, "An empty batch must not carry packets");
+
+    // fill a batch up to the maximum message size
+    Ptr<Packet> p = Create<Packet>(10000);
+    uint32_t count = 0;
+    while (batch.CanAdd(p))
+    {
+        batch.Add(p, Seconds(1), 0, 0);
+        count++;
+    }
+    NS_TEST_EXPECT_MSG_GT(count, 0, "At least one packet must fit");
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(batch.GetSize(), MAX_MPI_BATCH_SIZE, "Oversized batch");
+    NS_TEST_EXPECT_MSG_GT(batch.GetSize() + MpiPacketBatch::GetRecordSize(p),
+                          MAX_MPI_BATCH_SIZE,
+                          "The batch must refuse a packet only when it does not fit");
+}
+
+/**
+ * @ingroup mpi-tests
+ *
+ * @brief MpiPacketBatch TestSuite
+ */
+class MpiPacketBatchTestSuite : public TestSuite
+{
+  public:
+    MpiPacketBatchTestSuite();
+};
+
+MpiPacketBatchTestSuite::MpiPacketBatchTestSuite()
+    : TestSuite("mpi-packet-batch", Type::UNIT)
+{
+    AddTestCase(new MpiPacketBatchMixedSizesTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new MpiPacketBatchEmptyTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static MpiPacketBatchTestSuite g_mpiPacketBatchTestSuite;
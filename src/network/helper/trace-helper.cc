@@ -13,6 +13,7 @@
 #include "ns3/net-device.h"
 #include "ns3/node.h"
 #include "ns3/pcap-file-wrapper.h"
+#include "ns3/pointer.h"
 #include "ns3/ptr.h"
 
 #include <cstdint>
@@ -673,4 +674,107 @@ AsciiTraceHelperForDevice::EnableAsciiImpl(Ptr<OutputStreamWrapper> stream,
     }
 }
 
+BinaryTraceHelper::BinaryTraceHelper()
+{
+    NS_LOG_FUNCTION_NOARGS();
+}
+
+BinaryTraceHelper::~BinaryTraceHelper()
+{
+    NS_LOG_FUNCTION_NOARGS();
+}
+
+Ptr<BinaryTraceFile>
+BinaryTraceHelper::CreateFile(std::string filename, uint32_t blockSize)
+{
+    NS_LOG_FUNCTION(filename << blockSize);
+
+    Ptr<BinaryTraceFile> file = Create<BinaryTraceFile>(filename, std::ios::out, blockSize);
+    NS_ABORT_MSG_IF(file->Fail(), "Unable to Open " << filename);
+
+    //
+    // As for the other trace helpers, the file is kept alive by the callbacks
+    // it gets bound to, and the last block is written when it is destroyed.
+    //
+    return file;
+}
+
+void
+BinaryTraceHelper::EnableBinary(Ptr<BinaryTraceFile> file, Ptr<NetDevice> nd)
+{
+    NS_LOG_FUNCTION(file << nd);
+
+    uint32_t nodeId = nd->GetNode()->GetId();
+    uint32_t deviceId = nd->GetIfIndex();
+
+    PointerValue txQueue;
+    if (nd->GetAttributeFailSafe("TxQueue", txQueue))
+    {
+        Ptr<Object> queue = txQueue.Get<Object>();
+        if (queue)
+        {
+            HookDefaultSink(queue, "Enqueue", file, nodeId, deviceId, BinaryTraceFile::ENQUEUE);
+            HookDefaultSink(queue, "Dequeue", file, nodeId, deviceId, BinaryTraceFile::DEQUEUE);
+            HookDefaultSink(queue, "Drop", file, nodeId, deviceId, BinaryTraceFile::DROP);
+        }
+    }
+    HookDefaultSink(nd, "MacRx", file, nodeId, deviceId, BinaryTraceFile::RECEIVE);
+    HookDefaultSink(nd, "PhyRxDrop", file, nodeId, deviceId, BinaryTraceFile::DROP);
+}
+
+void
+BinaryTraceHelper::EnableBinary(Ptr<BinaryTraceFile> file, NetDeviceContainer d)
+{
+    for (auto i = d.Begin(); i != d.End(); ++i)
+    {
+        EnableBinary(file, *i);
+    }
+}
+
+void
+BinaryTraceHelper::EnableBinary(Ptr<BinaryTraceFile> file, NodeContainer n)
+{
+    for (auto i = n.Begin(); i != n.End(); ++i)
+    {
+        Ptr<Node> node = *i;
+        for (uint32_t j = 0; j < node->GetNDevices(); ++j)
+        {
+            EnableBinary(file, node->GetDevice(j));
+        }
+    }
+}
+
+void
+BinaryTraceHelper::EnableBinaryAll(Ptr<BinaryTraceFile> file)
+{
+    EnableBinary(file, NodeContainer::GetGlobal());
+}
+
+bool
+BinaryTraceHelper::HookDefaultSink(Ptr<Object> object,
+                                   std::string traceName,
+                                   Ptr<BinaryTraceFile> file,
+                                   uint32_t nodeId,
+                                   uint32_t deviceId,
+                                   BinaryTraceFile::EventType event)
+{
+    bool result = object->TraceConnectWithoutContext(
+        traceName,
+        MakeBoundCallback(&DefaultSink, file, nodeId, deviceId, event));
+    NS_LOG_LOGIC("Hooking " << traceName << " of node " << nodeId << " device " << deviceId
+                            << (result ? " succeeded" : " failed"));
+    return result;
+}
+
+void
+BinaryTraceHelper::DefaultSink(Ptr<BinaryTraceFile> file,
+                               uint32_t nodeId,
+                               uint32_t deviceId,
+                               BinaryTraceFile::EventType event,
+                               Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(file << nodeId << deviceId << event << p);
+    file->Write(Simulator::Now(), nodeId, deviceId, event, p);
+}
+
 } // namespace ns3
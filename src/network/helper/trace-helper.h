@@ -11,6 +11,7 @@
 #include "node-container.h"
 
 #include "ns3/assert.h"
+#include "ns3/binary-trace-file.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/pcap-file-wrapper.h"
 #include "ns3/simulator.h"
@@ -951,6 +952,106 @@ class AsciiTraceHelperForDevice
                          bool explicitFilename);
 };
 
+/**
+ * @brief Manage binary trace files for device models
+ *
+ * Writes the enqueue, dequeue, drop and receive events of net devices to
+ * a BinaryTraceFile, as a compact alternative to ASCII traces for long
+ * simulations.  The devices are hooked through the trace sources which
+ * most device models provide: "Enqueue", "Dequeue" and "Drop" of the
+ * queue held by the "TxQueue" attribute, and the "MacRx" and "PhyRxDrop"
+ * trace sources of the device.  Trace sources which a device does not
+ * provide are ignored.
+ */
+class BinaryTraceHelper
+{
+  public:
+    /**
+     * @brief Create a binary trace helper.
+     */
+    BinaryTraceHelper();
+
+    /**
+     * @brief Destroy a binary trace helper.
+     */
+    ~BinaryTraceHelper();
+
+    /**
+     * @brief Create and initialize a binary trace file.
+     *
+     * @param filename file name
+     * @param blockSize number of records buffered before they are written
+     * @returns a smart pointer to the binary trace file
+     */
+    Ptr<BinaryTraceFile> CreateFile(std::string filename,
+                                    uint32_t blockSize = BinaryTraceFile::BLOCK_SIZE_DEFAULT);
+
+    /**
+     * @brief Enable binary tracing of a net device.
+     *
+     * @param file The file to write the events to
+     * @param nd The net device to trace
+     */
+    void EnableBinary(Ptr<BinaryTraceFile> file, Ptr<NetDevice> nd);
+
+    /**
+     * @brief Enable binary tracing of every device in a container.
+     *
+     * @param file The file to write the events to
+     * @param d container of devices
+     */
+    void EnableBinary(Ptr<BinaryTraceFile> file, NetDeviceContainer d);
+
+    /**
+     * @brief Enable binary tracing of every device in a container of nodes.
+     *
+     * @param file The file to write the events to
+     * @param n container of nodes
+     */
+    void EnableBinary(Ptr<BinaryTraceFile> file, NodeContainer n);
+
+    /**
+     * @brief Enable binary tracing of every device in the simulation.
+     *
+     * @param file The file to write the events to
+     */
+    void EnableBinaryAll(Ptr<BinaryTraceFile> file);
+
+  private:
+    /**
+     * @brief Hook a trace source of an object to the default trace sink
+     *
+     * @param object object
+     * @param traceName trace source name
+     * @param file the file to write to
+     * @param nodeId the id of the node of the traced device
+     * @param deviceId the index of the traced device on its node
+     * @param event the kind of event reported by the trace source
+     * @returns true if the trace source could be hooked
+     */
+    bool HookDefaultSink(Ptr<Object> object,
+                         std::string traceName,
+                         Ptr<BinaryTraceFile> file,
+                         uint32_t nodeId,
+                         uint32_t deviceId,
+                         BinaryTraceFile::EventType event);
+
+    /**
+     * The default trace sink, which adds a record for the packet.
+     *
+     * @param file the file to write to
+     * @param nodeId the id of the node of the traced device
+     * @param deviceId the index of the traced device on its node
+     * @param event the kind of event
+     * @param p the packet
+     */
+    static void DefaultSink(Ptr<BinaryTraceFile> file,
+                            uint32_t nodeId,
+                            uint32_t deviceId,
+                            BinaryTraceFile::EventType event,
+                            Ptr<const Packet> p);
+};
+
 } // namespace ns3
 
 #endif /* TRACE_HELPER_H */
@@ -7,8 +7,14 @@
  */
 #include "buffer.h"
 
+#include "packet-memory-pool.h"
+
 #include "ns3/assert.h"
+#include "ns3/ip-checksum.h"
 #include "ns3/log.h"
+#include "ns3/object-accounting.h"
+
+#include <algorithm>
 
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
@@ -44,92 +50,31 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
 uint32_t Buffer::g_recommendedStart = 0;
-#ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy
- * constructor orderings.
- */
-#define MAGIC_DESTROYED (~(long)0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor()
-{
-    NS_LOG_FUNCTION(this);
-    if (IS_INITIALIZED(g_freeList))
-    {
-        for (auto i = g_freeList->begin(); i != g_freeList->end(); i++)
-        {
-            Buffer::Deallocate(*i);
-        }
-        delete g_freeList;
-        g_freeList = DESTROYED;
-    }
-}
 
+constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
+
+#ifdef BUFFER_FREE_LIST
 void
 Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
-    g_maxSize = std::max(g_maxSize, data->m_size);
-    /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
-    {
-        Buffer::Deallocate(data);
-    }
-    else
-    {
-        NS_ASSERT(IS_INITIALIZED(g_freeList));
-        g_freeList->push_back(data);
-    }
+    AccountData(data, false);
+    /* feed into the free list of the size class of the buffer */
+    PacketMemoryPool::Deallocate(data, data->m_size - 1 + sizeof(Buffer::Data));
 }
 
 Buffer::Data*
 Buffer::Create(uint32_t dataSize)
 {
     NS_LOG_FUNCTION(dataSize);
-    /* try to find a buffer correctly sized. */
-    if (IS_UNINITIALIZED(g_freeList))
-    {
-        g_freeList = new Buffer::FreeList();
-    }
-    else if (IS_INITIALIZED(g_freeList))
-    {
-        while (!g_freeList->empty())
-        {
-            Buffer::Data* data = g_freeList->back();
-            g_freeList->pop_back();
-            if (data->m_size >= dataSize)
-            {
-                data->m_count = 1;
-                return data;
-            }
-            Buffer::Deallocate(data);
-        }
-    }
-    Buffer::Data* data = Buffer::Allocate(dataSize);
-    NS_ASSERT(data->m_count == 1);
+    /* take a buffer from the free list of the matching size class, if any */
+    dataSize = std::max<uint32_t>(dataSize, 1) + ALLOC_OVER_PROVISION;
+    std::size_t size = PacketMemoryPool::GetBlockSize(dataSize - 1 + sizeof(Buffer::Data));
+    auto data = static_cast<Buffer::Data*>(PacketMemoryPool::Allocate(size));
+    data->m_size = static_cast<uint32_t>(size + 1 - sizeof(Buffer::Data));
+    data->m_count = 1;
+    AccountData(data, true);
     return data;
 }
 #else  /* BUFFER_FREE_LIST */
@@ -138,6 +83,7 @@ Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
+    AccountData(data, false);
     Deallocate(data);
 }
 
@@ -145,11 +91,30 @@ Buffer::Data*
 Buffer::Create(uint32_t size)
 {
     NS_LOG_FUNCTION(size);
-    return Allocate(size);
+    Buffer::Data* data = Allocate(size);
+    AccountData(data, true);
+    return data;
 }
 #endif /* BUFFER_FREE_LIST */
 
-constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
+void
+Buffer::AccountData(const Buffer::Data* data, bool created)
+{
+    if (ObjectAccounting::IsEnabled())
+    {
+        static ObjectAccounting::Counter* counter =
+            ObjectAccounting::LookupCounter("ns3::Buffer::Data");
+        std::size_t bytes = data->m_size - 1 + sizeof(Buffer::Data);
+        if (created)
+        {
+            ObjectAccounting::NotifyAllocation(counter, bytes);
+        }
+        else
+        {
+            ObjectAccounting::NotifyDeallocation(counter, bytes);
+        }
+    }
+}
 
 Buffer::Data*
 Buffer::Allocate(uint32_t reqSize)
@@ -1131,24 +1096,40 @@ uint16_t
 Buffer::Iterator::CalculateIpChecksum(uint16_t size, uint32_t initialChecksum)
 {
     NS_LOG_FUNCTION(this << size << initialChecksum);
+    NS_ASSERT_MSG(m_current >= m_dataStart && m_current + size <= m_dataEnd,
+                  GetReadErrorMessage());
     /* see RFC 1071 to understand this code. */
-    uint32_t sum = initialChecksum;
-
-    for (int j = 0; j < size / 2; j++)
+    uint64_t sum = initialChecksum;
+    uint32_t end = m_current + size;
+    // whether the next byte is the high order byte of a 16 bit word
+    bool odd = false;
+
+    // The data is summed by contiguous spans: the bytes before the zero
+    // area, then the bytes after it. The sum of a span starting at an odd
+    // offset from the start of the checksummed data is byte-swapped.
+    if (m_current < m_zeroStart)
     {
-        sum += ReadU16();
+        uint32_t spanEnd = std::min(end, m_zeroStart);
+        uint16_t partial = IpChecksumPartial(m_data + m_current, spanEnd - m_current);
+        sum += partial;
+        odd = (spanEnd - m_current) & 1;
+        m_current = spanEnd;
     }
-
-    if (size & 1)
+    if (m_current < end && m_current < m_zeroEnd)
     {
-        sum += ReadU8();
+        uint32_t spanEnd = std::min(end, m_zeroEnd);
+        odd ^= (spanEnd - m_current) & 1;
+        m_current = spanEnd;
     }
-
-    while (sum >> 16)
+    if (m_current < end)
     {
-        sum = (sum & 0xffff) + (sum >> 16);
+        uint16_t partial =
+            IpChecksumPartial(m_data + m_current - (m_zeroEnd - m_zeroStart), end - m_current);
+        sum += odd ? static_cast<uint16_t>((partial >> 8) | (partial << 8)) : partial;
+        m_current = end;
     }
-    return ~sum;
+
+    return ~IpChecksumFold(sum);
 }
 
 uint32_t
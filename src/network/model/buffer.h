@@ -739,6 +739,13 @@ class Buffer
      * @param data the buffer data storage
      */
     static void Deallocate(Buffer::Data* data);
+    /**
+     * @brief Count the creation or the recycling of a buffer data storage
+     * by the ObjectAccounting, if it is enabled
+     * @param data the buffer data storage
+     * @param created true if the storage was created, false if it is recycled
+     */
+    static void AccountData(const Buffer::Data* data, bool created);
 
     Data* m_data; //!< the buffer data storage
 
@@ -780,21 +787,6 @@ class Buffer
      * instance from the start of m_data->m_data
      */
     uint32_t m_end;
-
-#ifdef BUFFER_FREE_LIST
-    /// Container for buffer data
-    typedef std::vector<Buffer::Data*> FreeList;
-
-    /// Local static destructor structure
-    struct LocalStaticDestructor
-    {
-        ~LocalStaticDestructor();
-    };
-
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
 };
 
 } // namespace ns3
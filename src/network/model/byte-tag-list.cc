@@ -7,14 +7,14 @@
  */
 #include "byte-tag-list.h"
 
+#include "packet-memory-pool.h"
+
 #include "ns3/log.h"
 
 #include <cstring>
 #include <limits>
-#include <vector>
 
 #define USE_FREE_LIST 1
-#define FREE_LIST_SIZE 1000
 #define OFFSET_MAX (std::numeric_limits<int32_t>::max())
 
 namespace ns3
@@ -37,33 +37,6 @@ struct ByteTagListData
     uint8_t data[4]; //!< data
 };
 
-#ifdef USE_FREE_LIST
-/**
- * @ingroup packet
- *
- * @brief Container class for struct ByteTagListData
- *
- * Internal use only.
- */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
-{
-  public:
-    ~ByteTagListDataFreeList();
-} g_freeList; //!< Container for struct ByteTagListData
-
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
-
-ByteTagListDataFreeList::~ByteTagListDataFreeList()
-{
-    NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
-    {
-        auto buffer = (uint8_t*)(*i);
-        delete[] buffer;
-    }
-}
-#endif /* USE_FREE_LIST */
-
 ByteTagList::Iterator::Item::Item(TagBuffer buf_)
     : buf(buf_)
 {
@@ -344,24 +317,12 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
-    {
-        ByteTagListData* data = g_freeList.back();
-        g_freeList.pop_back();
-        NS_ASSERT(data != nullptr);
-        if (data->size >= size)
-        {
-            data->count = 1;
-            data->dirty = 0;
-            return data;
-        }
-        auto buffer = (uint8_t*)data;
-        delete[] buffer;
-    }
-    auto buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4];
-    auto data = (ByteTagListData*)buffer;
+    // Take the data from the free list of its size class, and make the
+    // whole block available to the tags
+    std::size_t blockSize = PacketMemoryPool::GetBlockSize(size + sizeof(ByteTagListData) - 4);
+    auto data = static_cast<ByteTagListData*>(PacketMemoryPool::Allocate(blockSize));
     data->count = 1;
-    data->size = size;
+    data->size = static_cast<uint32_t>(blockSize - sizeof(ByteTagListData) + 4);
     data->dirty = 0;
     return data;
 }
@@ -374,19 +335,10 @@ ByteTagList::Deallocate(ByteTagListData* data)
     {
         return;
     }
-    g_maxSize = std::max(g_maxSize, data->size);
     data->count--;
     if (data->count == 0)
     {
-        if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
-        {
-            auto buffer = (uint8_t*)data;
-            delete[] buffer;
-        }
-        else
-        {
-            g_freeList.push_back(data);
-        }
+        PacketMemoryPool::Deallocate(data, data->size + sizeof(ByteTagListData) - 4);
     }
 }
 
@@ -220,14 +220,18 @@ void
 Node::RegisterProtocolHandler(ProtocolHandler handler,
                               uint16_t protocolType,
                               Ptr<NetDevice> device,
-                              bool promiscuous)
+                              bool promiscuous,
+                              BatchProtocolHandler batchHandler)
 {
     NS_LOG_FUNCTION(this << &handler << protocolType << device << promiscuous);
+    NS_ASSERT_MSG(!promiscuous || batchHandler.IsNull(),
+                  "Batches of packets are not delivered to promiscuous mode handlers");
     Node::ProtocolHandlerEntry entry;
     entry.handler = handler;
     entry.protocol = protocolType;
     entry.device = device;
     entry.promiscuous = promiscuous;
+    entry.batchHandler = batchHandler;
 
     // On demand enable promiscuous mode in netdevices
     if (promiscuous)
@@ -336,6 +340,53 @@ Node::ReceiveFromDevice(Ptr<NetDevice> device,
     return found;
 }
 
+bool
+Node::IsReceiveCallback(const NetDevice::ReceiveCallback& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    return cb.IsEqual(
+        MakeCallback(&Node::NonPromiscReceiveFromDevice, const_cast<Node*>(this)));
+}
+
+bool
+Node::ReceiveBatchFromDevice(Ptr<NetDevice> device,
+                             const std::vector<Ptr<const Packet>>& packets,
+                             uint16_t protocol,
+                             const Address& from)
+{
+    NS_LOG_FUNCTION(this << device << packets.size() << protocol << &from);
+    NS_ASSERT_MSG(Simulator::GetContext() == GetId(),
+                  "Received packet with erroneous context ; "
+                      << "make sure the channels in use are correctly updating events context "
+                      << "when transferring events from one node to another.");
+    const Address to = device->GetAddress();
+    bool found = false;
+
+    for (auto i = m_handlers.begin(); i != m_handlers.end(); i++)
+    {
+        if ((!i->device || (i->device == device)) &&
+            (i->protocol == 0 || i->protocol == protocol) && !i->promiscuous)
+        {
+            if (!i->batchHandler.IsNull())
+            {
+                i->batchHandler(device, packets, protocol, from, to, NetDevice::PACKET_HOST);
+            }
+            else
+            {
+                for (const auto& packet : packets)
+                {
+                    i->handler(device, packet, protocol, from, to, NetDevice::PACKET_HOST);
+                }
+            }
+            found = true;
+        }
+    }
+    NS_LOG_DEBUG("Node " << GetId() << " ReceiveBatchFromDevice:  dev " << device->GetIfIndex()
+                         << " (type=" << device->GetInstanceTypeId().GetName() << ") "
+                         << packets.size() << " packets, handler found: " << found);
+    return found;
+}
+
 void
 Node::RegisterDeviceAdditionListener(DeviceAdditionListener listener)
 {
@@ -152,6 +152,26 @@ class Node : public Object
                      const Address&,
                      NetDevice::PacketType>
         ProtocolHandler;
+    /**
+     * A protocol handler for batches of packets
+     *
+     * @param device a pointer to the net device which received the packets
+     * @param packets the packets received, in order of reception
+     * @param protocol the 16 bit protocol number associated with the packets
+     * @param sender the address of the sender of the packets
+     * @param receiver the address of the receiver, i.e., device->GetAddress()
+     * @param packetType always NetDevice::PACKET_HOST
+     *
+     * @see ReceiveBatchFromDevice
+     */
+    typedef Callback<void,
+                     Ptr<NetDevice>,
+                     const std::vector<Ptr<const Packet>>&,
+                     uint16_t,
+                     const Address&,
+                     const Address&,
+                     NetDevice::PacketType>
+        BatchProtocolHandler;
     /**
      * @param handler the handler to register
      * @param protocolType the type of protocol this handler is
@@ -164,11 +184,16 @@ class Node : public Object
      *        value is zero, the handler is attached to all
      *        devices on this node.
      * @param promiscuous whether to register a promiscuous mode handler
+     * @param batchHandler the handler invoked with the batches of packets
+     *        received through ReceiveBatchFromDevice. If null, the handler
+     *        is invoked for each packet of the batches. It must be null for
+     *        promiscuous mode handlers.
      */
     void RegisterProtocolHandler(ProtocolHandler handler,
                                  uint16_t protocolType,
                                  Ptr<NetDevice> device,
-                                 bool promiscuous = false);
+                                 bool promiscuous = false,
+                                 BatchProtocolHandler batchHandler = BatchProtocolHandler());
     /**
      * @param handler the handler to unregister
      *
@@ -197,6 +222,39 @@ class Node : public Object
      */
     void UnregisterDeviceAdditionListener(DeviceAdditionListener listener);
 
+    /**
+     * @brief Receive a batch of packets from a device in non-promiscuous mode.
+     *
+     * This method is called by the devices which are configured to deliver
+     * the packets they receive in batches, instead of calling their receive
+     * callback for each packet, as long as their receive callback is the one
+     * set by AddDevice (see IsReceiveCallback). The protocol handlers are looked up once for
+     * the whole batch, and those registered with a batch handler process
+     * the batch at once.
+     *
+     * @param device the device
+     * @param packets the packets, in order of reception
+     * @param protocol the protocol of all the packets
+     * @param from the sender of all the packets
+     * @returns true if the packets have been delivered to a protocol handler.
+     */
+    bool ReceiveBatchFromDevice(Ptr<NetDevice> device,
+                                const std::vector<Ptr<const Packet>>& packets,
+                                uint16_t protocol,
+                                const Address& from);
+
+    /**
+     * @brief Check whether a receive callback delivers the packets to this node.
+     *
+     * The devices delivering the packets they receive in batches through
+     * ReceiveBatchFromDevice do so only when their receive callback is the
+     * one set by AddDevice: a custom receive callback must see every packet.
+     *
+     * @param cb the receive callback of a device
+     * @returns true if the callback is the one set by AddDevice.
+     */
+    bool IsReceiveCallback(const NetDevice::ReceiveCallback& cb) const;
+
     /**
      * @returns true if checksums are enabled, false otherwise.
      */
@@ -276,10 +334,11 @@ class Node : public Object
      */
     struct ProtocolHandlerEntry
     {
-        ProtocolHandler handler; //!< the protocol handler
-        Ptr<NetDevice> device;   //!< the NetDevice
-        uint16_t protocol;       //!< the protocol number
-        bool promiscuous;        //!< true if it is a promiscuous handler
+        ProtocolHandler handler;           //!< the protocol handler
+        BatchProtocolHandler batchHandler; //!< the protocol handler for batches, if any
+        Ptr<NetDevice> device;             //!< the NetDevice
+        uint16_t protocol;                 //!< the protocol number
+        bool promiscuous;                  //!< true if it is a promiscuous handler
     };
 
     /// Typedef for protocol handlers container
@@ -0,0 +1,128 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "packet-memory-pool.h"
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <vector>
+
+namespace ns3
+{
+
+namespace
+{
+
+/// Number of size classes
+constexpr std::size_t N_SIZE_CLASSES =
+    std::countr_zero(PacketMemoryPool::MAX_BLOCK_SIZE) -
+    std::countr_zero(PacketMemoryPool::MIN_BLOCK_SIZE) + 1;
+
+/**
+ * @ingroup packet
+ * @brief The free blocks of a thread, by size class.
+ */
+struct ThreadFreeLists
+{
+    ~ThreadFreeLists();
+
+    std::vector<void*> blocks[N_SIZE_CLASSES]; //!< Free blocks of each size class
+};
+
+/// Whether the free lists of the calling thread have been destroyed
+thread_local bool t_destroyed = false;
+
+ThreadFreeLists::~ThreadFreeLists()
+{
+    for (auto& blocks : this->blocks)
+    {
+        for (auto block : blocks)
+        {
+            ::operator delete(block);
+        }
+    }
+    t_destroyed = true;
+}
+
+/**
+ * @return the free lists of the calling thread, or nullptr if they have
+ *         already been destroyed
+ */
+ThreadFreeLists*
+GetThreadFreeLists()
+{
+    if (t_destroyed)
+    {
+        return nullptr;
+    }
+    thread_local ThreadFreeLists freeLists;
+    return &freeLists;
+}
+
+/**
+ * @param size a block size
+ * @return the size class of blocks of that size
+ */
+std::size_t
+GetSizeClass(std::size_t size)
+{
+    return std::countr_zero(PacketMemoryPool::GetBlockSize(size)) -
+           std::countr_zero(PacketMemoryPool::MIN_BLOCK_SIZE);
+}
+
+} // namespace
+
+std::size_t
+PacketMemoryPool::GetBlockSize(std::size_t size)
+{
+    if (size > MAX_BLOCK_SIZE)
+    {
+        return size;
+    }
+    return std::bit_ceil(std::max(size, MIN_BLOCK_SIZE));
+}
+
+void*
+PacketMemoryPool::Allocate(std::size_t size)
+{
+    std::size_t blockSize = GetBlockSize(size);
+    if (blockSize <= MAX_BLOCK_SIZE)
+    {
+        ThreadFreeLists* freeLists = GetThreadFreeLists();
+        if (freeLists != nullptr)
+        {
+            auto& blocks = freeLists->blocks[GetSizeClass(size)];
+            if (!blocks.empty())
+            {
+                void* block = blocks.back();
+                blocks.pop_back();
+                return block;
+            }
+        }
+    }
+    return ::operator new(blockSize);
+}
+
+void
+PacketMemoryPool::Deallocate(void* block, std::size_t size)
+{
+    std::size_t blockSize = GetBlockSize(size);
+    if (blockSize <= MAX_BLOCK_SIZE)
+    {
+        ThreadFreeLists* freeLists = GetThreadFreeLists();
+        if (freeLists != nullptr)
+        {
+            auto& blocks = freeLists->blocks[GetSizeClass(size)];
+            if (blocks.size() * blockSize < MAX_FREE_BYTES)
+            {
+                blocks.push_back(block);
+                return;
+            }
+        }
+    }
+    ::operator delete(block);
+}
+
+} // namespace ns3
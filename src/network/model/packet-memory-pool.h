@@ -0,0 +1,63 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PACKET_MEMORY_POOL_H
+#define PACKET_MEMORY_POOL_H
+
+#include <cstddef>
+
+namespace ns3
+{
+
+/**
+ * @ingroup packet
+ *
+ * @brief Per-thread pools of memory blocks, used to recycle the memory of
+ * packets, of their buffers and of their tags.
+ *
+ * Blocks are grouped in size classes, which are the powers of two from
+ * MIN_BLOCK_SIZE to MAX_BLOCK_SIZE bytes; larger blocks are allocated and
+ * released directly on the heap. Each thread has its own set of free
+ * lists, so that no locking is needed, and a block may be released by
+ * a thread other than the one which allocated it. The free blocks of a
+ * thread are returned to the heap when the thread exits; the blocks
+ * released afterwards, for example by static destructors, are not pooled.
+ *
+ * Internal use only.
+ */
+class PacketMemoryPool
+{
+  public:
+    static constexpr std::size_t MIN_BLOCK_SIZE = 32;      //!< Size of the smallest size class
+    static constexpr std::size_t MAX_BLOCK_SIZE = 65536;   //!< Size of the largest size class
+    static constexpr std::size_t MAX_FREE_BYTES = 1 << 22; //!< Free bytes kept per size class
+
+    /**
+     * @param size the requested size, in bytes
+     * @return the size of the block allocated for a request of that size,
+     *         which the caller is free to use entirely
+     */
+    static std::size_t GetBlockSize(std::size_t size);
+
+    /**
+     * Allocate a block of memory.
+     *
+     * @param size the requested size, in bytes
+     * @return a block of at least GetBlockSize (size) bytes
+     */
+    static void* Allocate(std::size_t size);
+
+    /**
+     * Release a block of memory.
+     *
+     * @param block the block, as returned by Allocate
+     * @param size the size requested when allocating the block, or any size
+     *        with the same block size
+     */
+    static void Deallocate(void* block, std::size_t size);
+};
+
+} // namespace ns3
+
+#endif /* PACKET_MEMORY_POOL_H */
@@ -9,6 +9,7 @@
 
 #include "buffer.h"
 #include "header.h"
+#include "packet-memory-pool.h"
 #include "trailer.h"
 
 #include "ns3/assert.h"
@@ -607,9 +608,10 @@ PacketMetadata::Allocate(uint32_t n)
         n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
     size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-    auto buf = new uint8_t[size];
-    auto data = (PacketMetadata::Data*)buf;
-    data->m_size = n;
+    // The whole block allocated by the pool is made available
+    std::size_t blockSize = PacketMemoryPool::GetBlockSize(size);
+    auto data = static_cast<PacketMetadata::Data*>(PacketMemoryPool::Allocate(blockSize));
+    data->m_size = static_cast<uint32_t>(n + blockSize - size);
     data->m_count = 1;
     data->m_dirtyEnd = 0;
     return data;
@@ -619,8 +621,8 @@ void
 PacketMetadata::Deallocate(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    auto buf = (uint8_t*)data;
-    delete[] buf;
+    PacketMemoryPool::Deallocate(data,
+                                 sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
 }
 
 PacketMetadata
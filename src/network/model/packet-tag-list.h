@@ -242,6 +242,13 @@ class PacketTagList
      */
     static TagData* CreateTagData(size_t dataSize);
 
+    /**
+     * Destroy a TagData struct and release its memory.
+     *
+     * @param [in] tag The TagData object, as returned by CreateTagData.
+     */
+    static void DestroyTagData(TagData* tag);
+
     /**
      * Typedef of method function pointer for copy-on-write operations
      *
@@ -354,15 +361,13 @@ PacketTagList::RemoveAll()
         }
         if (prev != nullptr)
         {
-            prev->~TagData();
-            std::free(prev);
+            DestroyTagData(prev);
         }
         prev = cur;
     }
     if (prev != nullptr)
     {
-        prev->~TagData();
-        std::free(prev);
+        DestroyTagData(prev);
     }
     m_next = nullptr;
 }
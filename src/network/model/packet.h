@@ -12,6 +12,7 @@
 #include "byte-tag-list.h"
 #include "header.h"
 #include "nix-vector.h"
+#include "packet-memory-pool.h"
 #include "packet-metadata.h"
 #include "packet-tag-list.h"
 #include "tag.h"
@@ -20,8 +21,10 @@
 #include "ns3/assert.h"
 #include "ns3/callback.h"
 #include "ns3/mac48-address.h"
+#include "ns3/object-accounting.h"
 #include "ns3/ptr.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 namespace ns3
@@ -279,6 +282,11 @@ class Packet : public SimpleRefCount<Packet>
      * @param size the size of the input buffer.
      */
     Packet(const uint8_t* buffer, uint32_t size);
+
+    // packets are allocated from the PacketMemoryPool of the calling thread,
+    // so that creating a packet does not usually reach the heap
+    NS_OBJECT_ACCOUNTING_ALLOCATION("ns3::Packet", PacketMemoryPool)
+
     /**
      * @brief Create a new packet which contains a fragment of the original
      * packet.
@@ -0,0 +1,365 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/binary-trace-file.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("binary-trace-file-test-suite");
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case checking that records written to a binary trace file
+ * are read back unchanged, across several blocks.
+ */
+class BinaryTraceFileReadWriteTestCase : public TestCase
+{
+  public:
+    BinaryTraceFileReadWriteTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Field callback used by the test.
+     * @param p the traced packet
+     * @return twice the size of the packet
+     */
+    static uint64_t GetField(Ptr<const Packet> p);
+
+    std::string m_testFilename; //!< File name
+};
+
+BinaryTraceFileReadWriteTestCase::BinaryTraceFileReadWriteTestCase()
+    : TestCase("Check that BinaryTraceFile records can be written and read back")
+{
+}
+
+void
+BinaryTraceFileReadWriteTestCase::DoSetup()
+{
+    std::stringstream filename;
+    uint32_t n = rand();
+    filename << n;
+    m_testFilename = CreateTempDirFilename(filename.str() + ".bin");
+}
+
+void
+BinaryTraceFileReadWriteTestCase::DoTeardown()
+{
+    if (remove(m_testFilename.c_str()))
+    {
+        NS_LOG_ERROR("Failed to delete file " << m_testFilename);
+    }
+}
+
+uint64_t
+BinaryTraceFileReadWriteTestCase::GetField(Ptr<const Packet> p)
+{
+    return 2 * p->GetSize();
+}
+
+void
+BinaryTraceFileReadWriteTestCase::DoRun()
+{
+    const uint32_t blockSize = 4;
+    const uint32_t nRecords = 10;
+
+    auto writer = Create<BinaryTraceFile>(m_testFilename, std::ios::out, blockSize);
+    NS_TEST_ASSERT_MSG_EQ(writer->Fail(), false, "Open for writing must not fail");
+    writer->SetFieldCallback(MakeCallback(&BinaryTraceFileReadWriteTestCase::GetField));
+
+    std::vector<Ptr<Packet>> packets;
+    for (uint32_t i = 0; i < nRecords; ++i)
+    {
+        Ptr<Packet> p = Create<Packet>(100 + i);
+        packets.push_back(p);
+        auto event = (i % 2) ? BinaryTraceFile::DEQUEUE : BinaryTraceFile::ENQUEUE;
+        writer->Write(MicroSeconds(i), i % 3, i % 2, event, p);
+    }
+    NS_TEST_ASSERT_MSG_EQ(writer->GetRecordCount(), nRecords, "Unexpected written record count");
+    writer->Close();
+    NS_TEST_ASSERT_MSG_EQ(writer->Fail(), false, "Write must not fail");
+
+    // 16 bytes of file header, 3 blocks of 4, 4 and 2 records of 37 bytes
+    std::ifstream in(m_testFilename, std::ios::binary | std::ios::ate);
+    NS_TEST_ASSERT_MSG_EQ(static_cast<uint32_t>(in.tellg()),
+                          16 + 3 * 4 + nRecords * 37,
+                          "Unexpected file size");
+    in.close();
+
+    auto reader = Create<BinaryTraceFile>(m_testFilename, std::ios::in);
+    NS_TEST_ASSERT_MSG_EQ(reader->Fail(), false, "Open for reading must not fail");
+    BinaryTraceFile::Record record;
+    for (uint32_t i = 0; i < nRecords; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(reader->Read(record), true, "Missing record " << i);
+        NS_TEST_EXPECT_MSG_EQ(record.time, i * 1000LL, "Unexpected time");
+        NS_TEST_EXPECT_MSG_EQ(record.node, i % 3, "Unexpected node");
+        NS_TEST_EXPECT_MSG_EQ(record.device, i % 2, "Unexpected device");
+        NS_TEST_EXPECT_MSG_EQ(record.event,
+                              (i % 2) ? BinaryTraceFile::DEQUEUE : BinaryTraceFile::ENQUEUE,
+                              "Unexpected event");
+        NS_TEST_EXPECT_MSG_EQ(record.uid, packets[i]->GetUid(), "Unexpected uid");
+        NS_TEST_EXPECT_MSG_EQ(record.size, 100 + i, "Unexpected size");
+        NS_TEST_EXPECT_MSG_EQ(record.field, 2 * (100 + i), "Unexpected field");
+    }
+    NS_TEST_EXPECT_MSG_EQ(reader->Read(record), false, "Unexpected record after the last one");
+    NS_TEST_EXPECT_MSG_EQ(reader->Fail(), false, "The end of the file must not be a failure");
+    NS_TEST_EXPECT_MSG_EQ(reader->GetRecordCount(), nRecords, "Unexpected read record count");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case checking that files which are not binary trace files
+ * are rejected.
+ */
+class BinaryTraceFileBadHeaderTestCase : public TestCase
+{
+  public:
+    BinaryTraceFileBadHeaderTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    std::string m_testFilename; //!< File name
+};
+
+BinaryTraceFileBadHeaderTestCase::BinaryTraceFileBadHeaderTestCase()
+    : TestCase("Check that BinaryTraceFile rejects invalid files")
+{
+}
+
+void
+BinaryTraceFileBadHeaderTestCase::DoSetup()
+{
+    std::stringstream filename;
+    uint32_t n = rand();
+    filename << n;
+    m_testFilename = CreateTempDirFilename(filename.str() + ".bin");
+}
+
+void
+BinaryTraceFileBadHeaderTestCase::DoTeardown()
+{
+    if (remove(m_testFilename.c_str()))
+    {
+        NS_LOG_ERROR("Failed to delete file " << m_testFilename);
+    }
+}
+
+void
+BinaryTraceFileBadHeaderTestCase::DoRun()
+{
+    std::ofstream out(m_testFilename, std::ios::binary);
+    out << "this is not a binary trace file";
+    out.close();
+
+    auto reader = Create<BinaryTraceFile>(m_testFilename, std::ios::in);
+    NS_TEST_ASSERT_MSG_EQ(reader->Fail(), true, "Invalid file must be rejected");
+    BinaryTraceFile::Record record;
+    NS_TEST_ASSERT_MSG_EQ(reader->Read(record), false, "Invalid file must not have records");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case checking that a block whose record count does not fit
+ * in the file is rejected without being allocated.
+ */
+class BinaryTraceFileCorruptBlockTestCase : public TestCase
+{
+  public:
+    BinaryTraceFileCorruptBlockTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    std::string m_testFilename; //!< File name
+};
+
+BinaryTraceFileCorruptBlockTestCase::BinaryTraceFileCorruptBlockTestCase()
+    : TestCase("Check that BinaryTraceFile rejects corrupt blocks")
+{
+}
+
+void
+BinaryTraceFileCorruptBlockTestCase::DoSetup()
+{
+    std::stringstream filename;
+    uint32_t n = rand();
+    filename << n;
+    m_testFilename = CreateTempDirFilename(filename.str() + ".bin");
+}
+
+void
+BinaryTraceFileCorruptBlockTestCase::DoTeardown()
+{
+    if (remove(m_testFilename.c_str()))
+    {
+        NS_LOG_ERROR("Failed to delete file " << m_testFilename);
+    }
+}
+
+void
+BinaryTraceFileCorruptBlockTestCase::DoRun()
+{
+    auto writer = Create<BinaryTraceFile>(m_testFilename, std::ios::out, 4);
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        writer->Write(MicroSeconds(i), 0, 0, BinaryTraceFile::ENQUEUE, Create<Packet>(100));
+    }
+    writer->Close();
+
+    // overwrite the record count of the second block, after the 16 bytes of
+    // file header and the first block of 4 records of 37 bytes
+    const uint32_t huge = 0xffffffff;
+    std::fstream file(m_testFilename, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(16 + 4 + 4 * 37);
+    file.write(reinterpret_cast<const char*>(&huge), sizeof(huge));
+    file.close();
+
+    auto reader = Create<BinaryTraceFile>(m_testFilename, std::ios::in);
+    NS_TEST_ASSERT_MSG_EQ(reader->Fail(), false, "The header must still be valid");
+    BinaryTraceFile::Record record;
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(reader->Read(record), true, "Missing record " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(reader->Read(record), false, "The corrupt block must be rejected");
+    NS_TEST_EXPECT_MSG_EQ(reader->Fail(), true, "The corrupt block must be reported");
+
+    // a block count within the block size, but beyond the end of the file
+    const uint32_t four = 4;
+    file.open(m_testFilename, std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(16 + 4 + 4 * 37);
+    file.write(reinterpret_cast<const char*>(&four), sizeof(four));
+    file.close();
+
+    reader = Create<BinaryTraceFile>(m_testFilename, std::ios::in);
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(reader->Read(record), true, "Missing record " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(reader->Read(record), false, "The truncated block must be rejected");
+    NS_TEST_EXPECT_MSG_EQ(reader->Fail(), true, "The truncated block must be reported");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case checking that a file truncated partway through a block
+ * is reported as failed, unlike a file read up to its end.
+ */
+class BinaryTraceFileTruncatedTestCase : public TestCase
+{
+  public:
+    BinaryTraceFileTruncatedTestCase();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    std::string m_testFilename; //!< File name
+};
+
+BinaryTraceFileTruncatedTestCase::BinaryTraceFileTruncatedTestCase()
+    : TestCase("Check that BinaryTraceFile reports truncated files")
+{
+}
+
+void
+BinaryTraceFileTruncatedTestCase::DoSetup()
+{
+    std::stringstream filename;
+    uint32_t n = rand();
+    filename << n;
+    m_testFilename = CreateTempDirFilename(filename.str() + ".bin");
+}
+
+void
+BinaryTraceFileTruncatedTestCase::DoTeardown()
+{
+    if (remove(m_testFilename.c_str()))
+    {
+        NS_LOG_ERROR("Failed to delete file " << m_testFilename);
+    }
+}
+
+void
+BinaryTraceFileTruncatedTestCase::DoRun()
+{
+    auto writer = Create<BinaryTraceFile>(m_testFilename, std::ios::out, 4);
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        writer->Write(MicroSeconds(i), 0, 0, BinaryTraceFile::ENQUEUE, Create<Packet>(100));
+    }
+    writer->Close();
+
+    // truncate the file in the columns, then in the record count, of the
+    // second block, after the 16 bytes of file header and the first block of
+    // 4 records of 37 bytes
+    const std::uintmax_t secondBlock = 16 + 4 + 4 * 37;
+    for (std::uintmax_t size : {secondBlock + 4 + 50, secondBlock + 2})
+    {
+        std::filesystem::resize_file(m_testFilename, size);
+        auto reader = Create<BinaryTraceFile>(m_testFilename, std::ios::in);
+        NS_TEST_ASSERT_MSG_EQ(reader->Fail(), false, "The header must still be valid");
+        BinaryTraceFile::Record record;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            NS_TEST_ASSERT_MSG_EQ(reader->Read(record), true, "Missing record " << i);
+        }
+        NS_TEST_EXPECT_MSG_EQ(reader->Fail(), false, "The first block must be valid");
+        NS_TEST_EXPECT_MSG_EQ(reader->Read(record), false, "The truncated block must be rejected");
+        NS_TEST_EXPECT_MSG_EQ(reader->Fail(),
+                              true,
+                              "The file truncated at " << size << " bytes must be reported");
+    }
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Binary trace file TestSuite
+ */
+class BinaryTraceFileTestSuite : public TestSuite
+{
+  public:
+    BinaryTraceFileTestSuite();
+};
+
+BinaryTraceFileTestSuite::BinaryTraceFileTestSuite()
+    : TestSuite("binary-trace-file", Type::UNIT)
+{
+    AddTestCase(new BinaryTraceFileReadWriteTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BinaryTraceFileBadHeaderTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BinaryTraceFileCorruptBlockTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BinaryTraceFileTruncatedTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static BinaryTraceFileTestSuite g_binaryTraceFileTestSuite;
@@ -8,6 +8,7 @@
 
 #include "ns3/buffer.h"
 #include "ns3/double.h"
+#include "ns3/ip-checksum.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
@@ -384,6 +385,90 @@ BufferTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Buffer checksum unit tests.
+ */
+class BufferChecksumTest : public TestCase
+{
+  public:
+    void DoRun() override;
+    BufferChecksumTest();
+};
+
+BufferChecksumTest::BufferChecksumTest()
+    : TestCase("Buffer checksum")
+{
+}
+
+void
+BufferChecksumTest::DoRun()
+{
+    // A buffer with data around its zero area
+    Buffer buffer(301);
+    buffer.AddAtStart(67);
+    buffer.AddAtEnd(93);
+    Buffer::Iterator i = buffer.Begin();
+    for (uint32_t j = 0; j < 67; j++)
+    {
+        i.WriteU8(j * 37 + 11);
+    }
+    i.Next(301);
+    for (uint32_t j = 0; j < 93; j++)
+    {
+        i.WriteU8(j * 53 + 250);
+    }
+
+    // Spans starting and ending at odd and even offsets, before, within and
+    // after the zero area, are checked against a byte-wise sum
+    for (uint32_t start : {0, 1, 2, 66, 67, 100, 367, 368, 400})
+    {
+        for (uint32_t size : {0, 1, 2, 3, 40, 65, 300, 301, 302, 393})
+        {
+            if (start + size > buffer.GetSize())
+            {
+                continue;
+            }
+            uint32_t sum = 0xabcd;
+            i = buffer.Begin();
+            i.Next(start);
+            for (uint32_t j = 0; j < size / 2; j++)
+            {
+                sum += i.ReadU16();
+            }
+            if (size & 1)
+            {
+                sum += i.ReadU8();
+            }
+            uint16_t expected = ~IpChecksumFold(sum);
+
+            i = buffer.Begin();
+            i.Next(start);
+            NS_TEST_EXPECT_MSG_EQ(i.CalculateIpChecksum(size, 0xabcd),
+                                  expected,
+                                  "Bad checksum of " << size << " bytes at " << start);
+            NS_TEST_EXPECT_MSG_EQ(i.GetRemainingSize(),
+                                  buffer.GetSize() - start - size,
+                                  "Iterator not advanced");
+        }
+    }
+
+    // An incrementally updated checksum matches the checksum of the new data
+    i = buffer.Begin();
+    uint16_t checksum = i.CalculateIpChecksum(67);
+    i = buffer.Begin();
+    i.Next(10);
+    uint16_t oldWord = i.ReadU16();
+    i.Prev(2);
+    i.WriteU16(0x1234);
+    i = buffer.Begin();
+    NS_TEST_EXPECT_MSG_EQ(IpChecksumUpdate(checksum, oldWord, 0x1234),
+                          i.CalculateIpChecksum(67),
+                          "Bad incremental checksum update");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -400,6 +485,7 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", Type::UNIT)
 {
     AddTestCase(new BufferTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferChecksumTest, TestCase::Duration::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
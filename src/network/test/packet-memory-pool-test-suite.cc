@@ -0,0 +1,89 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/packet-memory-pool.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+
+#include <thread>
+
+using namespace ns3;
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case checking the size classes of PacketMemoryPool and the
+ * recycling of its blocks.
+ */
+class PacketMemoryPoolTestCase : public TestCase
+{
+  public:
+    PacketMemoryPoolTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PacketMemoryPoolTestCase::PacketMemoryPoolTestCase()
+    : TestCase("Check the size classes and the recycling of PacketMemoryPool blocks")
+{
+}
+
+void
+PacketMemoryPoolTestCase::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::GetBlockSize(1),
+                          PacketMemoryPool::MIN_BLOCK_SIZE,
+                          "Unexpected block size");
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::GetBlockSize(100), 128, "Unexpected block size");
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::GetBlockSize(128), 128, "Unexpected block size");
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::GetBlockSize(PacketMemoryPool::MAX_BLOCK_SIZE + 1),
+                          PacketMemoryPool::MAX_BLOCK_SIZE + 1,
+                          "Large blocks must not be rounded");
+
+    // A released block is reused for the next request of the same size class
+    void* block = PacketMemoryPool::Allocate(100);
+    PacketMemoryPool::Deallocate(block, 100);
+    NS_TEST_EXPECT_MSG_EQ(PacketMemoryPool::Allocate(120), block, "Block not recycled");
+    PacketMemoryPool::Deallocate(block, 120);
+
+    // Blocks may be released by another thread than the one which allocated them
+    block = PacketMemoryPool::Allocate(1000);
+    std::thread thread([block]() { PacketMemoryPool::Deallocate(block, 1000); });
+    thread.join();
+
+    // The packets released to the pool are still usable once recycled
+    uint8_t data[] = {1, 2, 3, 4};
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        Ptr<Packet> p = Create<Packet>(data, sizeof(data));
+        p->AddPaddingAtEnd(1500);
+        uint8_t out[sizeof(data)];
+        p->CopyData(out, sizeof(out));
+        NS_TEST_EXPECT_MSG_EQ(p->GetSize(), 1504, "Unexpected packet size");
+        NS_TEST_EXPECT_MSG_EQ(uint32_t(out[3]), 4, "Unexpected packet content");
+    }
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Packet memory pool TestSuite
+ */
+class PacketMemoryPoolTestSuite : public TestSuite
+{
+  public:
+    PacketMemoryPoolTestSuite();
+};
+
+PacketMemoryPoolTestSuite::PacketMemoryPoolTestSuite()
+    : TestSuite("packet-memory-pool", Type::UNIT)
+{
+    AddTestCase(new PacketMemoryPoolTestCase, TestCase::Duration::QUICK);
+}
+
+/// Static variable for test initialization
+static PacketMemoryPoolTestSuite g_packetMemoryPoolTestSuite;
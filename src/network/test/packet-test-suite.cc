@@ -5,6 +5,7 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/object-accounting.h"
 #include "ns3/packet-tag-list.h"
 #include "ns3/packet.h"
 #include "ns3/test.h"
@@ -15,6 +16,7 @@
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -1257,6 +1259,69 @@ PacketTagListTest::DoRun()
     }
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Packet accounting unit tests.
+ */
+class PacketAccountingTest : public TestCase
+{
+  public:
+    PacketAccountingTest();
+
+  private:
+    void DoRun() override;
+};
+
+PacketAccountingTest::PacketAccountingTest()
+    : TestCase("Check the accounting of the live packets and buffers")
+{
+}
+
+void
+PacketAccountingTest::DoRun()
+{
+    bool wasEnabled = ObjectAccounting::IsEnabled();
+    ObjectAccounting::Enable();
+    ObjectAccounting::Counter* packets = ObjectAccounting::LookupCounter("ns3::Packet");
+    ObjectAccounting::Counter* buffers = ObjectAccounting::LookupCounter("ns3::Buffer::Data");
+    ObjectAccounting::Counter packetsBefore = *packets;
+    ObjectAccounting::Counter buffersBefore = *buffers;
+
+    // The copy of a packet shares the buffer of the packet, and the payload
+    // of a packet created from its size is not stored in its buffer
+    std::vector<uint8_t> payload(2000);
+    Ptr<Packet> p1 = Create<Packet>(100);
+    Ptr<Packet> p2 = p1->Copy();
+    Ptr<Packet> p3 = Create<Packet>(payload.data(), payload.size());
+
+    NS_TEST_EXPECT_MSG_EQ(packets->live - packetsBefore.live, 3, "Wrong number of live packets");
+    NS_TEST_EXPECT_MSG_EQ(packets->created - packetsBefore.created,
+                          3,
+                          "Wrong number of created packets");
+    NS_TEST_EXPECT_MSG_EQ(packets->bytes - packetsBefore.bytes,
+                          3 * sizeof(Packet),
+                          "Wrong size of the live packets");
+    NS_TEST_EXPECT_MSG_EQ(buffers->live - buffersBefore.live, 2, "Wrong number of live buffers");
+    NS_TEST_EXPECT_MSG_GT(buffers->bytes - buffersBefore.bytes,
+                          2000,
+                          "Wrong size of the live buffers");
+
+    p1 = nullptr;
+    p2 = nullptr;
+    p3 = nullptr;
+    NS_TEST_EXPECT_MSG_EQ(packets->live, packetsBefore.live, "Packets not uncounted");
+    NS_TEST_EXPECT_MSG_EQ(packets->bytes, packetsBefore.bytes, "Packets not uncounted");
+    NS_TEST_EXPECT_MSG_EQ(buffers->live, buffersBefore.live, "Buffers not uncounted");
+    NS_TEST_EXPECT_MSG_EQ(buffers->bytes, buffersBefore.bytes, "Buffers not uncounted");
+
+    if (!wasEnabled)
+    {
+        ObjectAccounting::Disable();
+    }
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1274,6 +1339,7 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketAccountingTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
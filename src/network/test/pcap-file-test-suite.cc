@@ -5,6 +5,7 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/packet.h"
 #include "ns3/pcap-file.h"
 #include "ns3/test.h"
 
@@ -1364,6 +1365,139 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that buffered and asynchronous writes
+ * produce the same file as direct writes, and that pcapng files have the
+ * expected layout.
+ */
+class BufferedWriteTestCase : public TestCase
+{
+  public:
+    BufferedWriteTestCase();
+    ~BufferedWriteTestCase() override;
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Write the same packets to a file.
+     * @param filename the file name
+     * @param bufferSize the write buffer size
+     * @param async whether to write from the background thread
+     */
+    void WritePackets(std::string filename, uint32_t bufferSize, bool async);
+
+    std::string m_testFilename;  //!< File name of the direct writes
+    std::string m_testFilename2; //!< File name of the buffered writes
+    std::string m_testFilename3; //!< File name of the pcapng file
+};
+
+BufferedWriteTestCase::BufferedWriteTestCase()
+    : TestCase("Check to see that PcapFile buffered and pcapng writes work")
+{
+}
+
+BufferedWriteTestCase::~BufferedWriteTestCase()
+{
+}
+
+void
+BufferedWriteTestCase::DoSetup()
+{
+    std::stringstream filename;
+    uint32_t n = rand();
+    filename << n;
+    m_testFilename = CreateTempDirFilename(filename.str() + ".pcap");
+    m_testFilename2 = CreateTempDirFilename(filename.str() + "-buffered.pcap");
+    m_testFilename3 = CreateTempDirFilename(filename.str() + ".pcapng");
+}
+
+void
+BufferedWriteTestCase::DoTeardown()
+{
+    for (const auto& name : {m_testFilename, m_testFilename2, m_testFilename3})
+    {
+        if (remove(name.c_str()))
+        {
+            NS_LOG_ERROR("Failed to delete file " << name);
+        }
+    }
+}
+
+void
+BufferedWriteTestCase::WritePackets(std::string filename, uint32_t bufferSize, bool async)
+{
+    PcapFile f;
+    f.Open(filename, std::ios::out);
+    f.Init(1, 100);
+    f.SetWriteBuffer(bufferSize, async);
+    uint8_t data[150];
+    for (uint32_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = i;
+    }
+    for (uint32_t i = 0; i < 50; ++i)
+    {
+        // Packets longer than the snap length are truncated
+        f.Write(i, 0, Create<Packet>(data, 50 + 2 * i));
+        f.Write(i, 1, data, i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Write returns error");
+    f.Close();
+}
+
+void
+BufferedWriteTestCase::DoRun()
+{
+    WritePackets(m_testFilename, 0, false);
+    WritePackets(m_testFilename2, 256, true);
+
+    uint32_t sec = 0;
+    uint32_t usec = 0;
+    uint32_t packets = 0;
+    bool diff = PcapFile::Diff(m_testFilename, m_testFilename2, sec, usec, packets);
+    NS_TEST_EXPECT_MSG_EQ(diff, false, "Buffered writes differ from direct writes");
+    NS_TEST_EXPECT_MSG_EQ(packets, 100, "Unexpected number of packets");
+
+    PcapFile f;
+    f.Open(m_testFilename3, std::ios::out);
+    f.Init(1, 100, PcapFile::ZONE_DEFAULT, false, true, true);
+    uint8_t buffer[5] = {1, 2, 3, 4, 5};
+    f.Write(1, 2, buffer, 5);
+    f.Write(3, 4, buffer, 5);
+    NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Write returns error");
+    f.Close();
+
+    //
+    // Section header block (28 bytes), interface description block with
+    // a timestamp resolution option (32 bytes), and two enhanced packet
+    // blocks of 5 bytes of data padded to 8 (40 bytes each).
+    //
+    NS_TEST_ASSERT_MSG_EQ(CheckFileLength(m_testFilename3, 140),
+                          true,
+                          "Unexpected pcapng file length");
+    FILE* p = std::fopen(m_testFilename3.c_str(), "rb");
+    NS_TEST_ASSERT_MSG_NE(p, nullptr, "Unable to open pcapng file");
+    uint32_t blockType = 0;
+    size_t result = std::fread(&blockType, sizeof(blockType), 1, p);
+    NS_TEST_EXPECT_MSG_EQ(result, 1, "Unable to read section header block type");
+    NS_TEST_EXPECT_MSG_EQ(blockType, 0x0a0d0d0a, "Unexpected section header block type");
+    std::fseek(p, 60, SEEK_SET);
+    uint32_t epb[7];
+    result = std::fread(epb, sizeof(epb), 1, p);
+    NS_TEST_EXPECT_MSG_EQ(result, 1, "Unable to read enhanced packet block");
+    NS_TEST_EXPECT_MSG_EQ(epb[0], 6, "Unexpected enhanced packet block type");
+    NS_TEST_EXPECT_MSG_EQ(epb[1], 40, "Unexpected enhanced packet block length");
+    NS_TEST_EXPECT_MSG_EQ(epb[4], 1000000002, "Unexpected nanosecond timestamp");
+    NS_TEST_EXPECT_MSG_EQ(epb[5], 5, "Unexpected captured length");
+    std::fclose(p);
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1387,6 +1521,7 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new BufferedWriteTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,334 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "binary-trace-file.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include <cstring>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceFile");
+
+namespace
+{
+
+const char MAGIC[4] = {'n', 's', '3', 'b'}; //!< Magic string starting a binary trace file
+const uint32_t BYTE_ORDER_MARK = 0x1a2b3c4d;  //!< Byte order check
+/// Size of a record in a block, summed over the columns
+const uint32_t RECORD_SIZE = sizeof(int64_t) + 3 * sizeof(uint32_t) + 2 * sizeof(uint64_t) + 1;
+
+/**
+ * Write a column of the current block.
+ * @param file the file to write to
+ * @param column the column
+ */
+template <typename T>
+void
+WriteColumn(std::fstream& file, const std::vector<T>& column)
+{
+    file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(T));
+}
+
+/**
+ * Read a column of the current block.
+ * @param file the file to read from
+ * @param column the column, already resized to the number of records
+ */
+template <typename T>
+void
+ReadColumn(std::fstream& file, std::vector<T>& column)
+{
+    file.read(reinterpret_cast<char*>(column.data()), column.size() * sizeof(T));
+}
+
+} // namespace
+
+BinaryTraceFile::BinaryTraceFile(const std::string& filename,
+                                 std::ios::openmode mode,
+                                 uint32_t blockSize)
+    : m_writing((mode & std::ios::out) != 0),
+      m_fail(false),
+      m_eof(false),
+      m_blockSize(blockSize),
+      m_count(0),
+      m_readIndex(0)
+{
+    NS_LOG_FUNCTION(this << filename << mode << blockSize);
+    NS_ASSERT_MSG(blockSize > 0, "Block size must be strictly positive");
+
+    m_file.open(filename, mode | std::ios::binary);
+    if (m_file.fail())
+    {
+        NS_LOG_ERROR("Unable to open " << filename);
+        return;
+    }
+
+    if (m_writing)
+    {
+        m_time.reserve(m_blockSize);
+        m_node.reserve(m_blockSize);
+        m_device.reserve(m_blockSize);
+        m_uid.reserve(m_blockSize);
+        m_size.reserve(m_blockSize);
+        m_field.reserve(m_blockSize);
+        m_event.reserve(m_blockSize);
+        WriteFileHeader();
+    }
+    else
+    {
+        ReadFileHeader();
+    }
+}
+
+BinaryTraceFile::~BinaryTraceFile()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+bool
+BinaryTraceFile::Fail() const
+{
+    // reaching the end of the file at a block boundary is not a failure
+    return m_fail || (m_file.fail() && !m_eof);
+}
+
+void
+BinaryTraceFile::SetFieldCallback(FieldCallback cb)
+{
+    NS_LOG_FUNCTION(this);
+    m_fieldCallback = cb;
+}
+
+void
+BinaryTraceFile::WriteFileHeader()
+{
+    NS_LOG_FUNCTION(this);
+
+    uint16_t version = VERSION;
+    uint16_t reserved = 0;
+    m_file.write(MAGIC, sizeof(MAGIC));
+    m_file.write(reinterpret_cast<const char*>(&BYTE_ORDER_MARK), sizeof(BYTE_ORDER_MARK));
+    m_file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    m_file.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+    m_file.write(reinterpret_cast<const char*>(&m_blockSize), sizeof(m_blockSize));
+}
+
+void
+BinaryTraceFile::ReadFileHeader()
+{
+    NS_LOG_FUNCTION(this);
+
+    char magic[sizeof(MAGIC)];
+    uint32_t byteOrderMark;
+    uint16_t version;
+    uint16_t reserved;
+    m_file.read(magic, sizeof(magic));
+    m_file.read(reinterpret_cast<char*>(&byteOrderMark), sizeof(byteOrderMark));
+    m_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    m_file.read(reinterpret_cast<char*>(&reserved), sizeof(reserved));
+    m_file.read(reinterpret_cast<char*>(&m_blockSize), sizeof(m_blockSize));
+    if (m_file.fail())
+    {
+        NS_LOG_ERROR("Truncated binary trace file header");
+        m_fail = true;
+        return;
+    }
+    if (std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+    {
+        NS_LOG_ERROR("Not a binary trace file");
+        m_fail = true;
+        return;
+    }
+    if (byteOrderMark != BYTE_ORDER_MARK)
+    {
+        NS_LOG_ERROR("Binary trace file was written on a host of different byte order");
+        m_fail = true;
+        return;
+    }
+    if (version != VERSION)
+    {
+        NS_LOG_ERROR("Unsupported binary trace file version " << version);
+        m_fail = true;
+    }
+}
+
+void
+BinaryTraceFile::Write(Time t, uint32_t node, uint32_t device, EventType event, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << t << node << device << event << p);
+
+    Record record;
+    record.time = t.GetNanoSeconds();
+    record.node = node;
+    record.device = device;
+    record.event = event;
+    record.uid = p->GetUid();
+    record.size = p->GetSize();
+    record.field = m_fieldCallback.IsNull() ? 0 : m_fieldCallback(p);
+    Write(record);
+}
+
+void
+BinaryTraceFile::Write(const Record& record)
+{
+    NS_LOG_FUNCTION(this << record.time << record.node << record.device << record.uid);
+    NS_ASSERT_MSG(m_writing, "Binary trace file not opened for writing");
+
+    m_time.push_back(record.time);
+    m_node.push_back(record.node);
+    m_device.push_back(record.device);
+    m_uid.push_back(record.uid);
+    m_size.push_back(record.size);
+    m_field.push_back(record.field);
+    m_event.push_back(record.event);
+    m_count++;
+
+    if (m_time.size() == m_blockSize)
+    {
+        Flush();
+    }
+}
+
+void
+BinaryTraceFile::Flush()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_writing || m_time.empty() || !m_file.is_open())
+    {
+        return;
+    }
+
+    auto n = static_cast<uint32_t>(m_time.size());
+    m_file.write(reinterpret_cast<const char*>(&n), sizeof(n));
+    WriteColumn(m_file, m_time);
+    WriteColumn(m_file, m_node);
+    WriteColumn(m_file, m_device);
+    WriteColumn(m_file, m_uid);
+    WriteColumn(m_file, m_size);
+    WriteColumn(m_file, m_field);
+    WriteColumn(m_file, m_event);
+    NS_LOG_LOGIC("Wrote block of " << n << " records");
+
+    m_time.clear();
+    m_node.clear();
+    m_device.clear();
+    m_uid.clear();
+    m_size.clear();
+    m_field.clear();
+    m_event.clear();
+}
+
+bool
+BinaryTraceFile::ReadBlock()
+{
+    NS_LOG_FUNCTION(this);
+
+    uint32_t n;
+    m_file.read(reinterpret_cast<char*>(&n), sizeof(n));
+    if (m_file.fail())
+    {
+        if (m_file.eof() && m_file.gcount() == 0)
+        {
+            m_eof = true;
+        }
+        else
+        {
+            NS_LOG_ERROR("Truncated binary trace file block count");
+            m_fail = true;
+        }
+        return false;
+    }
+    // check the count before allocating the block, the file may be corrupt
+    std::streampos start = m_file.tellg();
+    m_file.seekg(0, std::ios::end);
+    std::streamoff remaining = m_file.tellg() - start;
+    m_file.seekg(start);
+    if (n > m_blockSize ||
+        static_cast<uint64_t>(n) * RECORD_SIZE > static_cast<uint64_t>(remaining))
+    {
+        NS_LOG_ERROR("Corrupt binary trace file block of " << n << " records");
+        m_fail = true;
+        return false;
+    }
+    m_time.resize(n);
+    m_node.resize(n);
+    m_device.resize(n);
+    m_uid.resize(n);
+    m_size.resize(n);
+    m_field.resize(n);
+    m_event.resize(n);
+    ReadColumn(m_file, m_time);
+    ReadColumn(m_file, m_node);
+    ReadColumn(m_file, m_device);
+    ReadColumn(m_file, m_uid);
+    ReadColumn(m_file, m_size);
+    ReadColumn(m_file, m_field);
+    ReadColumn(m_file, m_event);
+    if (m_file.fail())
+    {
+        NS_LOG_ERROR("Truncated binary trace file block");
+        m_fail = true;
+        return false;
+    }
+    m_readIndex = 0;
+    return true;
+}
+
+bool
+BinaryTraceFile::Read(Record& record)
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT_MSG(!m_writing, "Binary trace file not opened for reading");
+
+    if (m_fail)
+    {
+        return false;
+    }
+    while (m_readIndex == m_time.size())
+    {
+        if (!ReadBlock())
+        {
+            return false;
+        }
+    }
+
+    record.time = m_time[m_readIndex];
+    record.node = m_node[m_readIndex];
+    record.device = m_device[m_readIndex];
+    record.event = static_cast<EventType>(m_event[m_readIndex]);
+    record.uid = m_uid[m_readIndex];
+    record.size = m_size[m_readIndex];
+    record.field = m_field[m_readIndex];
+    m_readIndex++;
+    m_count++;
+    return true;
+}
+
+void
+BinaryTraceFile::Close()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_file.is_open())
+    {
+        return;
+    }
+    Flush();
+    m_file.close();
+}
+
+uint64_t
+BinaryTraceFile::GetRecordCount() const
+{
+    return m_count;
+}
+
+} // namespace ns3
@@ -0,0 +1,187 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef BINARY_TRACE_FILE_H
+#define BINARY_TRACE_FILE_H
+
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <fstream>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+class Packet;
+
+/**
+ * @brief A compact binary file of packet trace events.
+ *
+ * Each record holds the time of the event, the node and device on which
+ * it happened, the kind of event, the uid and size of the packet and one
+ * optional header field, selected by a user-provided callback.  This is
+ * the information an ASCII trace line usually gets reduced to when it is
+ * post-processed, at a cost of 37 bytes per event and no formatting.
+ *
+ * Records are buffered in memory and written in blocks, column by column,
+ * so that the file can be both written and loaded with a few large I/O
+ * operations.  The file is laid out as follows, using the byte order of
+ * the host which wrote it:
+ *
+ * @verbatim
+   file header:  char magic[4] = "ns3b", uint32_t byte order mark (0x1a2b3c4d),
+                 uint16_t version, uint16_t reserved, uint32_t block size
+   block:        uint32_t record count n,
+                 int64_t time[n] (nanoseconds), uint32_t node[n],
+                 uint32_t device[n], uint64_t uid[n], uint32_t size[n],
+                 uint64_t field[n], uint8_t event[n]
+   @endverbatim
+ *
+ * This class is reference counted so that it can be bound to trace sinks,
+ * in the same way as OutputStreamWrapper; the last block is written when
+ * the file is closed or the last reference to it is released.
+ */
+class BinaryTraceFile : public SimpleRefCount<BinaryTraceFile>
+{
+  public:
+    /**
+     * The kind of a traced event.  The values are the characters
+     * used for the same events in ASCII traces.
+     */
+    enum EventType : uint8_t
+    {
+        ENQUEUE = '+', //!< Packet enqueued in a device transmit queue
+        DEQUEUE = '-', //!< Packet dequeued from a device transmit queue
+        DROP = 'd',    //!< Packet dropped
+        RECEIVE = 'r'  //!< Packet received by a device
+    };
+
+    /** One traced event. */
+    struct Record
+    {
+        int64_t time;    //!< Time of the event, in nanoseconds
+        uint32_t node;   //!< Node id
+        uint32_t device; //!< Device index on the node
+        EventType event; //!< Kind of event
+        uint64_t uid;    //!< Packet uid
+        uint32_t size;   //!< Packet size, in bytes
+        uint64_t field;  //!< Header field selected by the field callback
+    };
+
+    /**
+     * Callback selecting the header field stored with each record.
+     * It is passed the traced packet and returns the value to store.
+     */
+    typedef Callback<uint64_t, Ptr<const Packet>> FieldCallback;
+
+    static const uint32_t BLOCK_SIZE_DEFAULT = 65536; //!< Default number of records per block
+    static const uint16_t VERSION = 1;                //!< Version of the file format
+
+    /**
+     * Create a new binary trace file or open an existing one.
+     *
+     * @param filename the name of the file
+     * @param mode std::ios::out to write a new file, std::ios::in to read
+     *             an existing one; std::ios::binary is always added
+     * @param blockSize the number of records buffered before a block is written
+     */
+    BinaryTraceFile(const std::string& filename,
+                    std::ios::openmode mode,
+                    uint32_t blockSize = BLOCK_SIZE_DEFAULT);
+    ~BinaryTraceFile();
+
+    /**
+     * @return true if the file could not be opened, if its header or a block
+     *         read is not valid, truncated included, or if an I/O operation
+     *         failed, false otherwise. Reading all the records up to the end of
+     *         a valid file is not a failure.
+     */
+    bool Fail() const;
+
+    /**
+     * Set the callback selecting the header field stored with each packet
+     * written by Write(Time, uint32_t, uint32_t, EventType, Ptr<const Packet>).
+     * Without a callback the field is zero.
+     *
+     * @param cb the callback
+     */
+    void SetFieldCallback(FieldCallback cb);
+
+    /**
+     * Add the event for a packet to the file.
+     *
+     * @param t the time of the event
+     * @param node the node id
+     * @param device the device index on the node
+     * @param event the kind of event
+     * @param p the packet
+     */
+    void Write(Time t, uint32_t node, uint32_t device, EventType event, Ptr<const Packet> p);
+
+    /**
+     * Add a record to the file.
+     *
+     * @param record the record
+     */
+    void Write(const Record& record);
+
+    /**
+     * Read the next record from a file opened for reading.
+     *
+     * @param [out] record the record read
+     * @return false if there are no more records or the file is truncated
+     */
+    bool Read(Record& record);
+
+    /**
+     * Write the records buffered so far as a block.
+     */
+    void Flush();
+
+    /**
+     * Flush the buffered records and close the underlying file.
+     */
+    void Close();
+
+    /**
+     * @return the number of records written to or read from the file so far
+     */
+    uint64_t GetRecordCount() const;
+
+  private:
+    /** Write the file header. */
+    void WriteFileHeader();
+    /** Read and check the file header. */
+    void ReadFileHeader();
+    /**
+     * Load the next block of a file opened for reading.
+     * @return false if there are no more blocks
+     */
+    bool ReadBlock();
+
+    std::fstream m_file;            //!< The underlying file
+    bool m_writing;                 //!< Whether the file is opened for writing
+    bool m_fail;                    //!< Whether the header or a block was not valid
+    bool m_eof;                     //!< Whether the end of the file was read after a block
+    uint32_t m_blockSize;           //!< Maximum number of records per block
+    FieldCallback m_fieldCallback;  //!< Header field selection
+    uint64_t m_count;               //!< Number of records written or read
+    std::size_t m_readIndex;        //!< Next record to read in the current block
+    std::vector<int64_t> m_time;    //!< Time column of the current block
+    std::vector<uint32_t> m_node;   //!< Node column of the current block
+    std::vector<uint32_t> m_device; //!< Device column of the current block
+    std::vector<uint64_t> m_uid;    //!< Uid column of the current block
+    std::vector<uint32_t> m_size;   //!< Size column of the current block
+    std::vector<uint64_t> m_field;  //!< Field column of the current block
+    std::vector<uint8_t> m_event;   //!< Event column of the current block
+};
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_FILE_H */
@@ -0,0 +1,158 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ip-checksum.h"
+
+#include <bit>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#define IP_CHECKSUM_X86_64
+#endif
+
+namespace ns3
+{
+
+namespace
+{
+
+/*
+ * Since 2^16 = 1 modulo 2^16 - 1, the one's complement sum of the 16 bit
+ * words of the data is the folded sum of its 32 bit words, which the
+ * functions below add in 64 bit accumulators so that no carry is lost.
+ */
+
+/**
+ * Add the 32 bit words of a block of memory, in native byte order.
+ *
+ * @param data the data to sum
+ * @param length the length of the data, in bytes
+ * @param sum the sum to add the words to
+ * @returns the updated sum
+ */
+uint64_t
+SumScalar(const uint8_t* data, std::size_t length, uint64_t sum)
+{
+    for (; length >= 4; data += 4, length -= 4)
+    {
+        uint32_t word;
+        std::memcpy(&word, data, 4);
+        sum += word;
+    }
+    if (length > 0)
+    {
+        uint32_t word = 0;
+        std::memcpy(&word, data, length);
+        sum += word;
+    }
+    return sum;
+}
+
+#ifdef IP_CHECKSUM_X86_64
+
+/**
+ * Add the 32 bit words of a block of memory with SSE2 instructions.
+ *
+ * @param data the data to sum
+ * @param length the length of the data, in bytes
+ * @returns the sum of the words
+ */
+uint64_t
+SumSse2(const uint8_t* data, std::size_t length)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i acc = zero;
+    for (; length >= 16; data += 16, length -= 16)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        acc = _mm_add_epi64(acc, _mm_unpacklo_epi32(v, zero));
+        acc = _mm_add_epi64(acc, _mm_unpackhi_epi32(v, zero));
+    }
+    uint64_t lanes[2];
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return SumScalar(data, length, lanes[0] + lanes[1]);
+}
+
+/**
+ * Add the 32 bit words of a block of memory with AVX2 instructions.
+ *
+ * @param data the data to sum
+ * @param length the length of the data, in bytes
+ * @returns the sum of the words
+ */
+__attribute__((target("avx2"))) uint64_t
+SumAvx2(const uint8_t* data, std::size_t length)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i acc = zero;
+    for (; length >= 32; data += 32, length -= 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+        acc = _mm256_add_epi64(acc, _mm256_unpacklo_epi32(v, zero));
+        acc = _mm256_add_epi64(acc, _mm256_unpackhi_epi32(v, zero));
+    }
+    uint64_t lanes[4];
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return SumScalar(data, length, lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+}
+
+#endif /* IP_CHECKSUM_X86_64 */
+
+/**
+ * Add the 32 bit words of a block of memory, in native byte order, with the
+ * fastest implementation supported by the processor.
+ *
+ * @param data the data to sum
+ * @param length the length of the data, in bytes
+ * @returns the sum of the words
+ */
+uint64_t
+Sum(const uint8_t* data, std::size_t length)
+{
+#ifdef IP_CHECKSUM_X86_64
+    static const bool hasAvx2 = __builtin_cpu_supports("avx2");
+    if (length >= 64)
+    {
+        return hasAvx2 ? SumAvx2(data, length) : SumSse2(data, length);
+    }
+#endif
+    return SumScalar(data, length, 0);
+}
+
+} // namespace
+
+uint16_t
+IpChecksumPartial(const uint8_t* data, std::size_t length)
+{
+    uint16_t sum = IpChecksumFold(Sum(data, length));
+    if constexpr (std::endian::native == std::endian::big)
+    {
+        // Buffer::Iterator::ReadU16 reads words in little endian byte order
+        sum = (sum >> 8) | (sum << 8);
+    }
+    return sum;
+}
+
+uint16_t
+IpChecksumFold(uint64_t sum)
+{
+    while (sum >> 16)
+    {
+        sum = (sum & 0xffff) + (sum >> 16);
+    }
+    return sum;
+}
+
+uint16_t
+IpChecksumUpdate(uint16_t checksum, uint16_t oldWord, uint16_t newWord)
+{
+    // RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m')
+    uint32_t sum = static_cast<uint16_t>(~checksum);
+    sum += static_cast<uint16_t>(~oldWord);
+    sum += newWord;
+    return ~IpChecksumFold(sum);
+}
+
+} // namespace ns3
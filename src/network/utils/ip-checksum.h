@@ -0,0 +1,55 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef IP_CHECKSUM_H
+#define IP_CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ns3
+{
+
+/**
+ * @ingroup packet
+ *
+ * Calculate the 16 bit one's complement sum (see RFC 1071) of a contiguous
+ * block of memory.
+ *
+ * The data is summed as a sequence of 16 bit words in the byte order used by
+ * Buffer::Iterator::ReadU16, an odd trailing byte being padded with zero.
+ * The sum is computed with SSE2 or AVX2 instructions when available.
+ *
+ * @param data the data to sum
+ * @param length the length of the data, in bytes
+ * @returns the one's complement sum of the data, not complemented
+ */
+uint16_t IpChecksumPartial(const uint8_t* data, std::size_t length);
+
+/**
+ * @ingroup packet
+ *
+ * Fold a 64 bit sum of 16 bit words into their 16 bit one's complement sum.
+ *
+ * @param sum the sum to fold
+ * @returns the one's complement sum, not complemented
+ */
+uint16_t IpChecksumFold(uint64_t sum);
+
+/**
+ * @ingroup packet
+ *
+ * Update a checksum after a 16 bit word of the data it covers changed,
+ * without summing the data again (see RFC 1624).
+ *
+ * @param checksum the checksum of the data before the change
+ * @param oldWord the previous value of the word which changed
+ * @param newWord the new value of the word
+ * @returns the checksum of the data after the change
+ */
+uint16_t IpChecksumUpdate(uint16_t checksum, uint16_t oldWord, uint16_t newWord);
+
+} // namespace ns3
+
+#endif /* IP_CHECKSUM_H */
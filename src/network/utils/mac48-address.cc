@@ -13,6 +13,7 @@
 #include "ns3/simulator.h"
 
 #include <cstring>
+#include <functional>
 #include <iomanip>
 #include <iostream>
 
@@ -225,6 +226,14 @@ Mac48Address::GetMulticast(Ipv6Address addr)
     return etherAddr;
 }
 
+size_t
+Mac48AddressHash::operator()(const Mac48Address& x) const
+{
+    uint64_t address = 0;
+    std::memcpy(&address, x.m_address, 6);
+    return std::hash<uint64_t>()(address);
+}
+
 std::ostream&
 operator<<(std::ostream& os, const Mac48Address& address)
 {
@@ -201,12 +201,33 @@ class Mac48Address
      */
     friend std::istream& operator>>(std::istream& is, Mac48Address& address);
 
+    friend class Mac48AddressHash;
+
     static uint64_t m_allocationIndex; //!< Address allocation index
     uint8_t m_address[6]{0};           //!< Address value
 };
 
 ATTRIBUTE_HELPER_HEADER(Mac48Address);
 
+/**
+ * @ingroup address
+ *
+ * @brief Class providing an hash for MAC addresses
+ */
+class Mac48AddressHash
+{
+  public:
+    /**
+     * @brief Returns the hash of a MAC address.
+     * @param x the address
+     * @return the hash
+     *
+     * This method uses std::hash rather than class Hash
+     * as speed is more important than cryptographic robustness.
+     */
+    size_t operator()(const Mac48Address& x) const;
+};
+
 inline bool
 operator==(const Mac48Address& a, const Mac48Address& b)
 {
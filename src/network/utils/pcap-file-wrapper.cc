@@ -37,6 +37,25 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
+                          MakeBooleanChecker())
+            .AddAttribute("Pcapng",
+                          "Whether the file is written in the pcapng format instead of the "
+                          "classic pcap format.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_pcapng),
+                          MakeBooleanChecker())
+            .AddAttribute("WriteBufferSize",
+                          "Number of bytes of packet records buffered in memory before they "
+                          "are written to the file; 0 writes each packet immediately.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_writeBufferSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("AsyncWrite",
+                          "Whether the buffered packet records are written to the file by a "
+                          "background thread.  If WriteBufferSize is 0, buffers of "
+                          "PcapFile::WRITE_BUFFER_SIZE_DEFAULT bytes are used.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_asyncWrite),
                           MakeBooleanChecker());
     return tid;
 }
@@ -98,12 +117,26 @@ PcapFileWrapper::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrect
     NS_LOG_FUNCTION(this << dataLinkType << snapLen << tzCorrection);
     if (snapLen != std::numeric_limits<uint32_t>::max())
     {
-        m_file.Init(dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
+        m_file.Init(dataLinkType, snapLen, tzCorrection, false, m_nanosecMode, m_pcapng);
     }
     else
     {
-        m_file.Init(dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode);
+        m_file.Init(dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode, m_pcapng);
+    }
+
+    uint32_t bufferSize = m_writeBufferSize;
+    if (m_asyncWrite && bufferSize == 0)
+    {
+        bufferSize = PcapFile::WRITE_BUFFER_SIZE_DEFAULT;
     }
+    m_file.SetWriteBuffer(bufferSize, m_asyncWrite);
+}
+
+void
+PcapFileWrapper::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    m_file.Flush();
 }
 
 void
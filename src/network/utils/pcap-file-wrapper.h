@@ -132,6 +132,14 @@ class PcapFileWrapper : public Object
      */
     void Write(Time t, const uint8_t* buffer, uint32_t length);
 
+    /**
+     * @brief Write the packets buffered so far to the file.
+     *
+     * Packets are buffered when the WriteBufferSize or AsyncWrite attributes
+     * are set; they are otherwise written as soon as they are traced.
+     */
+    void Flush();
+
     /**
      * @brief Read the next packet from the file.
      *
@@ -211,9 +219,12 @@ class PcapFileWrapper : public Object
     uint32_t GetDataLinkType();
 
   private:
-    PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    PcapFile m_file;            //!< Pcap file
+    uint32_t m_snapLen;         //!< max length of saved packets
+    bool m_nanosecMode;         //!< Timestamps in nanosecond mode
+    bool m_pcapng;              //!< Write the pcapng format
+    uint32_t m_writeBufferSize; //!< Size of the buffer of records
+    bool m_asyncWrite;          //!< Write the buffers from a background thread
 };
 
 } // namespace ns3
@@ -17,8 +17,13 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <set>
+#include <thread>
 
 //
 // This file is used as part of the ns-3 test framework, so please refrain from
@@ -40,10 +45,220 @@ const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swappi
 const uint16_t VERSION_MAJOR = 2; /**< Major version of supported pcap file format */
 const uint16_t VERSION_MINOR = 4; /**< Minor version of supported pcap file format */
 
+const uint32_t PCAPNG_SHB_TYPE = 0x0a0d0d0a;   /**< pcapng Section Header Block type */
+const uint32_t PCAPNG_IDB_TYPE = 0x00000001;   /**< pcapng Interface Description Block type */
+const uint32_t PCAPNG_EPB_TYPE = 0x00000006;   /**< pcapng Enhanced Packet Block type */
+const uint32_t PCAPNG_BYTE_ORDER = 0x1a2b3c4d; /**< pcapng byte-order magic */
+const uint16_t PCAPNG_IF_TSRESOL = 9;          /**< pcapng timestamp resolution option code */
+const uint32_t PCAPNG_EPB_HEADER_SIZE = 28;    /**< pcapng Enhanced Packet Block header size */
+
+/**
+ * Background thread writing the buffers of the files with asynchronous
+ * writes enabled.  The thread runs while at least one such file is open,
+ * and is stopped at exit, after writing the buffers of the files still open.
+ */
+class PcapFile::Writer
+{
+  public:
+    /**
+     * Register a file with asynchronous writes, starting the thread if needed.
+     * @param file the file
+     */
+    static void Attach(PcapFile* file);
+    /**
+     * Unregister a file with asynchronous writes, stopping the thread if it was the last.
+     * @param file the file
+     */
+    static void Detach(PcapFile* file);
+    /**
+     * Queue the write buffer of a file and give it an empty buffer.
+     * @param file the file
+     */
+    static void Submit(PcapFile* file);
+    /**
+     * Wait until all the buffers queued for a file are written.
+     * @param file the file
+     */
+    static void Drain(const PcapFile* file);
+
+  private:
+    /** The thread body. */
+    static void Run();
+
+    /**
+     * Write the buffers of the files still open and stop the thread, at exit,
+     * before the thread is destroyed.  The buffers written afterwards, by the
+     * files closed during the static destruction, are written synchronously.
+     */
+    static void Exit();
+
+    /** A buffer to write to a file. */
+    struct Job
+    {
+        PcapFile* file;            //!< the file to write to
+        std::vector<uint8_t> data; //!< the records to write
+    };
+
+    static const uint32_t MAX_PENDING_BUFFERS = 4; //!< Buffers a file can queue before blocking
+
+    static std::mutex g_mutex;             //!< Protects the jobs and the file buffer lists
+    static std::condition_variable g_work; //!< Signals queued jobs to the thread
+    static std::condition_variable g_done; //!< Signals written buffers to the files
+    static std::deque<Job> g_jobs;         //!< Buffers waiting to be written
+    static std::thread g_thread;           //!< The writer thread
+    static std::set<PcapFile*> g_files;    //!< Files with asynchronous writes
+    static bool g_stop;                    //!< Asks the thread to stop once idle
+    static bool g_exited;                  //!< Whether the thread was stopped at exit
+};
+
+std::mutex PcapFile::Writer::g_mutex;
+std::condition_variable PcapFile::Writer::g_work;
+std::condition_variable PcapFile::Writer::g_done;
+std::deque<PcapFile::Writer::Job> PcapFile::Writer::g_jobs;
+std::thread PcapFile::Writer::g_thread;
+std::set<PcapFile*> PcapFile::Writer::g_files;
+bool PcapFile::Writer::g_stop = false;
+bool PcapFile::Writer::g_exited = false;
+
+void
+PcapFile::Writer::Attach(PcapFile* file)
+{
+    /**
+     * Stops the thread at exit: constructed after the thread object, it is
+     * destroyed before it, so that the thread is never destroyed while running.
+     */
+    static struct ExitGuard
+    {
+        ~ExitGuard()
+        {
+            Writer::Exit();
+        }
+    } exitGuard;
+
+    std::lock_guard lock(g_mutex);
+    g_files.insert(file);
+    if (g_files.size() == 1 && !g_exited)
+    {
+        g_stop = false;
+        g_thread = std::thread(&Writer::Run);
+    }
+}
+
+void
+PcapFile::Writer::Detach(PcapFile* file)
+{
+    {
+        std::lock_guard lock(g_mutex);
+        NS_ASSERT(g_files.count(file) == 1);
+        g_files.erase(file);
+        if (!g_files.empty() || g_exited)
+        {
+            return;
+        }
+        g_stop = true;
+    }
+    g_work.notify_all();
+    g_thread.join();
+}
+
+void
+PcapFile::Writer::Exit()
+{
+    std::vector<PcapFile*> files;
+    {
+        std::lock_guard lock(g_mutex);
+        files.assign(g_files.begin(), g_files.end());
+    }
+    for (auto file : files)
+    {
+        if (!file->m_buffer.empty())
+        {
+            Submit(file);
+        }
+    }
+    {
+        std::lock_guard lock(g_mutex);
+        g_exited = true;
+        g_stop = true;
+    }
+    g_work.notify_all();
+    if (g_thread.joinable())
+    {
+        g_thread.join();
+    }
+    for (auto file : files)
+    {
+        file->m_file.flush();
+    }
+}
+
+void
+PcapFile::Writer::Submit(PcapFile* file)
+{
+    std::unique_lock lock(g_mutex);
+    if (g_exited)
+    {
+        file->m_file.write((const char*)file->m_buffer.data(), file->m_buffer.size());
+        file->m_buffer.clear();
+        return;
+    }
+    g_done.wait(lock, [file] { return file->m_pendingBuffers < MAX_PENDING_BUFFERS; });
+    file->m_pendingBuffers++;
+    g_jobs.push_back({file, std::move(file->m_buffer)});
+    if (!file->m_freeBuffers.empty())
+    {
+        file->m_buffer = std::move(file->m_freeBuffers.back());
+        file->m_freeBuffers.pop_back();
+    }
+    else
+    {
+        file->m_buffer = std::vector<uint8_t>();
+    }
+    lock.unlock();
+    g_work.notify_one();
+}
+
+void
+PcapFile::Writer::Drain(const PcapFile* file)
+{
+    std::unique_lock lock(g_mutex);
+    g_done.wait(lock, [file] { return file->m_pendingBuffers == 0; });
+}
+
+void
+PcapFile::Writer::Run()
+{
+    std::unique_lock lock(g_mutex);
+    while (true)
+    {
+        g_work.wait(lock, [] { return g_stop || !g_jobs.empty(); });
+        if (g_jobs.empty())
+        {
+            return;
+        }
+        Job job = std::move(g_jobs.front());
+        g_jobs.pop_front();
+        lock.unlock();
+
+        job.file->m_file.write((const char*)job.data.data(), job.data.size());
+        job.data.clear();
+
+        lock.lock();
+        job.file->m_freeBuffers.push_back(std::move(job.data));
+        job.file->m_pendingBuffers--;
+        g_done.notify_all();
+    }
+}
+
 PcapFile::PcapFile()
     : m_file(),
       m_swapMode(false),
-      m_nanosecMode(false)
+      m_nanosecMode(false),
+      m_pcapng(false),
+      m_buffered(false),
+      m_async(false),
+      m_bufferSize(0),
+      m_pendingBuffers(0)
 {
     NS_LOG_FUNCTION(this);
     FatalImpl::RegisterStream(&m_file);
@@ -60,6 +275,10 @@ bool
 PcapFile::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_async)
+    {
+        Writer::Drain(this);
+    }
     return m_file.fail();
 }
 
@@ -67,6 +286,10 @@ bool
 PcapFile::Eof() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_async)
+    {
+        Writer::Drain(this);
+    }
     return m_file.eof();
 }
 
@@ -81,9 +304,53 @@ void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    Flush();
+    if (m_async)
+    {
+        Writer::Detach(this);
+        m_async = false;
+    }
     m_file.close();
 }
 
+void
+PcapFile::SetWriteBuffer(uint32_t bufferSize, bool async)
+{
+    NS_LOG_FUNCTION(this << bufferSize << async);
+    NS_ASSERT_MSG(!async || bufferSize > 0, "Asynchronous writes require a write buffer");
+
+    Flush();
+    if (async && !m_async)
+    {
+        Writer::Attach(this);
+    }
+    else if (!async && m_async)
+    {
+        Writer::Detach(this);
+    }
+    m_async = async;
+    m_bufferSize = bufferSize;
+    m_buffered = m_pcapng || m_bufferSize > 0;
+}
+
+void
+PcapFile::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_buffer.empty())
+    {
+        WriteBuffer();
+    }
+    if (m_async)
+    {
+        Writer::Drain(this);
+    }
+    if (m_file.is_open() && m_buffered)
+    {
+        m_file.flush();
+    }
+}
+
 uint32_t
 PcapFile::GetMagic()
 {
@@ -341,9 +608,22 @@ PcapFile::Init(uint32_t dataLinkType,
                uint32_t snapLen,
                int32_t timeZoneCorrection,
                bool swapMode,
-               bool nanosecMode)
+               bool nanosecMode,
+               bool pcapng)
 {
-    NS_LOG_FUNCTION(this << dataLinkType << snapLen << timeZoneCorrection << swapMode);
+    NS_LOG_FUNCTION(this << dataLinkType << snapLen << timeZoneCorrection << swapMode
+                         << nanosecMode << pcapng);
+
+    //
+    // Discard any record buffered for a previous initialization.
+    //
+    if (m_async)
+    {
+        Writer::Drain(this);
+    }
+    m_buffer.clear();
+    m_pcapng = pcapng;
+    m_buffered = m_pcapng || m_bufferSize > 0;
 
     //
     // Initialize the magic number and nanosecond mode flag
@@ -395,7 +675,143 @@ PcapFile::Init(uint32_t dataLinkType,
     //
     m_swapMode = swapMode || bigEndian;
 
-    WriteFileHeader();
+    if (m_pcapng)
+    {
+        WritePcapngHeader();
+    }
+    else
+    {
+        WriteFileHeader();
+    }
+}
+
+void
+PcapFile::WritePcapngHeader()
+{
+    NS_LOG_FUNCTION(this);
+    m_file.seekp(0, std::ios::beg);
+
+    //
+    // pcapng files are written in the byte order of the host, which readers
+    // detect from the byte-order magic of the section header block.
+    //
+    const uint32_t shbLength = 28;
+    uint16_t versionMajor = 1;
+    uint16_t versionMinor = 0;
+    int64_t sectionLength = -1;
+    m_file.write((const char*)&PCAPNG_SHB_TYPE, sizeof(PCAPNG_SHB_TYPE));
+    m_file.write((const char*)&shbLength, sizeof(shbLength));
+    m_file.write((const char*)&PCAPNG_BYTE_ORDER, sizeof(PCAPNG_BYTE_ORDER));
+    m_file.write((const char*)&versionMajor, sizeof(versionMajor));
+    m_file.write((const char*)&versionMinor, sizeof(versionMinor));
+    m_file.write((const char*)&sectionLength, sizeof(sectionLength));
+    m_file.write((const char*)&shbLength, sizeof(shbLength));
+
+    //
+    // A single interface, with an if_tsresol option for nanosecond timestamps
+    // (the default resolution being microseconds).
+    //
+    uint32_t idbLength = m_nanosecMode ? 32 : 20;
+    auto linkType = static_cast<uint16_t>(m_fileHeader.m_type);
+    uint16_t reserved = 0;
+    m_file.write((const char*)&PCAPNG_IDB_TYPE, sizeof(PCAPNG_IDB_TYPE));
+    m_file.write((const char*)&idbLength, sizeof(idbLength));
+    m_file.write((const char*)&linkType, sizeof(linkType));
+    m_file.write((const char*)&reserved, sizeof(reserved));
+    m_file.write((const char*)&m_fileHeader.m_snapLen, sizeof(m_fileHeader.m_snapLen));
+    if (m_nanosecMode)
+    {
+        uint16_t optionLength = 1;
+        uint8_t resolution[4] = {9, 0, 0, 0};
+        uint32_t endOfOptions = 0;
+        m_file.write((const char*)&PCAPNG_IF_TSRESOL, sizeof(PCAPNG_IF_TSRESOL));
+        m_file.write((const char*)&optionLength, sizeof(optionLength));
+        m_file.write((const char*)resolution, sizeof(resolution));
+        m_file.write((const char*)&endOfOptions, sizeof(endOfOptions));
+    }
+    m_file.write((const char*)&idbLength, sizeof(idbLength));
+}
+
+uint8_t*
+PcapFile::BufferRecord(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen, uint32_t& inclLen)
+{
+    NS_LOG_FUNCTION(this << tsSec << tsUsec << totalLen);
+
+    inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
+    std::size_t offset = m_buffer.size();
+
+    if (m_pcapng)
+    {
+        //
+        // Enhanced packet block: header, packet data padded to 32 bits and
+        // trailing block length.
+        //
+        uint32_t padding = (4 - inclLen % 4) % 4;
+        uint32_t blockLength = PCAPNG_EPB_HEADER_SIZE + inclLen + padding + 4;
+        m_buffer.resize(offset + blockLength);
+        uint8_t* block = m_buffer.data() + offset;
+
+        uint64_t ts = static_cast<uint64_t>(tsSec) * (m_nanosecMode ? 1000000000 : 1000000) +
+                      tsUsec;
+        uint32_t fields[7] = {PCAPNG_EPB_TYPE,
+                              blockLength,
+                              0,
+                              static_cast<uint32_t>(ts >> 32),
+                              static_cast<uint32_t>(ts),
+                              inclLen,
+                              totalLen};
+        std::memcpy(block, fields, sizeof(fields));
+        std::memcpy(block + blockLength - 4, &blockLength, sizeof(blockLength));
+        return block + PCAPNG_EPB_HEADER_SIZE;
+    }
+
+    PcapRecordHeader header;
+    header.m_tsSec = tsSec;
+    header.m_tsUsec = tsUsec;
+    header.m_inclLen = inclLen;
+    header.m_origLen = totalLen;
+
+    if (m_swapMode)
+    {
+        Swap(&header, &header);
+    }
+
+    //
+    // Watch out for memory alignment differences between machines, so copy
+    // them all individually.
+    //
+    m_buffer.resize(offset + 16 + inclLen);
+    uint8_t* record = m_buffer.data() + offset;
+    std::memcpy(record, &header.m_tsSec, sizeof(header.m_tsSec));
+    std::memcpy(record + 4, &header.m_tsUsec, sizeof(header.m_tsUsec));
+    std::memcpy(record + 8, &header.m_inclLen, sizeof(header.m_inclLen));
+    std::memcpy(record + 12, &header.m_origLen, sizeof(header.m_origLen));
+    return record + 16;
+}
+
+void
+PcapFile::CommitRecord()
+{
+    if (m_buffer.size() >= m_bufferSize)
+    {
+        WriteBuffer();
+    }
+}
+
+void
+PcapFile::WriteBuffer()
+{
+    NS_LOG_FUNCTION(this << m_buffer.size());
+    NS_ASSERT(m_file.good());
+
+    if (m_async)
+    {
+        Writer::Submit(this);
+        return;
+    }
+    m_file.write((const char*)m_buffer.data(), m_buffer.size());
+    m_buffer.clear();
+    NS_BUILD_DEBUG(m_file.flush());
 }
 
 uint32_t
@@ -433,6 +849,14 @@ void
 PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
+    if (m_buffered)
+    {
+        uint32_t inclLen;
+        uint8_t* buffer = BufferRecord(tsSec, tsUsec, totalLen, inclLen);
+        std::memcpy(buffer, data, inclLen);
+        CommitRecord();
+        return;
+    }
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
     m_file.write((const char*)data, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
@@ -442,6 +866,15 @@ void
 PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
+    if (m_buffered)
+    {
+        // Only the captured part of the packet is serialized
+        uint32_t inclLen;
+        uint8_t* buffer = BufferRecord(tsSec, tsUsec, p->GetSize(), inclLen);
+        p->CopyData(buffer, inclLen);
+        CommitRecord();
+        return;
+    }
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
     p->CopyData(&m_file, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
@@ -453,11 +886,23 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &header << p);
     uint32_t headerSize = header.GetSerializedSize();
     uint32_t totalSize = headerSize + p->GetSize();
-    uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalSize);
 
     Buffer headerBuffer;
     headerBuffer.AddAtStart(headerSize);
     header.Serialize(headerBuffer.Begin());
+
+    if (m_buffered)
+    {
+        uint32_t inclLen;
+        uint8_t* buffer = BufferRecord(tsSec, tsUsec, totalSize, inclLen);
+        uint32_t toCopy = std::min(headerSize, inclLen);
+        headerBuffer.CopyData(buffer, toCopy);
+        p->CopyData(buffer + toCopy, inclLen - toCopy);
+        CommitRecord();
+        return;
+    }
+
+    uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalSize);
     uint32_t toCopy = std::min(headerSize, inclLen);
     headerBuffer.CopyData(&m_file, toCopy);
     inclLen -= toCopy;
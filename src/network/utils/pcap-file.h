@@ -14,6 +14,7 @@
 #include <fstream>
 #include <stdint.h>
 #include <string>
+#include <vector>
 
 namespace ns3
 {
@@ -34,6 +35,8 @@ class PcapFile
     static const int32_t ZONE_DEFAULT = 0; //!< Time zone offset for current location
     static const uint32_t SNAPLEN_DEFAULT =
         65535; //!< Default value for maximum octets to save per packet
+    static const uint32_t WRITE_BUFFER_SIZE_DEFAULT =
+        65536; //!< Default size of the buffer of records written by a background thread
 
   public:
     PcapFile();
@@ -101,6 +104,13 @@ class PcapFile
      * @param nanosecMode Flag indicating the time resolution of the writing
      * system. Default to false.
      *
+     * @param pcapng Flag selecting the pcapng format instead of the classic
+     * pcap format.  A pcapng file holds a single interface, described by the
+     * data link type and snap length; the time zone correction and swap mode
+     * are ignored, the file being written in the byte order of the host.
+     * Defaults to false.  Files in the pcapng format can not be read back by
+     * this class.
+     *
      * @warning Calling this method on an existing file will result in the loss
      * any existing data.
      */
@@ -108,7 +118,35 @@ class PcapFile
               uint32_t snapLen = SNAPLEN_DEFAULT,
               int32_t timeZoneCorrection = ZONE_DEFAULT,
               bool swapMode = false,
-              bool nanosecMode = false);
+              bool nanosecMode = false,
+              bool pcapng = false);
+
+    /**
+     * @brief Buffer the packet records written to the file.
+     *
+     * Records are serialized, up to the snap length, into an in-memory buffer
+     * which is written to the file when it holds at least \p bufferSize bytes,
+     * when the file is flushed and when it is closed.  With \p async set, full
+     * buffers are handed to a background thread, shared by all the files,
+     * which writes them while the caller keeps filling a new buffer.  A few
+     * buffers per file are kept and reused; the caller blocks when all of
+     * them are waiting to be written.
+     *
+     * The records of the files with asynchronous writes still open at exit
+     * are written before the program exits.  On a fatal error however, only
+     * the records already written to the file stream are flushed: the records
+     * still in the write buffer, or queued for the background thread, are lost.
+     *
+     * @param bufferSize Number of bytes of records buffered before they are
+     * written; 0 writes each record as soon as it is added.
+     * @param async Flag to write the buffers from a background thread.
+     */
+    void SetWriteBuffer(uint32_t bufferSize, bool async = false);
+
+    /**
+     * @brief Write the buffered records to the file.
+     */
+    void Flush();
 
     /**
      * @brief Write next packet to file
@@ -357,16 +395,51 @@ class PcapFile
      */
     uint32_t WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen);
 
+    /**
+     * @brief Write the pcapng section header and interface description blocks
+     */
+    void WritePcapngHeader();
+    /**
+     * @brief Add a packet record header to the write buffer and reserve
+     * room for the packet data.
+     *
+     * @param tsSec Time stamp (seconds part)
+     * @param tsUsec Time stamp (microseconds part)
+     * @param totalLen total packet length
+     * @param [out] inclLen the length of the packet to write in the record
+     * @returns the location of the packet data in the write buffer
+     */
+    uint8_t* BufferRecord(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen, uint32_t& inclLen);
+    /**
+     * @brief Write the buffer if it holds enough records.
+     */
+    void CommitRecord();
+    /**
+     * @brief Hand the write buffer over to be written to the file.
+     */
+    void WriteBuffer();
+
     /**
      * @brief Read and verify a Pcap file header
      */
     void ReadAndVerifyFileHeader();
 
-    std::string m_filename;      //!< file name
-    std::fstream m_file;         //!< file stream
-    PcapFileHeader m_fileHeader; //!< file header
-    bool m_swapMode;             //!< swap mode
-    bool m_nanosecMode;          //!< nanosecond timestamp mode
+    class Writer; //!< Background thread writing the buffers of all files
+
+    std::string m_filename;        //!< file name
+    std::fstream m_file;           //!< file stream
+    PcapFileHeader m_fileHeader;   //!< file header
+    bool m_swapMode;               //!< swap mode
+    bool m_nanosecMode;            //!< nanosecond timestamp mode
+    bool m_pcapng;                 //!< pcapng format
+    bool m_buffered;               //!< records are written through m_buffer
+    bool m_async;                  //!< buffers are written by the background thread
+    uint32_t m_bufferSize;         //!< size at which the write buffer is written
+    std::vector<uint8_t> m_buffer; //!< records not written yet
+    /// Buffers written by the background thread, ready for reuse
+    std::vector<std::vector<uint8_t>> m_freeBuffers;
+    /// Number of buffers waiting for the background thread
+    uint32_t m_pendingBuffers;
 };
 
 } // namespace ns3
@@ -0,0 +1,174 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "fluid-background-traffic.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FluidBackgroundTraffic");
+
+NS_OBJECT_ENSURE_REGISTERED(FluidBackgroundTraffic);
+
+TypeId
+FluidBackgroundTraffic::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::FluidBackgroundTraffic")
+            .SetParent<Object>()
+            .SetGroupName("PointToPoint")
+            .AddConstructor<FluidBackgroundTraffic>()
+            .AddAttribute("PacketSize",
+                          "The size of the background packets, from which the queueing "
+                          "delay of the packets is computed",
+                          UintegerValue(1500),
+                          MakeUintegerAccessor(&FluidBackgroundTraffic::m_packetSize),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("MaxUtilization",
+                          "The maximum fraction of the capacity of the link used by the "
+                          "background traffic, whatever the rate of the background flows",
+                          DoubleValue(0.95),
+                          MakeDoubleAccessor(&FluidBackgroundTraffic::m_maxUtilization),
+                          MakeDoubleChecker<double>(0, 0.99))
+            .AddAttribute("QueueingDelay",
+                          "If true, the packets wait for the background packets queued "
+                          "before them, in addition to being transmitted at the capacity "
+                          "left by the background traffic",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&FluidBackgroundTraffic::m_queueingDelay),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+FluidBackgroundTraffic::FluidBackgroundTraffic()
+    : m_rate(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FluidBackgroundTraffic::~FluidBackgroundTraffic()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+FluidBackgroundTraffic::AddFlow(DataRate rate, Time start, Time stop)
+{
+    NS_LOG_FUNCTION(this << rate << start << stop);
+    NS_ABORT_MSG_UNLESS(start < stop, "The background flow must start before it stops");
+    Update();
+    m_flows.push_back({rate.GetBitRate(), start, stop});
+    AddRateChange(start, rate.GetBitRate());
+    if (stop != Time::Max())
+    {
+        AddRateChange(stop, -static_cast<int64_t>(rate.GetBitRate()));
+    }
+    return m_flows.size() - 1;
+}
+
+void
+FluidBackgroundTraffic::StopFlow(uint32_t flowId)
+{
+    NS_LOG_FUNCTION(this << flowId);
+    NS_ABORT_MSG_UNLESS(flowId < m_flows.size(), "Unknown background flow " << flowId);
+    Update();
+    Flow& flow = m_flows[flowId];
+    Time now = Simulator::Now();
+    if (flow.stop <= now)
+    {
+        return;
+    }
+    int64_t rate = flow.rate;
+    if (flow.stop != Time::Max())
+    {
+        // cancel the change of the rate when the flow was to stop
+        AddRateChange(flow.stop, rate);
+    }
+    if (flow.start <= now)
+    {
+        m_rate -= rate;
+    }
+    else
+    {
+        AddRateChange(flow.start, -rate);
+        flow.start = now;
+    }
+    flow.stop = now;
+}
+
+uint32_t
+FluidBackgroundTraffic::GetNFlows() const
+{
+    return m_flows.size();
+}
+
+DataRate
+FluidBackgroundTraffic::GetRate()
+{
+    Update();
+    return DataRate(m_rate);
+}
+
+Time
+FluidBackgroundTraffic::GetTransmissionTime(DataRate linkRate, uint32_t bytes)
+{
+    Update();
+    if (m_rate == 0)
+    {
+        return linkRate.CalculateBytesTxTime(bytes);
+    }
+
+    double utilization =
+        std::min(static_cast<double>(m_rate) / linkRate.GetBitRate(), m_maxUtilization);
+    DataRate residualRate(
+        std::max<uint64_t>(static_cast<uint64_t>(linkRate.GetBitRate() * (1 - utilization)), 1));
+    Time txTime = residualRate.CalculateBytesTxTime(bytes);
+    if (m_queueingDelay)
+    {
+        // mean waiting time of an M/D/1 queue of background packets
+        txTime += linkRate.CalculateBytesTxTime(m_packetSize) *
+                  (utilization / (2 * (1 - utilization)));
+    }
+    NS_LOG_LOGIC("Background utilization " << utilization << ", transmission time "
+                                           << txTime.As(Time::US));
+    return txTime;
+}
+
+void
+FluidBackgroundTraffic::Update()
+{
+    Time now = Simulator::Now();
+    while (!m_changes.empty() && m_changes.begin()->first <= now)
+    {
+        m_rate += m_changes.begin()->second;
+        m_changes.erase(m_changes.begin());
+    }
+}
+
+void
+FluidBackgroundTraffic::AddRateChange(Time time, int64_t delta)
+{
+    if (time <= Simulator::Now())
+    {
+        m_rate += delta;
+        return;
+    }
+    auto it = m_changes.emplace(time, 0).first;
+    it->second += delta;
+    if (it->second == 0)
+    {
+        m_changes.erase(it);
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,121 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FLUID_BACKGROUND_TRAFFIC_H
+#define FLUID_BACKGROUND_TRAFFIC_H
+
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup point-to-point
+ * @brief Fluid model of the background traffic sent through a PointToPointNetDevice.
+ *
+ * The background traffic is made of flows of constant rate, active between
+ * their start and stop times, which are not simulated packet by packet: no
+ * packet nor event is created for them. Instead, the device transmits each
+ * (foreground) packet at the capacity of the link left by the background
+ * traffic, after a queueing delay computed from the utilization of the link.
+ *
+ * With a link of rate C and background flows of aggregate rate R, the
+ * utilization of the link by the background traffic is rho = R / C, bounded
+ * by the MaxUtilization attribute. A packet of s bytes is transmitted in
+ * 8 s / (C (1 - rho)) and, if the QueueingDelay attribute is true, waits
+ * first for rho / (2 (1 - rho)) times the transmission time of a background
+ * packet of PacketSize bytes, as in an M/D/1 queue. The foreground packets
+ * are otherwise simulated exactly, and are transmitted exactly as without
+ * background traffic when no background flow is active.
+ */
+class FluidBackgroundTraffic : public Object
+{
+  public:
+    /**
+     * @brief Get the TypeId
+     *
+     * @return The TypeId for this class
+     */
+    static TypeId GetTypeId();
+
+    FluidBackgroundTraffic();
+    ~FluidBackgroundTraffic() override;
+
+    /**
+     * Add a background flow.
+     *
+     * @param rate the rate of the flow
+     * @param start the simulation time the flow starts at; a flow starting in
+     * the past starts now
+     * @param stop the simulation time the flow stops at
+     * @return the identifier of the flow
+     */
+    uint32_t AddFlow(DataRate rate, Time start = Seconds(0), Time stop = Time::Max());
+
+    /**
+     * Stop a background flow now, or cancel it if it has not started yet.
+     *
+     * @param flowId the identifier of the flow
+     */
+    void StopFlow(uint32_t flowId);
+
+    /**
+     * @return the number of background flows added, including the flows which
+     * stopped
+     */
+    uint32_t GetNFlows() const;
+
+    /**
+     * @return the aggregate rate of the background flows active now
+     */
+    DataRate GetRate();
+
+    /**
+     * Get the time a packet takes to be transmitted through a link shared with
+     * the background traffic, including its queueing delay.
+     *
+     * @param linkRate the rate of the link
+     * @param bytes the size of the packet
+     * @return the transmission time of the packet
+     */
+    Time GetTransmissionTime(DataRate linkRate, uint32_t bytes);
+
+  private:
+    /// Background flow
+    struct Flow
+    {
+        uint64_t rate; //!< rate of the flow, in bit/s
+        Time start;    //!< start time of the flow
+        Time stop;     //!< stop time of the flow
+    };
+
+    /**
+     * Apply the changes of the aggregate rate up to now.
+     */
+    void Update();
+
+    /**
+     * Change the aggregate rate at a time.
+     *
+     * @param time the time of the change
+     * @param delta the change of the aggregate rate, in bit/s
+     */
+    void AddRateChange(Time time, int64_t delta);
+
+    std::vector<Flow> m_flows;         //!< background flows, by identifier
+    std::map<Time, int64_t> m_changes; //!< future changes of the aggregate rate, by time
+    uint64_t m_rate;                   //!< aggregate rate of the active flows, in bit/s
+    uint32_t m_packetSize;             //!< size of the background packets
+    double m_maxUtilization;           //!< maximum utilization of the link by the background
+    bool m_queueingDelay;              //!< whether the packets are delayed by the background
+};
+
+} // namespace ns3
+
+#endif /* FLUID_BACKGROUND_TRAFFIC_H */
@@ -6,9 +6,11 @@
 
 #include "point-to-point-net-device.h"
 
+#include "fluid-background-traffic.h"
 #include "point-to-point-channel.h"
 #include "ppp-header.h"
 
+#include "ns3/boolean.h"
 #include "ns3/error-model.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
@@ -55,11 +57,34 @@ PointToPointNetDevice::GetTypeId()
                           PointerValue(),
                           MakePointerAccessor(&PointToPointNetDevice::m_receiveErrorModel),
                           MakePointerChecker<ErrorModel>())
+            .AddAttribute("BackgroundTraffic",
+                          "The fluid model of the background traffic sharing the link with "
+                          "the packets sent by this device",
+                          PointerValue(),
+                          MakePointerAccessor(&PointToPointNetDevice::m_backgroundTraffic),
+                          MakePointerChecker<FluidBackgroundTraffic>())
             .AddAttribute("InterframeGap",
                           "The time to wait between packet (frame) transmissions",
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&PointToPointNetDevice::m_tInterframeGap),
                           MakeTimeChecker())
+            .AddAttribute("ReceiveBatching",
+                          "If true, the packets received are passed to the node in batches, "
+                          "whose protocol handlers are looked up once per batch, rather than "
+                          "one by one through the receive callback. The packets are only batched "
+                          "if the receive callback is the one set by the node: with a custom "
+                          "receive callback, they are still passed one by one",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PointToPointNetDevice::m_receiveBatching),
+                          MakeBooleanChecker())
+            .AddAttribute("ReceiveBatchDelay",
+                          "When ReceiveBatching is enabled, the time the first packet of a "
+                          "batch is held, waiting for more packets, before the batch is passed "
+                          "to the node. A zero delay only batches the packets received at the "
+                          "same time.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&PointToPointNetDevice::m_receiveBatchDelay),
+                          MakeTimeChecker())
 
             //
             // Transmit queueing discipline for the device which includes its own set
@@ -167,7 +192,8 @@ PointToPointNetDevice::PointToPointNetDevice()
     : m_txMachineState(READY),
       m_channel(nullptr),
       m_linkUp(false),
-      m_currentPkt(nullptr)
+      m_currentPkt(nullptr),
+      m_rxCallbackIsNode(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -203,8 +229,11 @@ PointToPointNetDevice::DoDispose()
     m_node = nullptr;
     m_channel = nullptr;
     m_receiveErrorModel = nullptr;
+    m_backgroundTraffic = nullptr;
     m_currentPkt = nullptr;
     m_queue = nullptr;
+    m_rxBatchEvent.Cancel();
+    m_rxBatch.clear();
     NetDevice::DoDispose();
 }
 
@@ -238,7 +267,9 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
     m_currentPkt = p;
     m_phyTxBeginTrace(m_currentPkt);
 
-    Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
+    Time txTime = m_backgroundTraffic
+                      ? m_backgroundTraffic->GetTransmissionTime(m_bps, p->GetSize())
+                      : m_bps.CalculateBytesTxTime(p->GetSize());
     Time txCompleteTime = txTime + m_tInterframeGap;
 
     NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
@@ -318,6 +349,19 @@ PointToPointNetDevice::SetReceiveErrorModel(Ptr<ErrorModel> em)
     m_receiveErrorModel = em;
 }
 
+void
+PointToPointNetDevice::SetBackgroundTraffic(Ptr<FluidBackgroundTraffic> background)
+{
+    NS_LOG_FUNCTION(this << background);
+    m_backgroundTraffic = background;
+}
+
+Ptr<FluidBackgroundTraffic>
+PointToPointNetDevice::GetBackgroundTraffic() const
+{
+    return m_backgroundTraffic;
+}
+
 void
 PointToPointNetDevice::Receive(Ptr<Packet> packet)
 {
@@ -369,7 +413,39 @@ PointToPointNetDevice::Receive(Ptr<Packet> packet)
         }
 
         m_macRxTrace(originalPacket);
-        m_rxCallback(this, packet, protocol, GetRemote());
+        if (m_receiveBatching && m_rxCallbackIsNode)
+        {
+            m_rxBatch.emplace_back(packet, protocol);
+            if (!m_rxBatchEvent.IsPending())
+            {
+                m_rxBatchEvent = Simulator::Schedule(m_receiveBatchDelay,
+                                                     &PointToPointNetDevice::DeliverReceiveBatch,
+                                                     this);
+            }
+        }
+        else
+        {
+            m_rxCallback(this, packet, protocol, GetRemote());
+        }
+    }
+}
+
+void
+PointToPointNetDevice::DeliverReceiveBatch()
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<std::pair<Ptr<Packet>, uint16_t>> batch;
+    batch.swap(m_rxBatch);
+
+    std::vector<Ptr<const Packet>> packets;
+    for (auto i = batch.begin(); i != batch.end(); i++)
+    {
+        packets.push_back(i->first);
+        if (i + 1 == batch.end() || (i + 1)->second != i->second)
+        {
+            m_node->ReceiveBatchFromDevice(this, packets, i->second, GetRemote());
+            packets.clear();
+        }
     }
 }
 
@@ -582,6 +658,7 @@ void
 PointToPointNetDevice::SetReceiveCallback(NetDevice::ReceiveCallback cb)
 {
     m_rxCallback = cb;
+    m_rxCallbackIsNode = m_node && m_node->IsReceiveCallback(cb);
 }
 
 void
@@ -10,6 +10,7 @@
 #include "ns3/address.h"
 #include "ns3/callback.h"
 #include "ns3/data-rate.h"
+#include "ns3/event-id.h"
 #include "ns3/mac48-address.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -20,12 +21,14 @@
 #include "ns3/traced-callback.h"
 
 #include <cstring>
+#include <vector>
 
 namespace ns3
 {
 
 class PointToPointChannel;
 class ErrorModel;
+class FluidBackgroundTraffic;
 
 /**
  * @defgroup point-to-point Point-To-Point Network Device
@@ -131,6 +134,23 @@ class PointToPointNetDevice : public NetDevice
      */
     void SetReceiveErrorModel(Ptr<ErrorModel> em);
 
+    /**
+     * Attach a fluid model of background traffic to the PointToPointNetDevice.
+     *
+     * The packets sent by the device share the link with the background
+     * traffic, which reduces the capacity left to them and delays them.
+     *
+     * @param background Ptr to the FluidBackgroundTraffic.
+     */
+    void SetBackgroundTraffic(Ptr<FluidBackgroundTraffic> background);
+
+    /**
+     * Get the fluid model of background traffic attached to the device.
+     *
+     * @returns Ptr to the FluidBackgroundTraffic, or nullptr if none.
+     */
+    Ptr<FluidBackgroundTraffic> GetBackgroundTraffic() const;
+
     /**
      * Receive a packet from a connected PointToPointChannel.
      *
@@ -257,6 +277,14 @@ class PointToPointNetDevice : public NetDevice
      */
     void NotifyLinkUp();
 
+    /**
+     * Deliver the packets received since the last batch to the node, each
+     * run of packets of the same protocol as a batch.
+     *
+     * @see Node::ReceiveBatchFromDevice
+     */
+    void DeliverReceiveBatch();
+
     /**
      * Enumeration of the states of the transmit machine of the net device.
      */
@@ -302,6 +330,11 @@ class PointToPointNetDevice : public NetDevice
      */
     Ptr<ErrorModel> m_receiveErrorModel;
 
+    /**
+     * Fluid model of the background traffic sharing the link
+     */
+    Ptr<FluidBackgroundTraffic> m_backgroundTraffic;
+
     /**
      * The trace source fired when packets come into the "top" of the device
      * at the L3/L2 transition, before being queued for transmission.
@@ -433,6 +466,12 @@ class PointToPointNetDevice : public NetDevice
 
     Ptr<Packet> m_currentPkt; //!< Current packet processed
 
+    bool m_receiveBatching;   //!< Whether received packets are delivered in batches
+    Time m_receiveBatchDelay; //!< Time the first packet of a batch waits for more packets
+    std::vector<std::pair<Ptr<Packet>, uint16_t>> m_rxBatch; //!< Received packets and protocols
+    EventId m_rxBatchEvent;                                  //!< Delivery of the received packets
+    bool m_rxCallbackIsNode; //!< Whether the receive callback is the node's, needed to batch
+
     /**
      * @brief PPP to Ethernet protocol number mapping
      * @param protocol A PPP protocol number
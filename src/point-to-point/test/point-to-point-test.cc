@@ -6,7 +6,11 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/boolean.h"
+#include "ns3/data-rate.h"
+#include "ns3/double.h"
 #include "ns3/drop-tail-queue.h"
+#include "ns3/fluid-background-traffic.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
@@ -14,6 +18,7 @@
 #include "ns3/test.h"
 
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -128,6 +133,318 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Test the delivery of the packets received in batches
+ *
+ * It sends two bursts of packets from one NetDevice to another, which has
+ * ReceiveBatching enabled, and checks that each burst is passed to the
+ * protocol handler of the receiving node as one batch. It then replaces the
+ * receive callback of the receiving NetDevice, and checks that a third burst
+ * is passed to the new callback one packet at a time.
+ */
+class PointToPointReceiveBatchTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointReceiveBatchTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    std::vector<uint32_t> m_batchSizes; //!< sizes of the batches received
+    std::vector<Time> m_customRxTimes;  //!< times of the packets received by the custom callback
+    /**
+     * @brief Send packets to the device specified
+     *
+     * @param device NetDevice to send to.
+     * @param count Number of packets.
+     */
+    void SendPackets(Ptr<PointToPointNetDevice> device, uint32_t count);
+    /**
+     * @brief Protocol handler, which must not be called for the packets received in batches
+     *
+     * @param device The receiving device.
+     * @param packet The received packet.
+     * @param protocol The protocol number.
+     * @param from The sender address.
+     * @param to The receiver address.
+     * @param packetType The packet type.
+     */
+    void RxPacket(Ptr<NetDevice> device,
+                  Ptr<const Packet> packet,
+                  uint16_t protocol,
+                  const Address& from,
+                  const Address& to,
+                  NetDevice::PacketType packetType);
+    /**
+     * @brief Batch protocol handler, which records the size of the batches
+     *
+     * @param device The receiving device.
+     * @param packets The received packets.
+     * @param protocol The protocol number.
+     * @param from The sender address.
+     * @param to The receiver address.
+     * @param packetType The packet type.
+     */
+    void RxBatch(Ptr<NetDevice> device,
+                 const std::vector<Ptr<const Packet>>& packets,
+                 uint16_t protocol,
+                 const Address& from,
+                 const Address& to,
+                 NetDevice::PacketType packetType);
+    /**
+     * @brief Custom receive callback of the device, which records the reception times
+     *
+     * @param device The receiving device.
+     * @param packet The received packet.
+     * @param protocol The protocol number.
+     * @param from The sender address.
+     * @return true
+     */
+    bool CustomRxPacket(Ptr<NetDevice> device,
+                        Ptr<const Packet> packet,
+                        uint16_t protocol,
+                        const Address& from);
+};
+
+PointToPointReceiveBatchTest::PointToPointReceiveBatchTest()
+    : TestCase("PointToPoint receive batching")
+{
+}
+
+void
+PointToPointReceiveBatchTest::SendPackets(Ptr<PointToPointNetDevice> device, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++)
+    {
+        device->Send(Create<Packet>(100), device->GetBroadcast(), 0x800);
+    }
+}
+
+void
+PointToPointReceiveBatchTest::RxPacket(Ptr<NetDevice> device,
+                                       Ptr<const Packet> packet,
+                                       uint16_t protocol,
+                                       const Address& from,
+                                       const Address& to,
+                                       NetDevice::PacketType packetType)
+{
+    NS_TEST_EXPECT_MSG_EQ(true, false, "Packet not received in a batch");
+}
+
+void
+PointToPointReceiveBatchTest::RxBatch(Ptr<NetDevice> device,
+                                      const std::vector<Ptr<const Packet>>& packets,
+                                      uint16_t protocol,
+                                      const Address& from,
+                                      const Address& to,
+                                      NetDevice::PacketType packetType)
+{
+    NS_TEST_EXPECT_MSG_EQ(protocol, 0x800, "Wrong protocol number");
+    NS_TEST_EXPECT_MSG_EQ(packetType, NetDevice::PACKET_HOST, "Wrong packet type");
+    m_batchSizes.push_back(packets.size());
+}
+
+bool
+PointToPointReceiveBatchTest::CustomRxPacket(Ptr<NetDevice> device,
+                                             Ptr<const Packet> packet,
+                                             uint16_t protocol,
+                                             const Address& from)
+{
+    m_customRxTimes.push_back(Simulator::Now());
+    return true;
+}
+
+void
+PointToPointReceiveBatchTest::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+
+    devA->Attach(channel);
+    devA->SetAddress(Mac48Address::Allocate());
+    devA->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devA->SetDataRate(DataRate("1Gbps"));
+    devB->Attach(channel);
+    devB->SetAddress(Mac48Address::Allocate());
+    devB->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devB->SetAttribute("ReceiveBatching", BooleanValue(true));
+    devB->SetAttribute("ReceiveBatchDelay", TimeValue(MilliSeconds(10)));
+
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+
+    b->RegisterProtocolHandler(MakeCallback(&PointToPointReceiveBatchTest::RxPacket, this),
+                               0x800,
+                               devB,
+                               false,
+                               MakeCallback(&PointToPointReceiveBatchTest::RxBatch, this));
+
+    Simulator::Schedule(Seconds(1), &PointToPointReceiveBatchTest::SendPackets, this, devA, 5);
+    Simulator::Schedule(Seconds(2), &PointToPointReceiveBatchTest::SendPackets, this, devA, 3);
+    // a custom receive callback gets the packets one by one
+    Simulator::Schedule(Seconds(2.5),
+                        &PointToPointNetDevice::SetReceiveCallback,
+                        devB,
+                        MakeCallback(&PointToPointReceiveBatchTest::CustomRxPacket, this));
+    Simulator::Schedule(Seconds(3), &PointToPointReceiveBatchTest::SendPackets, this, devA, 4);
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_batchSizes.size(), 2, "Wrong number of batches");
+    NS_TEST_EXPECT_MSG_EQ(m_batchSizes[0], 5, "Wrong size of the first batch");
+    NS_TEST_EXPECT_MSG_EQ(m_batchSizes[1], 3, "Wrong size of the second batch");
+    NS_TEST_ASSERT_MSG_EQ(m_customRxTimes.size(),
+                          4,
+                          "Wrong number of packets received by the custom callback");
+    for (uint32_t i = 1; i < m_customRxTimes.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_GT(m_customRxTimes[i],
+                              m_customRxTimes[i - 1],
+                              "Packets must not be held to be passed to the custom callback");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * @brief Test the transmission of packets through a link shared with fluid
+ * background traffic
+ *
+ * It sends packets from one NetDevice to another, while background flows
+ * start and stop, and checks that each packet is received after its
+ * transmission time at the capacity left by the background traffic, plus
+ * its queueing delay.
+ */
+class PointToPointFluidBackgroundTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointFluidBackgroundTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    std::vector<Time> m_delays; //!< delays of the packets received
+    Time m_sendTime;            //!< time the last packet was sent
+    /**
+     * @brief Send one packet to the device specified
+     *
+     * @param device NetDevice to send to.
+     */
+    void SendOnePacket(Ptr<PointToPointNetDevice> device);
+    /**
+     * @brief Callback function which records the delay of the packet
+     *
+     * @param dev The receiving device.
+     * @param pkt The received packet.
+     * @param mode The protocol mode used.
+     * @param sender The sender address.
+     *
+     * @return A boolean indicating packet handled properly.
+     */
+    bool RxPacket(Ptr<NetDevice> dev, Ptr<const Packet> pkt, uint16_t mode, const Address& sender);
+};
+
+PointToPointFluidBackgroundTest::PointToPointFluidBackgroundTest()
+    : TestCase("PointToPoint fluid background traffic")
+{
+}
+
+void
+PointToPointFluidBackgroundTest::SendOnePacket(Ptr<PointToPointNetDevice> device)
+{
+    m_sendTime = Simulator::Now();
+    device->Send(Create<Packet>(998), device->GetBroadcast(), 0x800);
+}
+
+bool
+PointToPointFluidBackgroundTest::RxPacket(Ptr<NetDevice> dev,
+                                          Ptr<const Packet> pkt,
+                                          uint16_t mode,
+                                          const Address& sender)
+{
+    m_delays.push_back(Simulator::Now() - m_sendTime);
+    return true;
+}
+
+void
+PointToPointFluidBackgroundTest::DoRun()
+{
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    Ptr<FluidBackgroundTraffic> background = CreateObject<FluidBackgroundTraffic>();
+
+    devA->Attach(channel);
+    devA->SetAddress(Mac48Address::Allocate());
+    devA->SetQueue(CreateObject<DropTailQueue<Packet>>());
+    devA->SetDataRate(DataRate("8Mbps"));
+    devA->SetBackgroundTraffic(background);
+    devB->Attach(channel);
+    devB->SetAddress(Mac48Address::Allocate());
+    devB->SetQueue(CreateObject<DropTailQueue<Packet>>());
+
+    a->AddDevice(devA);
+    b->AddDevice(devB);
+
+    devB->SetReceiveCallback(MakeCallback(&PointToPointFluidBackgroundTest::RxPacket, this));
+
+    // 6 Mbps of background traffic between 2 s and 4 s, then 16 Mbps from 5 s,
+    // which is more than the link capacity, until the flow is stopped at 7 s
+    background->AddFlow(DataRate("2Mbps"), Seconds(2), Seconds(4));
+    background->AddFlow(DataRate("4Mbps"), Seconds(2), Seconds(4));
+    uint32_t flowId = background->AddFlow(DataRate("16Mbps"), Seconds(5));
+    background->SetAttribute("MaxUtilization", DoubleValue(0.75));
+    Simulator::Schedule(Seconds(7), &FluidBackgroundTraffic::StopFlow, background, flowId);
+
+    for (uint32_t i = 1; i <= 8; i++)
+    {
+        Simulator::Schedule(Seconds(i),
+                            &PointToPointFluidBackgroundTest::SendOnePacket,
+                            this,
+                            devA);
+    }
+
+    Simulator::Run();
+
+    // Packets of 1000 bytes with their PPP header: 1 ms at 8 Mbps, 4 ms at the
+    // 2 Mbps left by the background traffic, after a queueing delay of
+    // 0.75 / (2 * 0.25) times the 1.5 ms of a background packet
+    NS_TEST_ASSERT_MSG_EQ(m_delays.size(), 8, "Wrong number of packets received");
+    std::vector<Time> expected{MilliSeconds(1),
+                               MicroSeconds(6250),
+                               MicroSeconds(6250),
+                               MilliSeconds(1),
+                               MicroSeconds(6250),
+                               MicroSeconds(6250),
+                               MilliSeconds(1),
+                               MilliSeconds(1)};
+    for (uint32_t i = 0; i < 8; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_delays[i], expected[i], "Wrong delay of packet " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(background->GetRate(), DataRate(0), "Background flows not stopped");
+    NS_TEST_EXPECT_MSG_EQ(background->GetNFlows(), 3, "Wrong number of background flows");
+
+    Simulator::Destroy();
+}
+
 /**
  * @brief TestSuite for PointToPoint module
  */
@@ -144,6 +461,8 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointReceiveBatchTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointFluidBackgroundTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
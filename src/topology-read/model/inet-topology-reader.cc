@@ -13,9 +13,9 @@
 #include "ns3/names.h"
 #include "ns3/node-container.h"
 
-#include <cstdlib>
-#include <fstream>
-#include <sstream>
+#include <charconv>
+#include <limits>
+#include <vector>
 
 /**
  * @file
@@ -52,95 +52,86 @@ InetTopologyReader::~InetTopologyReader()
 NodeContainer
 InetTopologyReader::Read()
 {
-    std::ifstream topgen;
-    topgen.open(GetFileName());
-    std::map<std::string, Ptr<Node>> nodeMap;
-    NodeContainer nodes;
+    TopologyGraph graph = ReadGraph();
+    NodeContainer nodes = graph.CreateNodes();
+
+    // The nodes first seen as the origin of a link are named after their
+    // number, those first seen as its destination are prefixed with
+    // "InetTopology/NodeName/"
+    std::vector<bool> named(graph.GetNNodes(), false);
+    for (const auto& edge : graph.GetEdges())
+    {
+        if (!named[edge.from])
+        {
+            Names::Add(graph.GetNodeName(edge.from), nodes.Get(edge.from));
+            named[edge.from] = true;
+        }
+        if (!named[edge.to])
+        {
+            Names::Add("InetTopology/NodeName/" + graph.GetNodeName(edge.to), nodes.Get(edge.to));
+            named[edge.to] = true;
+        }
+    }
+
+    AddLinks(graph, nodes);
+    return nodes;
+}
+
+TopologyGraph
+InetTopologyReader::ReadGraph()
+{
+    TopologyGraph graph;
+    std::string contents;
 
-    if (!topgen.is_open())
+    if (!ReadFile(contents))
     {
         NS_LOG_WARN("Inet topology file object is not open, check file name and permissions");
-        return nodes;
+        return graph;
     }
 
-    std::string from;
-    std::string to;
-    std::string linkAttr;
+    std::string_view text(contents);
+    std::string_view header[2];
+    uint64_t totnode = 0;
+    uint64_t totlink = 0;
 
-    int linksNumber = 0;
-    int nodesNumber = 0;
-
-    int totnode = 0;
-    int totlink = 0;
+    if (Tokenize(text.substr(0, text.find('\n')), header, 2) == 2)
+    {
+        std::from_chars(header[0].data(), header[0].data() + header[0].size(), totnode);
+        std::from_chars(header[1].data(), header[1].data() + header[1].size(), totlink);
+    }
+    NS_LOG_INFO("Inet topology should have " << totnode << " nodes and " << totlink << " links");
 
-    std::istringstream lineBuffer;
-    std::string line;
+    // Skip the header and the lines of the nodes, then parse the lines of the links
+    text.remove_prefix(GetLineOffset(text, totnode + 1));
+    ParseEdgeLines(text, &ParseLinkLine, totlink, graph);
 
-    getline(topgen, line);
-    lineBuffer.str(line);
+    NS_LOG_INFO("Inet topology created with " << graph.GetNNodes() << " nodes and "
+                                              << graph.GetNEdges() << " links");
 
-    lineBuffer >> totnode;
-    lineBuffer >> totlink;
-    NS_LOG_INFO("Inet topology should have " << totnode << " nodes and " << totlink << " links");
+    return graph;
+}
 
-    for (int i = 0; i < totnode && !topgen.eof(); i++)
+TopologyReader::LineType
+InetTopologyReader::ParseLinkLine(std::string_view line, ParsedEdge& edge)
+{
+    // from to [weight]
+    std::string_view tokens[3];
+    uint32_t n = Tokenize(line, tokens, 3);
+    if (n < 2)
     {
-        getline(topgen, line);
+        return LINE_SKIP;
     }
-
-    for (int i = 0; i < totlink && !topgen.eof(); i++)
+    edge.from = tokens[0];
+    edge.to = tokens[1];
+    if (n < 3 || !ParseWeight(tokens[2], edge.weight))
     {
-        getline(topgen, line);
-        lineBuffer.clear();
-        lineBuffer.str(line);
-
-        lineBuffer >> from;
-        lineBuffer >> to;
-        lineBuffer >> linkAttr;
-
-        if ((!from.empty()) && (!to.empty()))
-        {
-            NS_LOG_INFO("Link " << linksNumber << " from: " << from << " to: " << to);
-
-            if (!nodeMap[from])
-            {
-                NS_LOG_INFO("Node " << nodesNumber << " name: " << from);
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodeName = "InetTopology/NodeName/" + from;
-                Names::Add(from, tmpNode);
-                nodeMap[from] = tmpNode;
-                nodes.Add(tmpNode);
-                nodesNumber++;
-            }
-
-            if (!nodeMap[to])
-            {
-                NS_LOG_INFO("Node " << nodesNumber << " name: " << to);
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodename = "InetTopology/NodeName/" + to;
-                Names::Add(nodename, tmpNode);
-                nodeMap[to] = tmpNode;
-                nodes.Add(tmpNode);
-                nodesNumber++;
-            }
-
-            Link link(nodeMap[from], from, nodeMap[to], to);
-            if (!linkAttr.empty())
-            {
-                NS_LOG_INFO("Link " << linksNumber << " weight: " << linkAttr);
-                link.SetAttribute("Weight", linkAttr);
-            }
-            AddLink(link);
-
-            linksNumber++;
-        }
+        edge.weight = std::numeric_limits<double>::quiet_NaN();
     }
-
-    NS_LOG_INFO("Inet topology created with " << nodesNumber << " nodes and " << linksNumber
-                                              << " links");
-    topgen.close();
-
-    return nodes;
+    else
+    {
+        edge.weightText = tokens[2];
+    }
+    return LINE_EDGE;
 }
 
 } /* namespace ns3 */
@@ -63,10 +63,34 @@ class InetTopologyReader : public TopologyReader
      * Then reads until the end of the file (total links number rows) and saves
      * the structure of every single link in the topology.
      *
+     * The nodes first seen as the origin of a link are named after their
+     * number in the file, and the nodes first seen as the destination of a
+     * link "InetTopology/NodeName/<number>".
+     *
      * @return The container of the nodes created (or empty container if there was an error)
      */
     NodeContainer Read() override;
 
+    /**
+     * @brief Topology reading function building a graph only.
+     *
+     * Same as Read(), but builds a TopologyGraph instead of nodes and links.
+     * The nodes of the graph are numbered in the order they first appear in
+     * the links, and the edges have the weight of their link, if any.
+     *
+     * @return The graph of the topology (empty if there was an error).
+     */
+    TopologyGraph ReadGraph() override;
+
+  private:
+    /**
+     * @brief Parses a line of a link.
+     * @param [in] line The line.
+     * @param [out] edge The edge of the link.
+     * @return The type of the line.
+     */
+    static LineType ParseLinkLine(std::string_view line, ParsedEdge& edge);
+
     // end class InetTopologyReader
 };
 
@@ -10,12 +10,9 @@
 #include "orbis-topology-reader.h"
 
 #include "ns3/log.h"
-#include "ns3/names.h"
 #include "ns3/node-container.h"
 
-#include <cstdlib>
-#include <fstream>
-#include <sstream>
+#include <limits>
 
 /**
  * @file
@@ -53,70 +50,43 @@ OrbisTopologyReader::~OrbisTopologyReader()
 NodeContainer
 OrbisTopologyReader::Read()
 {
-    std::ifstream topgen;
-    topgen.open(GetFileName());
-    std::map<std::string, Ptr<Node>> nodeMap;
-    NodeContainer nodes;
+    TopologyGraph graph = ReadGraph();
+    NodeContainer nodes = graph.CreateNodes("OrbisTopology/NodeName/");
+    AddLinks(graph, nodes);
+    return nodes;
+}
+
+TopologyGraph
+OrbisTopologyReader::ReadGraph()
+{
+    TopologyGraph graph;
+    std::string contents;
 
-    if (!topgen.is_open())
+    if (!ReadFile(contents))
     {
-        return nodes;
+        return graph;
     }
 
-    std::string from;
-    std::string to;
-    std::istringstream lineBuffer;
-    std::string line;
+    ParseEdgeLines(contents, &ParseLinkLine, std::numeric_limits<uint64_t>::max(), graph);
+    NS_LOG_INFO("Orbis topology created with " << graph.GetNNodes() << " nodes and "
+                                               << graph.GetNEdges() << " links");
 
-    int linksNumber = 0;
-    int nodesNumber = 0;
+    return graph;
+}
 
-    while (!topgen.eof())
+TopologyReader::LineType
+OrbisTopologyReader::ParseLinkLine(std::string_view line, ParsedEdge& edge)
+{
+    // from to
+    std::string_view tokens[2];
+    if (Tokenize(line, tokens, 2) < 2)
     {
-        line.clear();
-        lineBuffer.clear();
-        from.clear();
-        to.clear();
-
-        getline(topgen, line);
-        lineBuffer.str(line);
-        lineBuffer >> from;
-        lineBuffer >> to;
-
-        if ((!from.empty()) && (!to.empty()))
-        {
-            NS_LOG_INFO(linksNumber << " From: " << from << " to: " << to);
-            if (!nodeMap[from])
-            {
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodename = "OrbisTopology/NodeName/" + from;
-                Names::Add(nodename, tmpNode);
-                nodeMap[from] = tmpNode;
-                nodes.Add(tmpNode);
-                nodesNumber++;
-            }
-
-            if (!nodeMap[to])
-            {
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodename = "OrbisTopology/NodeName/" + to;
-                Names::Add(nodename, tmpNode);
-                nodeMap[to] = tmpNode;
-                nodes.Add(tmpNode);
-                nodesNumber++;
-            }
-
-            Link link(nodeMap[from], from, nodeMap[to], to);
-            AddLink(link);
-
-            linksNumber++;
-        }
+        return LINE_SKIP;
     }
-    NS_LOG_INFO("Orbis topology created with " << nodesNumber << " nodes and " << linksNumber
-                                               << " links");
-    topgen.close();
-
-    return nodes;
+    edge.from = tokens[0];
+    edge.to = tokens[1];
+    edge.weight = std::numeric_limits<double>::quiet_NaN();
+    return LINE_EDGE;
 }
 
 } /* namespace ns3 */
@@ -62,6 +62,26 @@ class OrbisTopologyReader : public TopologyReader
      */
     NodeContainer Read() override;
 
+    /**
+     * @brief Topology reading function building a graph only.
+     *
+     * Same as Read(), but builds a TopologyGraph instead of nodes and links.
+     * The nodes of the graph are numbered in the order they first appear in
+     * the links.
+     *
+     * @return The graph of the topology (empty if there was an error).
+     */
+    TopologyGraph ReadGraph() override;
+
+  private:
+    /**
+     * @brief Parses a line of a link.
+     * @param [in] line The line.
+     * @param [out] edge The edge of the link.
+     * @return The type of the line.
+     */
+    static LineType ParseLinkLine(std::string_view line, ParsedEdge& edge);
+
     // end class OrbisTopologyReader
 };
 
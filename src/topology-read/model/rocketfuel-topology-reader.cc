@@ -9,13 +9,12 @@
 #include "rocketfuel-topology-reader.h"
 
 #include "ns3/log.h"
-#include "ns3/names.h"
 #include "ns3/node-container.h"
 
 #include <cstdlib>
-#include <fstream>
-#include <iostream>
+#include <limits>
 #include <regex>
+#include <sstream>
 #include <string>
 
 /**
@@ -43,8 +42,6 @@ RocketfuelTopologyReader::GetTypeId()
 
 RocketfuelTopologyReader::RocketfuelTopologyReader()
 {
-    m_linksNumber = 0;
-    m_nodesNumber = 0;
     NS_LOG_FUNCTION(this);
 }
 
@@ -110,8 +107,9 @@ PrintNodeInfo(std::string& uid,
                              << "name: " << name << " radius: " << radius);
 }
 
-NodeContainer
-RocketfuelTopologyReader::GenerateFromMapsFile(const std::vector<std::string>& argv)
+void
+RocketfuelTopologyReader::GenerateFromMapsFile(const std::vector<std::string>& argv,
+                                               TopologyGraph& graph)
 {
     std::string uid;
     std::string loc;
@@ -123,7 +121,6 @@ RocketfuelTopologyReader::GenerateFromMapsFile(const std::vector<std::string>& a
     unsigned int num_neigh = 0;
     int radius = 0;
     std::vector<std::string> neigh_list;
-    NodeContainer nodes;
 
     uid = argv[0];
     loc = argv[1];
@@ -189,7 +186,7 @@ RocketfuelTopologyReader::GenerateFromMapsFile(const std::vector<std::string>& a
     radius = std::atoi(&argv[9][1]);
     if (radius > 0)
     {
-        return nodes;
+        return;
     }
 
     PrintNodeInfo(uid, loc, dns, bb, neigh_list.size(), name, radius);
@@ -197,113 +194,42 @@ RocketfuelTopologyReader::GenerateFromMapsFile(const std::vector<std::string>& a
     // Create node and link
     if (!uid.empty())
     {
-        if (!m_nodeMap[uid])
-        {
-            Ptr<Node> tmpNode = CreateObject<Node>();
-            std::string nodename = "RocketFuelTopology/NodeName/" + uid;
-            Names::Add(nodename, tmpNode);
-            m_nodeMap[uid] = tmpNode;
-            nodes.Add(tmpNode);
-            m_nodesNumber++;
-        }
+        uint32_t from = graph.AddNode(uid);
 
         for (auto& nuid : neigh_list)
         {
             if (nuid.empty())
             {
-                return nodes;
+                return;
             }
 
-            if (!m_nodeMap[nuid])
-            {
-                Ptr<Node> tmpNode = CreateObject<Node>();
-                std::string nodename = "RocketFuelTopology/NodeName/" + nuid;
-                Names::Add(nodename, tmpNode);
-                m_nodeMap[nuid] = tmpNode;
-                nodes.Add(tmpNode);
-                m_nodesNumber++;
-            }
-            NS_LOG_INFO(m_linksNumber << ":" << m_nodesNumber << " From: " << uid
-                                      << " to: " << nuid);
-            Link link(m_nodeMap[uid], uid, m_nodeMap[nuid], nuid);
-            AddLink(link);
-            m_linksNumber++;
+            uint32_t to = graph.AddNode(nuid);
+            NS_LOG_INFO(graph.GetNEdges() << ":" << graph.GetNNodes() << " From: " << uid
+                                          << " to: " << nuid);
+            graph.AddEdge(from, to, std::numeric_limits<double>::quiet_NaN());
         }
     }
-
-    NS_LOG_INFO("Rocketfuel topology created with " << m_nodesNumber << " nodes and "
-                                                    << m_linksNumber << " links");
-
-    return nodes;
 }
 
-NodeContainer
-RocketfuelTopologyReader::GenerateFromWeightsFile(const std::vector<std::string>& argv)
+TopologyReader::LineType
+RocketfuelTopologyReader::ParseWeightsLine(std::string_view line, ParsedEdge& edge)
 {
-    /* uid @loc [+] [bb] (num_neigh) [&ext] -> <nuid-1> <nuid-2> ... {-euid} ... =name[!] rn */
-    std::string sname;
-    std::string tname;
-    std::string::size_type endptr;
-    NodeContainer nodes;
-
-    sname = argv[0];
-    tname = argv[1];
-    double weight [[maybe_unused]] = std::stod(argv[2], &endptr);
-
-    if (argv[2].size() != endptr)
+    // Same as matching rocketfuel_weights_regex, without building strings
+    std::string_view tokens[4];
+    if (line.empty() || line[0] == ' ' || line[0] == '\t' || Tokenize(line, tokens, 4) != 3 ||
+        tokens[2].find_first_not_of("0123456789.") != std::string_view::npos)
     {
-        NS_LOG_WARN("invalid weight: " << argv[2]);
-        return nodes;
+        return LINE_STOP;
     }
-
-    // Create node and link
-    if (!sname.empty() && !tname.empty())
+    if (!ParseWeight(tokens[2], edge.weight))
     {
-        if (!m_nodeMap[sname])
-        {
-            Ptr<Node> tmpNode = CreateObject<Node>();
-            std::string nodename = "RocketFuelTopology/NodeName/" + sname;
-            Names::Add(nodename, tmpNode);
-            m_nodeMap[sname] = tmpNode;
-            nodes.Add(tmpNode);
-            m_nodesNumber++;
-        }
-
-        if (!m_nodeMap[tname])
-        {
-            Ptr<Node> tmpNode = CreateObject<Node>();
-            std::string nodename = "RocketFuelTopology/NodeName/" + tname;
-            Names::Add(nodename, tmpNode);
-            m_nodeMap[tname] = tmpNode;
-            nodes.Add(tmpNode);
-            m_nodesNumber++;
-        }
-        NS_LOG_INFO(m_linksNumber << ":" << m_nodesNumber << " From: " << sname
-                                  << " to: " << tname);
-        TopologyReader::ConstLinksIterator iter;
-        bool found = false;
-        for (iter = LinksBegin(); iter != LinksEnd(); iter++)
-        {
-            if ((iter->GetFromNode() == m_nodeMap[tname]) &&
-                (iter->GetToNode() == m_nodeMap[sname]))
-            {
-                found = true;
-                break;
-            }
-        }
-
-        if (!found)
-        {
-            Link link(m_nodeMap[sname], sname, m_nodeMap[tname], tname);
-            AddLink(link);
-            m_linksNumber++;
-        }
+        // The line is skipped, as the weight is not a number, such as "1.2.3"
+        return LINE_SKIP;
     }
-
-    NS_LOG_INFO("Rocketfuel topology created with " << m_nodesNumber << " nodes and "
-                                                    << m_linksNumber << " links");
-
-    return nodes;
+    edge.from = tokens[0];
+    edge.to = tokens[1];
+    edge.weightText = tokens[2];
+    return LINE_EDGE;
 }
 
 RocketfuelTopologyReader::RF_FileType
@@ -328,94 +254,65 @@ RocketfuelTopologyReader::GetFileType(const std::string& line)
 NodeContainer
 RocketfuelTopologyReader::Read()
 {
-    std::ifstream topgen;
-    topgen.open(GetFileName());
-    NodeContainer nodes;
+    TopologyGraph graph = ReadGraph();
+    NodeContainer nodes = graph.CreateNodes("RocketFuelTopology/NodeName/");
+    AddLinks(graph, nodes);
+    return nodes;
+}
 
-    std::istringstream lineBuffer;
-    std::string line;
-    int lineNumber = 0;
-    RF_FileType ftype = RF_UNKNOWN;
+TopologyGraph
+RocketfuelTopologyReader::ReadGraph()
+{
+    TopologyGraph graph;
+    std::string contents;
 
-    if (!topgen.is_open())
+    if (!ReadFile(contents))
     {
         NS_LOG_WARN("Couldn't open the file " << GetFileName());
-        return nodes;
+        return graph;
     }
 
-    while (!topgen.eof())
+    std::string_view text(contents);
+    RF_FileType ftype = GetFileType(std::string(text.substr(0, text.find('\n'))));
+    if (ftype == RF_UNKNOWN)
     {
-        std::vector<std::string> argv;
-
-        lineNumber++;
-        line.clear();
-        lineBuffer.clear();
-
-        getline(topgen, line);
+        NS_LOG_INFO("Unknown File Format (" << GetFileName() << ")");
+    }
+    else if (ftype == RF_MAPS)
+    {
+        std::string line;
+        std::istringstream lineBuffer(contents);
 
-        if (lineNumber == 1)
+        while (getline(lineBuffer, line))
         {
-            ftype = GetFileType(line);
-            if (ftype == RF_UNKNOWN)
-            {
-                NS_LOG_INFO("Unknown File Format (" << GetFileName() << ")");
-                break;
-            }
-        }
+            std::vector<std::string> argv;
+            std::smatch matches;
 
-        std::smatch matches;
-
-        if (ftype == RF_MAPS)
-        {
             bool ret = std::regex_match(line, matches, rocketfuel_maps_regex);
             if (!ret || matches.empty())
             {
                 NS_LOG_WARN("match failed (maps file): %s" << line);
                 break;
             }
-        }
-        else if (ftype == RF_WEIGHTS)
-        {
-            bool ret = std::regex_match(line, matches, rocketfuel_weights_regex);
-            if (!ret || matches.empty())
-            {
-                NS_LOG_WARN("match failed (weights file): %s" << line);
-                break;
-            }
-        }
-
-        std::string matched_string;
 
-        for (auto it = matches.begin() + 1; it != matches.end(); it++)
-        {
-            if (it->matched)
-            {
-                matched_string = it->str();
-            }
-            else
+            for (auto it = matches.begin() + 1; it != matches.end(); it++)
             {
-                matched_string = "";
+                argv.push_back(it->matched ? it->str() : "");
             }
-            argv.push_back(matched_string);
-        }
-
-        if (ftype == RF_MAPS)
-        {
-            nodes.Add(GenerateFromMapsFile(argv));
-        }
-        else if (ftype == RF_WEIGHTS)
-        {
-            nodes.Add(GenerateFromWeightsFile(argv));
-        }
-        else
-        {
-            NS_LOG_WARN("Unsupported file format (only Maps/Weights are supported)");
+            GenerateFromMapsFile(argv, graph);
         }
     }
+    else
+    {
+        ParseEdgeLines(text, &ParseWeightsLine, std::numeric_limits<uint64_t>::max(), graph);
+        // A link is ignored if the link in the opposite direction precedes it
+        graph.RemoveReverseEdges();
+    }
 
-    topgen.close();
+    NS_LOG_INFO("Rocketfuel topology created with " << graph.GetNNodes() << " nodes and "
+                                                    << graph.GetNEdges() << " links");
 
-    return nodes;
+    return graph;
 }
 
 } /* namespace ns3 */
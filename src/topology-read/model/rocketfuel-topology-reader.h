@@ -61,28 +61,40 @@ class RocketfuelTopologyReader : public TopologyReader
      */
     NodeContainer Read() override;
 
+    /**
+     * @brief Topology reading function building a graph only.
+     *
+     * Same as Read(), but builds a TopologyGraph instead of nodes and links.
+     * The nodes of the graph are numbered in the order they first appear in
+     * the file, and the edges read from a weights file have their weight.
+     *
+     * @return The graph of the topology (empty if there was an error).
+     */
+    TopologyGraph ReadGraph() override;
+
   private:
     /**
-     * @brief Topology read function from a file containing the nodes map.
+     * @brief Topology read function from a line of a file containing the nodes map.
      *
      * Parser for the *.cch file available at:
      * http://www.cs.washington.edu/research/networking/rocketfuel/maps/rocketfuel_maps_cch.tar.gz
      *
      * @param [in] argv Argument vector.
-     * @return The container of the nodes created (or empty container if there was an error).
+     * @param [in,out] graph The graph the node and its links are added to.
      */
-    NodeContainer GenerateFromMapsFile(const std::vector<std::string>& argv);
+    void GenerateFromMapsFile(const std::vector<std::string>& argv, TopologyGraph& graph);
 
     /**
-     * @brief Topology read function from a file containing the nodes weights.
+     * @brief Parses a line of a file containing the nodes weights.
      *
      * Parser for the weights.* file available at:
      * http://www.cs.washington.edu/research/networking/rocketfuel/maps/weights-dist.tar.gz
      *
-     * @param [in] argv Argument vector.
-     * @return The container of the nodes created (or empty container if there was an error).
+     * @param [in] line The line.
+     * @param [out] edge The edge of the link.
+     * @return The type of the line.
      */
-    NodeContainer GenerateFromWeightsFile(const std::vector<std::string>& argv);
+    static LineType ParseWeightsLine(std::string_view line, ParsedEdge& edge);
 
     /**
      * @brief Enum of the possible file types.
@@ -102,10 +114,6 @@ class RocketfuelTopologyReader : public TopologyReader
      */
     RF_FileType GetFileType(const std::string& buf);
 
-    int m_linksNumber;                          //!< Number of links.
-    int m_nodesNumber;                          //!< Number of nodes.
-    std::map<std::string, Ptr<Node>> m_nodeMap; //!< Map of the nodes (name, node).
-
     // end class RocketfuelTopologyReader
 };
 
@@ -0,0 +1,225 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "topology-graph.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/names.h"
+
+#include <charconv>
+#include <cmath>
+#include <unordered_set>
+
+/**
+ * @file
+ * @ingroup topology
+ * ns3::TopologyGraph implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TopologyGraph");
+
+namespace
+{
+
+/**
+ * @ingroup topology
+ * Format a weight in its shortest form, which reads back as the same value.
+ * @param [in] weight The weight.
+ * @param [out] buffer The buffer the weight is written to.
+ * @return The text of the weight, in the buffer.
+ */
+std::string_view
+FormatWeight(double weight, char (&buffer)[32])
+{
+    auto [ptr, ec] = std::to_chars(buffer, buffer + sizeof(buffer), weight);
+    return std::string_view(buffer, ptr - buffer);
+}
+
+} // unnamed namespace
+
+uint32_t
+TopologyGraph::AddNode(std::string_view name)
+{
+    auto it = m_nodes.find(name);
+    if (it != m_nodes.end())
+    {
+        return it->second;
+    }
+    uint32_t node = m_names.size();
+    // The names are stored in a deque, which never moves them, so that the
+    // keys of the map can view them
+    m_names.emplace_back(name);
+    m_nodes.emplace(m_names.back(), node);
+    return node;
+}
+
+bool
+TopologyGraph::FindNode(std::string_view name, uint32_t& node) const
+{
+    auto it = m_nodes.find(name);
+    if (it == m_nodes.end())
+    {
+        return false;
+    }
+    node = it->second;
+    return true;
+}
+
+void
+TopologyGraph::AddEdge(uint32_t from, uint32_t to, double weight, std::string_view weightText)
+{
+    NS_ASSERT(from < m_names.size() && to < m_names.size());
+    if (!weightText.empty() && !std::isnan(weight))
+    {
+        char buffer[32];
+        if (weightText != FormatWeight(weight, buffer))
+        {
+            m_weightTexts.emplace(m_edges.size(), weightText);
+        }
+    }
+    m_edges.push_back({from, to, weight});
+}
+
+void
+TopologyGraph::AddEdges(const TopologyGraph& graph, const std::vector<uint32_t>& nodes)
+{
+    NS_ASSERT(nodes.size() == graph.GetNNodes());
+    uint32_t offset = m_edges.size();
+    m_edges.reserve(m_edges.size() + graph.m_edges.size());
+    for (const auto& edge : graph.m_edges)
+    {
+        NS_ASSERT(nodes[edge.from] < m_names.size() && nodes[edge.to] < m_names.size());
+        m_edges.push_back({nodes[edge.from], nodes[edge.to], edge.weight});
+    }
+    for (const auto& [i, weightText] : graph.m_weightTexts)
+    {
+        m_weightTexts.emplace(offset + i, weightText);
+    }
+}
+
+uint32_t
+TopologyGraph::GetNNodes() const
+{
+    return m_names.size();
+}
+
+const std::string&
+TopologyGraph::GetNodeName(uint32_t node) const
+{
+    NS_ASSERT(node < m_names.size());
+    return m_names[node];
+}
+
+uint32_t
+TopologyGraph::GetNEdges() const
+{
+    return m_edges.size();
+}
+
+const TopologyGraph::Edge&
+TopologyGraph::GetEdge(uint32_t i) const
+{
+    NS_ASSERT(i < m_edges.size());
+    return m_edges[i];
+}
+
+const std::vector<TopologyGraph::Edge>&
+TopologyGraph::GetEdges() const
+{
+    return m_edges;
+}
+
+std::string
+TopologyGraph::GetWeightText(uint32_t i) const
+{
+    NS_ASSERT(i < m_edges.size());
+    auto it = m_weightTexts.find(i);
+    if (it != m_weightTexts.end())
+    {
+        return it->second;
+    }
+    if (std::isnan(m_edges[i].weight))
+    {
+        return "";
+    }
+    char buffer[32];
+    return std::string(FormatWeight(m_edges[i].weight, buffer));
+}
+
+void
+TopologyGraph::RemoveReverseEdges()
+{
+    NS_LOG_FUNCTION(this);
+    std::unordered_set<uint64_t> edges;
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < m_edges.size(); i++)
+    {
+        const Edge& edge = m_edges[i];
+        if (edges.count((uint64_t(edge.to) << 32) | edge.from) == 0)
+        {
+            edges.insert((uint64_t(edge.from) << 32) | edge.to);
+            // the weight text of the edge moves with it
+            auto weightText = m_weightTexts.extract(i);
+            if (!weightText.empty())
+            {
+                weightText.key() = kept;
+                m_weightTexts.insert(std::move(weightText));
+            }
+            m_edges[kept++] = edge;
+        }
+        else
+        {
+            m_weightTexts.erase(i);
+        }
+    }
+    NS_LOG_INFO("Removed " << m_edges.size() - kept << " reverse edges");
+    m_edges.resize(kept);
+}
+
+void
+TopologyGraph::Clear()
+{
+    m_nodes.clear();
+    m_names.clear();
+    m_edges.clear();
+    m_weightTexts.clear();
+}
+
+NodeContainer
+TopologyGraph::CreateNodes(const std::string& namePrefix) const
+{
+    NS_LOG_FUNCTION(this << namePrefix);
+    NodeContainer nodes;
+    nodes.Create(m_names.size());
+    if (!namePrefix.empty())
+    {
+        for (uint32_t i = 0; i < m_names.size(); i++)
+        {
+            Names::Add(namePrefix + m_names[i], nodes.Get(i));
+        }
+    }
+    return nodes;
+}
+
+NetDeviceContainer
+TopologyGraph::InstallLinks(const NodeContainer& nodes, InstallLinkCallback install) const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_UNLESS(nodes.GetN() == m_names.size(),
+                        "TopologyGraph::InstallLinks(): the graph has "
+                            << m_names.size() << " nodes, not " << nodes.GetN());
+    NetDeviceContainer devices;
+    for (const auto& edge : m_edges)
+    {
+        devices.Add(install(nodes.Get(edge.from), nodes.Get(edge.to)));
+    }
+    return devices;
+}
+
+} /* namespace ns3 */
@@ -0,0 +1,167 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TOPOLOGY_GRAPH_H
+#define TOPOLOGY_GRAPH_H
+
+#include "ns3/callback.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup topology
+ * ns3::TopologyGraph declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup topology
+ *
+ * @brief Compact graph of a topology read from a file.
+ *
+ * The nodes of the graph are numbered from 0 in the order they first appear
+ * in the file, and only their names are stored. The edges are stored in an
+ * array of pairs of node numbers, in the order of the file, with their
+ * weight, if any. The weights are also kept as written in the file when
+ * they are not written in their shortest form, such as "1.50". Unlike TopologyReader::Read(), building the graph creates
+ * no Node nor TopologyReader::Link object, so that large topologies can be
+ * loaded and inspected cheaply, then instantiated in bulk with
+ * CreateNodes() and InstallLinks().
+ */
+class TopologyGraph
+{
+  public:
+    /// Edge of the graph
+    struct Edge
+    {
+        uint32_t from; //!< number of the node the edge originates from
+        uint32_t to;   //!< number of the node the edge is directed to
+        double weight; //!< weight of the edge, NaN if it has none
+    };
+
+    /**
+     * @brief Callback installing a link between two nodes, such as a lambda
+     * calling PointToPointHelper::Install(), and returning its devices.
+     */
+    typedef Callback<NetDeviceContainer, Ptr<Node>, Ptr<Node>> InstallLinkCallback;
+
+    /**
+     * @brief Add a node, unless a node with this name already exists.
+     * @param [in] name The name of the node in the topology file.
+     * @return The number of the node.
+     */
+    uint32_t AddNode(std::string_view name);
+
+    /**
+     * @brief Find a node by name.
+     * @param [in] name The name of the node in the topology file.
+     * @param [out] node The number of the node, if found.
+     * @return True if the node exists.
+     */
+    bool FindNode(std::string_view name, uint32_t& node) const;
+
+    /**
+     * @brief Add an edge between two nodes.
+     * @param [in] from The number of the node the edge originates from.
+     * @param [in] to The number of the node the edge is directed to.
+     * @param [in] weight The weight of the edge, NaN if it has none.
+     * @param [in] weightText The weight as written in the topology file, or
+     * an empty string if it is the shortest text of the weight.
+     */
+    void AddEdge(uint32_t from, uint32_t to, double weight, std::string_view weightText = {});
+
+    /**
+     * @brief Add the edges of another graph.
+     * @param [in] graph The other graph.
+     * @param [in] nodes The numbers in this graph of the nodes of the other graph.
+     */
+    void AddEdges(const TopologyGraph& graph, const std::vector<uint32_t>& nodes);
+
+    /**
+     * @return The number of nodes.
+     */
+    uint32_t GetNNodes() const;
+
+    /**
+     * @param [in] node The number of the node.
+     * @return The name of the node in the topology file.
+     */
+    const std::string& GetNodeName(uint32_t node) const;
+
+    /**
+     * @return The number of edges.
+     */
+    uint32_t GetNEdges() const;
+
+    /**
+     * @param [in] i The index of the edge.
+     * @return The edge.
+     */
+    const Edge& GetEdge(uint32_t i) const;
+
+    /**
+     * @return The edges, in the order of the topology file.
+     */
+    const std::vector<Edge>& GetEdges() const;
+
+    /**
+     * @param [in] i The index of the edge.
+     * @return The weight of the edge as written in the topology file, or an
+     * empty string if it has none.
+     */
+    std::string GetWeightText(uint32_t i) const;
+
+    /**
+     * @brief Remove the edges whose reverse edge precedes them, so that a
+     * single edge remains between two nodes linked in both directions.
+     */
+    void RemoveReverseEdges();
+
+    /**
+     * @brief Remove all the nodes and edges.
+     */
+    void Clear();
+
+    /**
+     * @brief Create a Node for each node of the graph, in the order of their
+     * numbers.
+     *
+     * Naming a large number of nodes with Names::Add() is slow, so that the
+     * nodes are only named if a prefix is given.
+     *
+     * @param [in] namePrefix The prefix of the name given to each node, followed
+     * by its name in the topology file, or an empty string not to name the nodes.
+     * @return The nodes created, the i-th node being node number i.
+     */
+    NodeContainer CreateNodes(const std::string& namePrefix = "") const;
+
+    /**
+     * @brief Install a link between the nodes of each edge.
+     * @param [in] nodes The nodes created by CreateNodes().
+     * @param [in] install The callback installing a link between two nodes.
+     * @return The devices of all the links, in the order of the edges.
+     */
+    NetDeviceContainer InstallLinks(const NodeContainer& nodes, InstallLinkCallback install) const;
+
+  private:
+    std::deque<std::string> m_names;                        //!< Names of the nodes, by number.
+    std::unordered_map<std::string_view, uint32_t> m_nodes; //!< Numbers of the nodes, by name.
+    std::vector<Edge> m_edges;                              //!< The edges.
+    /// Weights of the edges not written in their shortest form, by index of the edge
+    std::unordered_map<uint32_t, std::string> m_weightTexts;
+};
+
+} // namespace ns3
+
+#endif /* TOPOLOGY_GRAPH_H */
@@ -10,6 +10,14 @@
 #include "topology-reader.h"
 
 #include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <thread>
 
 /**
  * @file
@@ -24,11 +32,25 @@ NS_LOG_COMPONENT_DEFINE("TopologyReader");
 
 NS_OBJECT_ENSURE_REGISTERED(TopologyReader);
 
+/**
+ * Minimum size of the chunks of a file parsed by different threads, in bytes:
+ * smaller chunks are parsed faster than a thread is started.
+ */
+static const std::size_t MIN_CHUNK_SIZE = 64 * 1024;
+
 TypeId
 TopologyReader::GetTypeId()
 {
     static TypeId tid =
-        TypeId("ns3::TopologyReader").SetParent<Object>().SetGroupName("TopologyReader");
+        TypeId("ns3::TopologyReader")
+            .SetParent<Object>()
+            .SetGroupName("TopologyReader")
+            .AddAttribute("ParserThreads",
+                          "The maximum number of threads parsing the lines of a large "
+                          "topology file, 0 for the number of hardware threads.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&TopologyReader::m_parserThreads),
+                          MakeUintegerChecker<uint32_t>());
     return tid;
 }
 
@@ -54,6 +76,190 @@ TopologyReader::GetFileName() const
     return m_fileName;
 }
 
+TopologyGraph
+TopologyReader::ReadGraph()
+{
+    NS_LOG_WARN(GetInstanceTypeId().GetName() << " cannot build a topology graph");
+    return TopologyGraph();
+}
+
+bool
+TopologyReader::ReadFile(std::string& contents) const
+{
+    NS_LOG_FUNCTION(this);
+    std::ifstream file(m_fileName, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    if (size < 0)
+    {
+        return false;
+    }
+    file.seekg(0, std::ios::beg);
+    contents.resize(size);
+    file.read(contents.data(), size);
+    return !file.fail();
+}
+
+void
+TopologyReader::ParseEdgeLines(std::string_view text,
+                               LineParser parser,
+                               uint64_t maxLines,
+                               TopologyGraph& graph) const
+{
+    NS_LOG_FUNCTION(this << text.size() << maxLines);
+
+    // Keep the first lines only, which is much faster than parsing them
+    text = text.substr(0, GetLineOffset(text, maxLines));
+
+    // Split the text into chunks of whole lines, one per thread
+    uint32_t nThreads = m_parserThreads;
+    if (nThreads == 0)
+    {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+    std::size_t nChunks = std::clamp<std::size_t>(text.size() / MIN_CHUNK_SIZE, 1, nThreads);
+    std::vector<std::string_view> chunks;
+    std::size_t begin = 0;
+    for (std::size_t i = 1; i <= nChunks && begin < text.size(); i++)
+    {
+        std::size_t end = text.size();
+        if (i < nChunks)
+        {
+            end = text.find('\n', std::max(begin, text.size() * i / nChunks));
+            end = (end == std::string_view::npos) ? text.size() : end + 1;
+        }
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    NS_LOG_INFO("Parsing " << text.size() << " bytes in " << chunks.size() << " chunks");
+
+    // The first chunk is parsed into the graph, and each other chunk by its
+    // own thread into a graph of its own, whose nodes are numbered in the
+    // order they first appear in the chunk. Nothing is logged by the
+    // threads, as logging is not thread-safe.
+    std::vector<TopologyGraph> graphs(chunks.size());
+    std::vector<char> stopped(chunks.size(), false); // not vector<bool>, written concurrently
+    std::vector<std::string_view> invalidLines(chunks.size());
+    auto parseChunk = [&](std::size_t i, TopologyGraph& chunkGraph) {
+        std::string_view chunk = chunks[i];
+        while (!chunk.empty())
+        {
+            std::size_t eol = chunk.find('\n');
+            std::string_view line = chunk.substr(0, eol);
+            chunk.remove_prefix(eol == std::string_view::npos ? chunk.size() : eol + 1);
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+            ParsedEdge edge;
+            LineType type = parser(line, edge);
+            if (type == LINE_STOP)
+            {
+                stopped[i] = true;
+                invalidLines[i] = line;
+                break;
+            }
+            if (type == LINE_EDGE)
+            {
+                uint32_t from = chunkGraph.AddNode(edge.from);
+                uint32_t to = chunkGraph.AddNode(edge.to);
+                chunkGraph.AddEdge(from, to, edge.weight, edge.weightText);
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < chunks.size(); i++)
+    {
+        threads.emplace_back(parseChunk, i, std::ref(graphs[i]));
+    }
+    if (!chunks.empty())
+    {
+        parseChunk(0, graph);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Add the nodes and edges of the other chunks, up to the first invalid
+    // line: adding the nodes of each chunk in order numbers the nodes in the
+    // order they first appear in the text
+    for (std::size_t i = 0; i < chunks.size(); i++)
+    {
+        if (i > 0)
+        {
+            std::vector<uint32_t> nodes(graphs[i].GetNNodes());
+            for (uint32_t j = 0; j < nodes.size(); j++)
+            {
+                nodes[j] = graph.AddNode(graphs[i].GetNodeName(j));
+            }
+            graph.AddEdges(graphs[i], nodes);
+        }
+        if (stopped[i])
+        {
+            NS_LOG_WARN("Invalid line, parsing stopped: " << invalidLines[i]);
+            break;
+        }
+    }
+}
+
+std::size_t
+TopologyReader::GetLineOffset(std::string_view text, uint64_t line)
+{
+    std::size_t offset = 0;
+    for (uint64_t i = 0; i < line && offset < text.size(); i++)
+    {
+        offset = text.find('\n', offset);
+        offset = (offset == std::string_view::npos) ? text.size() : offset + 1;
+    }
+    return offset;
+}
+
+uint32_t
+TopologyReader::Tokenize(std::string_view line, std::string_view* tokens, uint32_t maxTokens)
+{
+    uint32_t n = 0;
+    std::size_t begin = line.find_first_not_of(" \t");
+    while (n < maxTokens && begin != std::string_view::npos)
+    {
+        std::size_t end = line.find_first_of(" \t", begin);
+        tokens[n++] = line.substr(begin, end - begin);
+        begin = line.find_first_not_of(" \t", end);
+    }
+    return n;
+}
+
+bool
+TopologyReader::ParseWeight(std::string_view token, double& weight)
+{
+    const char* end = token.data() + token.size();
+    auto [ptr, ec] = std::from_chars(token.data(), end, weight);
+    return ec == std::errc() && ptr == end;
+}
+
+void
+TopologyReader::AddLinks(const TopologyGraph& graph, const NodeContainer& nodes)
+{
+    NS_LOG_FUNCTION(this);
+    for (uint32_t i = 0; i < graph.GetNEdges(); i++)
+    {
+        const TopologyGraph::Edge& edge = graph.GetEdge(i);
+        Link link(nodes.Get(edge.from),
+                  graph.GetNodeName(edge.from),
+                  nodes.Get(edge.to),
+                  graph.GetNodeName(edge.to));
+        if (!std::isnan(edge.weight))
+        {
+            link.SetAttribute("Weight", graph.GetWeightText(i));
+        }
+        AddLink(link);
+    }
+}
+
 /* Manipulating the address block */
 
 TopologyReader::ConstLinksIterator
@@ -10,12 +10,16 @@
 #ifndef TOPOLOGY_READER_H
 #define TOPOLOGY_READER_H
 
+#include "topology-graph.h"
+
 #include "ns3/node.h"
 #include "ns3/object.h"
 
 #include <list>
 #include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
 /**
  * @file
@@ -158,6 +162,21 @@ class TopologyReader : public Object
      */
     virtual NodeContainer Read() = 0;
 
+    /**
+     * @brief Topology reading function building a graph only.
+     *
+     * The file is parsed into a compact graph of node numbers, without
+     * creating any Node nor Link, and without adding any link to this reader.
+     * The nodes and the links can then be created in bulk with
+     * TopologyGraph::CreateNodes() and TopologyGraph::InstallLinks().
+     *
+     * The default implementation warns that the reader does not support it and
+     * returns an empty graph.
+     *
+     * @return The graph of the topology (empty if there was an error).
+     */
+    virtual TopologyGraph ReadGraph();
+
     /**
      * @brief Sets the input file name.
      * @param [in] fileName The input file name.
@@ -200,7 +219,100 @@ class TopologyReader : public Object
      */
     void AddLink(Link link);
 
+  protected:
+    /**
+     * @brief Type of a line of a topology file.
+     */
+    enum LineType
+    {
+        LINE_EDGE, //!< The line describes an edge.
+        LINE_SKIP, //!< The line is ignored.
+        LINE_STOP  //!< The line is invalid, and the parsing stops before it.
+    };
+
+    /**
+     * @brief Edge parsed from a line of a topology file, viewing the names of
+     * its nodes in the line.
+     */
+    struct ParsedEdge
+    {
+        std::string_view from; //!< Name of the node the edge originates from.
+        std::string_view to;   //!< Name of the node the edge is directed to.
+        double weight;         //!< Weight of the edge, NaN if it has none.
+        std::string_view weightText; //!< Weight of the edge as written in the line.
+    };
+
+    /**
+     * @brief Function parsing a line, without its end of line, of a topology file.
+     */
+    typedef LineType (*LineParser)(std::string_view line, ParsedEdge& edge);
+
+    /**
+     * @brief Reads the whole input file at once.
+     * @param [out] contents The contents of the file.
+     * @return True if the file could be read.
+     */
+    bool ReadFile(std::string& contents) const;
+
+    /**
+     * @brief Parses lines of edges into a graph.
+     *
+     * Large texts are split into chunks of whole lines which are parsed by
+     * several threads (see the ParserThreads attribute); the nodes and edges
+     * are added to the graph in the order of the lines nonetheless.
+     *
+     * @param [in] text The lines.
+     * @param [in] parser The function parsing a line.
+     * @param [in] maxLines The maximum number of lines parsed.
+     * @param [in,out] graph The graph the nodes and edges are added to.
+     */
+    void ParseEdgeLines(std::string_view text,
+                        LineParser parser,
+                        uint64_t maxLines,
+                        TopologyGraph& graph) const;
+
+    /**
+     * @brief Finds the beginning of a line.
+     * @param [in] text The lines.
+     * @param [in] line The number of the line, from 0.
+     * @return The offset of the line in text, or the size of text if it has fewer lines.
+     */
+    static std::size_t GetLineOffset(std::string_view text, uint64_t line);
+
+    /**
+     * @brief Splits a line into tokens separated by spaces and tabs.
+     * @param [in] line The line.
+     * @param [out] tokens The first tokens of the line.
+     * @param [in] maxTokens The maximum number of tokens extracted.
+     * @return The number of tokens extracted.
+     */
+    static uint32_t Tokenize(std::string_view line, std::string_view* tokens, uint32_t maxTokens);
+
+    /**
+     * @brief Parses the weight of an edge.
+     * @param [in] token The weight.
+     * @param [out] weight The value of the weight.
+     * @return True if the whole token is a number.
+     */
+    static bool ParseWeight(std::string_view token, double& weight);
+
+    /**
+     * @brief Adds a link for each edge of a graph.
+     *
+     * The links have a "Weight" attribute if their edge has a weight, as
+     * written in the topology file.
+     *
+     * @param [in] graph The graph.
+     * @param [in] nodes The nodes created from the graph by TopologyGraph::CreateNodes().
+     */
+    void AddLinks(const TopologyGraph& graph, const NodeContainer& nodes);
+
   private:
+    /**
+     * The maximum number of threads parsing a file, 0 for the number of hardware threads.
+     */
+    uint32_t m_parserThreads;
+
     /**
      * The name of the input file.
      */
@@ -0,0 +1,113 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/inet-topology-reader.h"
+#include "ns3/names.h"
+#include "ns3/node-container.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup topology-test
+ * ns3::InetTopologyReader test suite.
+ */
+
+using namespace ns3;
+
+/**
+ * @ingroup topology-test
+ *
+ * @brief Inet Topology Reader Node Names Test
+ *
+ * The nodes first seen as the origin of a link are named after their number,
+ * the nodes first seen as the destination of a link are named
+ * "InetTopology/NodeName/<number>", which is their number as well unless
+ * "InetTopology/NodeName" names an object.
+ */
+class InetTopologyReaderNamesTest : public TestCase
+{
+  public:
+    InetTopologyReaderNamesTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Read the Inet sample file and check the names of its nodes.
+     * @param [in] prefix The path the nodes first seen as the destination of
+     * a link are named in.
+     */
+    void CheckNames(const std::string& prefix);
+};
+
+InetTopologyReaderNamesTest::InetTopologyReaderNamesTest()
+    : TestCase("Check the names of the nodes read from an Inet file")
+{
+}
+
+void
+InetTopologyReaderNamesTest::CheckNames(const std::string& prefix)
+{
+    Ptr<InetTopologyReader> inFile = CreateObject<InetTopologyReader>();
+    inFile->SetFileName("./src/topology-read/examples/Inet_small_toposample.txt");
+    NodeContainer nodes = inFile->Read();
+    NS_TEST_ASSERT_MSG_EQ(nodes.GetN(), 10, "nodes");
+
+    // The nodes in the order they first appear in the links: only node 0
+    // first appears as the origin of a link, the others as its destination
+    const std::vector<std::string> names = {"0", "1", "2", "3", "5", "6", "9", "8", "7", "4"};
+    for (uint32_t i = 0; i < names.size(); i++)
+    {
+        std::string name = (i == 0) ? names[i] : prefix + names[i];
+        NS_TEST_EXPECT_MSG_EQ(Names::Find<Node>(name), nodes.Get(i), "node named " << name);
+        NS_TEST_EXPECT_MSG_EQ(Names::FindName(nodes.Get(i)), names[i], "name of node " << i);
+    }
+}
+
+void
+InetTopologyReaderNamesTest::DoRun()
+{
+    // "InetTopology/NodeName" does not name an object: all the nodes are
+    // named after their number
+    CheckNames("");
+    Names::Clear();
+
+    // The nodes first seen as the destination of a link are named in
+    // "InetTopology/NodeName"
+    Names::Add("InetTopology", CreateObject<Node>());
+    Names::Add("InetTopology/NodeName", CreateObject<Node>());
+    CheckNames("InetTopology/NodeName/");
+    NS_TEST_EXPECT_MSG_EQ(Names::Find<Node>("5"), nullptr, "node 5 named without prefix");
+
+    Names::Clear();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup topology-test
+ *
+ * @brief Inet Topology Reader TestSuite
+ */
+class InetTopologyReaderTestSuite : public TestSuite
+{
+  public:
+    InetTopologyReaderTestSuite();
+};
+
+InetTopologyReaderTestSuite::InetTopologyReaderTestSuite()
+    : TestSuite("inet-topology-reader", Type::UNIT)
+{
+    AddTestCase(new InetTopologyReaderNamesTest(), TestCase::Duration::QUICK);
+}
+
+/**
+ * @ingroup topology-test
+ * Static variable for test initialization
+ */
+static InetTopologyReaderTestSuite g_inetTopologyReaderTestSuite;
@@ -0,0 +1,275 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/inet-topology-reader.h"
+#include "ns3/log.h"
+#include "ns3/names.h"
+#include "ns3/node-container.h"
+#include "ns3/orbis-topology-reader.h"
+#include "ns3/rocketfuel-topology-reader.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+/**
+ * @file
+ * @ingroup topology-test
+ * ns3::TopologyGraph test suite.
+ */
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TopologyGraphTestSuite");
+
+/**
+ * @ingroup topology-test
+ *
+ * @brief Inet Topology Reader Graph Test
+ */
+class InetTopologyGraphTest : public TestCase
+{
+  public:
+    InetTopologyGraphTest();
+
+  private:
+    void DoRun() override;
+};
+
+InetTopologyGraphTest::InetTopologyGraphTest()
+    : TestCase("Check the graph read from an Inet file and the nodes and links created from it")
+{
+}
+
+void
+InetTopologyGraphTest::DoRun()
+{
+    Ptr<InetTopologyReader> inFile = CreateObject<InetTopologyReader>();
+    inFile->SetFileName("./src/topology-read/examples/Inet_small_toposample.txt");
+
+    TopologyGraph graph = inFile->ReadGraph();
+    NS_TEST_ASSERT_MSG_EQ(graph.GetNNodes(), 10, "nodes");
+    NS_TEST_ASSERT_MSG_EQ(graph.GetNEdges(), 9, "links");
+    NS_TEST_EXPECT_MSG_EQ(inFile->LinksSize(), 0, "ReadGraph() should not add any link");
+
+    // The nodes are numbered in the order they first appear in the links
+    NS_TEST_EXPECT_MSG_EQ(graph.GetNodeName(0), "0", "node 0");
+    NS_TEST_EXPECT_MSG_EQ(graph.GetNodeName(4), "5", "node 4");
+    NS_TEST_EXPECT_MSG_EQ(graph.GetNodeName(9), "4", "node 9");
+    uint32_t node;
+    NS_TEST_EXPECT_MSG_EQ(graph.FindNode("7", node), true, "node 7 should exist");
+    NS_TEST_EXPECT_MSG_EQ(node, 8, "node 7");
+    NS_TEST_EXPECT_MSG_EQ(graph.FindNode("10", node), false, "node 10 should not exist");
+    NS_TEST_EXPECT_MSG_EQ(graph.GetEdge(7).from, 2, "link 7");
+    NS_TEST_EXPECT_MSG_EQ(graph.GetEdge(7).to, 8, "link 7");
+    NS_TEST_EXPECT_MSG_EQ(graph.GetEdge(7).weight, 10589, "link 7");
+
+    // The nodes and links created in bulk
+    NodeContainer nodes = graph.CreateNodes();
+    SimpleNetDeviceHelper simple;
+    NetDeviceContainer devices = graph.InstallLinks(nodes, [&](Ptr<Node> from, Ptr<Node> to) {
+        return simple.Install(NodeContainer(from, to));
+    });
+    NS_TEST_EXPECT_MSG_EQ(nodes.GetN(), 10, "nodes");
+    NS_TEST_EXPECT_MSG_EQ(devices.GetN(), 18, "devices");
+    NS_TEST_EXPECT_MSG_EQ(nodes.Get(0)->GetNDevices(), 6, "devices of node 0");
+    NS_TEST_EXPECT_MSG_EQ(devices.Get(14)->GetNode(), nodes.Get(2), "devices of link 7");
+    NS_TEST_EXPECT_MSG_EQ(devices.Get(15)->GetNode(), nodes.Get(8), "devices of link 7");
+
+    // The nodes and links created by Read() are those of the graph
+    nodes = inFile->Read();
+    NS_TEST_ASSERT_MSG_EQ(nodes.GetN(), 10, "nodes");
+    NS_TEST_ASSERT_MSG_EQ(inFile->LinksSize(), 9, "links");
+    uint32_t i = 0;
+    for (auto link = inFile->LinksBegin(); link != inFile->LinksEnd(); link++, i++)
+    {
+        const TopologyGraph::Edge& edge = graph.GetEdge(i);
+        NS_TEST_EXPECT_MSG_EQ(link->GetFromNode(), nodes.Get(edge.from), "link " << i);
+        NS_TEST_EXPECT_MSG_EQ(link->GetFromNodeName(), graph.GetNodeName(edge.from), "link " << i);
+        NS_TEST_EXPECT_MSG_EQ(link->GetToNode(), nodes.Get(edge.to), "link " << i);
+        NS_TEST_EXPECT_MSG_EQ(link->GetToNodeName(), graph.GetNodeName(edge.to), "link " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(inFile->LinksBegin()->GetAttribute("Weight"), "1973", "link 0");
+    NS_TEST_EXPECT_MSG_EQ(Names::FindName(nodes.Get(9)), "4", "name of node 9");
+
+    Names::Clear();
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup topology-test
+ *
+ * @brief Topology Reader Parallel Parsing Test
+ *
+ * Large files are parsed by several threads: check that the graph is the
+ * same as when the file is parsed by a single thread.
+ */
+class TopologyReaderParallelTest : public TestCase
+{
+  public:
+    TopologyReaderParallelTest();
+
+  private:
+    void DoSetup() override;
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Read a graph with a number of threads.
+     * @param reader the reader
+     * @param threads the number of threads
+     * @return the graph
+     */
+    static TopologyGraph ReadGraph(Ptr<TopologyReader> reader, uint32_t threads);
+
+    /**
+     * Check that two graphs are the same.
+     * @param graph the graph
+     * @param expected the expected graph
+     */
+    void CheckGraph(const TopologyGraph& graph, const TopologyGraph& expected);
+
+    std::string m_orbisFilename;      //!< Orbis file name
+    std::string m_rocketfuelFilename; //!< Rocketfuel weights file name
+};
+
+TopologyReaderParallelTest::TopologyReaderParallelTest()
+    : TestCase("Check that large topology files are parsed in parallel correctly")
+{
+}
+
+void
+TopologyReaderParallelTest::DoSetup()
+{
+    m_orbisFilename = CreateTempDirFilename("orbis.txt");
+    m_rocketfuelFilename = CreateTempDirFilename("rocketfuel-weights.txt");
+
+    // Random links, with lines that are not links
+    std::ofstream orbis(m_orbisFilename);
+    uint32_t seed = 1;
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        orbis << (seed >> 16) % 5000 << "\t" << (seed >> 8) % 5000 << "\n";
+        if (i % 10000 == 5000)
+        {
+            orbis << "\n" << i << "\n";
+        }
+    }
+    orbis << "last link";
+
+    // A chain of links, with an invalid line in the middle, and half of the
+    // weights not written in their shortest form
+    std::ofstream rocketfuel(m_rocketfuelFilename);
+    for (uint32_t i = 0; i < 50000; i++)
+    {
+        if (i == 30000)
+        {
+            rocketfuel << "invalid line\n";
+        }
+        rocketfuel << "Router-" << i << " Router-" << i + 1 << "  " << i % 7
+                   << (i % 2 ? ".5\n" : ".50\n");
+    }
+}
+
+void
+TopologyReaderParallelTest::DoTeardown()
+{
+    for (const auto& filename : {m_orbisFilename, m_rocketfuelFilename})
+    {
+        if (remove(filename.c_str()))
+        {
+            NS_LOG_ERROR("Failed to delete file " << filename);
+        }
+    }
+}
+
+TopologyGraph
+TopologyReaderParallelTest::ReadGraph(Ptr<TopologyReader> reader, uint32_t threads)
+{
+    reader->SetAttribute("ParserThreads", UintegerValue(threads));
+    return reader->ReadGraph();
+}
+
+void
+TopologyReaderParallelTest::CheckGraph(const TopologyGraph& graph, const TopologyGraph& expected)
+{
+    NS_TEST_ASSERT_MSG_EQ(graph.GetNNodes(), expected.GetNNodes(), "nodes");
+    NS_TEST_ASSERT_MSG_EQ(graph.GetNEdges(), expected.GetNEdges(), "links");
+    for (uint32_t i = 0; i < graph.GetNNodes(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(graph.GetNodeName(i), expected.GetNodeName(i), "node " << i);
+    }
+    for (uint32_t i = 0; i < graph.GetNEdges(); i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(graph.GetEdge(i).from, expected.GetEdge(i).from, "link " << i);
+        NS_TEST_ASSERT_MSG_EQ(graph.GetEdge(i).to, expected.GetEdge(i).to, "link " << i);
+        NS_TEST_ASSERT_MSG_EQ(graph.GetWeightText(i), expected.GetWeightText(i), "link " << i);
+    }
+}
+
+void
+TopologyReaderParallelTest::DoRun()
+{
+    Ptr<OrbisTopologyReader> orbis = CreateObject<OrbisTopologyReader>();
+    orbis->SetFileName(m_orbisFilename);
+    TopologyGraph expected = ReadGraph(orbis, 1);
+    NS_TEST_ASSERT_MSG_EQ(expected.GetNEdges(), 100001, "links");
+    NS_TEST_EXPECT_MSG_EQ(expected.GetNodeName(expected.GetEdge(100000).to), "link", "last link");
+    CheckGraph(ReadGraph(orbis, 4), expected);
+    CheckGraph(ReadGraph(orbis, 7), expected);
+
+    Ptr<RocketfuelTopologyReader> rocketfuel = CreateObject<RocketfuelTopologyReader>();
+    rocketfuel->SetFileName(m_rocketfuelFilename);
+    expected = ReadGraph(rocketfuel, 1);
+    NS_TEST_ASSERT_MSG_EQ(expected.GetNEdges(), 30000, "links before the invalid line");
+    NS_TEST_EXPECT_MSG_EQ(expected.GetEdge(29999).weight, 4.5, "weight of the last link");
+    NS_TEST_EXPECT_MSG_EQ(expected.GetWeightText(29998), "3.50", "weight as written");
+    NS_TEST_EXPECT_MSG_EQ(expected.GetWeightText(29999), "4.5", "weight as written");
+    CheckGraph(ReadGraph(rocketfuel, 4), expected);
+    CheckGraph(ReadGraph(rocketfuel, 7), expected);
+
+    // The weights as written follow their edges when the reverse edges are removed
+    TopologyGraph graph;
+    uint32_t a = graph.AddNode("a");
+    uint32_t b = graph.AddNode("b");
+    uint32_t c = graph.AddNode("c");
+    graph.AddEdge(a, b, 1.5, "1.50");
+    graph.AddEdge(b, a, 2, "2.0");
+    graph.AddEdge(b, c, 1e3, "1e3");
+    graph.AddEdge(c, a, std::numeric_limits<double>::quiet_NaN());
+    graph.RemoveReverseEdges();
+    NS_TEST_ASSERT_MSG_EQ(graph.GetNEdges(), 3, "links without the reverse edges");
+    NS_TEST_EXPECT_MSG_EQ(graph.GetWeightText(0), "1.50", "weight of link a-b");
+    NS_TEST_EXPECT_MSG_EQ(graph.GetWeightText(1), "1e3", "weight of link b-c");
+    NS_TEST_EXPECT_MSG_EQ(graph.GetWeightText(2), "", "link c-a has no weight");
+}
+
+/**
+ * @ingroup topology-test
+ *
+ * @brief Topology Graph TestSuite
+ */
+class TopologyGraphTestSuite : public TestSuite
+{
+  public:
+    TopologyGraphTestSuite();
+};
+
+TopologyGraphTestSuite::TopologyGraphTestSuite()
+    : TestSuite("topology-graph", Type::UNIT)
+{
+    AddTestCase(new InetTopologyGraphTest(), TestCase::Duration::QUICK);
+    AddTestCase(new TopologyReaderParallelTest(), TestCase::Duration::QUICK);
+}
+
+/**
+ * @ingroup topology-test
+ * Static variable for test initialization
+ */
+static TopologyGraphTestSuite g_topologyGraphTestSuite;
@@ -16,13 +16,11 @@
 #ifndef FQ_COBALT_QUEUE_DISC
 #define FQ_COBALT_QUEUE_DISC
 
+#include "fq-flow-table.h"
 #include "queue-disc.h"
 
 #include "ns3/object-factory.h"
 
-#include <list>
-#include <map>
-
 namespace ns3
 {
 
@@ -179,11 +177,9 @@ class FqCobaltQueueDisc : public QueueDisc
     double m_Pdrop;       //!< Drop Probability
     Time m_blueThreshold; //!< Threshold to enable blue enhancement
 
-    std::list<Ptr<FqCobaltFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqCobaltFlow>> m_oldFlows; //!< The list of old flows
-
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    /// Table of the flow queues
+    typedef FqFlowTable<FqCobaltFlow> FlowTable;
+    FlowTable m_flowTable; //!< The flow queues, their tags and the lists of new and old flows
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
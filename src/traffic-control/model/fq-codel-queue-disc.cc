@@ -199,22 +199,19 @@ FqCoDelQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        const Ptr<FqCoDelFlow>& flow = m_flowTable.GetFlow(i);
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqCoDelFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqCoDelFlow::INACTIVE)
+        if (!flow || m_flowTable.HasTag(i, flowHash) || flow->GetStatus() == FqCoDelFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
-            m_tags[i] = flowHash;
+            m_flowTable.SetTag(i, flowHash);
             return i;
         }
     }
 
     // all the queues of the set are used. Use the first queue of the set
-    m_tags[outerHash] = flowHash;
+    m_flowTable.SetTag(outerHash, flowHash);
     return outerHash;
 }
 
@@ -255,8 +252,8 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         h = flowHash % m_flows;
     }
 
-    Ptr<FqCoDelFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    Ptr<FqCoDelFlow> flow = m_flowTable.GetFlow(h);
+    if (!flow)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqCoDelFlow>();
@@ -274,23 +271,19 @@ FqCoDelQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         flow->SetIndex(h);
         AddQueueDiscClass(flow);
 
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
-    }
-    else
-    {
-        flow = StaticCast<FqCoDelFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        m_flowTable.SetFlow(h, flow);
     }
 
     if (flow->GetStatus() == FqCoDelFlow::INACTIVE)
     {
         flow->SetStatus(FqCoDelFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_flowTable.PushBack(FlowTable::NEW_FLOWS, h);
     }
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h);
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -313,16 +306,16 @@ FqCoDelQueueDisc::DoDequeue()
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_flowTable.IsEmpty(FlowTable::NEW_FLOWS))
         {
-            flow = m_newFlows.front();
+            flow = m_flowTable.GetFront(FlowTable::NEW_FLOWS);
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.splice(m_oldFlows.end(), m_newFlows, m_newFlows.begin());
+                m_flowTable.MoveFront(FlowTable::NEW_FLOWS, FlowTable::OLD_FLOWS);
             }
             else
             {
@@ -331,15 +324,15 @@ FqCoDelQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_flowTable.IsEmpty(FlowTable::OLD_FLOWS))
         {
-            flow = m_oldFlows.front();
+            flow = m_flowTable.GetFront(FlowTable::OLD_FLOWS);
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.splice(m_oldFlows.end(), m_oldFlows, m_oldFlows.begin());
+                m_flowTable.MoveFront(FlowTable::OLD_FLOWS, FlowTable::OLD_FLOWS);
             }
             else
             {
@@ -359,16 +352,15 @@ FqCoDelQueueDisc::DoDequeue()
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_flowTable.IsEmpty(FlowTable::NEW_FLOWS))
             {
                 flow->SetStatus(FqCoDelFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_flowTable.MoveFront(FlowTable::NEW_FLOWS, FlowTable::OLD_FLOWS);
             }
             else
             {
                 flow->SetStatus(FqCoDelFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_flowTable.PopFront(FlowTable::OLD_FLOWS);
             }
         }
         else
@@ -442,6 +434,8 @@ FqCoDelQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
+    m_flowTable.SetSize(m_flows);
+
     m_flowFactory.SetTypeId("ns3::FqCoDelFlow");
 
     m_queueDiscFactory.SetTypeId("ns3::CoDelQueueDisc");
@@ -10,13 +10,11 @@
 #ifndef FQ_CODEL_QUEUE_DISC
 #define FQ_CODEL_QUEUE_DISC
 
+#include "fq-flow-table.h"
 #include "queue-disc.h"
 
 #include "ns3/object-factory.h"
 
-#include <list>
-#include <map>
-
 namespace ns3
 {
 
@@ -169,11 +167,9 @@ class FqCoDelQueueDisc : public QueueDisc
     bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
     bool m_useL4s; //!< True if L4S is used (ECT1 packets are marked at CE threshold)
 
-    std::list<Ptr<FqCoDelFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqCoDelFlow>> m_oldFlows; //!< The list of old flows
-
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    /// Table of the flow queues
+    typedef FqFlowTable<FqCoDelFlow> FlowTable;
+    FlowTable m_flowTable; //!< The flow queues, their tags and the lists of new and old flows
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
@@ -0,0 +1,237 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef FQ_FLOW_TABLE_H
+#define FQ_FLOW_TABLE_H
+
+#include "ns3/assert.h"
+#include "ns3/ptr.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup traffic-control
+ *
+ * @brief Table of the flow queues of a flow queueing queue disc (FqCoDel,
+ * FqCobalt, FqPie), with the lists of new and old flows of its deficit round
+ * robin scheduler.
+ *
+ * The flow queues are stored in an array indexed by the index computed from
+ * the hash of their packets, together with the tags used by set associative
+ * hashing. The lists of new and old flows are linked through the entries of
+ * the array, so that finding the flow queue of a packet does not search a
+ * tree and moving a flow queue from a list to another does not allocate
+ * memory.
+ *
+ * @tparam Flow the class of the flow queues
+ */
+template <class Flow>
+class FqFlowTable
+{
+  public:
+    /// The lists of flow queues of the scheduler
+    enum FlowList
+    {
+        NEW_FLOWS = 0,
+        OLD_FLOWS = 1
+    };
+
+    /**
+     * @brief Set the number of flow queues, removing all the flow queues
+     * @param nFlows the number of flow queues
+     */
+    void SetSize(uint32_t nFlows);
+
+    /**
+     * @brief Get a flow queue
+     * @param index the index of the flow queue
+     * @return the flow queue, or a null pointer if it has not been created
+     */
+    const Ptr<Flow>& GetFlow(uint32_t index) const;
+
+    /**
+     * @brief Set a flow queue
+     * @param index the index of the flow queue
+     * @param flow the flow queue
+     */
+    void SetFlow(uint32_t index, Ptr<Flow> flow);
+
+    /**
+     * @brief Check the tag of a flow queue (used by set associative hash)
+     * @param index the index of the flow queue
+     * @param tag the tag
+     * @return true if the flow queue has this tag
+     */
+    bool HasTag(uint32_t index, uint32_t tag) const;
+
+    /**
+     * @brief Set the tag of a flow queue (used by set associative hash)
+     * @param index the index of the flow queue
+     * @param tag the tag
+     */
+    void SetTag(uint32_t index, uint32_t tag);
+
+    /**
+     * @param list the list
+     * @return true if the list is empty
+     */
+    bool IsEmpty(FlowList list) const;
+
+    /**
+     * @param list the list, which must not be empty
+     * @return the flow queue at the front of the list
+     */
+    const Ptr<Flow>& GetFront(FlowList list) const;
+
+    /**
+     * @brief Append a flow queue, which must not be in a list, to a list
+     * @param list the list
+     * @param index the index of the flow queue
+     */
+    void PushBack(FlowList list, uint32_t index);
+
+    /**
+     * @brief Remove the flow queue at the front of a list
+     * @param list the list, which must not be empty
+     */
+    void PopFront(FlowList list);
+
+    /**
+     * @brief Move the flow queue at the front of a list to the back of a
+     * list, which may be the same list
+     * @param from the list, which must not be empty
+     * @param to the list the flow queue is appended to
+     */
+    void MoveFront(FlowList from, FlowList to);
+
+  private:
+    /// Marks the end of a list
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    /// Entry of the table
+    struct Entry
+    {
+        Ptr<Flow> flow; //!< the flow queue
+        uint32_t next;  //!< index of the next flow queue in its list
+        uint32_t tag;   //!< tag of the flow queue
+        bool tagged;    //!< true if the flow queue has a tag
+    };
+
+    std::vector<Entry> m_entries;   //!< the entries, indexed by flow queue index
+    uint32_t m_head[2]{NONE, NONE}; //!< index of the first flow queue of each list
+    uint32_t m_tail[2]{NONE, NONE}; //!< index of the last flow queue of each list
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <class Flow>
+void
+FqFlowTable<Flow>::SetSize(uint32_t nFlows)
+{
+    m_entries.assign(nFlows, Entry{nullptr, NONE, 0, false});
+    m_head[NEW_FLOWS] = m_head[OLD_FLOWS] = NONE;
+    m_tail[NEW_FLOWS] = m_tail[OLD_FLOWS] = NONE;
+}
+
+template <class Flow>
+const Ptr<Flow>&
+FqFlowTable<Flow>::GetFlow(uint32_t index) const
+{
+    NS_ASSERT(index < m_entries.size());
+    return m_entries[index].flow;
+}
+
+template <class Flow>
+void
+FqFlowTable<Flow>::SetFlow(uint32_t index, Ptr<Flow> flow)
+{
+    NS_ASSERT(index < m_entries.size());
+    m_entries[index].flow = flow;
+}
+
+template <class Flow>
+bool
+FqFlowTable<Flow>::HasTag(uint32_t index, uint32_t tag) const
+{
+    NS_ASSERT(index < m_entries.size());
+    return m_entries[index].tagged && m_entries[index].tag == tag;
+}
+
+template <class Flow>
+void
+FqFlowTable<Flow>::SetTag(uint32_t index, uint32_t tag)
+{
+    NS_ASSERT(index < m_entries.size());
+    m_entries[index].tag = tag;
+    m_entries[index].tagged = true;
+}
+
+template <class Flow>
+bool
+FqFlowTable<Flow>::IsEmpty(FlowList list) const
+{
+    return m_head[list] == NONE;
+}
+
+template <class Flow>
+const Ptr<Flow>&
+FqFlowTable<Flow>::GetFront(FlowList list) const
+{
+    NS_ASSERT(m_head[list] != NONE);
+    return m_entries[m_head[list]].flow;
+}
+
+template <class Flow>
+void
+FqFlowTable<Flow>::PushBack(FlowList list, uint32_t index)
+{
+    NS_ASSERT(index < m_entries.size());
+    NS_ASSERT_MSG(m_entries[index].next == NONE && m_tail[NEW_FLOWS] != index &&
+                      m_tail[OLD_FLOWS] != index,
+                  "The flow queue is already in a list");
+    if (m_tail[list] == NONE)
+    {
+        m_head[list] = index;
+    }
+    else
+    {
+        m_entries[m_tail[list]].next = index;
+    }
+    m_tail[list] = index;
+}
+
+template <class Flow>
+void
+FqFlowTable<Flow>::PopFront(FlowList list)
+{
+    NS_ASSERT(m_head[list] != NONE);
+    uint32_t index = m_head[list];
+    m_head[list] = m_entries[index].next;
+    if (m_head[list] == NONE)
+    {
+        m_tail[list] = NONE;
+    }
+    m_entries[index].next = NONE;
+}
+
+template <class Flow>
+void
+FqFlowTable<Flow>::MoveFront(FlowList from, FlowList to)
+{
+    NS_ASSERT(m_head[from] != NONE);
+    uint32_t index = m_head[from];
+    PopFront(from);
+    PushBack(to, index);
+}
+
+} // namespace ns3
+
+#endif /* FQ_FLOW_TABLE_H */
@@ -254,22 +254,19 @@ FqPieQueueDisc::SetAssociativeHash(uint32_t flowHash)
 
     for (uint32_t i = outerHash; i < outerHash + m_setWays; i++)
     {
-        auto it = m_flowsIndices.find(i);
+        const Ptr<FqPieFlow>& flow = m_flowTable.GetFlow(i);
 
-        if (it == m_flowsIndices.end() ||
-            (m_tags.find(i) != m_tags.end() && m_tags[i] == flowHash) ||
-            StaticCast<FqPieFlow>(GetQueueDiscClass(it->second))->GetStatus() ==
-                FqPieFlow::INACTIVE)
+        if (!flow || m_flowTable.HasTag(i, flowHash) || flow->GetStatus() == FqPieFlow::INACTIVE)
         {
             // this queue has not been created yet or is associated with this flow
             // or is inactive, hence we can use it
-            m_tags[i] = flowHash;
+            m_flowTable.SetTag(i, flowHash);
             return i;
         }
     }
 
     // all the queues of the set are used. Use the first queue of the set
-    m_tags[outerHash] = flowHash;
+    m_flowTable.SetTag(outerHash, flowHash);
     return outerHash;
 }
 
@@ -310,8 +307,8 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         h = flowHash % m_flows;
     }
 
-    Ptr<FqPieFlow> flow;
-    if (m_flowsIndices.find(h) == m_flowsIndices.end())
+    Ptr<FqPieFlow> flow = m_flowTable.GetFlow(h);
+    if (!flow)
     {
         NS_LOG_DEBUG("Creating a new flow queue with index " << h);
         flow = m_flowFactory.Create<FqPieFlow>();
@@ -329,23 +326,19 @@ FqPieQueueDisc::DoEnqueue(Ptr<QueueDiscItem> item)
         flow->SetIndex(h);
         AddQueueDiscClass(flow);
 
-        m_flowsIndices[h] = GetNQueueDiscClasses() - 1;
-    }
-    else
-    {
-        flow = StaticCast<FqPieFlow>(GetQueueDiscClass(m_flowsIndices[h]));
+        m_flowTable.SetFlow(h, flow);
     }
 
     if (flow->GetStatus() == FqPieFlow::INACTIVE)
     {
         flow->SetStatus(FqPieFlow::NEW_FLOW);
         flow->SetDeficit(m_quantum);
-        m_newFlows.push_back(flow);
+        m_flowTable.PushBack(FlowTable::NEW_FLOWS, h);
     }
 
     flow->GetQueueDisc()->Enqueue(item);
 
-    NS_LOG_DEBUG("Packet enqueued into flow " << h << "; flow index " << m_flowsIndices[h]);
+    NS_LOG_DEBUG("Packet enqueued into flow " << h);
 
     if (GetCurrentSize() > GetMaxSize())
     {
@@ -368,17 +361,16 @@ FqPieQueueDisc::DoDequeue()
     {
         bool found = false;
 
-        while (!found && !m_newFlows.empty())
+        while (!found && !m_flowTable.IsEmpty(FlowTable::NEW_FLOWS))
         {
-            flow = m_newFlows.front();
+            flow = m_flowTable.GetFront(FlowTable::NEW_FLOWS);
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for new flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
                 flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_flowTable.MoveFront(FlowTable::NEW_FLOWS, FlowTable::OLD_FLOWS);
             }
             else
             {
@@ -387,16 +379,15 @@ FqPieQueueDisc::DoDequeue()
             }
         }
 
-        while (!found && !m_oldFlows.empty())
+        while (!found && !m_flowTable.IsEmpty(FlowTable::OLD_FLOWS))
         {
-            flow = m_oldFlows.front();
+            flow = m_flowTable.GetFront(FlowTable::OLD_FLOWS);
 
             if (flow->GetDeficit() <= 0)
             {
                 NS_LOG_DEBUG("Increase deficit for old flow index " << flow->GetIndex());
                 flow->IncreaseDeficit(m_quantum);
-                m_oldFlows.push_back(flow);
-                m_oldFlows.pop_front();
+                m_flowTable.MoveFront(FlowTable::OLD_FLOWS, FlowTable::OLD_FLOWS);
             }
             else
             {
@@ -416,16 +407,15 @@ FqPieQueueDisc::DoDequeue()
         if (!item)
         {
             NS_LOG_DEBUG("Could not get a packet from the selected flow queue");
-            if (!m_newFlows.empty())
+            if (!m_flowTable.IsEmpty(FlowTable::NEW_FLOWS))
             {
                 flow->SetStatus(FqPieFlow::OLD_FLOW);
-                m_oldFlows.push_back(flow);
-                m_newFlows.pop_front();
+                m_flowTable.MoveFront(FlowTable::NEW_FLOWS, FlowTable::OLD_FLOWS);
             }
             else
             {
                 flow->SetStatus(FqPieFlow::INACTIVE);
-                m_oldFlows.pop_front();
+                m_flowTable.PopFront(FlowTable::OLD_FLOWS);
             }
         }
         else
@@ -499,6 +489,8 @@ FqPieQueueDisc::InitializeParams()
 {
     NS_LOG_FUNCTION(this);
 
+    m_flowTable.SetSize(m_flows);
+
     m_flowFactory.SetTypeId("ns3::FqPieFlow");
 
     m_queueDiscFactory.SetTypeId("ns3::PieQueueDisc");
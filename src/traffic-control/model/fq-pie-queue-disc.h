@@ -15,13 +15,11 @@
 #ifndef FQ_PIE_QUEUE_DISC
 #define FQ_PIE_QUEUE_DISC
 
+#include "fq-flow-table.h"
 #include "queue-disc.h"
 
 #include "ns3/object-factory.h"
 
-#include <list>
-#include <map>
-
 namespace ns3
 {
 
@@ -189,11 +187,9 @@ class FqPieQueueDisc : public QueueDisc
     uint32_t m_perturbation;         //!< hash perturbation value
     bool m_enableSetAssociativeHash; //!< whether to enable set associative hash
 
-    std::list<Ptr<FqPieFlow>> m_newFlows; //!< The list of new flows
-    std::list<Ptr<FqPieFlow>> m_oldFlows; //!< The list of old flows
-
-    std::map<uint32_t, uint32_t> m_flowsIndices; //!< Map with the index of class for each flow
-    std::map<uint32_t, uint32_t> m_tags;         //!< Tags used by set associative hash
+    /// Table of the flow queues
+    typedef FqFlowTable<FqPieFlow> FlowTable;
+    FlowTable m_flowTable; //!< The flow queues, their tags and the lists of new and old flows
 
     ObjectFactory m_flowFactory;      //!< Factory to create a new flow
     ObjectFactory m_queueDiscFactory; //!< Factory to create a new queue
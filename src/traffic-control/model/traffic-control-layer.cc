@@ -91,12 +91,14 @@ TrafficControlLayer::DoInitialize()
 void
 TrafficControlLayer::RegisterProtocolHandler(Node::ProtocolHandler handler,
                                              uint16_t protocolType,
-                                             Ptr<NetDevice> device)
+                                             Ptr<NetDevice> device,
+                                             Node::BatchProtocolHandler batchHandler)
 {
     NS_LOG_FUNCTION(this << protocolType << device);
 
     ProtocolHandlerEntry entry;
     entry.handler = handler;
+    entry.batchHandler = batchHandler;
     entry.protocol = protocolType;
     entry.device = device;
     entry.promiscuous = false;
@@ -340,6 +342,48 @@ TrafficControlLayer::Receive(Ptr<NetDevice> device,
                                             << " not found. It isn't forwarded up; it dies here.");
 }
 
+void
+TrafficControlLayer::ReceiveBatch(Ptr<NetDevice> device,
+                                  const std::vector<Ptr<const Packet>>& packets,
+                                  uint16_t protocol,
+                                  const Address& from,
+                                  const Address& to,
+                                  NetDevice::PacketType packetType)
+{
+    NS_LOG_FUNCTION(this << device << packets.size() << protocol << from << to << packetType);
+
+    bool found = false;
+
+    for (auto i = m_handlers.begin(); i != m_handlers.end(); i++)
+    {
+        if (!i->device || (i->device == device))
+        {
+            if (i->protocol == 0 || i->protocol == protocol)
+            {
+                NS_LOG_DEBUG("Found handler for " << packets.size() << " packets, protocol "
+                                                  << protocol << " and NetDevice " << device
+                                                  << ". Send packets up");
+                if (!i->batchHandler.IsNull())
+                {
+                    i->batchHandler(device, packets, protocol, from, to, packetType);
+                }
+                else
+                {
+                    for (const auto& p : packets)
+                    {
+                        i->handler(device, p, protocol, from, to, packetType);
+                    }
+                }
+                found = true;
+            }
+        }
+    }
+
+    NS_ABORT_MSG_IF(!found,
+                    "Handler for protocol " << protocol << " and device " << device
+                                            << " not found. It isn't forwarded up; it dies here.");
+}
+
 void
 TrafficControlLayer::Send(Ptr<NetDevice> device, Ptr<QueueDiscItem> item)
 {
@@ -120,10 +120,15 @@ class TrafficControlLayer : public Object
      * @param device the device attached to this handler. If the
      *        value is zero, the handler is attached to all
      *        devices.
+     * @param batchHandler the handler invoked with the batches of packets
+     *        received through ReceiveBatch. If null, the handler is invoked
+     *        for each packet of the batches.
      */
-    void RegisterProtocolHandler(Node::ProtocolHandler handler,
-                                 uint16_t protocolType,
-                                 Ptr<NetDevice> device);
+    void RegisterProtocolHandler(
+        Node::ProtocolHandler handler,
+        uint16_t protocolType,
+        Ptr<NetDevice> device,
+        Node::BatchProtocolHandler batchHandler = Node::BatchProtocolHandler());
 
     /// Typedef for queue disc vector
     typedef std::vector<Ptr<QueueDisc>> QueueDiscVector;
@@ -186,6 +191,28 @@ class TrafficControlLayer : public Object
                          const Address& from,
                          const Address& to,
                          NetDevice::PacketType packetType);
+
+    /**
+     * @brief Called by the node, incoming batch of packets
+     *
+     * The handler of the packets is looked up once for the whole batch,
+     * which is passed up in the stack at once if the handler accepts
+     * batches, or packet by packet otherwise.
+     *
+     * @param device network device
+     * @param packets the packets, in order of reception
+     * @param protocol next header value
+     * @param from address of the correspondent
+     * @param to address of the destination
+     * @param packetType type of the packets
+     */
+    virtual void ReceiveBatch(Ptr<NetDevice> device,
+                              const std::vector<Ptr<const Packet>>& packets,
+                              uint16_t protocol,
+                              const Address& from,
+                              const Address& to,
+                              NetDevice::PacketType packetType);
+
     /**
      * @brief Called from upper layer to queue a packet for the transmission.
      *
@@ -206,10 +233,11 @@ class TrafficControlLayer : public Object
      */
     struct ProtocolHandlerEntry
     {
-        Node::ProtocolHandler handler; //!< the protocol handler
-        Ptr<NetDevice> device;         //!< the NetDevice
-        uint16_t protocol;             //!< the protocol number
-        bool promiscuous;              //!< true if it is a promiscuous handler
+        Node::ProtocolHandler handler;           //!< the protocol handler
+        Node::BatchProtocolHandler batchHandler; //!< the protocol handler for batches, if any
+        Ptr<NetDevice> device;                   //!< the NetDevice
+        uint16_t protocol;                       //!< the protocol number
+        bool promiscuous;                        //!< true if it is a promiscuous handler
     };
 
     /**
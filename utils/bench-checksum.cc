@@ -0,0 +1,136 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the computation of Internet
+// checksums: the checksum of the whole packet, as computed by UDP and TCP,
+// for several packet sizes, and the update of the IPv4 header checksum when
+// a router decrements the TTL of the packets it forwards.
+// Sample usage:  ./ns3 run 'bench-checksum --n=1000000'
+
+#include "ns3/buffer.h"
+#include "ns3/command-line.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/packet.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+static void
+benchPacketChecksum(uint32_t size, uint32_t n)
+{
+    Buffer buffer;
+    buffer.AddAtStart(size);
+    Buffer::Iterator i = buffer.Begin();
+    for (uint32_t j = 0; j < size; j++)
+    {
+        i.WriteU8(j * 7);
+    }
+
+    for (uint32_t j = 0; j < n; j++)
+    {
+        i = buffer.Begin();
+        i.CalculateIpChecksum(size);
+    }
+}
+
+static void
+benchForwarding(uint32_t size, uint32_t n)
+{
+    Ipv4Header header;
+    header.EnableChecksum();
+    header.SetSource(Ipv4Address("10.1.1.1"));
+    header.SetDestination(Ipv4Address("10.2.2.2"));
+    header.SetProtocol(17);
+    header.SetPayloadSize(size);
+    header.SetTtl(255);
+    Ptr<Packet> p = Create<Packet>(size);
+    p->AddHeader(header);
+
+    for (uint32_t j = 0; j < n; j++)
+    {
+        // Receive the packet, decrement its TTL and send it again, as
+        // Ipv4L3Protocol does when forwarding it
+        Ipv4Header ipHeader;
+        ipHeader.EnableChecksum();
+        p->RemoveHeader(ipHeader);
+        ipHeader.SetTtl(ipHeader.GetTtl() == 1 ? 255 : ipHeader.GetTtl() - 1);
+        p->AddHeader(ipHeader);
+    }
+}
+
+static uint64_t
+runBenchOneIteration(void (*bench)(uint32_t, uint32_t), uint32_t size, uint32_t n)
+{
+    SystemWallClockMs time;
+    time.Start();
+    (*bench)(size, n);
+    uint64_t deltaMs = time.End();
+    return deltaMs;
+}
+
+static void
+runBench(void (*bench)(uint32_t, uint32_t),
+         uint32_t size,
+         uint32_t n,
+         uint32_t minIterations,
+         const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        uint64_t delay = runBenchOneIteration(bench, size, n);
+        minDelay = std::min(minDelay, delay);
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    double ns = minDelay;
+    ns *= 1000000;
+    ns /= n;
+    std::cout << ps << " packets/s, " << ns << " ns/packet"
+              << " (" << minDelay << " ms elapsed)\t" << name << " " << size << " bytes"
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t minIterations = 1;
+    std::string sizes = "40,576,1500,9000";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the computation of Internet checksums");
+    cmd.AddValue("n", "number of packets", n);
+    cmd.AddValue("sizes", "comma-separated list of packet sizes, in bytes", sizes);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0)
+    {
+        std::cerr << "Error-- number of packets must be specified "
+                  << "by command-line argument --n=(number of packets)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-checksum with n=" << n << std::endl;
+
+    std::istringstream sizeList(sizes);
+    std::string size;
+    while (std::getline(sizeList, size, ','))
+    {
+        runBench(&benchPacketChecksum, std::stoul(size), n, minIterations, "packet checksum");
+    }
+    runBench(&benchForwarding, 1000, n, minIterations, "IPv4 TTL decrement");
+
+    return 0;
+}
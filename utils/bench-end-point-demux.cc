@@ -0,0 +1,159 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the lookup of the end point a
+// received TCP or UDP segment is delivered to, on a server which holds
+// many connections to the same listening port.
+// Sample usage:  ./ns3 run 'bench-end-point-demux --connections=50000 --n=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/ipv4-end-point-demux.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/ipv6-end-point-demux.h"
+#include "ns3/ipv6-interface.h"
+#include "ns3/net-device.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/// Port the server listens on
+static const uint16_t SERVER_PORT = 80;
+
+/**
+ * Get the address and port of a client of the server.
+ * @param i the index of the client
+ * @param [out] address the address of the client, as a 32 bit integer
+ * @param [out] port the port of the client
+ */
+static void
+GetClient(uint32_t i, uint32_t& address, uint16_t& port)
+{
+    // 100 connections per client address, from ports 1024 and up
+    address = 0x0b000000 + i / 100;
+    port = 1024 + i % 100;
+}
+
+static void
+benchIpv4(uint32_t connections, uint32_t n)
+{
+    Ipv4EndPointDemux demux;
+    Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
+    Ipv4Address server("10.0.0.1");
+    demux.Allocate(nullptr, SERVER_PORT);
+    for (uint32_t i = 0; i < connections; i++)
+    {
+        uint32_t address;
+        uint16_t port;
+        GetClient(i, address, port);
+        demux.Allocate(nullptr, server, SERVER_PORT, Ipv4Address(address), port);
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t address;
+        uint16_t port;
+        GetClient(i % (connections + 1), address, port);
+        demux.Lookup(server, SERVER_PORT, Ipv4Address(address), port, interface);
+    }
+}
+
+static void
+benchIpv6(uint32_t connections, uint32_t n)
+{
+    Ipv6EndPointDemux demux;
+    Ptr<Ipv6Interface> interface = CreateObject<Ipv6Interface>();
+    Ipv6Address server("2001:db8::1");
+    demux.Allocate(nullptr, SERVER_PORT);
+    for (uint32_t i = 0; i < connections; i++)
+    {
+        uint32_t address;
+        uint16_t port;
+        GetClient(i, address, port);
+        demux.Allocate(nullptr,
+                       server,
+                       SERVER_PORT,
+                       Ipv6Address::MakeIpv4MappedAddress(Ipv4Address(address)),
+                       port);
+    }
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        uint32_t address;
+        uint16_t port;
+        GetClient(i % (connections + 1), address, port);
+        demux.Lookup(server,
+                     SERVER_PORT,
+                     Ipv6Address::MakeIpv4MappedAddress(Ipv4Address(address)),
+                     port,
+                     interface);
+    }
+}
+
+static uint64_t
+runBenchOneIteration(void (*bench)(uint32_t, uint32_t), uint32_t connections, uint32_t n)
+{
+    SystemWallClockMs time;
+    time.Start();
+    (*bench)(connections, n);
+    uint64_t deltaMs = time.End();
+    return deltaMs;
+}
+
+static void
+runBench(void (*bench)(uint32_t, uint32_t),
+         uint32_t connections,
+         uint32_t n,
+         uint32_t minIterations,
+         const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        uint64_t delay = runBenchOneIteration(bench, connections, n);
+        minDelay = std::min(minDelay, delay);
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " lookups/s"
+              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t connections = 50000;
+    uint32_t n = 0;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark Ipv4EndPointDemux and Ipv6EndPointDemux lookups");
+    cmd.AddValue("connections", "number of connections to the server", connections);
+    cmd.AddValue("n", "number of lookups", n);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0)
+    {
+        std::cerr << "Error-- number of lookups must be specified "
+                  << "by command-line argument --n=(number of lookups)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-end-point-demux with n=" << n << std::endl;
+    std::cout << "All tests look up segments sent to a server with " << connections
+              << " connections on one listening port; one lookup in " << connections + 1
+              << " is for a new connection." << std::endl;
+
+    runBench(&benchIpv4, connections, n, minIterations, "Ipv4EndPointDemux");
+    runBench(&benchIpv6, connections, n, minIterations, "Ipv6EndPointDemux");
+
+    return 0;
+}
@@ -0,0 +1,200 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the forwarding of IPv4 packets by a
+// router, when the packets received are passed up one by one, as most
+// devices do, and when they are passed up in batches, as done by the
+// point-to-point and CSMA devices with the ReceiveBatching attribute set.
+// Sample usage:  ./ns3 run 'bench-forwarding --n=1000000'
+
+#include "ns3/boolean.h"
+#include "ns3/command-line.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/mac48-address.h"
+#include "ns3/node.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/// Size of the payload of the packets forwarded, in bytes
+static const uint32_t PAYLOAD_SIZE = 1000;
+
+/// Address of the sender of the packets forwarded
+static const Mac48Address SENDER = Mac48Address("00:00:00:00:00:01");
+
+/**
+ * Create a device connected to its own channel, on which it is the only device.
+ * @param node the node the device is added to
+ * @returns the device
+ */
+static Ptr<SimpleNetDevice>
+CreateDevice(Ptr<Node> node)
+{
+    Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+    device->SetAddress(Mac48Address::Allocate());
+    device->SetAttribute("PointToPointMode", BooleanValue(true));
+    device->SetChannel(CreateObject<SimpleChannel>());
+    node->AddDevice(device);
+    return device;
+}
+
+/**
+ * Pass packets up from a device one by one, through its receive callback.
+ * @param device the device
+ * @param packets the packets
+ */
+static void
+ReceivePackets(Ptr<SimpleNetDevice> device, std::vector<Ptr<const Packet>> packets)
+{
+    Mac48Address to = Mac48Address::ConvertFrom(device->GetAddress());
+    for (const auto& packet : packets)
+    {
+        device->Receive(packet->Copy(), Ipv4L3Protocol::PROT_NUMBER, to, SENDER);
+    }
+}
+
+/**
+ * Pass packets up from a device as a batch.
+ * @param device the device
+ * @param packets the packets
+ */
+static void
+ReceiveBatch(Ptr<SimpleNetDevice> device, std::vector<Ptr<const Packet>> packets)
+{
+    device->GetNode()->ReceiveBatchFromDevice(device, packets, Ipv4L3Protocol::PROT_NUMBER, SENDER);
+}
+
+static void
+benchForwarding(bool batch, uint32_t batchSize, uint32_t n)
+{
+    Ptr<Node> router = CreateObject<Node>();
+    Ptr<SimpleNetDevice> in = CreateDevice(router);
+    Ptr<SimpleNetDevice> out = CreateDevice(router);
+    InternetStackHelper internet;
+    internet.Install(router);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.1.1.0", "255.255.255.0");
+    ipv4.Assign(NetDeviceContainer(in));
+    ipv4.SetBase("10.2.2.0", "255.255.255.0");
+    ipv4.Assign(NetDeviceContainer(out));
+
+    Ipv4Header header;
+    header.SetSource(Ipv4Address("10.1.1.2"));
+    header.SetDestination(Ipv4Address("10.2.2.2"));
+    header.SetProtocol(17);
+    header.SetPayloadSize(PAYLOAD_SIZE);
+    header.SetTtl(64);
+    std::vector<Ptr<const Packet>> packets;
+    for (uint32_t i = 0; i < batchSize; i++)
+    {
+        Ptr<Packet> packet = Create<Packet>(PAYLOAD_SIZE);
+        packet->AddHeader(header);
+        packets.push_back(packet);
+    }
+
+    // Each round of packets is received at once, then the simulation
+    // runs until they are all sent by the outgoing device
+    for (uint32_t i = 0; i < n; i += batchSize)
+    {
+        if (batch)
+        {
+            Simulator::ScheduleWithContext(router->GetId(), Time(0), &ReceiveBatch, in, packets);
+        }
+        else
+        {
+            Simulator::ScheduleWithContext(router->GetId(), Time(0), &ReceivePackets, in, packets);
+        }
+        Simulator::Run();
+    }
+    Simulator::Destroy();
+}
+
+static uint64_t
+runBenchOneIteration(void (*bench)(bool, uint32_t, uint32_t),
+                     bool batch,
+                     uint32_t batchSize,
+                     uint32_t n)
+{
+    SystemWallClockMs time;
+    time.Start();
+    (*bench)(batch, batchSize, n);
+    uint64_t deltaMs = time.End();
+    return deltaMs;
+}
+
+static void
+runBench(void (*bench)(bool, uint32_t, uint32_t),
+         bool batch,
+         uint32_t batchSize,
+         uint32_t n,
+         uint32_t minIterations,
+         const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        uint64_t delay = runBenchOneIteration(bench, batch, batchSize, n);
+        minDelay = std::min(minDelay, delay);
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    double ns = minDelay;
+    ns *= 1000000;
+    ns /= n;
+    std::cout << ps << " packets/s, " << ns << " ns/packet"
+              << " (" << minDelay << " ms elapsed)\t" << name << " " << batchSize
+              << " packets per round" << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t minIterations = 1;
+    std::string batchSizes = "1,8,64";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the forwarding of IPv4 packets, received one by one or in batches");
+    cmd.AddValue("n", "number of packets", n);
+    cmd.AddValue("batch-sizes",
+                 "comma-separated list of numbers of packets received at once",
+                 batchSizes);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0)
+    {
+        std::cerr << "Error-- number of packets must be specified "
+                  << "by command-line argument --n=(number of packets)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-forwarding with n=" << n << std::endl;
+
+    std::istringstream batchSizeList(batchSizes);
+    std::string batchSize;
+    while (std::getline(batchSizeList, batchSize, ','))
+    {
+        runBench(&benchForwarding, false, std::stoul(batchSize), n, minIterations, "one by one");
+        runBench(&benchForwarding, true, std::stoul(batchSize), n, minIterations, "batch");
+    }
+
+    return 0;
+}
@@ -0,0 +1,96 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the installation of the Internet
+// stack on many nodes by InternetStackHelper, either on a NodeContainer at
+// once or node by node, with IPv4 and IPv6 or with one of them only.
+// Sample usage:  ./ns3 run 'bench-internet-stack --n=100000'
+
+#include "ns3/command-line.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace ns3;
+
+static uint64_t
+benchInstall(bool bulk, bool ipv4, bool ipv6, uint32_t n)
+{
+    NodeContainer nodes;
+    nodes.Create(n);
+    InternetStackHelper internet;
+    internet.SetIpv4StackInstall(ipv4);
+    internet.SetIpv6StackInstall(ipv6);
+
+    SystemWallClockMs time;
+    time.Start();
+    if (bulk)
+    {
+        internet.Install(nodes);
+    }
+    else
+    {
+        for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+        {
+            internet.Install(*i);
+        }
+    }
+    uint64_t deltaMs = time.End();
+    Simulator::Destroy();
+    return deltaMs;
+}
+
+static void
+runBench(bool bulk, bool ipv4, bool ipv6, uint32_t n, uint32_t minIterations, const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        uint64_t delay = benchInstall(bulk, ipv4, ipv6, n);
+        minDelay = std::min(minDelay, delay);
+    }
+    double us = minDelay;
+    us *= 1000;
+    us /= n;
+    std::cout << us << " us/node"
+              << " (" << minDelay << " ms elapsed)\t" << name << (ipv4 ? " IPv4" : "")
+              << (ipv6 ? " IPv6" : "") << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the installation of the Internet stack on many nodes");
+    cmd.AddValue("n", "number of nodes", n);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0)
+    {
+        std::cerr << "Error-- number of nodes must be specified "
+                  << "by command-line argument --n=(number of nodes)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-internet-stack with n=" << n << std::endl;
+
+    runBench(true, true, true, n, minIterations, "NodeContainer");
+    runBench(false, true, true, n, minIterations, "node by node");
+    runBench(true, true, false, n, minIterations, "NodeContainer");
+    runBench(true, false, true, n, minIterations, "NodeContainer");
+
+    return 0;
+}
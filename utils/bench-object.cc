@@ -0,0 +1,202 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark Object::GetObject lookups on
+// aggregations of various sizes, as done for instance when protocols
+// look up Ipv4 or GlobalRouter on a Node for every packet.
+// Sample usage:  ./ns3 run 'bench-object --n=10000000'
+
+#include "ns3/abort.h"
+#include "ns3/command-line.h"
+#include "ns3/object.h"
+#include "ns3/system-wall-clock-ms.h"
+
+#include <algorithm>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+using namespace ns3;
+
+/// BenchObject class used for benchmarking aggregate lookups
+template <int N>
+class BenchObject : public Object
+{
+  public:
+    /**
+     * Register this type.
+     * @return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId(GetName())
+                                .SetParent<Object>()
+                                .SetGroupName("Utils")
+                                .HideFromDocumentation()
+                                .AddConstructor<BenchObject<N>>();
+        return tid;
+    }
+
+  private:
+    /**
+     * Get the bench object name.
+     * @return the name.
+     */
+    static std::string GetName()
+    {
+        std::ostringstream oss;
+        oss << "anon::BenchObject<" << N << ">";
+        return oss.str();
+    }
+};
+
+/// Derived BenchObject, looked up through its parent TypeId
+class DerivedBenchObject : public BenchObject<9>
+{
+  public:
+    /**
+     * Register this type.
+     * @return The TypeId.
+     */
+    static TypeId GetTypeId()
+    {
+        static TypeId tid = TypeId("anon::DerivedBenchObject")
+                                .SetParent<BenchObject<9>>()
+                                .SetGroupName("Utils")
+                                .HideFromDocumentation()
+                                .AddConstructor<DerivedBenchObject>();
+        return tid;
+    }
+};
+
+/**
+ * Build an aggregation of 10 objects, similar in size to a Node with
+ * an internet stack installed.
+ * @return the first object of the aggregation
+ */
+static Ptr<Object>
+CreateAggregation()
+{
+    Ptr<Object> root = CreateObject<BenchObject<0>>();
+    root->AggregateObject(CreateObject<BenchObject<1>>());
+    root->AggregateObject(CreateObject<BenchObject<2>>());
+    root->AggregateObject(CreateObject<BenchObject<3>>());
+    root->AggregateObject(CreateObject<BenchObject<4>>());
+    root->AggregateObject(CreateObject<BenchObject<5>>());
+    root->AggregateObject(CreateObject<BenchObject<6>>());
+    root->AggregateObject(CreateObject<BenchObject<7>>());
+    root->AggregateObject(CreateObject<BenchObject<8>>());
+    root->AggregateObject(CreateObject<DerivedBenchObject>());
+    return root;
+}
+
+static void
+benchFirst(uint32_t n)
+{
+    Ptr<Object> root = CreateAggregation();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        NS_ABORT_IF(!root->GetObject<BenchObject<0>>());
+    }
+    root->Dispose();
+}
+
+static void
+benchAlternate(uint32_t n)
+{
+    Ptr<Object> root = CreateAggregation();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        if (i % 2)
+        {
+            NS_ABORT_IF(!root->GetObject<BenchObject<3>>());
+        }
+        else
+        {
+            NS_ABORT_IF(!root->GetObject<BenchObject<7>>());
+        }
+    }
+    root->Dispose();
+}
+
+static void
+benchParent(uint32_t n)
+{
+    Ptr<Object> root = CreateAggregation();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        NS_ABORT_IF(!root->GetObject<BenchObject<9>>());
+    }
+    root->Dispose();
+}
+
+static void
+benchMissing(uint32_t n)
+{
+    Ptr<Object> root = CreateAggregation();
+    for (uint32_t i = 0; i < n; i++)
+    {
+        NS_ABORT_IF(root->GetObject<BenchObject<10>>());
+    }
+    root->Dispose();
+}
+
+static uint64_t
+runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
+{
+    SystemWallClockMs time;
+    time.Start();
+    (*bench)(n);
+    uint64_t deltaMs = time.End();
+    return deltaMs;
+}
+
+static void
+runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        uint64_t delay = runBenchOneIteration(bench, n);
+        minDelay = std::min(minDelay, delay);
+    }
+    double ps = n;
+    ps *= 1000;
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " lookups/s"
+              << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark Object::GetObject");
+    cmd.AddValue("n", "number of lookups", n);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0)
+    {
+        std::cerr << "Error-- number of lookups must be specified "
+                  << "by command-line argument --n=(number of lookups)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-object with n=" << n << std::endl;
+    std::cout << "All tests look up objects in an aggregation of 10 objects." << std::endl;
+
+    runBench(&benchFirst, n, minIterations, "First aggregate");
+    runBench(&benchAlternate, n, minIterations, "Alternate between two aggregates");
+    runBench(&benchParent, n, minIterations, "Aggregate found through parent TypeId");
+    runBench(&benchMissing, n, minIterations, "Missing aggregate");
+
+    return 0;
+}
@@ -7,7 +7,9 @@
  */
 
 // This program can be used to benchmark packet serialization/deserialization
-// operations using Headers and Tags, for various numbers of packets 'n'
+// operations using Headers and Tags, for various numbers of packets 'n'.
+// It reports the number of packets processed per second, and the number of
+// heap allocations made per packet.
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
 
 #include "ns3/command-line.h"
@@ -19,11 +21,52 @@
 #include <cstdlib> // for exit ()
 #include <iostream>
 #include <limits>
+#include <new>
 #include <sstream>
 #include <string>
 
 using namespace ns3;
 
+/// Number of heap allocations made by the program
+static uint64_t g_allocations = 0;
+
+/**
+ * Replacement of the global allocation function, counting allocations.
+ * @param size the size of the allocation
+ * @returns the allocated memory
+ */
+void*
+operator new(std::size_t size)
+{
+    g_allocations++;
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+/**
+ * Replacement of the global deallocation function.
+ * @param p the memory to release
+ */
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Replacement of the global sized deallocation function.
+ * @param p the memory to release
+ */
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
 /// BenchHeader class used for benchmarking packet serialization/deserialization
 template <int N>
 class BenchHeader : public Header
@@ -353,15 +396,19 @@ static void
 runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char* name)
 {
     uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    uint64_t allocations = 0;
     for (uint32_t i = 0; i < minIterations; i++)
     {
+        uint64_t start = g_allocations;
         uint64_t delay = runBenchOneIteration(bench, n);
+        allocations = g_allocations - start;
         minDelay = std::min(minDelay, delay);
     }
     double ps = n;
     ps *= 1000;
-    ps /= minDelay;
-    std::cout << ps << " packets/s"
+    ps /= std::max<uint64_t>(minDelay, 1);
+    std::cout << ps << " packets/s, " << static_cast<double>(allocations) / n
+              << " allocations/packet"
               << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
 }
 
@@ -0,0 +1,700 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the enqueue and dequeue operations
+// of any queue disc, without any node nor network stack. The packets of a
+// number of flows arrive according to a synthetic arrival process, with
+// synthetic sizes, and are dequeued at the rate of a link, the transmission
+// of which stops the device queue of the queue disc. The MQ queue disc gets a
+// child queue disc and a link per device queue, among which the flows are
+// spread. The program reports, for the enqueue and dequeue operations, their
+// rate, the number of heap allocations they make and the percentiles of
+// their latency, which include the cost of reading the clock.
+// Sample usage:  ./ns3 run 'bench-queue-disc --n=1000000'
+//                ./ns3 run 'bench-queue-disc --n=1000000 --arrivals=bursty --sizes=imix'
+//                ./ns3 run 'bench-queue-disc --n=1000000 --queue-discs=ns3::FqCoDelQueueDisc
+//                           --flows=1000,10000,100000'
+
+#include "ns3/command-line.h"
+#include "ns3/data-rate.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/ipv4-queue-disc-item.h"
+#include "ns3/mq-queue-disc.h"
+#include "ns3/net-device-queue-interface.h"
+#include "ns3/object-factory.h"
+#include "ns3/queue-disc.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/udp-header.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <limits>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/// Number of heap allocations made by the program
+static uint64_t g_allocations = 0;
+
+/**
+ * Replacement of the global allocation function, counting allocations.
+ * @param size the size of the allocation
+ * @returns the allocated memory
+ */
+void*
+operator new(std::size_t size)
+{
+    g_allocations++;
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+/**
+ * Replacement of the global deallocation function.
+ * @param p the memory to release
+ */
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Replacement of the global sized deallocation function.
+ * @param p the memory to release
+ */
+void
+operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+/// Size of the IPv4 and UDP headers of the packets, in bytes
+static const uint32_t HEADERS_SIZE = 28;
+
+/// Arrival process of the packets
+enum Arrivals
+{
+    CONSTANT, //!< packets arrive at regular intervals
+    POISSON,  //!< packets arrive with exponentially distributed intervals
+    BURSTY    //!< bursts of packets arrive with exponentially distributed intervals
+};
+
+/// Distribution of the sizes of the packets
+enum Sizes
+{
+    FIXED,   //!< all the packets have the same size
+    UNIFORM, //!< sizes uniformly distributed between 64 and 1500 bytes
+    IMIX     //!< 40, 576 and 1500 bytes, in proportions 7:4:1 (simple IMIX)
+};
+
+/// Parameters of the benchmark, common to all the queue discs
+struct BenchConfig
+{
+    uint32_t n;          //!< number of packets
+    Arrivals arrivals;   //!< arrival process
+    uint32_t burst;      //!< number of packets of a burst
+    Sizes sizes;         //!< distribution of the sizes of the packets
+    uint32_t size;       //!< size of the packets, if fixed
+    double load;         //!< offered load, relative to the rate of the link
+    DataRate linkRate;   //!< rate of the link
+    uint32_t txQueues;   //!< number of device queues of the MQ queue disc
+    std::string mqChild; //!< TypeId of the child queue discs of the MQ queue disc
+};
+
+/// Statistics of the enqueue or dequeue operations
+struct OperationStats
+{
+    std::vector<uint64_t> latencies; //!< the latency of each operation, in nanoseconds
+    uint64_t allocations{0};         //!< the heap allocations made by the operations
+    uint64_t totalNs{0};             //!< the sum of the latencies, in nanoseconds
+};
+
+/**
+ * Run a queue disc operation, measuring its latency and the heap
+ * allocations it makes.
+ * @param stats the statistics the measure is added to
+ * @param operation the operation
+ * @returns the result of the operation
+ */
+template <class Operation>
+static auto
+Measure(OperationStats& stats, Operation operation)
+{
+    uint64_t allocations = g_allocations;
+    auto start = std::chrono::steady_clock::now();
+    auto result = operation();
+    auto end = std::chrono::steady_clock::now();
+    stats.allocations += g_allocations - allocations;
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    stats.latencies.push_back(ns);
+    stats.totalNs += ns;
+    return result;
+}
+
+/**
+ * Benchmark of a queue disc, fed by the arrivals of the packets of a number
+ * of flows and drained by the transmission of the packets on a link.
+ */
+class QueueDiscBench
+{
+  public:
+    /**
+     * Create the queue disc.
+     * @param config the parameters of the benchmark
+     * @param typeId the TypeId of the queue disc
+     * @param nFlows the number of flows, to which the Flows attribute of the
+     *        queue disc is set if it has one
+     */
+    QueueDiscBench(const BenchConfig& config, const std::string& typeId, uint32_t nFlows);
+
+    /**
+     * Run the benchmark: first send a packet of each flow, which is not
+     * measured, then the packets of the flows, until all of them are sent
+     * or dropped.
+     */
+    void Run();
+
+    /// @returns the statistics of the enqueue operations
+    const OperationStats& GetEnqueueStats() const;
+
+    /// @returns the statistics of the dequeue operations
+    const OperationStats& GetDequeueStats() const;
+
+    /// @returns the number of packets dropped by the queue disc
+    uint64_t GetDropped() const;
+
+    /// @returns the number of packets dequeued when the queue disc woke itself up
+    uint64_t GetSelfDequeued() const;
+
+  private:
+    /**
+     * Create a queue disc.
+     * @param typeId the TypeId of the queue disc
+     * @param nFlows the number of flows
+     * @returns the queue disc
+     */
+    Ptr<QueueDisc> CreateQueueDisc(const std::string& typeId, uint32_t nFlows) const;
+
+    /// @returns the number of packets dropped by the queue discs
+    uint64_t CountDropped() const;
+
+    /**
+     * Enqueue a packet, and start its transmission if the link is idle.
+     * @param flow the flow of the packet
+     * @param size the size of the packet, in bytes
+     */
+    void EnqueuePacket(uint32_t flow, uint32_t size);
+
+    /// Enqueue the packets arriving now and schedule the next arrival
+    void Arrive();
+
+    /// @returns the interval until the next arrival
+    Time GetNextInterval();
+
+    /// @returns the size of a packet, in bytes
+    uint32_t GetNextSize();
+
+    /**
+     * Dequeue a packet to transmit on an idle link, if there is one.
+     * @param txq the index of the device queue of the link
+     */
+    void StartTransmission(uint32_t txq);
+
+    /**
+     * Transmit a packet on a link, which stops its device queue.
+     * @param txq the index of the device queue of the link
+     * @param item the packet
+     */
+    void Transmit(uint32_t txq, Ptr<QueueDiscItem> item);
+
+    /**
+     * End the transmission of a packet on a link.
+     * @param txq the index of the device queue of the link
+     */
+    void TransmitComplete(uint32_t txq);
+
+    /**
+     * Stop the simulation once all the packets arrived are sent or dropped,
+     * since some queue discs have timers which never expire.
+     */
+    void StopIfDone();
+
+    const BenchConfig& m_config;                //!< the parameters of the benchmark
+    uint32_t m_nFlows;                          //!< the number of flows
+    Ptr<NetDeviceQueueInterface> m_ndqi;        //!< the device queues
+    Ptr<QueueDisc> m_queueDisc;                 //!< the queue disc
+    std::vector<Ptr<QueueDisc>> m_txQueueDiscs; //!< the queue disc of each device queue
+    Ptr<UniformRandomVariable> m_flowVariable;  //!< the flow of the packets
+    Ptr<UniformRandomVariable> m_sizeVariable;  //!< the size of the packets
+    Ptr<ExponentialRandomVariable> m_intervals; //!< the intervals between arrivals
+    double m_meanInterval;                      //!< the mean interval, in seconds
+    uint32_t m_arrived{0};                      //!< the number of packets arrived
+    bool m_measuring{false};                    //!< true once the warm up is over
+    OperationStats m_enqueueStats;              //!< the statistics of the enqueues
+    OperationStats m_dequeueStats;              //!< the statistics of the dequeues
+    uint64_t m_sent{0};                         //!< the number of packets transmitted
+    uint64_t m_warmUpDropped{0};                //!< the packets dropped by the warm up
+    uint64_t m_selfDequeued{0};                 //!< the packets dequeued by Run
+};
+
+QueueDiscBench::QueueDiscBench(const BenchConfig& config,
+                               const std::string& typeId,
+                               uint32_t nFlows)
+    : m_config(config),
+      m_nFlows(nFlows)
+{
+    m_queueDisc = CreateQueueDisc(typeId, nFlows);
+    Ptr<MqQueueDisc> mq = DynamicCast<MqQueueDisc>(m_queueDisc);
+    uint32_t txQueues = mq ? config.txQueues : 1;
+
+    Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+    m_ndqi = CreateObjectWithAttributes<NetDeviceQueueInterface>("NTxQueues",
+                                                                 UintegerValue(txQueues));
+    device->AggregateObject(m_ndqi);
+    m_queueDisc->SetNetDeviceQueueInterface(m_ndqi);
+
+    // As done by the traffic control layer, the packets are enqueued into
+    // the child queue discs of a multi-queue root queue disc
+    for (uint32_t txq = 0; txq < txQueues; txq++)
+    {
+        Ptr<QueueDisc> queueDisc = m_queueDisc;
+        if (mq)
+        {
+            queueDisc = CreateQueueDisc(config.mqChild, nFlows);
+            Ptr<QueueDiscClass> c = CreateObject<QueueDiscClass>();
+            c->SetQueueDisc(queueDisc);
+            mq->AddQueueDiscClass(c);
+            queueDisc->SetNetDeviceQueueInterface(m_ndqi);
+        }
+        // A queue disc waking itself up, as TBF does, dequeues the packets
+        // through QueueDisc::Run, which transmits them through this callback
+        queueDisc->SetSendCallback([this, txq](Ptr<QueueDiscItem> item) {
+            m_selfDequeued++;
+            Transmit(txq, item);
+        });
+        m_txQueueDiscs.push_back(queueDisc);
+    }
+    m_queueDisc->Initialize();
+
+    m_flowVariable = CreateObject<UniformRandomVariable>();
+    m_flowVariable->SetStream(0);
+    m_sizeVariable = CreateObject<UniformRandomVariable>();
+    m_sizeVariable->SetStream(1);
+    m_intervals = CreateObject<ExponentialRandomVariable>();
+    m_intervals->SetStream(2);
+
+    double meanSize = config.size;
+    if (config.sizes == UNIFORM)
+    {
+        meanSize = (64 + 1500) / 2.0;
+    }
+    else if (config.sizes == IMIX)
+    {
+        meanSize = (7 * 40 + 4 * 576 + 1500) / 12.0;
+    }
+    m_meanInterval = meanSize * 8 / (config.load * config.linkRate.GetBitRate());
+
+    m_enqueueStats.latencies.reserve(config.n);
+    m_dequeueStats.latencies.reserve(config.n);
+}
+
+Ptr<QueueDisc>
+QueueDiscBench::CreateQueueDisc(const std::string& typeId, uint32_t nFlows) const
+{
+    ObjectFactory factory(typeId);
+    TypeId::AttributeInformation info;
+    if (factory.GetTypeId().LookupAttributeByName("Flows", &info))
+    {
+        factory.Set("Flows", UintegerValue(nFlows));
+    }
+    return factory.Create<QueueDisc>();
+}
+
+const OperationStats&
+QueueDiscBench::GetEnqueueStats() const
+{
+    return m_enqueueStats;
+}
+
+const OperationStats&
+QueueDiscBench::GetDequeueStats() const
+{
+    return m_dequeueStats;
+}
+
+uint64_t
+QueueDiscBench::GetDropped() const
+{
+    return CountDropped() - m_warmUpDropped;
+}
+
+uint64_t
+QueueDiscBench::GetSelfDequeued() const
+{
+    return m_selfDequeued;
+}
+
+uint64_t
+QueueDiscBench::CountDropped() const
+{
+    uint64_t dropped = 0;
+    for (const auto& queueDisc : m_txQueueDiscs)
+    {
+        dropped += queueDisc->GetStats().nTotalDroppedPackets;
+    }
+    return dropped;
+}
+
+void
+QueueDiscBench::Run()
+{
+    // The first packet of each flow may create its flow queue, which is not
+    // part of the measure
+    for (uint32_t flow = 0; flow < m_nFlows; flow++)
+    {
+        EnqueuePacket(flow, GetNextSize());
+    }
+    Simulator::Run();
+    m_warmUpDropped = CountDropped();
+    m_sent = 0;
+    m_selfDequeued = 0;
+
+    m_measuring = true;
+    Simulator::ScheduleNow(&QueueDiscBench::Arrive, this);
+    Simulator::Run();
+    m_measuring = false;
+
+    if (m_sent + GetDropped() != m_config.n)
+    {
+        std::cerr << "Error-- " << m_config.n - m_sent - GetDropped()
+                  << " packets neither sent nor dropped by " << m_queueDisc->GetInstanceTypeId()
+                  << std::endl;
+        exit(1);
+    }
+    m_queueDisc->Dispose();
+    Simulator::Destroy();
+}
+
+void
+QueueDiscBench::EnqueuePacket(uint32_t flow, uint32_t size)
+{
+    uint32_t txq = flow % m_txQueueDiscs.size();
+    Ipv4Header header;
+    header.SetSource(Ipv4Address(0x0a000000 + flow));
+    header.SetDestination(Ipv4Address("192.168.1.1"));
+    header.SetProtocol(17);
+    header.SetPayloadSize(size - 20);
+    UdpHeader udp;
+    udp.SetSourcePort(49152);
+    udp.SetDestinationPort(9);
+    Ptr<Packet> packet = Create<Packet>(size - HEADERS_SIZE);
+    packet->AddHeader(udp);
+    Ptr<QueueDiscItem> item = Create<Ipv4QueueDiscItem>(packet, Address(), 0x0800, header);
+    item->SetTxQueueIndex(txq);
+
+    Ptr<QueueDisc> queueDisc = m_txQueueDiscs[txq];
+    if (m_measuring)
+    {
+        Measure(m_enqueueStats, [&queueDisc, &item]() { return queueDisc->Enqueue(item); });
+    }
+    else
+    {
+        queueDisc->Enqueue(item);
+    }
+    StartTransmission(txq);
+}
+
+void
+QueueDiscBench::Arrive()
+{
+    uint32_t packets = (m_config.arrivals == BURSTY) ? m_config.burst : 1;
+    for (uint32_t i = 0; i < packets && m_arrived < m_config.n; i++, m_arrived++)
+    {
+        EnqueuePacket(m_flowVariable->GetInteger(0, m_nFlows - 1), GetNextSize());
+    }
+    if (m_arrived < m_config.n)
+    {
+        Simulator::Schedule(GetNextInterval(), &QueueDiscBench::Arrive, this);
+    }
+    StopIfDone();
+}
+
+Time
+QueueDiscBench::GetNextInterval()
+{
+    switch (m_config.arrivals)
+    {
+    case CONSTANT:
+        return Seconds(m_meanInterval);
+    case POISSON:
+        return Seconds(m_intervals->GetValue(m_meanInterval, 0));
+    case BURSTY:
+        return Seconds(m_intervals->GetValue(m_meanInterval * m_config.burst, 0));
+    }
+    return Seconds(m_meanInterval);
+}
+
+uint32_t
+QueueDiscBench::GetNextSize()
+{
+    switch (m_config.sizes)
+    {
+    case FIXED:
+        return m_config.size;
+    case UNIFORM:
+        return m_sizeVariable->GetInteger(64, 1500);
+    case IMIX: {
+        uint32_t i = m_sizeVariable->GetInteger(0, 11);
+        return (i < 7) ? 40 : (i < 11) ? 576 : 1500;
+    }
+    }
+    return m_config.size;
+}
+
+void
+QueueDiscBench::StartTransmission(uint32_t txq)
+{
+    Ptr<QueueDisc> queueDisc = m_txQueueDiscs[txq];
+    if (m_ndqi->GetTxQueue(txq)->IsStopped() || queueDisc->GetNPackets() == 0)
+    {
+        return;
+    }
+    Ptr<QueueDiscItem> item;
+    if (m_measuring)
+    {
+        item = Measure(m_dequeueStats, [&queueDisc]() { return queueDisc->Dequeue(); });
+    }
+    else
+    {
+        item = queueDisc->Dequeue();
+    }
+    if (item)
+    {
+        Transmit(txq, item);
+    }
+}
+
+void
+QueueDiscBench::Transmit(uint32_t txq, Ptr<QueueDiscItem> item)
+{
+    m_sent++;
+    m_ndqi->GetTxQueue(txq)->Stop();
+    Simulator::Schedule(m_config.linkRate.CalculateBytesTxTime(item->GetSize()),
+                        &QueueDiscBench::TransmitComplete,
+                        this,
+                        txq);
+}
+
+void
+QueueDiscBench::TransmitComplete(uint32_t txq)
+{
+    m_ndqi->GetTxQueue(txq)->Start();
+    StartTransmission(txq);
+    StopIfDone();
+}
+
+void
+QueueDiscBench::StopIfDone()
+{
+    if (m_measuring && m_arrived < m_config.n)
+    {
+        return;
+    }
+    for (uint32_t txq = 0; txq < m_txQueueDiscs.size(); txq++)
+    {
+        if (m_ndqi->GetTxQueue(txq)->IsStopped() || m_txQueueDiscs[txq]->GetNPackets() > 0)
+        {
+            return;
+        }
+    }
+    Simulator::Stop();
+}
+
+/**
+ * Print the statistics of operations.
+ * @param name the name of the operations
+ * @param stats the statistics
+ */
+static void
+PrintStats(const std::string& name, OperationStats stats)
+{
+    uint64_t count = stats.latencies.size();
+    if (count == 0)
+    {
+        std::cout << "  " << name << ": none" << std::endl;
+        return;
+    }
+    std::sort(stats.latencies.begin(), stats.latencies.end());
+    auto percentile = [&stats, count](double p) {
+        return stats.latencies[std::min<uint64_t>(count - 1, p * count)];
+    };
+    double ops = count;
+    ops *= 1000000000;
+    ops /= std::max<uint64_t>(stats.totalNs, 1);
+    std::cout << "  " << name << ": " << ops << " ops/s, "
+              << static_cast<double>(stats.allocations) / count << " allocations/op, "
+              << "latency p50 " << percentile(0.5) << " ns, p90 " << percentile(0.9)
+              << " ns, p99 " << percentile(0.99) << " ns, p99.9 " << percentile(0.999)
+              << " ns, max " << stats.latencies.back() << " ns" << std::endl;
+}
+
+static void
+runBench(const BenchConfig& config,
+         const std::string& typeId,
+         uint32_t nFlows,
+         uint32_t minIterations)
+{
+    OperationStats enqueueStats;
+    OperationStats dequeueStats;
+    uint64_t dropped = 0;
+    uint64_t selfDequeued = 0;
+    uint64_t minNs = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        QueueDiscBench bench(config, typeId, nFlows);
+        bench.Run();
+        uint64_t ns = bench.GetEnqueueStats().totalNs + bench.GetDequeueStats().totalNs;
+        if (ns < minNs)
+        {
+            minNs = ns;
+            enqueueStats = bench.GetEnqueueStats();
+            dequeueStats = bench.GetDequeueStats();
+            dropped = bench.GetDropped();
+            selfDequeued = bench.GetSelfDequeued();
+        }
+    }
+    std::cout << typeId << " " << nFlows << " flows: " << config.n << " packets, " << dropped
+              << " dropped";
+    if (selfDequeued > 0)
+    {
+        std::cout << ", " << selfDequeued << " dequeued by the queue disc itself (not measured)";
+    }
+    std::cout << std::endl;
+    PrintStats("enqueue", enqueueStats);
+    PrintStats("dequeue", dequeueStats);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t minIterations = 1;
+    std::string queueDiscs = "ns3::FifoQueueDisc,ns3::RedQueueDisc,ns3::CoDelQueueDisc,"
+                             "ns3::PieQueueDisc,ns3::CobaltQueueDisc,ns3::FqCoDelQueueDisc,"
+                             "ns3::FqCobaltQueueDisc,ns3::FqPieQueueDisc,ns3::TbfQueueDisc,"
+                             "ns3::MqQueueDisc";
+    std::string flows = "1,1000";
+    std::string arrivals = "poisson";
+    std::string sizes = "fixed";
+    BenchConfig config;
+    config.burst = 32;
+    config.size = 1000;
+    config.load = 1.1;
+    config.linkRate = DataRate("100Mbps");
+    config.txQueues = 4;
+    config.mqChild = "ns3::FqCoDelQueueDisc";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the enqueue and dequeue operations of queue discs, fed by synthetic "
+              "traffic and drained by a link. The Flows attribute of the queue discs which "
+              "have one is set to the number of flows; other attributes can be set with "
+              "--ns3::<TypeId>::<Attribute>=<value>.");
+    cmd.AddValue("n", "number of packets", n);
+    cmd.AddValue("queue-discs", "comma-separated list of TypeIds of queue discs", queueDiscs);
+    cmd.AddValue("flows", "comma-separated list of numbers of flows", flows);
+    cmd.AddValue("arrivals", "arrival process: constant, poisson or bursty", arrivals);
+    cmd.AddValue("burst", "number of packets of a burst, if bursty", config.burst);
+    cmd.AddValue("sizes", "packet sizes: fixed, uniform or imix", sizes);
+    cmd.AddValue("size", "size of the IPv4 packets, if fixed, in bytes", config.size);
+    cmd.AddValue("load", "offered load, relative to the rate of the link", config.load);
+    cmd.AddValue("link-rate", "rate of the link", config.linkRate);
+    cmd.AddValue("tx-queues", "number of device queues of the MQ queue disc", config.txQueues);
+    cmd.AddValue("mq-child", "TypeId of the child queue discs of MQ", config.mqChild);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0)
+    {
+        std::cerr << "Error-- number of packets must be specified "
+                  << "by command-line argument --n=(number of packets)" << std::endl;
+        exit(1);
+    }
+    config.n = n;
+
+    if (arrivals == "constant")
+    {
+        config.arrivals = CONSTANT;
+    }
+    else if (arrivals == "poisson")
+    {
+        config.arrivals = POISSON;
+    }
+    else if (arrivals == "bursty")
+    {
+        config.arrivals = BURSTY;
+    }
+    else
+    {
+        std::cerr << "Error-- unknown arrival process " << arrivals << std::endl;
+        exit(1);
+    }
+
+    if (sizes == "fixed")
+    {
+        config.sizes = FIXED;
+    }
+    else if (sizes == "uniform")
+    {
+        config.sizes = UNIFORM;
+    }
+    else if (sizes == "imix")
+    {
+        config.sizes = IMIX;
+    }
+    else
+    {
+        std::cerr << "Error-- unknown packet sizes " << sizes << std::endl;
+        exit(1);
+    }
+
+    if (config.size < HEADERS_SIZE || config.load <= 0 || config.burst == 0 ||
+        config.txQueues == 0)
+    {
+        std::cerr << "Error-- invalid size, load, burst or number of device queues" << std::endl;
+        exit(1);
+    }
+
+    std::cout << "Running bench-queue-disc with n=" << n << ", " << arrivals << " arrivals, "
+              << sizes << " sizes, load " << config.load << " of " << config.linkRate
+              << std::endl;
+
+    std::istringstream queueDiscList(queueDiscs);
+    std::string typeId;
+    while (std::getline(queueDiscList, typeId, ','))
+    {
+        std::istringstream flowList(flows);
+        std::string nFlows;
+        while (std::getline(flowList, nFlows, ','))
+        {
+            runBench(config, typeId, std::stoul(nFlows), minIterations);
+        }
+    }
+
+    return 0;
+}
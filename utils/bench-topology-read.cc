@@ -0,0 +1,115 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program can be used to benchmark the topology readers on a large
+// synthetic Orbis file: the creation of the nodes and links by Read(), and
+// the parsing of the file into a graph by ReadGraph(), by one thread or by
+// several threads.
+// Sample usage:  ./ns3 run 'bench-topology-read --n=1000000'
+
+#include "ns3/command-line.h"
+#include "ns3/orbis-topology-reader.h"
+#include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib> // for exit ()
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace ns3;
+
+static void
+benchRead(const std::string& fileName, uint32_t threads)
+{
+    Ptr<OrbisTopologyReader> reader = CreateObject<OrbisTopologyReader>();
+    reader->SetFileName(fileName);
+    reader->SetAttribute("ParserThreads", UintegerValue(threads));
+    reader->Read();
+    Simulator::Destroy();
+}
+
+static void
+benchReadGraph(const std::string& fileName, uint32_t threads)
+{
+    Ptr<OrbisTopologyReader> reader = CreateObject<OrbisTopologyReader>();
+    reader->SetFileName(fileName);
+    reader->SetAttribute("ParserThreads", UintegerValue(threads));
+    reader->ReadGraph();
+}
+
+static void
+runBench(void (*bench)(const std::string&, uint32_t),
+         const std::string& fileName,
+         uint32_t threads,
+         uint32_t n,
+         uint32_t minIterations,
+         const char* name)
+{
+    uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < minIterations; i++)
+    {
+        SystemWallClockMs time;
+        time.Start();
+        (*bench)(fileName, threads);
+        minDelay = std::min<uint64_t>(minDelay, time.End());
+    }
+    double ns = minDelay;
+    ns *= 1000000;
+    ns /= n;
+    std::cout << ns << " ns/link"
+              << " (" << minDelay << " ms elapsed)\t" << name << " " << threads << " thread(s)"
+              << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t nodes = 0;
+    uint32_t threads = 4;
+    uint32_t minIterations = 1;
+    std::string fileName = "bench-topology-read.txt";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the topology readers on a large synthetic Orbis file");
+    cmd.AddValue("n", "number of links", n);
+    cmd.AddValue("nodes", "number of nodes, 0 for a tenth of the number of links", nodes);
+    cmd.AddValue("threads", "number of threads parsing the file in parallel", threads);
+    cmd.AddValue("file", "name of the temporary topology file", fileName);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0)
+    {
+        std::cerr << "Error-- number of links must be specified "
+                  << "by command-line argument --n=(number of links)" << std::endl;
+        exit(1);
+    }
+    nodes = (nodes == 0) ? std::max(n / 10, 2U) : nodes;
+    std::cout << "Running bench-topology-read with n=" << n << " nodes=" << nodes << std::endl;
+
+    {
+        std::ofstream file(fileName);
+        uint64_t seed = 1;
+        for (uint32_t i = 0; i < n; i++)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+            file << (seed >> 33) % nodes << " " << (seed >> 13) % nodes << "\n";
+        }
+    }
+
+    runBench(&benchRead, fileName, 1, n, minIterations, "Read");
+    runBench(&benchReadGraph, fileName, 1, n, minIterations, "ReadGraph");
+    runBench(&benchReadGraph, fileName, threads, n, minIterations, "ReadGraph");
+
+    std::remove(fileName.c_str());
+    return 0;
+}